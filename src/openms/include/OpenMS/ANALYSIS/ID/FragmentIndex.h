@@ -0,0 +1,233 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Fragment-ion index mapping binned fragment m/z values to candidate peptides
+
+    The index stores the theoretical fragment ions of all candidate peptides of
+    a database search (one entry per modified variant of a digested sequence).
+    Fragment m/z values are discretized into bins of fixed width, and for
+    each bin the peptides having a fragment in it are listed. Peptides are
+    ordered by mass, so the peptides within a precursor mass window form a
+    contiguous range that can be looked up by binary search (see
+    getPeptideRange()). For each spectrum, query() then counts the fragments
+    shared with each peptide in that range and returns only the peptides
+    sharing enough fragments. These candidates are scored in full
+    afterwards. This approach (as in MSFragger or Sage) avoids generating and
+    scoring the theoretical spectra of all peptides in wide precursor windows
+    (e.g. in open searches).
+
+    Usage: add the unmodified sequences with addSequence() and the candidate
+    peptides with addPeptide(), then call finalize() before querying. A
+    finalized index can be written to disk with store() and read back with
+    load(), so it only needs to be built once per database and search
+    settings. Use setSettings() to record these settings in the index file,
+    and compare them to getSettings() after loading.
+
+    All const member functions of a finalized index are thread-safe.
+
+    @ingroup Analysis_ID
+  */
+  class OPENMS_DLLAPI FragmentIndex
+  {
+  public:
+    /// A candidate peptide, i.e. one modified variant of a digested sequence
+    struct Peptide
+    {
+      Size sequence_index; ///< index of the unmodified sequence (see getSequences())
+      Size modification_index; ///< index of the modified variant (as enumerated by ModifiedPeptideGenerator)
+      double mass; ///< monoisotopic mass of the modified peptide
+    };
+
+    /**
+      @brief Constructor
+
+      @param bin_size  width of the fragment m/z bins (in Th)
+
+      @throw Exception::InvalidParameter if @p bin_size is not positive
+    */
+    explicit FragmentIndex(double bin_size = 0.05);
+
+    /// Returns the width of the fragment m/z bins
+    double getBinSize() const;
+
+    /// Sets a description of the settings the index was built with (stored with the index)
+    void setSettings(const String& settings);
+
+    /// Returns the description of the settings the index was built with
+    const String& getSettings() const;
+
+    /// Adds an unmodified peptide sequence and returns its index
+    Size addSequence(const String& sequence);
+
+    /**
+      @brief Adds a candidate peptide and its theoretical fragments
+
+      The fragments are taken from @p theoretical_spectrum, which has to be
+      sorted by m/z. If present, the first character of the ion names in its
+      first StringDataArray (e.g. 'b' or 'y') is stored along with each fragment.
+      Intensities are not stored.
+
+      Not thread-safe. Must not be called on a finalized index.
+
+      @throw Exception::IllegalArgument if the index is already finalized
+    */
+    void addPeptide(Size sequence_index, Size modification_index, double mass, const MSSpectrum& theoretical_spectrum);
+
+    /**
+      @brief Sorts the peptides by mass and builds the fragment bins
+
+      Needs to be called after all peptides have been added and before querying.
+      Peptides of equal mass are ordered by sequence and modification index,
+      so the result does not depend on the order in which peptides were added.
+    */
+    void finalize();
+
+    /// Returns whether finalize() has been called
+    bool isFinalized() const;
+
+    /// Returns the number of candidate peptides
+    Size size() const;
+
+    /// Returns the unmodified sequences
+    const std::vector<String>& getSequences() const;
+
+    /// Returns the candidate peptides (ordered by mass after finalize())
+    const std::vector<Peptide>& getPeptides() const;
+
+    /**
+      @brief Returns the range [first, second) of peptide indices with mass in [@p min_mass, @p max_mass]
+    */
+    std::pair<Size, Size> getPeptideRange(double min_mass, double max_mass) const;
+
+    /**
+      @brief Finds the peptides that share fragments with a spectrum
+
+      Each peak of @p spectrum is matched against the fragment bins within the
+      fragment mass tolerance. Only peptides with indices in
+      [@p peptide_begin, @p peptide_end) are considered.
+
+      @param spectrum  experimental spectrum (fragment m/z as singly charged ions)
+      @param fragment_mass_tolerance  fragment mass tolerance
+      @param fragment_mass_tolerance_unit_ppm  whether the tolerance is given in ppm (instead of Th)
+      @param peptide_begin  first peptide index to consider
+      @param peptide_end  peptide index past the last one to consider
+      @param min_shared_fragments  minimum number of shared fragments for a peptide to be reported
+      @param candidates  indices of the peptides sharing enough fragments, in ascending order (appended)
+
+      @throw Exception::IllegalArgument if the index is not finalized
+    */
+    void query(const MSSpectrum& spectrum,
+      double fragment_mass_tolerance,
+      bool fragment_mass_tolerance_unit_ppm,
+      Size peptide_begin,
+      Size peptide_end,
+      Size min_shared_fragments,
+      std::vector<Size>& candidates) const;
+
+    /**
+      @brief Reconstructs the theoretical spectrum of a peptide from the stored fragments
+
+      All peaks get an intensity of one. The ion types are stored as
+      single-character ion names in a StringDataArray "IonNames", as expected
+      by HyperScore::compute().
+    */
+    void getTheoreticalSpectrum(Size peptide_index, MSSpectrum& spectrum) const;
+
+    /**
+      @brief Writes the finalized index to a binary file
+
+      @throw Exception::IllegalArgument if the index is not finalized
+      @throw Exception::UnableToCreateFile if the file cannot be written
+    */
+    void store(const String& filename) const;
+
+    /**
+      @brief Reads an index written by store()
+
+      @throw Exception::FileNotFound if the file does not exist
+      Lengths and offsets read from the file are validated before they are used,
+      so a truncated or corrupt file results in an exception instead of a
+      huge allocation or out-of-bounds access. After an exception, the index
+      is not finalized and needs to be rebuilt or loaded again.
+
+      @throw Exception::ParseError if the file is not a fragment index file (of this version), or is truncated or corrupt
+    */
+    void load(const String& filename);
+
+  protected:
+    /// Returns the bin of a fragment m/z
+    Size bin_(double mz) const;
+
+    /// width of the fragment m/z bins
+    double bin_size_;
+
+    /// description of the settings the index was built with
+    String settings_;
+
+    /// whether the fragment bins have been built
+    bool finalized_;
+
+    /// unmodified sequences
+    std::vector<String> sequences_;
+
+    /// candidate peptides (sorted by mass when finalized)
+    std::vector<Peptide> peptides_;
+
+    /// fragments of peptide i are at [fragment_offsets_[i], fragment_offsets_[i + 1])
+    std::vector<Size> fragment_offsets_;
+
+    /// fragment m/z values (single precision to keep the index compact)
+    std::vector<float> fragment_mz_;
+
+    /// fragment ion types (first character of the ion name)
+    std::vector<char> fragment_ion_types_;
+
+    /// peptides with a fragment in bin b are at [bin_offsets_[b], bin_offsets_[b + 1]) in bin_peptides_
+    std::vector<Size> bin_offsets_;
+
+    /// peptide indices for each bin, ascending within a bin
+    std::vector<UInt32> bin_peptides_;
+  };
+
+} // namespace OpenMS
@@ -35,13 +35,17 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
 #include <OpenMS/ANALYSIS/RNPXL/ModifiedPeptideGenerator.h>
+#include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <vector>
 
 namespace OpenMS
 {
+class TheoreticalSpectrumGenerator;
 
 class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
   public DefaultParamHandler,
@@ -88,6 +92,45 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
     /// @brief filter, deisotope, decharge spectra
     static void preprocessSpectra_(PeakMap& exp, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm);
 
+    /// @brief add all candidate peptides of the database to the fragment index (and finalize it)
+    void buildFragmentIndex_(FragmentIndex& fragment_index,
+      const std::vector<FASTAFile::FASTAEntry>& fasta_db,
+      const ProteaseDigestion& digestor,
+      const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+      const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+      const TheoreticalSpectrumGenerator& spectrum_generator) const;
+
+    /// @brief score the candidates preselected by the fragment index against each spectrum
+    void searchFragmentIndex_(const FragmentIndex& fragment_index,
+      const PeakMap& spectra,
+      std::vector<std::vector<AnnotatedHit_> >& annotated_hits,
+      bool precursor_mass_tolerance_unit_ppm,
+      bool fragment_mass_tolerance_unit_ppm) const;
+
+    /// @brief build or load the fragment index, preselect and score candidates with it and report the hits
+    ExitCodes searchWithFragmentIndex_(const String& in_mzML,
+      const String& in_db,
+      PeakMap& spectra,
+      std::vector<FASTAFile::FASTAEntry>& fasta_db,
+      const ProteaseDigestion& digestor,
+      const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+      const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+      const TheoreticalSpectrumGenerator& spectrum_generator,
+      std::vector<std::vector<AnnotatedHit_> >& annotated_hits,
+      std::vector<ProteinIdentification>& protein_ids,
+      std::vector<PeptideIdentification>& peptide_ids) const;
+
+    /// @brief post-process the scored hits (see postProcessHits_) and map the peptides to the proteins of the database
+    ExitCodes postProcessAndIndexHits_(const String& in_mzML,
+      const String& in_db,
+      PeakMap& spectra,
+      std::vector<FASTAFile::FASTAEntry>& fasta_db,
+      const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+      const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+      std::vector<std::vector<AnnotatedHit_> >& annotated_hits,
+      std::vector<ProteinIdentification>& protein_ids,
+      std::vector<PeptideIdentification>& peptide_ids) const;
+
     /// @brief filter and annotate search results
     /// most of the parameters are used to properly add meta data to the id objects
     void postProcessHits_(const PeakMap& exp, 
@@ -141,6 +184,11 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
     String peptide_motif_;
 
     Size report_top_hits_;
+
+    bool fragment_index_;
+    double fragment_index_bin_size_;
+    Size fragment_index_min_shared_fragments_;
+    String fragment_index_file_;
 };
 
 } // namespace
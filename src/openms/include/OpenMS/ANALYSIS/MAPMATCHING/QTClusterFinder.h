@@ -37,6 +37,7 @@
 #include <OpenMS/ANALYSIS/MAPMATCHING/BaseGroupFinder.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/COMPARISON/CLUSTERING/HashGrid.h>
+#include <OpenMS/COMPARISON/CLUSTERING/FlatHashGrid.h>
 #include <OpenMS/DATASTRUCTURES/GridFeature.h>
 #include <OpenMS/DATASTRUCTURES/QTCluster.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureDistance.h>
@@ -120,6 +121,9 @@ namespace OpenMS
 
     typedef HashGrid<OpenMS::GridFeature*> Grid;
 
+    /// Immutable copy of the grid used for the (many) neighbourhood queries
+    typedef FlatHashGrid<OpenMS::GridFeature*> FlatGrid;
+
   private:
     /// Number of input maps
     Size num_maps_;
@@ -165,7 +169,7 @@ namespace OpenMS
     bool makeConsensusFeature_(Heap& cluster_heads,
                                ConsensusFeature& feature,
                                ElementMapping& element_mapping,
-                               const Grid& grid,
+                               const FlatGrid& grid,
                                const std::vector<Heap::handle_type>& handles);
 
     /**
@@ -177,7 +181,7 @@ namespace OpenMS
      * @param handles vector where handles of the inserted clusters are stored
      * @param element_mapping the element mapping where all the clusters get registered for their features
      */
-    void computeClustering_(const Grid& grid,
+    void computeClustering_(const FlatGrid& grid,
                             Heap& cluster_heads,
                             std::vector<QTCluster::BulkData>& cluster_data,
                             std::vector<Heap::handle_type>& handles,
@@ -223,7 +227,7 @@ namespace OpenMS
      * therefore don't have to delete them.
      */
     void updateClustering_(ElementMapping& element_mapping,
-                           const Grid& grid, 
+                           const FlatGrid& grid, 
                            const QTCluster::Elements& elements,
                            Heap& cluster_heads,
                            const std::vector<Heap::handle_type>& handles,
@@ -244,7 +248,7 @@ namespace OpenMS
      * @param grid the grid is used to find neighboring features the cluster
      * @param cluster cluster to which the new elements are added
      */ 
-    void addClusterElements_(const Grid& grid, QTCluster& cluster);
+    void addClusterElements_(const FlatGrid& grid, QTCluster& cluster);
 
 protected:
 
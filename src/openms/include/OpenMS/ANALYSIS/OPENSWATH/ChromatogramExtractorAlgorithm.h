@@ -98,6 +98,12 @@ public:
      * @param ppm Whether mz_extraction_window is in ppm or in Th
      * @param filter Which function to apply in m/z space (currently "tophat" only)
      *
+     * If @p input is a SpectrumAccessOpenMSCached with memory mapping
+     * enabled, the spectra are read in place from the mapped file. Any other
+     * accessor, including wrappers around a cached accessor (e.g.
+     * SpectrumAccessQuadMZTransforming), is read through getSpectrumById so
+     * that the transformations applied by the wrapper are honored.
+     *
     */
     void extractChromatograms(const OpenSwath::SpectrumAccessPtr input,
         std::vector< OpenSwath::ChromatogramPtr >& output,
@@ -140,6 +146,36 @@ public:
                               const double mz_extraction_window,
                               const bool ppm);
 
+    /**
+     * @brief Extract the integrated intensities around many m/z values at once.
+     *
+     * Sums up the same peaks as calling the iterator-based
+     * extract_value_tophat once for each target m/z, but does so in a single
+     * merge pass over the spectrum (using SIMD instructions where available).
+     * Since the intensities are accumulated in a different order, the
+     * results may differ from the scalar function by floating-point rounding.
+     * This is used by extractChromatograms whenever no ion mobility
+     * extraction is requested.
+     *
+     * @param mz_array m/z values of the spectrum (sorted)
+     * @param int_array Intensity values of the spectrum
+     * @param mz_targets Target m/z values (need to be sorted in ascending order)
+     * @param integrated_intensities Output, one integrated intensity for each target m/z value
+     * @param mz_extraction_window Extracts a window of this size in m/z
+     * dimension (e.g. a window of 50 ppm means an extraction of 25 ppm on
+     * either side)
+     * @param ppm Whether the parameter mz_extraction_window is given in ppm or Th
+     *
+     * @throws Exception::IllegalArgument if m/z and intensity array differ in size
+     *
+    */
+    void extract_value_tophat(const std::vector<double>& mz_array,
+                              const std::vector<double>& int_array,
+                              const std::vector<double>& mz_targets,
+                              std::vector<double>& integrated_intensities,
+                              const double mz_extraction_window,
+                              const bool ppm);
+
     /**
      * @brief Extract the next m/z value and add the integrated intensity to integrated_intensity.
      *
@@ -39,6 +39,7 @@
 #include <boost/numeric/conversion/cast.hpp>
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/ANALYSIS/TARGETED/TargetedExperiment.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/TransitionExperiment.h>
@@ -59,6 +60,9 @@ public:
     /// Convert an OpenMS Spectrum to an SpectrumPtr
     static OpenSwath::SpectrumPtr convertToSpectrumPtr(const OpenMS::MSSpectrum & spectrum);
 
+    /// Convert peak arrays to an SpectrumPtr, moving the arrays (no copy), @p spectrum is left empty
+    static OpenSwath::SpectrumPtr convertToSpectrumPtr(OpenMS::MSSpectrumSoA && spectrum);
+
     /// Convert a ChromatogramPtr to an OpenMS Chromatogram
     static void convertToOpenMSChromatogram(const OpenSwath::ChromatogramPtr cptr, OpenMS::MSChromatogram & chromatogram);
 
@@ -0,0 +1,212 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinFile.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace boost
+{
+  namespace iostreams
+  {
+    class mapped_file_source;
+  }
+}
+
+namespace OpenMS
+{
+
+  /**
+    @brief Read-only, memory-mapped view of a binary transition library
+
+    Maps a library written by TransitionBinFile into memory and provides
+    zero-copy access to its numeric columns. Strings are read from the string
+    tables only when requested, and complete OpenSwath::LightTransition,
+    LightCompound and LightProtein objects are only created for the
+    transitions selected by selectSwathTransitions() or selectTransitions().
+
+    The mapping is read-only and shared, so several processes working on the
+    same library share its pages through the page cache. Copies of this
+    object share the mapping as well; all const member functions are
+    thread-safe.
+
+    The pointers returned by the column accessors stay valid as long as this
+    object (or a copy of it) exists.
+  */
+  class OPENMS_DLLAPI MappedTransitionLibrary
+  {
+public:
+
+    /** @name Constructors and Destructor */
+    //@{
+    /// Default constructor, creates an empty library
+    MappedTransitionLibrary();
+
+    /**
+      @brief Maps the library in file @p filename (see open())
+    */
+    explicit MappedTransitionLibrary(const String& filename);
+
+    /// Destructor
+    ~MappedTransitionLibrary();
+    //@}
+
+    /**
+      @brief Maps the library in file @p filename into memory
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::FileNotReadable is thrown if the file could not be mapped
+      @exception Exception::ParseError is thrown if the file is not a binary transition library or is corrupt
+    */
+    void open(const String& filename);
+
+    /// Returns whether a library is mapped
+    bool isOpen() const;
+
+    /// Returns the name of the mapped file
+    const String& getFilename() const;
+
+    /** @name Sizes */
+    //@{
+    Size getNrTransitions() const;
+    Size getNrCompounds() const;
+    Size getNrProteins() const;
+    //@}
+
+    /** @name Transition columns (one entry per transition) */
+    //@{
+    const double* getPrecursorMZs() const;
+    const double* getProductMZs() const;
+    const double* getLibraryIntensities() const;
+    const Int32* getFragmentCharges() const;
+    /// Index of the compound of each transition
+    const UInt32* getCompoundIndices() const;
+    /// Bit flags of each transition (see TransitionBinFile::TransitionFlag)
+    const unsigned char* getFlags() const;
+    //@}
+
+    /** @name Compound columns (one entry per compound) */
+    //@{
+    /// Normalized retention times
+    const double* getNormalizedRTs() const;
+    /// Ion mobility (drift times)
+    const double* getDriftTimes() const;
+    const Int32* getCharges() const;
+    //@}
+
+    /** @name String access (resolved from the string tables on each call) */
+    //@{
+    std::string getTransitionName(Size index) const;
+    std::string getCompoundId(Size index) const;
+    std::string getProteinId(Size index) const;
+    //@}
+
+    /** @name Materialization */
+    //@{
+    /// Creates transition @p index
+    void getTransition(Size index, OpenSwath::LightTransition& transition) const;
+
+    /// Creates compound @p index
+    void getCompound(Size index, OpenSwath::LightCompound& compound) const;
+
+    /// Creates protein @p index
+    void getProtein(Size index, OpenSwath::LightProtein& protein) const;
+
+    /**
+      @brief Adds the transitions with the given indices, their compounds and proteins to @p transition_exp_used
+
+      Transitions, compounds and proteins are added in library order.
+
+      @param indices Indices of the transitions, sorted in ascending order
+      @param transition_exp_used Output library
+    */
+    void selectTransitions(const std::vector<Size>& indices, OpenSwath::LightTargetedExperiment& transition_exp_used) const;
+
+    /**
+      @brief Selects the transitions of a SWATH window
+
+      Equivalent to OpenSwathHelper::selectSwathTransitions() on the full
+      library, but uses the precursor m/z index and only creates the selected
+      transitions with their compounds and proteins.
+    */
+    void selectSwathTransitions(OpenSwath::LightTargetedExperiment& transition_exp_used, double min_upper_edge_dist,
+                                double lower, double upper) const;
+
+    /// Creates the complete library
+    void getLightTargetedExperiment(OpenSwath::LightTargetedExperiment& transition_exp) const;
+    //@}
+
+protected:
+
+    /// Throws Exception::ParseError with message @p message
+    void parseError_(const String& message) const;
+
+    /// Returns a pointer to the start of column @p column
+    template <typename T>
+    const T* column_(TransitionBinFile::Column column) const
+    {
+      return reinterpret_cast<const T*>(columns_[column]);
+    }
+
+    /// Reads entry @p index from the string table starting at column @p offsets_column
+    std::string getString_(TransitionBinFile::Column offsets_column, Size index) const;
+
+    /// Reads entries [@p first, @p last) from the string table starting at column @p offsets_column
+    std::vector<std::string> getStrings_(TransitionBinFile::Column offsets_column, Size first, Size last) const;
+
+    /// Checks that the file is mapped and the column pointers are valid
+    void validate_();
+
+    String filename_;
+
+    std::shared_ptr<boost::iostreams::mapped_file_source> mapped_file_;
+
+    TransitionBinFile::Header header_;
+
+    /// Start of each column in the mapped file
+    std::vector<const char*> columns_;
+
+    /// Size of each column in bytes
+    std::vector<UInt64> column_sizes_;
+
+    /// Indices of the proteins by their id, so protein references resolve without scanning all proteins
+    std::unordered_multimap<std::string, Size> protein_index_;
+  };
+
+} // namespace OpenMS
@@ -55,10 +55,14 @@ namespace OpenMS
     (ISpectrumAccess) using the CachedmzML class which is able to read and
     write a cached mzML file.
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    @note By default, this implementation is @a not thread-safe since it keeps
+    internally a single file access pointer which it moves when accessing a
+    specific data item. The caller is responsible to ensure that access is
+    performed atomically.
+
+    If memory mapping is enabled (see CachedmzML::setMemoryMapping), access is
+    thread-safe and ChromatogramExtractorAlgorithm reads the spectra directly
+    from the mapped file without copying them to the heap.
 
   */
   class OPENMS_DLLAPI SpectrumAccessOpenMSCached :
@@ -4,6 +4,7 @@ set(directory include/OpenMS/ANALYSIS/OPENSWATH/DATAACCESS)
 ### list all header files of the directory here
 set(sources_list_h
 DataAccessHelper.h
+MappedTransitionLibrary.h
 MRMFeatureAccessOpenMS.h
 SimpleOpenMSSpectraAccessFactory.h
 SpectrumAccessOpenMS.h
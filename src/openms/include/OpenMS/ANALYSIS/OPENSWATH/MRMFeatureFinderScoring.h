@@ -59,6 +59,8 @@
 #include <boost/make_shared.hpp>
 #include <boost/unordered_map.hpp>
 
+#include <unordered_map>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -135,6 +137,11 @@ public:
                         TransformationDescription trafo, PeakMap& swath_map);
 
     /** @brief Pick features in one experiment containing chromatogram
+     *
+     * Transition groups are picked and scored in parallel (if OpenMP is
+     * enabled), each thread uses its own picker and scoring objects. The
+     * features are stored in the order of @p transition_group_map,
+     * independent of the number of threads.
      *
      * @param input The input chromatograms
      * @param output The output features with corresponding scores
@@ -306,7 +313,7 @@ private:
     double im_extra_drift_;
 
     // members
-    std::map<OpenMS::String, const PeptideType*> PeptideRefMap_;
+    std::unordered_map<OpenMS::String, const PeptideType*> PeptideRefMap_;
     OpenSwath_Scores_Usage su_;
     OpenMS::DIAScoring diascoring_;
     OpenMS::SONARScoring sonarscoring_;
@@ -47,6 +47,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessTransforming.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/MappedTransitionLibrary.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SwathMap.h>
 
 // Helpers
@@ -446,8 +447,48 @@ protected:
                            int ms1_isotopes,
                            bool load_into_memory);
 
+    /** @brief Execute OpenSWATH analysis on a set of SwathMaps and a memory-mapped transition library.
+     *
+     * Same as above, but the transitions of each SWATH window are read from
+     * the mapped @p assay_library (see TransitionBinFile) when the window is
+     * processed, so the complete library is never held in memory (except
+     * when only MS1 data is analyzed).
+     *
+    */
+    void performExtraction(const std::vector< OpenSwath::SwathMap > & swath_maps,
+                           const TransformationDescription trafo,
+                           const ChromExtractParams & chromatogram_extraction_params,
+                           const ChromExtractParams & ms1_chromatogram_extraction_params,
+                           const Param & feature_finder_param,
+                           const MappedTransitionLibrary& assay_library,
+                           FeatureMap& result_featureFile,
+                           bool store_features_in_featureFile,
+                           OpenSwathTSVWriter & result_tsv,
+                           OpenSwathOSWWriter & result_osw,
+                           Interfaces::IMSDataConsumer * result_chromatograms,
+                           int batchSize,
+                           int ms1_isotopes,
+                           bool load_into_memory);
+
   protected:
 
+    /// Implementation of performExtraction(), uses either @p assay_library or @p mapped_library (the other one is null)
+    void performExtraction_(const std::vector< OpenSwath::SwathMap > & swath_maps,
+                            const TransformationDescription& trafo,
+                            const ChromExtractParams & chromatogram_extraction_params,
+                            const ChromExtractParams & ms1_chromatogram_extraction_params,
+                            const Param & feature_finder_param,
+                            const OpenSwath::LightTargetedExperiment* assay_library,
+                            const MappedTransitionLibrary* mapped_library,
+                            FeatureMap& result_featureFile,
+                            bool store_features_in_featureFile,
+                            OpenSwathTSVWriter & result_tsv,
+                            OpenSwathOSWWriter & result_osw,
+                            Interfaces::IMSDataConsumer * result_chromatograms,
+                            int batchSize,
+                            int ms1_isotopes,
+                            bool load_into_memory);
+
 
     /** @brief Write output features and chromatograms
      *
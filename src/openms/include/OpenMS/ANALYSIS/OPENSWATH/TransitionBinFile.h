@@ -0,0 +1,194 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/TransitionExperiment.h>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Compact binary, memory-mappable transition library for OpenSWATH
+
+    PQP, TSV and TraML libraries are parsed completely into an
+    OpenSwath::LightTargetedExperiment before extraction, so every
+    OpenSwathWorkflow process holds its own copy of the library with one
+    std::string per identifier. This class stores a LightTargetedExperiment
+    in a columnar binary layout that can be used in place after mapping the
+    file into memory (see MappedTransitionLibrary). Processes working on the
+    same library then share it read-only through the page cache and only
+    materialize the transitions of the SWATH window they currently work on.
+
+    Layout:
+
+    - header: magic number, format version, byte order mark, number of
+      transitions, compounds and proteins, number of columns
+    - column directory: offset and size in bytes of every column (see Column)
+    - columns: one contiguous array per property, each starting at an offset
+      that is a multiple of 8 bytes
+
+    Numeric properties (precursor and product m/z, library intensity,
+    normalized retention time, ion mobility, charges, flags) are stored as
+    plain arrays. Transitions refer to their compound by index. Strings
+    (identifiers, sequences, annotations) are stored as string tables, i.e.
+    an array of n + 1 offsets into a block of characters, and are only
+    touched when they are accessed. In addition, the transitions are indexed
+    by ascending precursor m/z so that the transitions of a SWATH window can
+    be found without scanning the whole library.
+
+    Values are written in native byte order (like cachedMzML); files cannot be
+    read on machines with a different byte order.
+
+    @note Compound identifiers need to be unique, transitions are linked to
+    the first compound with the identifier given as their peptide reference.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI TransitionBinFile :
+    public ProgressLogger
+  {
+public:
+
+    /// Columns of the binary layout, in the order of the column directory
+    enum Column
+    {
+      TRANSITION_PRECURSOR_MZ,          ///< double
+      TRANSITION_PRODUCT_MZ,            ///< double
+      TRANSITION_LIBRARY_INTENSITY,     ///< double
+      TRANSITION_FRAGMENT_CHARGE,       ///< Int32
+      TRANSITION_COMPOUND,              ///< UInt32, index of the compound
+      TRANSITION_FLAGS,                 ///< unsigned char, see TransitionFlag
+      TRANSITION_NAME_OFFSETS,          ///< UInt64, string table of transition names
+      TRANSITION_NAME_DATA,             ///< char
+      TRANSITION_BY_PRECURSOR_MZ,       ///< UInt32, transition indices sorted by precursor m/z
+      COMPOUND_RT,                      ///< double, normalized retention time
+      COMPOUND_DRIFT_TIME,              ///< double, ion mobility
+      COMPOUND_CHARGE,                  ///< Int32
+      COMPOUND_ID_OFFSETS,              ///< UInt64, string table of compound identifiers
+      COMPOUND_ID_DATA,                 ///< char
+      COMPOUND_SEQUENCE_OFFSETS,        ///< UInt64, string table of sequences
+      COMPOUND_SEQUENCE_DATA,           ///< char
+      COMPOUND_GROUP_LABEL_OFFSETS,     ///< UInt64, string table of peptide group labels
+      COMPOUND_GROUP_LABEL_DATA,        ///< char
+      COMPOUND_GENE_NAME_OFFSETS,       ///< UInt64, string table of gene names
+      COMPOUND_GENE_NAME_DATA,          ///< char
+      COMPOUND_SUM_FORMULA_OFFSETS,     ///< UInt64, string table of sum formulas
+      COMPOUND_SUM_FORMULA_DATA,        ///< char
+      COMPOUND_NAME_OFFSETS,            ///< UInt64, string table of compound names
+      COMPOUND_NAME_DATA,               ///< char
+      COMPOUND_PROTEIN_REF_RANGES,      ///< UInt64, n + 1 offsets into the protein references
+      COMPOUND_PROTEIN_REF_OFFSETS,     ///< UInt64, string table of protein references
+      COMPOUND_PROTEIN_REF_DATA,        ///< char
+      COMPOUND_MODIFICATION_RANGES,     ///< UInt64, n + 1 offsets into the modifications
+      COMPOUND_MODIFICATIONS,           ///< Int32, pairs of location and UniMod id
+      PROTEIN_ID_OFFSETS,               ///< UInt64, string table of protein identifiers
+      PROTEIN_ID_DATA,                  ///< char
+      PROTEIN_SEQUENCE_OFFSETS,         ///< UInt64, string table of protein sequences
+      PROTEIN_SEQUENCE_DATA,            ///< char
+      SIZE_OF_COLUMN
+    };
+
+    /// Bits of the TRANSITION_FLAGS column
+    enum TransitionFlag
+    {
+      FLAG_DECOY = 1,
+      FLAG_DETECTING = 2,
+      FLAG_QUANTIFYING = 4,
+      FLAG_IDENTIFYING = 8
+    };
+
+    /// Fixed-size header at the start of every file, followed by the column directory
+    struct Header
+    {
+      char magic[8];
+      UInt32 version;
+      UInt32 byte_order_mark;
+      UInt64 nr_transitions;
+      UInt64 nr_compounds;
+      UInt64 nr_proteins;
+      UInt64 nr_columns;
+    };
+
+    /// Entry of the column directory
+    struct ColumnEntry
+    {
+      UInt64 offset;
+      UInt64 size;
+    };
+
+    /// Magic number (first 8 bytes of a file)
+    static const char MAGIC[8];
+
+    /// Version of the binary layout written by store(); files with a higher version cannot be read
+    static const UInt32 VERSION;
+
+    /// Byte order mark, reads back differently on machines with another byte order
+    static const UInt32 BYTE_ORDER_MARK;
+
+    /** @name Constructors and Destructor */
+    //@{
+    /// Default constructor
+    TransitionBinFile();
+    /// Destructor
+    ~TransitionBinFile();
+    //@}
+
+    /**
+      @brief Stores the transition library @p transition_exp in file @p filename
+
+      @exception Exception::IllegalArgument is thrown if a transition refers to a compound that is not part of the library
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const OpenSwath::LightTargetedExperiment& transition_exp);
+
+    /**
+      @brief Loads the complete transition library from file @p filename
+
+      To work on the library without holding all of it in memory, use
+      MappedTransitionLibrary instead.
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary transition library or is corrupt
+    */
+    void load(const String& filename, OpenSwath::LightTargetedExperiment& transition_exp);
+
+    /// Returns whether @p filename starts with the magic number of a binary transition library
+    static bool isTransitionBinFile(const String& filename);
+  };
+
+} // namespace OpenMS
@@ -0,0 +1,180 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/TransitionExperiment.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Integer index over the references of a transition library
+
+    Built once for a OpenSwath::LightTargetedExperiment, the index interns the
+    compound and protein identifiers to integer keys and resolves all string
+    references of the library (transition to compound, compound to proteins)
+    to these keys. Lookups by identifier use a hash table, everything else is
+    plain integer array access.
+
+    The selection functions create the transitions of a SWATH or PRM window
+    together with their compounds and proteins without building any string
+    sets, so they can be called for every window (and from several threads)
+    on the same index. The result is the same as that of
+    OpenSwathHelper::selectSwathTransitions(): transitions, compounds and
+    proteins are added in library order, compounds and proteins are matched
+    by identifier (so duplicate identifiers are all selected), and references
+    to missing compounds or proteins are ignored.
+
+    The index stores indices into the library it was built from. It has to
+    be rebuilt if the transitions, compounds or proteins of that library
+    change, and the library has to be passed to the selection functions.
+    All const member functions are thread-safe.
+  */
+  class OPENMS_DLLAPI TransitionLibraryIndex
+  {
+public:
+
+    /// Returned for identifiers or references which are not part of the library
+    static const Size NOT_FOUND;
+
+    /// Default constructor, creates an empty index
+    TransitionLibraryIndex();
+
+    /// Builds the index for @p library (see build())
+    explicit TransitionLibraryIndex(const OpenSwath::LightTargetedExperiment& library);
+
+    /// Builds the index for @p library, replacing the current one
+    void build(const OpenSwath::LightTargetedExperiment& library);
+
+    /** @name Sizes of the indexed library */
+    //@{
+    Size getNrTransitions() const;
+    Size getNrCompounds() const;
+    Size getNrProteins() const;
+    //@}
+
+    /** @name Lookups */
+    //@{
+    /// Index of the first compound with identifier @p id, or NOT_FOUND
+    Size getCompoundIndex(const std::string& id) const;
+
+    /// Index of the first protein with identifier @p id, or NOT_FOUND
+    Size getProteinIndex(const std::string& id) const;
+
+    /// Index of the (first) compound referenced by transition @p transition_index, or NOT_FOUND
+    Size getTransitionCompound(Size transition_index) const;
+
+    /// Indices of the (first) proteins referenced by compound @p compound_index (in reference order, missing proteins are skipped)
+    std::vector<Size> getCompoundProteins(Size compound_index) const;
+    //@}
+
+    /** @name Selection */
+    //@{
+    /**
+      @brief Adds the transitions with the given indices, their compounds and proteins to @p selected
+
+      @param library The library the index was built from
+      @param transition_indices Indices of the transitions, sorted in ascending order
+      @param selected Output library
+    */
+    void selectTransitions(const OpenSwath::LightTargetedExperiment& library, const std::vector<Size>& transition_indices,
+                           OpenSwath::LightTargetedExperiment& selected) const;
+
+    /**
+      @brief Selects the transitions of a SWATH window
+
+      Same result as OpenSwathHelper::selectSwathTransitions() on @p library,
+      but the transitions are found by binary search on the precursor m/z.
+
+      @param library The library the index was built from
+      @param selected Output library
+      @param min_upper_edge_dist Distance in Th to the upper edge
+      @param lower Lower edge of SWATH window (in Th)
+      @param upper Upper edge of SWATH window (in Th)
+    */
+    void selectSwathTransitions(const OpenSwath::LightTargetedExperiment& library, OpenSwath::LightTargetedExperiment& selected,
+                                double min_upper_edge_dist, double lower, double upper) const;
+    //@}
+
+protected:
+
+    /// Interns @p id in @p keys and returns its key
+    static UInt32 intern_(const std::string& id, std::unordered_map<std::string, UInt32>& keys);
+
+    /// Groups the entries with the same key: members of key k are at [offsets[k], offsets[k + 1]) in members
+    static void group_(const std::vector<UInt32>& entry_keys, Size nr_keys, std::vector<Size>& offsets, std::vector<UInt32>& members);
+
+    /// Adds the compounds with the given keys and their proteins to @p selected
+    void selectCompounds_(const OpenSwath::LightTargetedExperiment& library, std::vector<UInt32>& compound_keys,
+                          OpenSwath::LightTargetedExperiment& selected) const;
+
+    /// Size of the indexed library
+    Size nr_transitions_;
+    Size nr_compounds_;
+    Size nr_proteins_;
+
+    /// Compound identifier to compound key
+    std::unordered_map<std::string, UInt32> compound_keys_;
+    /// Protein identifier to protein key
+    std::unordered_map<std::string, UInt32> protein_keys_;
+
+    /// Compound key of each transition (NOT_FOUND_KEY_ if the compound is missing)
+    std::vector<UInt32> transition_compound_keys_;
+
+    /// Compounds of compound key k are at [compound_offsets_[k], compound_offsets_[k + 1]) in compound_members_
+    std::vector<Size> compound_offsets_;
+    std::vector<UInt32> compound_members_;
+
+    /// Protein keys referenced by compound c are at [compound_protein_offsets_[c], compound_protein_offsets_[c + 1]) in compound_proteins_
+    std::vector<Size> compound_protein_offsets_;
+    std::vector<UInt32> compound_proteins_;
+
+    /// Proteins of protein key k are at [protein_offsets_[k], protein_offsets_[k + 1]) in protein_members_
+    std::vector<Size> protein_offsets_;
+    std::vector<UInt32> protein_members_;
+
+    /// Transitions with a valid precursor m/z, sorted by precursor m/z
+    std::vector<UInt32> precursor_order_;
+    std::vector<double> precursor_mzs_;
+
+    /// Key of references which are not part of the library
+    static const UInt32 NOT_FOUND_KEY_;
+  };
+
+} // namespace OpenMS
@@ -36,6 +36,8 @@ set(sources_list_h
   SwathQC.h
   SpectrumAddition.h
   TargetedSpectraExtractor.h
+  TransitionBinFile.h
+  TransitionLibraryIndex.h
   TransitionTSVFile.h
   TransitionPQPFile.h
 )
@@ -43,6 +43,7 @@
 #include <OpenMS/METADATA/SourceFile.h>
 #include <OpenMS/ANALYSIS/TARGETED/TargetedExperimentHelper.h>
 
+#include <unordered_map>
 #include <vector>
 
 namespace OpenMS
@@ -89,9 +90,10 @@ public:
     typedef ReactionMonitoringTransition Transition;
     typedef Residue IonType; // IonType enum of Interpretation class
 
-    typedef std::map<String, const Protein *> ProteinReferenceMapType;
-    typedef std::map<String, const Peptide *> PeptideReferenceMapType;
-    typedef std::map<String, const Compound *> CompoundReferenceMapType;
+    /// Hash-based indices from reference id to the referenced object (built lazily, see get*ByRef())
+    typedef std::unordered_map<String, const Protein *> ProteinReferenceMapType;
+    typedef std::unordered_map<String, const Peptide *> PeptideReferenceMapType;
+    typedef std::unordered_map<String, const Compound *> CompoundReferenceMapType;
 
     /** @name Constructors and destructors
     */
@@ -49,6 +49,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathWindowLoader.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathTSVWriter.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 
@@ -256,6 +257,26 @@ protected:
                           const boost::shared_ptr<ExperimentalSettings>& exp_meta,
                           const OpenSwath::LightTargetedExperiment& transition_exp,
                           const String& out_chrom)
+  {
+    prepareChromOutput(chromatogramConsumer, exp_meta, transition_exp.transitions.size(), out_chrom);
+  }
+
+  /**
+   * @brief Prepare chromatogram output
+   *
+   * Same as above, but only needs the number of transitions of the spectral
+   * library (e.g. if the library is memory-mapped, see MappedTransitionLibrary).
+   *
+   * @param chromatogramConsumer Chromatogram consumer object to store the extracted chromatograms
+   * @param exp_meta meta data about experiment
+   * @param nr_transitions Number of transitions in the spectral library
+   * @param out_chrom The output file for the chromatograms
+   *
+   */
+  void prepareChromOutput(Interfaces::IMSDataConsumer ** chromatogramConsumer, 
+                          const boost::shared_ptr<ExperimentalSettings>& exp_meta,
+                          Size nr_transitions,
+                          const String& out_chrom)
   {
     if (!out_chrom.empty())
     {
@@ -269,7 +290,7 @@ protected:
       else
       {
         PlainMSDataWritingConsumer * chromConsumer = new PlainMSDataWritingConsumer(out_chrom);
-        int expected_chromatograms = transition_exp.transitions.size();
+        int expected_chromatograms = nr_transitions;
         chromConsumer->setExpectedSize(0, expected_chromatograms);
         chromConsumer->setExperimentalSettings(*exp_meta);
         chromConsumer->getOptions().setWriteIndex(true);  // ensure that we write the index
@@ -328,6 +349,12 @@ protected:
       TransitionPQPFile().convertPQPToTargetedExperiment(tr_file.c_str(), transition_exp);
       progresslogger.endProgress();
     }
+    else if (tr_type == FileTypes::TRANSITIONBIN)
+    {
+      progresslogger.startProgress(0, 1, "Load binary transition library");
+      TransitionBinFile().load(tr_file, transition_exp);
+      progresslogger.endProgress();
+    }
     else if (tr_type == FileTypes::TSV)
     {
       progresslogger.startProgress(0, 1, "Load TSV file");
@@ -338,7 +365,7 @@ protected:
     }
     else
     {
-      OPENMS_LOG_ERROR << "Provide valid TraML, TSV or PQP transition file." << std::endl;
+      OPENMS_LOG_ERROR << "Provide valid TraML, TSV, PQP or trBin transition file." << std::endl;
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Need to provide valid input file.");
     }
     return transition_exp;
@@ -626,6 +626,30 @@ protected:
     static AASequence fromString(const char* s,
                                  bool permissive = true);
 
+    /**
+      @name Parse cache
+
+      fromString() can use a process-wide, thread-safe cache of parsed
+      sequences. Each distinct input string is then only parsed once (per
+      value of @p permissive); subsequent calls return a copy of the cached
+      sequence and skip the residue and modification lookups. This pays off
+      when the same sequences are parsed over and over again, e.g. when
+      loading identification files with many PSMs per peptide.
+
+      The cache holds at most @p max_size sequences and is cleared when this
+      limit is reached. It is disabled by default.
+    */
+    //@{
+    /// Enables (or disables and clears) the parse cache of fromString()
+    static void setParseCacheEnabled(bool enabled, Size max_size = 1000000);
+
+    /// Returns whether the parse cache of fromString() is enabled
+    static bool isParseCacheEnabled();
+
+    /// Removes all sequences from the parse cache
+    static void clearParseCache();
+    //@}
+
   protected:
 
     std::vector<const Residue*> peptide_;
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/DATASTRUCTURES/Map.h>
+#include <OpenMS/DATASTRUCTURES/SnapshotHolder.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 
@@ -71,6 +72,11 @@ namespace OpenMS
       databases. This can be done by providing a path through
       initializeModificationsDB(), however it is important that this is done
       *before* the first call to getInstance().
+
+      All lookups work on an immutable snapshot of the database and can be
+      done concurrently without locking. Adding a modification (see
+      addModification()) copies the lookup tables and publishes the new
+      version, it should therefore be the exception and not the rule.
   */
   class OPENMS_DLLAPI ModificationsDB
   {
@@ -151,6 +157,8 @@ public:
        The function returns a pointer to the modification in the ModificationDB (which can be differ from input if mod was already present).
 
        @param new_mod Owning pointer, which transfers ownership to ModificationsDB (mod might get deleted if already present!)
+
+       @note Adding a modification copies all lookup tables (linear in the size of the database), see publishLookupTables_().
     */
     const ResidueModification* addModification(std::unique_ptr<ResidueModification> new_mod);
 
@@ -203,12 +211,32 @@ protected:
     /// Stores whether ModificationsDB was instantiated before
     static bool is_instantiated_;
 
-    /// Stores the modifications
+    /// Stores the modifications (only changed under the OpenMS_ModificationsDB lock, lookups use lookup_)
     std::vector<ResidueModification*> mods_;
 
-    /// Stores the mappings of (unique) names to the modifications
+    /// Stores the mappings of (unique) names to the modifications (only changed under the OpenMS_ModificationsDB lock, lookups use lookup_)
     std::unordered_map<String, std::set<const ResidueModification*> > modification_names_;
 
+    /// Immutable copy of mods_ and modification_names_ which is used for all lookups
+    struct LookupTables
+    {
+      std::vector<const ResidueModification*> mods;
+      std::unordered_map<String, std::set<const ResidueModification*> > modification_names;
+    };
+
+    /// The lookup tables currently visible to readers
+    SnapshotHolder<LookupTables> lookup_;
+
+    /**
+      @brief Publishes the current content of mods_ and modification_names_ to readers (needs to be called after changing them)
+
+      Copies both tables (but not the modifications they point to). Every new modification
+      changes both of them, so nothing can be shared with the previous snapshot. This makes
+      addModification() linear in the size of the database. The database files are read
+      before the first snapshot is published, so only modifications added at runtime pay this.
+    */
+    void publishLookupTables_();
+
     /** @brief Helper function to check if a residue matches the origin for a modification
      *
      * Special cases are handled as follows:
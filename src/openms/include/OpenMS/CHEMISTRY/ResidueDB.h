@@ -36,8 +36,10 @@
 
 #include <OpenMS/DATASTRUCTURES/Map.h>
 #include <boost/unordered_map.hpp>
+#include <OpenMS/DATASTRUCTURES/SnapshotHolder.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <memory>
 #include <set>
 
 namespace OpenMS
@@ -56,6 +58,10 @@ namespace OpenMS
       By default no modified residues are stored in an instance. However, if one
       queries the instance with getModifiedResidue, a new modified residue is
       added.
+
+      Lookups work on an immutable snapshot of the database and can be done
+      concurrently without locking. Only adding a new modified residue takes
+      a lock and publishes a new snapshot.
   */
   class OPENMS_DLLAPI ResidueDB
   {
@@ -219,5 +225,35 @@ protected:
     Map<String, std::set<const Residue*> > residues_by_set_;
 
     std::set<String> residue_sets_;
+
+    /// Immutable copy of the lookup structures of the unmodified residues (only change when residues are read from file)
+    struct ResidueTables
+    {
+      boost::unordered_map<String, Residue*> residue_names;
+      std::set<const Residue*> const_residues;
+      Map<String, std::set<const Residue*> > residues_by_set;
+      std::set<String> residue_sets;
+    };
+
+    /// Immutable copy of the lookup structures above which is used by all (concurrent) readers
+    struct LookupTables
+    {
+      /// shared between snapshots as long as no unmodified residues are added
+      std::shared_ptr<const ResidueTables> residues = std::make_shared<const ResidueTables>();
+      Map<String, Map<String, Residue*> > residue_mod_names;
+      std::set<const Residue*> const_modified_residues;
+    };
+
+    /// The lookup tables currently visible to readers
+    SnapshotHolder<LookupTables> lookup_;
+
+    /**
+      @brief Publishes the current content of the lookup structures to readers (needs to be called after changing them)
+
+      Every call copies the tables of the modified residues. The tables of the unmodified
+      residues are only copied if @p residues_changed is set, otherwise they are shared with
+      the previous snapshot (adding a modified residue does not change them).
+    */
+    void publishLookupTables_(bool residues_changed = true);
   };
 }
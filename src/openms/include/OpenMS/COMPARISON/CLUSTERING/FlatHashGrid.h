@@ -0,0 +1,295 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/COMPARISON/CLUSTERING/HashGrid.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+   * @brief Immutable, cache-friendly variant of HashGrid
+   *
+   * All (2-dimensional coordinate, value) pairs are stored in a single array
+   * grouped by cell, i.e. the contents of each cell are contiguous (compressed
+   * sparse row layout). Cells are found through an open-addressing hash table
+   * of cell indices. In contrast to HashGrid, whose cells are node based hash
+   * maps, a neighbourhood query touches only a few contiguous blocks of memory.
+   *
+   * Use it if a grid is filled once and queried many times afterwards (e.g.
+   * QTClusterFinder). When constructed from a HashGrid, cells and elements keep
+   * the iteration order of the HashGrid, so results of order dependent
+   * algorithms do not change.
+   *
+   * @tparam Value Type to be stored in the grid (e.g. a pointer to a GridFeature)
+   */
+  template <typename Value>
+  class FlatHashGrid
+  {
+public:
+    typedef typename HashGrid<Value>::ClusterCenter ClusterCenter;
+    typedef typename HashGrid<Value>::CellIndex CellIndex;
+    typedef std::pair<ClusterCenter, Value> value_type;
+    typedef const value_type* const_iterator;
+
+    /**
+     * @brief Contiguous range of elements (e.g. the contents of a cell)
+     */
+    struct Range
+    {
+      const_iterator first = nullptr;
+      const_iterator last = nullptr;
+
+      const_iterator begin() const { return first; }
+      const_iterator end() const { return last; }
+      Size size() const { return last - first; }
+      bool empty() const { return first == last; }
+    };
+
+    /// Maximal number of ranges returned by a neighbourhood query (3 x 3 cells)
+    static const Size NEIGHBOURHOOD_SIZE = 9;
+
+    /// Marks a cell which is not present in the grid
+    static const Size NPOS = std::numeric_limits<Size>::max();
+
+    /**
+     * @brief Builds the grid from a HashGrid (keeping its iteration order)
+     */
+    explicit FlatHashGrid(const HashGrid<Value>& grid) :
+      cell_dimension_(grid.cell_dimension)
+    {
+      elements_.reserve(grid.size());
+      cell_offsets_.push_back(0);
+      for (auto cell_it = grid.grid_begin(); cell_it != grid.grid_end(); ++cell_it)
+      {
+        if (cell_it->second.empty()) continue;
+        elements_.insert(elements_.end(), cell_it->second.begin(), cell_it->second.end());
+        cell_indices_.push_back(cell_it->first);
+        cell_offsets_.push_back(elements_.size());
+      }
+      buildTable_();
+    }
+
+    /**
+     * @brief Builds the grid from (coordinate, value) pairs
+     *
+     * Cells are sorted by their index, elements within a cell keep the order of @p elements.
+     *
+     * @throw Exception::OutOfRange if a cell index cannot be represented
+     */
+    FlatHashGrid(const ClusterCenter& cell_dimension, const std::vector<value_type>& elements) :
+      cell_dimension_(cell_dimension)
+    {
+      std::vector<std::pair<CellIndex, Size> > keys;
+      keys.reserve(elements.size());
+      for (Size i = 0; i < elements.size(); ++i)
+      {
+        keys.push_back(std::make_pair(cellIndexAt(elements[i].first), i));
+      }
+      std::stable_sort(keys.begin(), keys.end(),
+                       [](const std::pair<CellIndex, Size>& a, const std::pair<CellIndex, Size>& b) { return a.first < b.first; });
+
+      elements_.reserve(elements.size());
+      cell_offsets_.push_back(0);
+      for (Size i = 0; i < keys.size(); ++i)
+      {
+        if (i > 0 && keys[i].first != keys[i - 1].first)
+        {
+          cell_offsets_.push_back(elements_.size());
+        }
+        if (i == 0 || keys[i].first != keys[i - 1].first)
+        {
+          cell_indices_.push_back(keys[i].first);
+        }
+        elements_.push_back(elements[keys[i].second]);
+      }
+      if (!elements_.empty()) cell_offsets_.push_back(elements_.size());
+      buildTable_();
+    }
+
+    /// Dimension of the cells
+    const ClusterCenter& getCellDimension() const { return cell_dimension_; }
+
+    /// Number of elements
+    Size size() const { return elements_.size(); }
+
+    /// Returns true if the grid contains no elements
+    bool empty() const { return elements_.empty(); }
+
+    /// Iterator to the first element (elements are grouped by cell)
+    const_iterator begin() const { return elements_.data(); }
+
+    /// Iterator past the last element
+    const_iterator end() const { return elements_.data() + elements_.size(); }
+
+    /// Number of (non-empty) cells
+    Size cellCount() const { return cell_indices_.size(); }
+
+    /// Index of the @p cell -th cell
+    const CellIndex& cellIndex(Size cell) const { return cell_indices_[cell]; }
+
+    /// Contents of the @p cell -th cell
+    Range cellContents(Size cell) const
+    {
+      Range r;
+      r.first = elements_.data() + cell_offsets_[cell];
+      r.last = elements_.data() + cell_offsets_[cell + 1];
+      return r;
+    }
+
+    /// Position of the cell with index @p index (for cellContents), NPOS if the cell is empty
+    Size findCell(const CellIndex& index) const
+    {
+      if (table_.empty()) return NPOS;
+      for (Size slot = hash_(index) & table_mask_; ; slot = (slot + 1) & table_mask_)
+      {
+        const Size cell = table_[slot];
+        if (cell == NPOS || cell_indices_[cell] == index) return cell;
+      }
+    }
+
+    /// Contents of the cell with index @p index (empty range if the cell is empty)
+    Range cell(const CellIndex& index) const
+    {
+      const Size cell = findCell(index);
+      return cell == NPOS ? Range() : cellContents(cell);
+    }
+
+    /**
+     * @brief Neighbourhood query: contents of the 3 x 3 cells around @p index
+     *
+     * The non-empty cells are written to @p ranges (which must hold
+     * NEIGHBOURHOOD_SIZE entries) in order of increasing first and then
+     * second index (the same order as probing the cells one by one).
+     *
+     * @return Number of ranges written
+     */
+    Size neighbourhood(const CellIndex& index, Range* ranges) const
+    {
+      Size n = 0;
+      for (Int64 i = index[0] - 1; i <= index[0] + 1; ++i)
+      {
+        for (Int64 j = index[1] - 1; j <= index[1] + 1; ++j)
+        {
+          const Size cell = findCell(CellIndex(i, j));
+          if (cell != NPOS) ranges[n++] = cellContents(cell);
+        }
+      }
+      return n;
+    }
+
+    /**
+     * @brief Batched neighbourhood query
+     *
+     * The ranges of the neighbourhood of @p indices [k] are stored in
+     * @p ranges [offsets[k]] to @p ranges [offsets[k + 1] - 1].
+     */
+    void neighbourhoods(const std::vector<CellIndex>& indices, std::vector<Range>& ranges, std::vector<Size>& offsets) const
+    {
+      ranges.resize(indices.size() * NEIGHBOURHOOD_SIZE);
+      offsets.resize(indices.size() + 1);
+      offsets[0] = 0;
+      for (Size k = 0; k < indices.size(); ++k)
+      {
+        offsets[k + 1] = offsets[k] + neighbourhood(indices[k], &ranges[offsets[k]]);
+      }
+      ranges.resize(offsets.back());
+    }
+
+    /**
+     * @brief Index of the cell containing @p center
+     *
+     * @throw Exception::OutOfRange if the cell index cannot be represented
+     */
+    CellIndex cellIndexAt(const ClusterCenter& center) const
+    {
+      CellIndex ret;
+      for (Size d = 0; d < 2; ++d)
+      {
+        const double t = std::floor(center[d] / cell_dimension_[d]);
+        // Int64 covers [-2^63, 2^63); both bounds are exact doubles (the maximum itself is
+        // not, it rounds up to 2^63). Written as a negated range check so that NaN is rejected.
+        if (!(t >= -9223372036854775808.0 && t < 9223372036854775808.0))
+        {
+          throw Exception::OutOfRange(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        }
+        ret[d] = static_cast<Int64>(t);
+      }
+      return ret;
+    }
+
+private:
+    static Size hash_(const CellIndex& index)
+    {
+      UInt64 h = static_cast<UInt64>(index[0]) * 0x9E3779B97F4A7C15ULL;
+      h ^= static_cast<UInt64>(index[1]) * 0xC2B2AE3D27D4EB4FULL;
+      h ^= h >> 31;
+      return static_cast<Size>(h);
+    }
+
+    /// builds the open-addressing table (load factor at most 0.5)
+    void buildTable_()
+    {
+      Size capacity = 8;
+      while (capacity < 2 * cell_indices_.size()) capacity *= 2;
+      table_.assign(capacity, NPOS);
+      table_mask_ = capacity - 1;
+      for (Size cell = 0; cell < cell_indices_.size(); ++cell)
+      {
+        Size slot = hash_(cell_indices_[cell]) & table_mask_;
+        while (table_[slot] != NPOS) slot = (slot + 1) & table_mask_;
+        table_[slot] = cell;
+      }
+    }
+
+    ClusterCenter cell_dimension_;
+    std::vector<value_type> elements_;
+    std::vector<CellIndex> cell_indices_;
+    std::vector<Size> cell_offsets_; ///< start of each cell in elements_ (plus the end)
+    std::vector<Size> table_; ///< cell positions (NPOS for empty slots)
+    Size table_mask_ = 0;
+  };
+
+  template <typename Value>
+  const Size FlatHashGrid<Value>::NEIGHBOURHOOD_SIZE;
+
+  template <typename Value>
+  const Size FlatHashGrid<Value>::NPOS;
+}
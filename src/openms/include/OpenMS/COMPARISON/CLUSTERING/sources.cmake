@@ -12,6 +12,7 @@ CompleteLinkage.h
 EuclideanSimilarity.h
 GridBasedCluster.h
 GridBasedClustering.h
+FlatHashGrid.h
 HashGrid.h
 SingleLinkage.h
 )
@@ -51,6 +51,13 @@ namespace OpenMS
     - Automatic conversion is supported and throws Exceptions in case of invalid conversions.
     - An empty object is created with the default constructor.
 
+    Strings are immutable once stored: short strings (up to 7 characters, e.g. "target" or "decoy")
+    are stored inside the object without any allocation, longer strings in a reference counted
+    buffer which is shared (not copied) when the DataValue is copied. Values created with interned()
+    additionally share their buffer with all other interned values of equal content, which
+    reduces memory considerably for labels repeated in millions of MetaInfo entries (file origins,
+    score types, etc.).
+
     @ingroup Datastructures
   */
   class OPENMS_DLLAPI DataValue
@@ -129,6 +136,17 @@ public:
     ~DataValue();
     //@}
 
+    /**
+      @brief Creates a string DataValue which shares its storage with all other interned DataValues of the same content
+
+      Use this for strings which are likely repeated across many objects (e.g. when loading meta values from file).
+      The shared storage is released when the last DataValue using it is destroyed. This method is thread-safe.
+    */
+    static DataValue interned(const String& value);
+
+    /// Returns the number of distinct strings currently stored for interned DataValues (see interned())
+    static Size internedCount();
+
     ///@name Cast operators
     ///These methods are used when the DataType is known.
     ///If they are applied to a DataValue with the wrong DataType, an exception (Exception::ConversionError) is thrown. In particular, none of these operators will work for an empty DataValue (DataType EMPTY_VALUE) - except toChar(), which will return 0.
@@ -423,12 +441,18 @@ public:
 
 protected:
 
+    /// Reference counted, immutable string buffer (shared by copies of a DataValue)
+    struct SharedString_;
+
     /// Type of the currently stored value
     DataType value_type_;
 
     /// Type of the currently stored unit
     UnitType unit_type_;
 
+    /// For string values: true if the string is stored in data_.chars_, false if it is stored in data_.str_
+    bool str_inline_;
+
     /// The unit of the data value (if it has one) using UO identifier, otherwise -1.
     int32_t unit_;
 
@@ -437,7 +461,8 @@ protected:
     {
       SignedSize ssize_;
       double dou_;
-      String* str_;
+      SharedString_* str_;
+      char chars_[8]; ///< zero-terminated short string
       StringList* str_list_;
       IntList* int_list_;
       DoubleList* dou_list_;
@@ -447,6 +472,21 @@ private:
 
     /// Clears the current state of the DataValue and release every used memory.
     void clear_() noexcept;
+
+    /// Stores a string value (the DataValue must be cleared before)
+    void setString_(const char* s, Size length);
+
+    /// Returns the characters of a string value (zero-terminated)
+    const char* stringData_() const;
+
+    /// Returns the length of a string value
+    Size stringSize_() const;
+
+    /// Compares two string values like std::string::compare
+    static int compareStrings_(const DataValue& a, const DataValue& b);
+
+    /// Releases one reference to a shared string buffer
+    static void releaseString_(SharedString_* str) noexcept;
   };
 }
 
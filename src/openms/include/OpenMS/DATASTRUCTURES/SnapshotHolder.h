@@ -0,0 +1,152 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Holds an immutable snapshot of read-mostly data that can be read concurrently without locking
+
+    Writers create a new version of the data (copy-on-write) and publish()
+    it. Readers call get() and obtain the most recently published snapshot.
+    As long as nothing was published since the last get() of the calling
+    thread, get() only performs two atomic loads (the generation and the
+    liveness of the cache entry) and takes no lock.
+
+    Every thread keeps a reference to the snapshot it read last, which keeps
+    that snapshot alive. The reference returned by get() therefore stays
+    valid until the same thread calls get() on the same holder again.
+    Pointers into the data which are owned elsewhere (e.g. by the database
+    class which holds the snapshot) are of course not affected.
+
+    The per-thread cache entries only hold a weak reference to their holder.
+    Entries of destroyed holders are removed (and their snapshots released)
+    whenever the thread adds a new entry, i.e. on its first get() on another
+    holder of the same type, so creating and destroying holders repeatedly
+    does not make the cache grow.
+
+    Concurrent calls to publish() must be serialized by the caller.
+
+    @ingroup Datastructures
+  */
+  template <typename T>
+  class SnapshotHolder
+  {
+public:
+    /// Default constructor (publishes a default-constructed snapshot)
+    SnapshotHolder() :
+      current_(std::make_shared<const T>()),
+      generation_(nextGeneration_()),
+      alive_(std::make_shared<const char>(0))
+    {
+    }
+
+    /// Copy constructor (deleted)
+    SnapshotHolder(const SnapshotHolder&) = delete;
+
+    /// Assignment operator (deleted)
+    SnapshotHolder& operator=(const SnapshotHolder&) = delete;
+
+    /// Returns the most recently published snapshot
+    const T& get() const
+    {
+      // every thread remembers the snapshot it saw last for each holder
+      thread_local std::vector<CacheEntry_> cache;
+
+      const Size generation = generation_.load(std::memory_order_acquire);
+      for (CacheEntry_& entry : cache)
+      {
+        // an expired entry belongs to a destroyed holder which lived at the same address
+        if (entry.holder == this && !entry.alive.expired())
+        {
+          if (entry.generation != generation)
+          {
+            entry.snapshot = std::atomic_load(&current_);
+            entry.generation = generation;
+          }
+          return *entry.snapshot;
+        }
+      }
+
+      // first access of this thread: drop the entries (and snapshots) of destroyed holders before adding one
+      cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CacheEntry_& entry) { return entry.alive.expired(); }), cache.end());
+      cache.push_back(CacheEntry_{this, alive_, generation, std::atomic_load(&current_)});
+      return *cache.back().snapshot;
+    }
+
+    /// Replaces the current snapshot by @p snapshot (readers will pick it up with their next call to get())
+    void publish(std::shared_ptr<const T> snapshot)
+    {
+      std::atomic_store(&current_, std::move(snapshot));
+      generation_.store(nextGeneration_(), std::memory_order_release);
+    }
+
+protected:
+    /// The snapshot seen by a thread
+    struct CacheEntry_
+    {
+      const SnapshotHolder* holder;
+      std::weak_ptr<const char> alive;
+      Size generation;
+      std::shared_ptr<const T> snapshot;
+    };
+
+    /// Returns a new generation (unique over all holders)
+    static Size nextGeneration_()
+    {
+      static std::atomic<Size> counter(0);
+      return ++counter;
+    }
+
+    /// The current snapshot (only accessed via std::atomic_load/store)
+    std::shared_ptr<const T> current_;
+
+    /// Generation of the current snapshot
+    std::atomic<Size> generation_;
+
+    /// Expires with the holder, so threads can drop their cache entries for it
+    std::shared_ptr<const char> alive_;
+  };
+
+} // namespace OpenMS
+
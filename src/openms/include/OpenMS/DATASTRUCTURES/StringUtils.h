@@ -45,6 +45,7 @@
 #include <boost/spirit/include/karma.hpp>
 #include <boost/type_traits.hpp>
 
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -797,9 +798,18 @@ public:
     {
       Int ret;
 
+      // fast path for plain integers; everything else (including invalid input) is left to boost::spirit::qi below
+      String::ConstIterator it = this_s.begin();
+      skipWhitespace_(it, this_s.end());
+      if (parseFastInt_(it, this_s.end(), ret))
+      {
+        skipWhitespace_(it, this_s.end());
+        if (it == this_s.end()) return ret;
+      }
+
       // boost::spirit::qi was found to be vastly superior to boost::lexical_cast or stringstream extraction (especially for VisualStudio),
       // so don't change this unless you have benchmarks for all platforms!
-      String::ConstIterator it = this_s.begin();
+      it = this_s.begin();
       if (!boost::spirit::qi::phrase_parse(it, this_s.end(), boost::spirit::qi::int_, boost::spirit::ascii::space, ret))
       {
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert string '") + this_s + "' to an integer value");
@@ -816,9 +826,18 @@ public:
     {
       float ret;
 
+      // fast path for plain decimal numbers; everything else (including invalid input) is left to boost::spirit::qi below
+      String::ConstIterator it = this_s.begin();
+      skipWhitespace_(it, this_s.end());
+      if (parseFastReal_(it, this_s.end(), ret))
+      {
+        skipWhitespace_(it, this_s.end());
+        if (it == this_s.end()) return ret;
+      }
+
       // boost::spirit::qi was found to be vastly superior to boost::lexical_cast or stringstream extraction (especially for VisualStudio),
       // so don't change this unless you have benchmarks for all platforms!
-      String::ConstIterator it = this_s.begin();
+      it = this_s.begin();
       if (!boost::spirit::qi::phrase_parse(it, this_s.end(), parse_float_, boost::spirit::ascii::space, ret))
       {
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert string '") + this_s + "' to a float value");
@@ -841,9 +860,19 @@ public:
     static double toDouble(const String& s)
     {
       double ret;
+
+      // fast path for plain decimal numbers; everything else (including invalid input) is left to boost::spirit::qi below
+      String::ConstIterator it = s.begin();
+      skipWhitespace_(it, s.end());
+      if (parseFastReal_(it, s.end(), ret))
+      {
+        skipWhitespace_(it, s.end());
+        if (it == s.end()) return ret;
+      }
+
       // boost::spirit::qi was found to be vastly superior to boost::lexical_cast or stringstream extraction (especially for VisualStudio),
       // so don't change this unless you have benchmarks for all platforms!
-      String::ConstIterator it = s.begin();
+      it = s.begin();
       if (!boost::spirit::qi::phrase_parse(it, s.end(), parse_double_, boost::spirit::ascii::space, ret))
       {
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert string '") + s + "' to a double value");
@@ -866,6 +895,9 @@ public:
       // boost::spirit::qi was found to be vastly superior to boost::lexical_cast or stringstream extraction (especially for VisualStudio),
       // so don't change this unless you have benchmarks for all platforms!
 
+      // plain decimal numbers are handled by the (exact) fast path, everything else is left to qi
+      if (parseFastReal_(begin, end, target)) return true;
+
       // qi::parse() does not consume whitespace before or after the double (qi::parse_phrase() would).
       return boost::spirit::qi::parse(begin, end, parse_double_, target);
     }
@@ -952,6 +984,126 @@ public:
 
   private:
 
+  /// Advances @p it over ASCII whitespace (the same characters skipped by boost::spirit::ascii::space)
+  template <typename IteratorT>
+  static void skipWhitespace_(IteratorT& it, const IteratorT& end)
+  {
+    while (it != end && (*it == ' ' || (*it >= '\t' && *it <= '\r'))) ++it;
+  }
+
+  /**
+    @brief Fast path for parsing a plain integer (optional sign followed by digits)
+
+    Returns false (and leaves @p begin untouched) if there are no digits or the value does not fit into an Int.
+  */
+  template <typename IteratorT>
+  static bool parseFastInt_(IteratorT& begin, const IteratorT& end, Int& target)
+  {
+    IteratorT it = begin;
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+'))
+    {
+      negative = (*it == '-');
+      ++it;
+    }
+    const Int64 limit = negative ? -Int64(std::numeric_limits<Int>::min()) : Int64(std::numeric_limits<Int>::max());
+    Int64 value = 0;
+    IteratorT digits_begin = it;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it)
+    {
+      value = value * 10 + (*it - '0');
+      if (value > limit) return false;
+    }
+    if (it == digits_begin) return false;
+    target = Int(negative ? -value : value);
+    begin = it;
+    return true;
+  }
+
+  /**
+    @brief Fast path for parsing a plain decimal number (e.g. "-12.5e3") into a float or double
+
+    Only numbers with at most 19 significant digits are accepted, whose mantissa fits into the
+    significand of @p T and whose decimal exponent is small enough for the power of ten to be exact
+    (Clinger's fast path). A single multiplication or division then yields the correctly rounded result.
+    This covers the vast majority of numbers found in our files. Everything else (nan, inf, long
+    mantissas, large exponents, incomplete exponents, ...) is declined and @p begin is left untouched,
+    so the caller can fall back to the general qi parser.
+  */
+  template <typename T, typename IteratorT>
+  static bool parseFastReal_(IteratorT& begin, const IteratorT& end, T& target)
+  {
+    static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    // largest power of ten that is exactly representable in T (5^k needs to fit into the significand)
+    const int max_exponent = std::numeric_limits<T>::digits >= 53 ? 22 : 10;
+
+    IteratorT it = begin;
+    bool negative = false;
+    if (it != end && (*it == '-' || *it == '+'))
+    {
+      negative = (*it == '-');
+      ++it;
+    }
+
+    UInt64 mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    for (; it != end && *it >= '0' && *it <= '9'; ++it)
+    {
+      has_digits = true;
+      if (mantissa == 0 && *it == '0') continue; // leading zeros
+      if (++significant_digits > 19) return false;
+      mantissa = mantissa * 10 + (*it - '0');
+    }
+    if (it != end && *it == '.')
+    {
+      ++it;
+      for (; it != end && *it >= '0' && *it <= '9'; ++it)
+      {
+        has_digits = true;
+        --exponent;
+        if (mantissa == 0 && *it == '0') continue;
+        if (++significant_digits > 19) return false;
+        mantissa = mantissa * 10 + (*it - '0');
+      }
+    }
+    if (!has_digits) return false;
+
+    if (it != end && (*it == 'e' || *it == 'E'))
+    {
+      ++it;
+      bool negative_exponent = false;
+      if (it != end && (*it == '-' || *it == '+'))
+      {
+        negative_exponent = (*it == '-');
+        ++it;
+      }
+      if (it == end || *it < '0' || *it > '9') return false; // let qi decide what to do with "1e"
+      int e = 0;
+      for (; it != end && *it >= '0' && *it <= '9'; ++it)
+      {
+        if (e < 10000) e = e * 10 + (*it - '0');
+      }
+      exponent += negative_exponent ? -e : e;
+    }
+
+    if (exponent < -max_exponent || exponent > max_exponent) return false;
+    if (mantissa > (UInt64(1) << std::numeric_limits<T>::digits)) return false;
+
+    T value = 0;
+    if (mantissa != 0)
+    {
+      value = T(mantissa);
+      if (exponent < 0) value /= T(pow10[-exponent]);
+      else value *= T(pow10[exponent]);
+    }
+    target = negative ? -value : value;
+    begin = it;
+    return true;
+  }
+
   /*
     @brief A fixed Boost:pi real parser policy, capable of dealing with 'nan' without crashing
 
@@ -39,6 +39,7 @@ OSWData.h
 Param.h
 QTCluster.h
 SeqanIncludeWrapper.h
+SnapshotHolder.h
 String.h
 StringUtils.h
 StringListUtils.h
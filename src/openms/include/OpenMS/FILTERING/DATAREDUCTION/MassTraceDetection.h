@@ -40,8 +40,11 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 
+#include <list>
+
 namespace OpenMS
 {
+    class OnDiscMSExperiment;
 
     /**
       @brief A mass trace extraction method that gathers peaks similar in m/z and moving along retention time.
@@ -65,6 +68,10 @@ namespace OpenMS
       length as well as having the minimal sample rate criterion fulfilled) get
       added to the result.
 
+      For large inputs, the overload taking an @ref OnDiscMSExperiment reads the
+      MS1 spectra block-wise from disc, so that only a window of spectra is held
+      in memory instead of the whole map (see there).
+
       @htmlinclude OpenMS_MassTraceDetection.parameters
 
       @ingroup Quantitation
@@ -95,6 +102,40 @@ namespace OpenMS
         /// Invokes the run method (see above) on merely a subregion of a @ref MSExperiment map.
         void run(PeakMap::ConstAreaIterator & begin, PeakMap::ConstAreaIterator & end, std::vector<MassTrace> & found_masstraces);
 
+        /**
+          @brief Extracts mass traces block-wise from an experiment on disc (low memory mode)
+
+          The MS1 spectra are read sequentially in blocks of @p block_size
+          spectra. Besides the current block, the last @p block_overlap
+          spectra of the previous block and the next @p block_overlap spectra
+          are held in memory. Within this window, apices are processed in
+          order of decreasing intensity as in the in-memory version, including
+          those in the lookahead (whose traces are detected again in the next
+          block). Apices further ahead are only seeded with a later block,
+          though, so the processing order is not global. If traces seeded in
+          different windows compete for the same peaks, the contested peaks may
+          be assigned differently than in the in-memory version, and the
+          resulting traces can differ. The result is the same if no such
+          competition occurs, e.g. when traces extend at most block_overlap
+          spectra from their apex and are separated in m/z. Traces extending
+          beyond the window are continued in the next block, thus traces of
+          any length are stitched across block boundaries.
+
+          Memory consumption is bounded by the filtered peaks of block_size +
+          2 * block_overlap spectra (plus the resulting traces), independent
+          of the length of the run.
+
+          @param input_exp The input (spectra which are not sorted by m/z are sorted after loading)
+          @param found_masstraces The resulting mass traces
+          @param block_size Number of MS1 spectra per block
+          @param block_overlap Number of MS1 spectra before and after the block which are kept in memory
+          @param max_traces Stop after this many traces were found (0 = unlimited)
+
+          @throw Exception::InvalidValue if @p block_size is 0 or the input contains less than 3 MS1 spectra
+        */
+        void run(OnDiscMSExperiment & input_exp, std::vector<MassTrace> & found_masstraces,
+                 const Size block_size = 1000, const Size block_overlap = 100, const Size max_traces = 0);
+
         /** @name Private methods and members
         */
     protected:
@@ -104,6 +145,50 @@ namespace OpenMS
 
         typedef std::multimap<double, std::pair<Size, Size> > MapIdxSortedByInt;
 
+        /// State of a mass trace during its extension (spectrum indices refer to the whole run)
+        struct TraceState_
+        {
+          std::list<PeakType> peaks; ///< collected peaks, sorted by RT
+          std::vector<std::pair<Size, Size> > gathered_idx; ///< (spectrum, peak) indices of the collected peaks
+          std::vector<double> fwhms_mz; ///< peak-FWHM meta values of the collected peaks
+          double apex_intensity;
+          double centroid_mz;
+          double prev_counter;
+          double prev_denom;
+          double ftl_sd;
+          double intensity_so_far;
+          Size down_idx; ///< first spectrum visited
+          Size up_idx; ///< last spectrum visited
+          Size up_hitting_peak = 0, down_hitting_peak = 0;
+          Size up_scan_counter = 0, down_scan_counter = 0;
+          Size conseq_missed_peak_up = 0, conseq_missed_peak_down = 0;
+          bool toggle_up = true, toggle_down = true;
+          double current_sample_rate = 1.0;
+        };
+
+        /// Starts a new trace at peak @p peak_idx of spectrum @p scan_idx (relative to @p first_scan) of @p work_exp
+        void initTrace_(TraceState_ & trace, const PeakMap & work_exp, const Size first_scan,
+                        const Size scan_idx, const Size peak_idx, const int fwhm_meta_idx);
+
+        /**
+          @brief Extends a trace in both RT directions until the termination criterion is met or the borders of @p work_exp are reached
+
+          @p work_exp holds the spectra with (global) indices first_scan to first_scan + work_exp.size() - 1.
+        */
+        void extendTrace_(TraceState_ & trace, const PeakMap & work_exp, const Size first_scan,
+                          const std::vector<Size> & spec_offsets, const std::vector<bool> & peak_visited,
+                          const int fwhm_meta_idx);
+
+        /**
+          @brief Checks the length and quality criteria of a finished trace and stores it in @p found_masstraces
+
+          The peaks of an accepted trace are marked as visited (as far as they are contained in @p work_exp).
+
+          @return true if the trace was accepted
+        */
+        bool storeTrace_(const TraceState_ & trace, const Size first_scan, const std::vector<Size> & spec_offsets,
+                         std::vector<bool> & peak_visited, Size & trace_number, std::vector<MassTrace> & found_masstraces);
+
         /// The internal run method
         void run_(const MapIdxSortedByInt& chrom_apices,
                   const Size peak_count,
@@ -112,6 +197,12 @@ namespace OpenMS
                   std::vector<MassTrace> & found_masstraces,
                   const Size max_traces = 0);
 
+        /// Removes peaks below the noise threshold
+        void filterSpectrum_(MSSpectrum & spec) const;
+
+        /// Adds the peaks of @p spec (index @p scan_idx) which are chrom_peak_snr times above the noise threshold to @p chrom_apices
+        void addApexCandidates_(const MSSpectrum & spec, const Size scan_idx, MapIdxSortedByInt & chrom_apices) const;
+
         // parameter stuff
         double mass_error_ppm_;
         double noise_threshold_int_;
@@ -38,7 +38,10 @@
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/INTERFACES/DataStructures.h>
 #include <OpenMS/INTERFACES/ISpectrumAccess.h>
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <limits>
 #include <vector>
 
 namespace OpenMS
@@ -127,7 +130,12 @@ public:
     /**
       @brief Smoothes an two data arrays containing data.
 
-      Convolutes the filter and the profile data and writes the results into the output iterators mz_out and int_out. 
+      Convolutes the filter and the profile data and writes the results into the output iterators mz_out and int_out.
+
+      If the data is equally spaced (up to the rounding of the positions, and no ppm tolerance is used),
+      the kernel is the same for every data point and a precomputed, vectorizable convolution is used
+      instead of the point-wise integration. Both give the same result up to floating point rounding
+      (the summation order differs).
     */
     template <typename ConstIterT, typename IterT>
     bool filter(
@@ -137,6 +145,11 @@ public:
         IterT mz_out,
         IterT int_out)
     {
+      if (!use_ppm_tolerance_ && isEquallySpaced_(mz_in_start, mz_in_end))
+      {
+        return filterEquallySpaced_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out);
+      }
+
       bool found_signal = false;
 
       ConstIterT mz_it = mz_in_start;
@@ -177,6 +190,151 @@ protected:
     bool use_ppm_tolerance_;
     double ppm_tolerance_;
 
+    /**
+      @brief Returns true if [first, last) holds at least three positions with constant spacing
+
+      Only deviations that can be explained by the rounding of the positions themselves (a few units
+      in the last place) are accepted. For such data the shared kernel of filterEquallySpaced_() gives
+      the same result as integrate_() up to floating point rounding. Data that is merely close to
+      equally spaced is integrated point-wise.
+    */
+    template <typename InputPeakIterator>
+    static bool isEquallySpaced_(InputPeakIterator first, InputPeakIterator last)
+    {
+      const Size n = std::distance(first, last);
+      if (n < 3) return false;
+
+      const double spacing = (*(last - 1) - *first) / (n - 1);
+      if (!(spacing > 0)) return false;
+
+      const double tolerance = 8 * std::numeric_limits<double>::epsilon() * std::max(fabs(*first), fabs(*(last - 1)));
+      for (InputPeakIterator it = first + 1; it != last; ++it)
+      {
+        if (fabs((*it - *(it - 1)) - spacing) > tolerance) return false;
+      }
+      return true;
+    }
+
+    /// Interpolated kernel coefficient at the given distance from the kernel center
+    double coefficientAt_(double distance_in_gaussian) const
+    {
+      const Size middle = coeffs_.size();
+      Size left_position = std::min((Size)floor(distance_in_gaussian / spacing_), middle - 1);
+      Size right_position = left_position + 1;
+      double d = fabs((left_position * spacing_) - distance_in_gaussian) / spacing_;
+      return (right_position < middle) ? (1 - d) * coeffs_[left_position] + d * coeffs_[right_position]
+                                       : coeffs_[left_position];
+    }
+
+    /**
+      @brief Convolution for equally spaced data (see filter())
+
+      Determines for every data point how many neighbors on the left and right side are inside the
+      kernel window (exactly as integrate_() does) and evaluates the kernel at multiples of the spacing.
+      All points with a complete window share one normalized kernel, which is applied to the whole
+      intensity array at once (one contiguous multiply-add loop per kernel coefficient). The remaining
+      points at the borders are integrated individually.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterEquallySpaced_(ConstIterT mz_in_start, ConstIterT mz_in_end, ConstIterT int_in_start, IterT mz_out, IterT int_out)
+    {
+      const Size n = std::distance(mz_in_start, mz_in_end);
+      const double spacing = (*(mz_in_end - 1) - *mz_in_start) / (n - 1);
+      const double window = coeffs_.size() * spacing_;
+      const double first_pos = *mz_in_start;
+      const double last_pos = *(mz_in_end - 1);
+
+      // number of neighbors taken into account on either side
+      std::vector<Size> left(n), right(n);
+      Size lower = 0, upper = 0, max_neighbors = 0;
+      for (Size i = 0; i < n; ++i)
+      {
+        const double pos = mz_in_start[i];
+        const double start_pos = ((pos - window) > first_pos) ? (pos - window) : first_pos;
+        const double end_pos = ((pos + window) < last_pos) ? (pos + window) : last_pos;
+        while (lower < i && !(mz_in_start[lower] > start_pos)) ++lower;
+        if (upper <= i) upper = i + 1;
+        while (upper < n && mz_in_start[upper] < end_pos) ++upper;
+        left[i] = i - std::min(lower, i);
+        right[i] = upper - 1 - i;
+        max_neighbors = std::max(max_neighbors, std::max(left[i], right[i]));
+      }
+
+      std::vector<double> weights(max_neighbors + 1), intensities(n);
+      for (Size k = 0; k <= max_neighbors; ++k)
+      {
+        weights[k] = coefficientAt_(k * spacing);
+      }
+      for (Size i = 0; i < n; ++i)
+      {
+        intensities[i] = int_in_start[i];
+      }
+
+      // shared kernel of all points that see the same neighborhood as the center point
+      const Size kernel_left = left[n / 2], kernel_right = right[n / 2];
+      std::vector<double> kernel(kernel_left + kernel_right + 1, 0.0);
+      for (Size m = 1; m <= kernel_left; ++m)
+      {
+        kernel[kernel_left - m] += spacing / 2. * weights[m];
+        kernel[kernel_left - m + 1] += spacing / 2. * weights[m - 1];
+      }
+      for (Size m = 1; m <= kernel_right; ++m)
+      {
+        kernel[kernel_left + m - 1] += spacing / 2. * weights[m - 1];
+        kernel[kernel_left + m] += spacing / 2. * weights[m];
+      }
+      double norm = 0.;
+      for (Size k = 0; k < kernel.size(); ++k) norm += kernel[k];
+
+      std::vector<double> convolved;
+      if (norm > 0)
+      {
+        const Size count = n - kernel_left - kernel_right;
+        convolved.assign(count, 0.0);
+        for (Size k = 0; k < kernel.size(); ++k)
+        {
+          const double coefficient = kernel[k] / norm;
+          const double* src = &intensities[k];
+          double* dst = &convolved[0];
+          for (Size j = 0; j < count; ++j)
+          {
+            dst[j] += coefficient * src[j];
+          }
+        }
+      }
+
+      bool found_signal = false;
+      for (Size i = 0; i < n; ++i, ++mz_out, ++int_out)
+      {
+        double new_int;
+        if (!convolved.empty() && left[i] == kernel_left && right[i] == kernel_right)
+        {
+          new_int = convolved[i - kernel_left];
+        }
+        else
+        {
+          double v = 0., point_norm = 0.;
+          for (Size m = 1; m <= left[i]; ++m)
+          {
+            point_norm += spacing / 2. * (weights[m] + weights[m - 1]);
+            v += spacing / 2. * (intensities[i - m] * weights[m] + intensities[i - m + 1] * weights[m - 1]);
+          }
+          for (Size m = 1; m <= right[i]; ++m)
+          {
+            point_norm += spacing / 2. * (weights[m - 1] + weights[m]);
+            v += spacing / 2. * (intensities[i + m - 1] * weights[m - 1] + intensities[i + m] * weights[m]);
+          }
+          new_int = (v > 0) ? v / point_norm : 0;
+        }
+        if (!(new_int > 0)) new_int = 0;
+
+        *mz_out = mz_in_start[i];
+        *int_out = new_int;
+        if (fabs(new_int) > 0) found_signal = true;
+      }
+      return found_signal;
+    }
+
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
     double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
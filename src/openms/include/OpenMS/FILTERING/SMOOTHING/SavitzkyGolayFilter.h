@@ -187,12 +187,8 @@ public:
     */
     void filter(MSSpectrum & spectrum)
     {
-      // copy the data AND META DATA to the output container
-      MSSpectrum output = spectrum;
-      // filter
-      filter(spectrum.begin(), spectrum.end(), output.begin());
-      // swap back
-      std::swap(spectrum, output);
+      std::vector<double> int_in, int_out;
+      filterIntensities_(spectrum, int_in, int_out);
     }
 
     /**
@@ -200,33 +196,16 @@ public:
     */
     void filter(MSChromatogram & chromatogram)
     {
-      // copy the data AND META DATA to the output container
-      MSChromatogram output = chromatogram;
-      // filter
-      filter(chromatogram.begin(), chromatogram.end(), output.begin());
-      // swap back
-      std::swap(chromatogram, output);
+      std::vector<double> int_in, int_out;
+      filterIntensities_(chromatogram, int_in, int_out);
     }
 
     /**
       @brief Removed the noise from an MSExperiment containing profile data.
+
+      Spectra and chromatograms are smoothed in parallel, each thread reusing its own scratch arrays.
     */
-    void filterExperiment(PeakMap & map)
-    {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
-      endProgress();
-    }
+    void filterExperiment(PeakMap & map);
 
 protected:
     /// Coefficients
@@ -238,6 +217,39 @@ protected:
     /// The order of the smoothing polynomial.
     UInt order_;
 
+    /**
+      @brief Smoothes the intensities of a spectrum or chromatogram in place
+
+      The intensities are copied to @p int_in, smoothed into @p int_out (both are resized as needed and
+      can be reused between calls) and written back. Positions and meta data are left untouched.
+      Containers shorter than the frame length are not modified.
+    */
+    template <typename ContainerT>
+    void filterIntensities_(ContainerT & container, std::vector<double> & int_in, std::vector<double> & int_out) const
+    {
+      const Size n = container.size();
+      if (frame_size_ > n) { return; }
+
+      int_in.resize(n);
+      for (Size p = 0; p < n; ++p)
+      {
+        int_in[p] = container[p].getIntensity();
+      }
+      smoothIntensities_(int_in, int_out);
+      for (Size p = 0; p < n; ++p)
+      {
+        container[p].setIntensity(int_out[p]);
+      }
+    }
+
+    /**
+      @brief Smoothes the contiguous intensity array @p in (at least frame_size_ entries) into @p out
+
+      Computes the same result as the iterator based filter(), but the steady state part is evaluated
+      as one multiply-add pass over the whole array per coefficient, which the compiler can vectorize.
+    */
+    void smoothIntensities_(const std::vector<double> & in, std::vector<double> & out) const;
+
     // Docu in base class
     void updateMembers_() override;
   };
@@ -199,14 +199,22 @@ public:
       exp.sortSpectra();
     }
 
-    /// merges spectra with similar precursors (must have MS2 level)
+    /**
+      @brief merges spectra with similar precursors (must have MS2 level)
+
+      Spectra whose precursors are within @em precursor_method:rt_tolerance and @em precursor_method:mz_tolerance
+      of each other are grouped (transitively, i.e. single linkage) and each group is merged into its first spectrum.
+      With @em precursor_method:clustering set to 'grid' (default), only neighbouring precursors are compared
+      (see clusterPrecursors_()); 'single_linkage' computes the full pairwise distance matrix. Both result in the
+      same groups.
+    */
     template <typename MapType>
     void mergeSpectraPrecursors(MapType& exp)
     {
 
       // convert spectra's precursors to clusterizable data
       Size data_size;
-      std::vector<BinaryTreeNode> tree;
+      std::vector<std::vector<Size> > clusters;
       Map<Size, Size> index_mapping;
       // local scope to save memory - we do not need the clustering stuff later
       {
@@ -241,35 +249,43 @@ public:
 
         SpectraDistance_ llc;
         llc.setParameters(param_.copy("precursor_method:", true));
-        SingleLinkage sl;
-        DistanceMatrix<float> dist; // will be filled
-        ClusterHierarchical ch;
-
-        //ch.setThreshold(0.99);
-        // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
-        ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
-      }
 
-      // extract the clusters
-      ClusterAnalyzer ca;
-      std::vector<std::vector<Size> > clusters;
-      // count number of real tree nodes (not the -1 ones):
-      Size node_count = 0;
-      for (Size ii = 0; ii < tree.size(); ++ii)
-      {
-        if (tree[ii].distance >= 1)
+        if (param_.getValue("precursor_method:clustering") == "grid")
         {
-          tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
+          clusterPrecursors_(data, llc, clusters);
         }
-        if (tree[ii].distance != -1)
+        else
         {
-          ++node_count;
+          std::vector<BinaryTreeNode> tree;
+          SingleLinkage sl;
+          DistanceMatrix<float> dist; // will be filled
+          ClusterHierarchical ch;
+
+          //ch.setThreshold(0.99);
+          // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
+          ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
+
+          // extract the clusters
+          ClusterAnalyzer ca;
+          // count number of real tree nodes (not the -1 ones):
+          Size node_count = 0;
+          for (Size ii = 0; ii < tree.size(); ++ii)
+          {
+            if (tree[ii].distance >= 1)
+            {
+              tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
+            }
+            if (tree[ii].distance != -1)
+            {
+              ++node_count;
+            }
+          }
+          ca.cut(data_size - node_count, tree, clusters);
+
+          //std::cerr << "Treesize: " << (tree.size()+1) << "   #clusters: " << clusters.size() << std::endl;
+          //std::cerr << "tree:\n" << ca.newickTree(tree, true) << "\n";
         }
       }
-      ca.cut(data_size - node_count, tree, clusters);
-
-      //std::cerr << "Treesize: " << (tree.size()+1) << "   #clusters: " << clusters.size() << std::endl;
-      //std::cerr << "tree:\n" << ca.newickTree(tree, true) << "\n";
 
       // convert to blocks
       MergeBlocks spectra_to_merge;
@@ -479,6 +495,18 @@ public:
 
 protected:
 
+    /**
+        @brief Groups precursors using a spatial index instead of a full distance matrix
+
+        Two precursors are linked if their distance according to @p distance is below 1 (i.e. their similarity
+        is positive), which implies that they are within the RT and m/z tolerances. Precursors are put into a
+        FlatHashGrid with cells of the tolerance size, so only precursors in neighbouring cells are compared
+        (in parallel). The connected components of the resulting sparse graph with at least two elements are
+        returned in @p clusters, each sorted by index and ordered by their first index -- the same groups as
+        single linkage clustering of the full distance matrix cut at distance 1.
+    */
+    void clusterPrecursors_(const std::vector<BaseFeature>& data, const SpectraDistance_& distance, std::vector<std::vector<Size> >& clusters) const;
+
     /**
         @brief merges blocks of spectra of a certain level
 
@@ -48,6 +48,7 @@
 #include <algorithm>
 #include <iterator>
 #include <cmath>
+#include <cstring>
 #include <vector>
 
 #include <QByteArray>
@@ -166,7 +167,29 @@ private:
     };
 
     static const char encoder_[];
-    static const char decoder_[];
+
+    /**
+      @brief Encodes @p length raw bytes to a Base64 string (including padding)
+
+      Uses vectorized (SSE4.1 / AVX2) kernels if the CPU supports them, the
+      result is identical to the scalar encoding.
+    */
+    static void encodeBytes_(const Byte * in, Size length, String & out);
+
+    /**
+      @brief Decodes a Base64 string of @p length characters to raw bytes
+
+      Trailing padding characters are skipped, an incomplete last group of
+      characters is filled up with zero bits (i.e. @p out always contains a
+      multiple of 3 bytes). Uses vectorized (SSE4.1 / AVX2) kernels if the CPU
+      supports them, the result is identical to the scalar decoding.
+
+      @return False if @p in contains characters outside of the Base64 alphabet
+    */
+    static bool decodeBytes_(const char * in, Size length, std::string & out);
+
+    /// Decodes a Base64 string to bytes and decompresses them with zlib
+    static void decodeCompressedBytes_(const String & in, std::string & out);
     /// Decodes a Base64 string to a vector of floating point numbers
     template <typename ToType>
     static void decodeUncompressed_(const String & in, ByteOrder from_byte_order, std::vector<ToType> & out);
@@ -277,60 +300,17 @@ private:
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Compression error?");
       }
 
-      String(compressed).swap(compressed);
       it = reinterpret_cast<Byte *>(&compressed[0]);
       end = it + compressed_length;
-      out.resize((Size)ceil(compressed_length / 3.) * 4);     //resize output array in order to have enough space for all characters
     }
     //encode without compression
     else
     {
-      out.resize((Size)ceil(input_bytes / 3.) * 4);     //resize output array in order to have enough space for all characters
       it = reinterpret_cast<Byte *>(&in[0]);
       end = it + input_bytes;
     }
 
-    Byte * to = reinterpret_cast<Byte *>(&out[0]);
-
-
-    Size written = 0;
-
-    while (it != end)
-    {
-      Int int_24bit = 0;
-      Int padding_count = 0;
-
-      // construct 24-bit integer from 3 bytes
-      for (Size i = 0; i < 3; i++)
-      {
-        if (it != end)
-        {
-          int_24bit |= *it++ << ((2 - i) * 8);
-        }
-        else
-        {
-          padding_count++;
-        }
-      }
-
-      // write out 4 characters
-      for (Int i = 3; i >= 0; i--)
-      {
-        to[i] = encoder_[int_24bit & 0x3F];
-        int_24bit >>= 6;
-      }
-
-      // fixup for padding
-      if (padding_count > 0)
-        to[3] = '=';
-      if (padding_count > 1)
-        to[2] = '=';
-
-      to += 4;
-      written += 4;
-    }
-
-    out.resize(written);         //no more space is needed
+    encodeBytes_(it, end - it, out);
   }
 
   template <typename ToType>
@@ -355,25 +335,7 @@ private:
     const Size element_size = sizeof(ToType);
 
     String decompressed;
-
-    QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-
-    if (base64_uncompressed.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
+    decodeCompressedBytes_(in, decompressed);
 
     void* byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
     Size buffer_size = decompressed.size();
@@ -421,103 +383,36 @@ private:
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Malformed base64 input, length is not a multiple of 4.");
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
-    UInt a;
-    UInt b;
-
-    UInt offset = 0;
-    int inc = 1;
-    UInt written = 0;
+    std::string decoded;
+    if (!decodeBytes_(in.c_str(), in.size(), decoded))
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Malformed base64 input, contains invalid characters.");
+    }
 
     const Size element_size = sizeof(ToType);
-
-    // enough for either float or double
-    char element[8] = "\x00\x00\x00\x00\x00\x00\x00";
+    const Size float_count = decoded.size() / element_size;
+    void* byte_buffer = reinterpret_cast<void *>(&decoded[0]);
 
     // Parse little endian data in big endian OpenMS (or other way round)
     if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || 
        (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
     {
-      offset = (element_size - 1);              // other endian
-      inc = -1;
-    }
-    else
-    {
-      offset = 0;
-      inc = 1;
-    }
-
-    //reserve enough space in the output vector
-    out.reserve((UInt)(std::ceil((4.0 * src_size) / 3.0) + 6.0));
-
-    // sort all read bytes correctly into a char[4] (double) or
-    // char[8] (float) and push_back when necessary.
-    for (Size i = 0; i < src_size; i += 4)
-    {
-      // decode 4 Base64-Chars to 3 Byte
-      // -------------------------------
-
-      // decode the first two chars
-      a = decoder_[(int)in[i] - 43] - 62;
-      b = decoder_[(int)in[i + 1] - 43] - 62;
-      if (i + 1 >= src_size)
-      {
-        b = 0;
-      }
-      // write first byte (6 bits from a and 2 highest bits from b)
-      element[offset] = (unsigned char) ((a << 2) | (b >> 4));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
-
-      // decode the third char
-      a = decoder_[(int)in[i + 2] - 43] - 62;
-      if (i + 2 >= src_size)
-      {
-        a = 0;
-      }
-      // write second byte (4 lowest bits from b and 4 highest bits from a)
-      element[offset] = (unsigned char) (((b & 15) << 4) | (a >> 2));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
+      if (element_size == 4) // 32 bit
       {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
+        UInt32 * p = reinterpret_cast<UInt32 *>(byte_buffer);
+        std::transform(p, p + float_count, p, endianize32);
       }
-
-      // decode the fourth char
-      b = decoder_[(int)in[i + 3] - 43] - 62;
-      if (i + 3 >= src_size)
+      else // 64 bit
       {
-        b = 0;
+        UInt64 * p = reinterpret_cast<UInt64 *>(byte_buffer);
+        std::transform(p, p + float_count, p, endianize64);
       }
-      // write third byte (2 lowest bits from a and 6 bits from b)
-      element[offset] = (unsigned char) (((a & 3) << 6) | b);
-      written++;
-      offset = (offset + inc) % element_size;
+    }
 
-      if (written % element_size == 0)
-      {
-        ToType * to_type = reinterpret_cast<ToType *>(&element[0]);
-        out.push_back((*to_type));
-        strcpy(element, "");
-      }
+    out.resize(float_count);
+    if (float_count > 0)
+    {
+      std::memcpy(&out[0], byte_buffer, float_count * element_size);
     }
   }
 
@@ -572,60 +467,17 @@ private:
       }
 
 
-      String(compressed).swap(compressed);
       it = reinterpret_cast<Byte *>(&compressed[0]);
       end = it + compressed_length;
-      out.resize((Size)ceil(compressed_length / 3.) * 4);     //resize output array in order to have enough space for all characters
     }
     //encode without compression
     else
     {
-      out.resize((Size)ceil(input_bytes / 3.) * 4);     //resize output array in order to have enough space for all characters
       it = reinterpret_cast<Byte *>(&in[0]);
       end = it + input_bytes;
     }
 
-    Byte * to = reinterpret_cast<Byte *>(&out[0]);
-
-
-    Size written = 0;
-
-    while (it != end)
-    {
-      Int int_24bit = 0;
-      Int padding_count = 0;
-
-      // construct 24-bit integer from 3 bytes
-      for (Size i = 0; i < 3; i++)
-      {
-        if (it != end)
-        {
-          int_24bit |= *it++ << ((2 - i) * 8);
-        }
-        else
-        {
-          padding_count++;
-        }
-      }
-
-      // write out 4 characters
-      for (Int i = 3; i >= 0; i--)
-      {
-        to[i] = encoder_[int_24bit & 0x3F];
-        int_24bit >>= 6;
-      }
-
-      // fixup for padding
-      if (padding_count > 0)
-        to[3] = '=';
-      if (padding_count > 1)
-        to[2] = '=';
-
-      to += 4;
-      written += 4;
-    }
-
-    out.resize(written);         //no more space is needed
+    encodeBytes_(it, end - it, out);
   }
 
   template <typename ToType>
@@ -653,24 +505,7 @@ private:
     const Size element_size = sizeof(ToType);
 
     String decompressed;
-
-    QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-    if (base64_uncompressed.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
+    decodeCompressedBytes_(in, decompressed);
 
     byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
     buffer_size = decompressed.size();
@@ -765,131 +600,34 @@ private:
       return;
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
-    UInt a;
-    UInt b;
-
-    UInt offset = 0;
-    int inc = 1;
-    UInt written = 0;
-
-    const Size element_size = sizeof(ToType);
-
-    // enough for either float or double
-    char element[8] = "\x00\x00\x00\x00\x00\x00\x00";
-
-    if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
-    {
-      offset = (element_size - 1);              // other endian
-      inc = -1;
-    }
-    else
+    std::string decoded;
+    if (!decodeBytes_(in.c_str(), in.size(), decoded))
     {
-      offset = 0;
-      inc = 1;
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Malformed base64 input, contains invalid characters.");
     }
 
-    //reserve enough space in the output vector
-    out.reserve((UInt)(std::ceil((4.0 * src_size) / 3.0) + 6.0));
+    const Size element_size = sizeof(ToType);
+    const Size count = decoded.size() / element_size;
+    const bool swap_bytes = (OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || 
+                            (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN);
 
-    // sort all read bytes correctly into a char[4] (double) or
-    // char[8] (float) and push_back when necessary.
-    for (Size i = 0; i < src_size; i += 4)
+    out.resize(count);
+    // do NOT use assign here, as it will give a lot of type conversion warnings on VS compiler
+    for (Size i = 0; i < count; ++i)
     {
-
-      // decode 4 Base64-Chars to 3 Byte
-      // -------------------------------
-
-      // decode the first two chars
-      a = decoder_[(int)in[i] - 43] - 62;
-      b = decoder_[(int)in[i + 1] - 43] - 62;
-      if (i + 1 >= src_size)
-      {
-        b = 0;
-      }
-      // write first byte (6 bits from a and 2 highest bits from b)
-      element[offset] = (unsigned char) ((a << 2) | (b >> 4));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
-      }
-
-      // decode the third char
-      a = decoder_[(int)in[i + 2] - 43] - 62;
-      if (i + 2 >= src_size)
-      {
-        a = 0;
-      }
-      // write second byte (4 lowest bits from b and 4 highest bits from a)
-      element[offset] = (unsigned char) (((b & 15) << 4) | (a >> 2));
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
-      {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
-      }
-
-      // decode the fourth char
-      b = decoder_[(int)in[i + 3] - 43] - 62;
-      if (i + 3 >= src_size)
+      if (element_size == 4)
       {
-        b = 0;
+        UInt32 value;
+        std::memcpy(&value, &decoded[i * element_size], element_size);
+        if (swap_bytes) value = endianize32(value);
+        out[i] = (ToType) static_cast<Int32>(value);
       }
-      // write third byte (2 lowest bits from a and 6 bits from b)
-      element[offset] = (unsigned char) (((a & 3) << 6) | b);
-      written++;
-      offset = (offset + inc) % element_size;
-
-      if (written % element_size == 0)
+      else
       {
-        ToType float_value;
-        if (element_size == 4)
-        {
-          Int32 * value = reinterpret_cast<Int32 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        else
-        {
-          Int64 * value = reinterpret_cast<Int64 *>(&element[0]);
-          float_value = (ToType) * value;
-        }
-        out.push_back(float_value);
-        strcpy(element, "");
+        UInt64 value;
+        std::memcpy(&value, &decoded[i * element_size], element_size);
+        if (swap_bytes) value = endianize64(value);
+        out[i] = (ToType) static_cast<Int64>(value);
       }
     }
   }
@@ -35,8 +35,18 @@
 #pragma once
 
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
 
 #include <fstream>
+#include <memory>
+
+namespace boost
+{
+  namespace iostreams
+  {
+    class mapped_file_source;
+  }
+}
 
 namespace OpenMS
 {
@@ -49,6 +59,12 @@ namespace OpenMS
     be very fast and done in random order (once the in-memory index is built
     for the file).
 
+    By default, data is read through a single file stream which makes access
+    @a not thread-safe. Alternatively, the cached file can be memory-mapped
+    (see setMemoryMapping). In this mode no stream state is kept, copies of
+    the object share the same (read-only) mapping and zero-copy views of the
+    stored data can be obtained through getSpectrumView and getChromatogramView.
+
   */
   class OPENMS_DLLAPI CachedmzML
   {
@@ -78,6 +94,36 @@ public:
 
     size_t getNrChromatograms() const;
 
+    /**
+      @brief Enable or disable access through a memory mapping of the cached file
+
+      @throws Exception::FileNotReadable is thrown if the file cannot be mapped
+    */
+    void setMemoryMapping(bool use_mmap);
+
+    /// Whether the cached file is accessed through a memory mapping
+    bool getMemoryMapping() const;
+
+    /**
+      @brief Zero-copy access to the data of a spectrum
+
+      The returned view points into the memory-mapped file and is valid as
+      long as this object (or a copy of it) is alive. This function does not
+      modify any state and can be called concurrently from multiple threads.
+
+      @throws Exception::IllegalArgument is thrown if memory mapping is not enabled
+      @throws Exception::ParseError is thrown if the spectrum cannot be read
+    */
+    void getSpectrumView(Size id, Internal::CachedMzMLHandler::DataView& view) const;
+
+    /**
+      @brief Zero-copy access to the data of a chromatogram
+
+      @throws Exception::IllegalArgument is thrown if memory mapping is not enabled
+      @throws Exception::ParseError is thrown if the chromatogram cannot be read
+    */
+    void getChromatogramView(Size id, Internal::CachedMzMLHandler::DataView& view) const;
+
     const MSExperiment& getMetaData() const
     {
       return meta_ms_experiment_;
@@ -108,12 +154,24 @@ protected:
 
     void load_(const String& filename);
 
+    /// Maps the cached file into memory
+    void mapFile_();
+
+    /// Returns the begin and end of the data item at @p offset in the mapped file
+    std::pair<const char*, const char*> mappedRange_(std::streampos offset) const;
+
     /// Meta data
     MSExperiment meta_ms_experiment_;
 
     /// Internal filestream 
     std::ifstream ifs_;
 
+    /// The memory-mapped cached file (only used if use_mmap_ is true)
+    std::shared_ptr<boost::iostreams::mapped_file_source> mapped_file_;
+
+    /// Whether to access the cached file through a memory mapping instead of ifs_
+    bool use_mmap_ = false;
+
     /// Name of the mzML file
     String filename_;
 
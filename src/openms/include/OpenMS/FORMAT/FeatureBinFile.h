@@ -0,0 +1,147 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/FORMAT/OPTIONS/FeatureFileOptions.h>
+
+namespace OpenMS
+{
+  class ConsensusMap;
+  class FeatureMap;
+
+  /**
+    @brief Compact binary storage for feature maps and consensus maps
+
+    featureXML and consensusXML are expensive to parse and to write, which
+    is paid by every tool in a pipeline that passes maps on to the next step
+    (e.g. FeatureFinder, FeatureLinker, IDMapper, ProteinQuantifier). This
+    class stores the same content in a versioned binary layout:
+
+    - header: magic number (different for feature and consensus maps), format version, byte order mark and number of features
+    - metadata: identifier, meta values, data processing, identification runs, unassigned peptide identifications
+      (and, for consensus maps, experiment type and column headers)
+    - columns: RT, m/z, intensity, charge, quality, width and unique id of all features, each stored as one contiguous array
+    - annotations: meta values and peptide identifications of each feature
+    - convex hulls and subordinates (feature maps) or feature handles (consensus maps)
+
+    Every section is prefixed by its size in bytes. Sections which are not
+    requested (see getOptions(): convex hulls, subordinates, or all features if
+    only metadata is requested) are skipped without being read.
+
+    Values are written in native byte order (like cachedMzML); files are meant
+    as intermediate results and cannot be read on machines with a different
+    byte order.
+
+    The binary format retains everything that is stored in featureXML and consensusXML.
+    In addition, the feature width is stored directly. Not stored (as in the XML formats) are
+    e.g. CV terms of software entries, modifications of protein hits and ratios of consensus features.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI FeatureBinFile :
+    public ProgressLogger
+  {
+public:
+
+    /// Version of the binary layout written by store(); files with a higher version cannot be loaded
+    static const UInt32 VERSION;
+
+    /** @name Constructors and Destructor */
+    //@{
+    /// Default constructor
+    FeatureBinFile();
+    /// Destructor
+    ~FeatureBinFile();
+    //@}
+
+    /**
+      @brief Loads a feature map from file @p filename and calls updateRanges()
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary feature map or is corrupt
+    */
+    void load(const String& filename, FeatureMap& feature_map);
+
+    /**
+      @brief Returns the number of features stored in the feature map file @p filename (only the header is read)
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary feature map
+    */
+    Size loadSize(const String& filename);
+
+    /**
+      @brief Stores the feature map @p feature_map in file @p filename
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const FeatureMap& feature_map);
+
+    /**
+      @brief Loads a consensus map from file @p filename and calls updateRanges()
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a binary consensus map or is corrupt
+    */
+    void load(const String& filename, ConsensusMap& consensus_map);
+
+    /**
+      @brief Stores the consensus map @p consensus_map in file @p filename
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const ConsensusMap& consensus_map);
+
+    /// Mutable access to the options for loading
+    FeatureFileOptions& getOptions();
+
+    /// Non-mutable access to the options for loading
+    const FeatureFileOptions& getOptions() const;
+
+    /// Setter for the options for loading
+    void setOptions(const FeatureFileOptions& options);
+
+protected:
+
+    /// Returns whether a feature at the given position passes the range restrictions of the options
+    bool isInRange_(double rt, double mz, double intensity) const;
+
+    /// Options for loading
+    FeatureFileOptions options_;
+  };
+
+} // namespace OpenMS
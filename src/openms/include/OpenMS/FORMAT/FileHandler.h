@@ -37,6 +37,7 @@
 #include <OpenMS/config.h>
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/FORMAT/OPTIONS/FeatureFileOptions.h>
 #include <OpenMS/FORMAT/OPTIONS/PeakFileOptions.h>
 
 namespace OpenMS
@@ -45,6 +46,7 @@ namespace OpenMS
   class MSSpectrum;
   class MSExperiment;
   class FeatureMap;
+  class ConsensusMap;
 
   /**
     @brief Facilitates file handling by file type recognition.
@@ -122,6 +124,15 @@ public:
     /// set options for loading/storing
     void setOptions(const PeakFileOptions&);
 
+    /// Mutable access to the options for loading feature maps (featureXML, featureBin, consensusBin)
+    FeatureFileOptions& getFeatOptions();
+
+    /// Non-mutable access to the options for loading feature maps
+    const FeatureFileOptions& getFeatOptions() const;
+
+    /// set options for loading feature maps
+    void setFeatOptions(const FeatureFileOptions&);
+
     /**
       @brief Loads a file into an MSExperiment
 
@@ -155,6 +166,8 @@ public:
     /**
       @brief Loads a file into a FeatureMap
 
+      featureXML and featureBin files are loaded with the options set by setFeatOptions().
+
       @param filename the file name of the file to load.
       @param map The FeatureMap to load the data into.
       @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
@@ -166,6 +179,46 @@ public:
     */
     bool loadFeatures(const String& filename, FeatureMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
 
+    /**
+      @brief Stores a FeatureMap to a file
+
+      The binary format (featureBin) is used if the file name has the corresponding extension, featureXML otherwise.
+
+      @param filename The name of the file to store the data in.
+      @param map The FeatureMap to store.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeFeatures(const String& filename, const FeatureMap& map);
+
+    /**
+      @brief Loads a file into a ConsensusMap
+
+      consensusBin files are loaded with the options set by setFeatOptions().
+
+      @param filename the file name of the file to load.
+      @param map The ConsensusMap to load the data into.
+      @param force_type Forces to load the file with that file type. If no type is forced, it is determined from the extension (or from the content if that fails).
+
+      @return true if the file could be loaded, false otherwise
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    bool loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type = FileTypes::UNKNOWN);
+
+    /**
+      @brief Stores a ConsensusMap to a file
+
+      The binary format (consensusBin) is used if the file name has the corresponding extension, consensusXML otherwise.
+
+      @param filename The name of the file to store the data in.
+      @param map The ConsensusMap to store.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be written
+    */
+    void storeConsensusFeatures(const String& filename, const ConsensusMap& map);
+
     /**
       @brief Computes a SHA-1 hash value for the content of the given file.
 
@@ -176,6 +229,8 @@ public:
 private:
     PeakFileOptions options_;
 
+    FeatureFileOptions f_options_;
+
   };
 
 } //namespace
@@ -115,6 +115,9 @@ namespace OpenMS
       XML,                ///< any XML format
       BZ2,                ///< any BZ2 compressed file
       GZ,                 ///< any Gzipped file
+      FEATUREBIN,         ///< %OpenMS binary feature map (.featureBin)
+      CONSENSUSBIN,       ///< %OpenMS binary consensus feature map (.consensusBin)
+      TRANSITIONBIN,      ///< OpenSWATH binary transition library (.trBin), see TransitionBinFile
       SIZE_OF_TYPE        ///< No file type. Simply stores the number of types
     };
 
@@ -44,7 +44,9 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 
+#include <cstring>
 #include <fstream>
+#include <iterator>
 
 #define CACHED_MZML_FILE_IDENTIFIER 8094
 
@@ -80,6 +82,134 @@ public:
 
     typedef std::vector<DatumSingleton> Datavector;
 
+    /**
+      @brief Non-owning view of a single data array inside a memory-mapped cached file
+
+      The view points directly into the mapped file and thus stays valid only
+      as long as the mapping is alive. Since the cached format does not align
+      the stored values, elements are accessed through operator[] which
+      performs an unaligned load instead of exposing a raw @p double pointer.
+    */
+    struct DataArrayView
+    {
+      /// Bidirectional iterator over the (unaligned) elements of a DataArrayView
+      class ConstIterator
+      {
+public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef DatumSingleton value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const DatumSingleton* pointer;
+        typedef DatumSingleton reference;
+
+        ConstIterator() = default;
+
+        explicit ConstIterator(const char* pos) :
+          pos_(pos)
+        {
+        }
+
+        DatumSingleton operator*() const
+        {
+          DatumSingleton value;
+          std::memcpy(&value, pos_, sizeof(DatumSingleton));
+          return value;
+        }
+
+        ConstIterator& operator++()
+        {
+          pos_ += sizeof(DatumSingleton);
+          return *this;
+        }
+
+        ConstIterator operator++(int)
+        {
+          ConstIterator tmp(*this);
+          ++(*this);
+          return tmp;
+        }
+
+        ConstIterator& operator--()
+        {
+          pos_ -= sizeof(DatumSingleton);
+          return *this;
+        }
+
+        ConstIterator operator--(int)
+        {
+          ConstIterator tmp(*this);
+          --(*this);
+          return tmp;
+        }
+
+        bool operator==(const ConstIterator& rhs) const
+        {
+          return pos_ == rhs.pos_;
+        }
+
+        bool operator!=(const ConstIterator& rhs) const
+        {
+          return pos_ != rhs.pos_;
+        }
+
+private:
+        const char* pos_ = nullptr;
+      };
+
+      /// Start of the (unaligned) data in the mapped file
+      const char* data = nullptr;
+      /// Number of elements
+      Size size = 0;
+      /// Start of the array name (not zero-terminated, only set for additional arrays)
+      const char* name = nullptr;
+      /// Length of the array name
+      Size name_size = 0;
+
+      /// Returns element @p i of the array
+      DatumSingleton operator[](Size i) const
+      {
+        DatumSingleton value;
+        std::memcpy(&value, data + i * sizeof(DatumSingleton), sizeof(DatumSingleton));
+        return value;
+      }
+
+      /// Iterator to the first element
+      ConstIterator begin() const
+      {
+        return ConstIterator(data);
+      }
+
+      /// Iterator past the last element
+      ConstIterator end() const
+      {
+        return ConstIterator(data + size * sizeof(DatumSingleton));
+      }
+
+      /// Returns whether the array name starts with @p prefix
+      bool nameStartsWith(const char* prefix) const
+      {
+        Size len = std::strlen(prefix);
+        return len <= name_size && std::memcmp(name, prefix, len) == 0;
+      }
+    };
+
+    /**
+      @brief Non-owning view of a spectrum or chromatogram inside a memory-mapped cached file
+
+      For spectra, @p first is the m/z and @p second the intensity array; for
+      chromatograms, @p first is the RT and @p second the intensity array. The
+      vector of additional arrays is reused between calls, thus reading into
+      the same view repeatedly does not allocate memory after the first call.
+    */
+    struct DataView
+    {
+      DataArrayView first;
+      DataArrayView second;
+      std::vector<DataArrayView> additional;
+      int ms_level = -1;
+      double rt = -1.0;
+    };
+
     /** @name Constructors and Destructor
     */
     //@{
@@ -183,6 +313,34 @@ public:
       @throws Exception::ParseError is thrown if the chromatogram size cannot be read
     */
     static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(std::ifstream& ifs);
+
+    /**
+      @brief Zero-copy access to a spectrum stored in memory
+
+      Fills @p view with pointers into the buffer [@p pos, @p end) (usually a
+      memory-mapped cached file) without copying any peak data.
+
+      @param pos Start of the spectrum in the buffer (as recorded in the spectra index)
+      @param end End of the buffer
+      @param view Output view of the spectrum (also stores MS level and retention time)
+
+      @throws Exception::ParseError is thrown if the spectrum extends past the end of the buffer
+    */
+    static void readSpectrumView(const char* pos, const char* end, DataView& view);
+
+    /**
+      @brief Zero-copy access to a chromatogram stored in memory
+
+      @param pos Start of the chromatogram in the buffer (as recorded in the chromatogram index)
+      @param end End of the buffer
+      @param view Output view of the chromatogram
+
+      @throws Exception::ParseError is thrown if the chromatogram extends past the end of the buffer
+    */
+    static void readChromatogramView(const char* pos, const char* end, DataView& view);
+
+    /// Copies the data referenced by @p view into newly allocated binary data arrays
+    static std::vector<OpenSwath::BinaryDataArrayPtr> copyDataView(const DataView& view);
     //@}
 
     /**
@@ -217,6 +375,10 @@ protected:
     static inline void readDataFast_(std::ifstream& ifs, std::vector<OpenSwath::BinaryDataArrayPtr>& data, const Size& data_size, 
       const Size& nr_float_arrays);
 
+    /// helper method for zero-copy reading of spectra and chromatograms
+    static void readDataView_(const char* pos, const char* end, DataView& view, Size data_size,
+      Size nr_float_arrays);
+
     /// Members
     std::vector<std::streampos> spectra_index_;
     std::vector<std::streampos> chrom_index_;
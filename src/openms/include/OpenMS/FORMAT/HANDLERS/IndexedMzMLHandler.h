@@ -44,8 +44,17 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
 #include <unordered_map>
 
+namespace boost
+{
+  namespace iostreams
+  {
+    class mapped_file_source;
+  }
+}
+
 namespace OpenMS
 {
 
@@ -70,10 +79,15 @@ namespace Internal
     extracting all the offsets of the <chromatogram> and <spectrum> tags. These
     offsets are stored as members of this class as well as the offset to the <indexList> element
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    @note By default, this implementation is @a not thread-safe since it
+    keeps internally a single file access pointer which it moves when
+    accessing a specific data item. The caller is responsible to ensure that
+    access is performed atomically.
+
+    Alternatively, the file can be memory-mapped (see setMemoryMapping). In
+    this mode no stream state is kept and each access only reads from the
+    mapped file, thus a single instance can be shared by multiple threads
+    without additional locking. Copies of the object share the same mapping.
 
   */
   class OPENMS_DLLAPI IndexedMzMLHandler
@@ -94,6 +108,10 @@ namespace Internal
     bool spectra_before_chroms_;
     /// The current filestream (opened by openFile)
     std::ifstream filestream_;
+    /// The memory-mapped file (only used if use_mmap_ is true)
+    std::shared_ptr<boost::iostreams::mapped_file_source> mapped_file_;
+    /// Whether to access the file through a memory mapping instead of filestream_
+    bool use_mmap_;
     /// Whether parsing the indexedmzML file was successful
     bool parsing_success_;
     /// Whether to skip XML checks
@@ -109,6 +127,12 @@ namespace Internal
     */
     void parseFooter_(String filename);
 
+    /// Maps the current file into memory (requires a successfully parsed file)
+    void mapFile_();
+
+    /// Read the raw text between the offsets @p startidx and @p endidx
+    std::string readChunk_(std::streampos startidx, std::streampos endidx);
+
     std::string getChromatogramById_helper_(int id);
 
     std::string getSpectrumById_helper_(int id);
@@ -247,6 +271,21 @@ namespace Internal
       skip_xml_checks_ = skip;
     }
 
+    /**
+      @brief Whether to access the file through a read-only memory mapping
+
+      If enabled, spectra and chromatograms are decoded directly from the
+      mapped file and all access functions become safe to call concurrently
+      from multiple threads on the same object. Can be called before or after
+      openFile.
+
+      @throw Exception::FileNotReadable if the file cannot be mapped into memory
+    */
+    void setMemoryMapping(bool use_mmap);
+
+    /// Returns whether the file is accessed through a memory mapping
+    bool getMemoryMapping() const;
+
   };
 }
 }
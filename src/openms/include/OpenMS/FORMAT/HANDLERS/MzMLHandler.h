@@ -296,6 +296,21 @@ protected:
                             const String& unit_accession = "");
       //@}
 
+      /**
+          @brief Encoded content of a single \<binaryDataArray\> element
+
+          Encoding the binary data (numpress, zlib compression and Base64) is
+          separated from writing the XML so that the expensive encoding step
+          can be done for a whole batch of spectra or chromatograms in
+          parallel, while the XML is still written sequentially (see writeTo).
+      */
+      struct EncodedArray
+      {
+        String data; ///< Base64 encoded (and possibly compressed) data
+        bool is32bit = false; ///< Whether the data was encoded as 32 bit float (only if numpress was not used)
+        bool numpress = false; ///< Whether numpress encoding was used
+      };
+
       /**
        * @anchor helper_write
        * @name Helper functions for writing data
@@ -309,41 +324,72 @@ protected:
                         const Internal::MzMLValidator& validator);
 
 
-      /// Write out a single spectrum
+      /// Write out a single spectrum (binary data is encoded on the fly unless @p encoded_arrays is given, see encodeBinaryData_)
       void writeSpectrum_(std::ostream& os,
                           const SpectrumType& spec,
                           Size spec_idx,
                           const Internal::MzMLValidator& validator,
                           bool renew_native_ids,
-                          std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+                          std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                          const std::vector<EncodedArray>* encoded_arrays = nullptr);
 
-      /// Write out a single chromatogram
+      /// Write out a single chromatogram (binary data is encoded on the fly unless @p encoded_arrays is given, see encodeBinaryData_)
       void writeChromatogram_(std::ostream& os,
                               const ChromatogramType& chromatogram,
                               Size chrom_idx,
-                              const Internal::MzMLValidator& validator);
+                              const Internal::MzMLValidator& validator,
+                              const std::vector<EncodedArray>* encoded_arrays = nullptr);
 
+      /**
+          @brief Encode all binary data arrays of a spectrum or chromatogram
+
+          The arrays are stored in the order in which they are written: m/z
+          (or time), intensity, float data arrays, integer data arrays and
+          string data arrays.
+
+          @note Only depends on the PeakFileOptions and can be called in parallel.
+      */
       template <typename ContainerT>
-      void writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, String array_type);
+      void encodeBinaryData_(const ContainerT& container, std::vector<EncodedArray>& encoded) const;
+
+      /// Encode the binary data of the spectra or chromatograms in [@p begin, @p end) in parallel
+      template <typename ContainerT>
+      void encodeBinaryDataBatch_(const std::vector<ContainerT>& data,
+                                  Size begin,
+                                  Size end,
+                                  std::vector<std::vector<EncodedArray> >& encoded) const;
+
+      /// Encode the m/z (or time) or intensity dimension of a spectrum or chromatogram (@p array_type is "mz", "time" or "intensity")
+      template <typename ContainerT>
+      static void encodeContainerData_(const PeakFileOptions& pf_options_, const ContainerT& container, const String& array_type, EncodedArray& encoded);
 
       /**
-          @brief Write a single \<binaryDataArray\> element to the output
+          @brief Encode a single data array
 
-          @param os The stream into which to write
-          @param options The PeakFileOptions which determines the compression type to use
-          @param data The data to write (32bit float or 64 bit double)
-          @param is32bit Whether data is 32bit
-          @param array_type Which type of data array is written (mz, time, intensity or float_data)
+          Numpress encoding is tried first (if enabled in @p np_config), the
+          data is Base64 encoded as 32 or 64 bit float otherwise.
 
           @note The data argument may be modified by the function (see Base64 for reasons why)
-
       */
       template <typename DataType>
+      static void encodeDataArray_(const PeakFileOptions& options,
+                                   const MSNumpressCoder::NumpressConfig& np_config,
+                                   std::vector<DataType>& data,
+                                   bool is32bit,
+                                   EncodedArray& encoded);
+
+      /**
+          @brief Write a single \<binaryDataArray\> element to the output
+
+          @param os The stream into which to write
+          @param options The PeakFileOptions which determines the compression type to use
+          @param encoded The encoded data to write (see encodeContainerData_)
+          @param array_type Which type of data array is written (mz, time or intensity)
+      */
       void writeBinaryDataArray_(std::ostream& os,
                                  const PeakFileOptions& options,
-                                 std::vector<DataType>& data,
-                                 bool is32bit,
-                                 String array_type);
+                                 const EncodedArray& encoded,
+                                 const String& array_type);
 
       /**
           @brief Write a single \<binaryDataArray\> element for a float data array to the output
@@ -353,7 +399,8 @@ protected:
 
           @param os The stream into which to write
           @param options The PeakFileOptions which determines the compression type to use
-          @param array The data to write
+          @param array The data array (for its name and meta data)
+          @param encoded The encoded data to write
           @param spec_chrom_idx The index of the current spectrum or chromatogram
           @param array_idx The index of the current float data array
           @param is_spectrum Whether data is associated with a spectrum (if false, a chromatogram is assumed)
@@ -362,6 +409,7 @@ protected:
       void writeBinaryFloatDataArray_(std::ostream& os,
                                       const PeakFileOptions& options,
                                       const OpenMS::DataArrays::FloatDataArray& array,
+                                      const EncodedArray& encoded,
                                       const Size spec_chrom_idx,
                                       const Size array_idx,
                                       bool is_spectrum,
@@ -76,6 +76,11 @@ namespace OpenMS
       // Converts from a narrow-character string to a wide-character string.
       inline XercesString fromNative_(const char* str) const
       {
+        // plain ASCII (e.g. all tag and attribute names) can be widened directly, without invoking the transcoder
+        const char* it = str;
+        while (*it != 0 && (unsigned char)*it < 128) ++it;
+        if (*it == 0) return XercesString(str, it);
+
         XMLCh* ptr(xercesc::XMLString::transcode(str));
         XercesString result(ptr);
         xercesc::XMLString::release(&ptr);
@@ -91,6 +96,19 @@ namespace OpenMS
       // Converts from a wide-character string to a narrow-character string.
       inline String toNative_(const XMLCh* str) const
       {
+        // plain ASCII (the common case for attribute values) can be narrowed directly, without invoking the transcoder
+        if (str != nullptr)
+        {
+          const XMLCh* it = str;
+          while (*it != 0 && *it < 128) ++it;
+          if (*it == 0)
+          {
+            String result;
+            appendASCII(str, it - str, result);
+            return result;
+          }
+        }
+
         char* ptr(xercesc::XMLString::transcode(str));
         String result(ptr);
         xercesc::XMLString::release(&ptr);
@@ -143,6 +161,23 @@ public:
       */
       static void appendASCII(const XMLCh * str, const XMLSize_t length, String & result);
 
+      /**
+       * @brief Parses a plain number from the (null-terminated) XMLCh* without transcoding it to a String first
+       *
+       * Leading and trailing whitespace is allowed.
+       *
+       * Used by attributeAsDouble_(), optionalAttributeAsDouble_() and
+       * asDouble_(const XMLCh*), i.e. for numeric attributes of all handlers
+       * and for the element text of featureXML. Handlers which convert values
+       * to a String first (e.g. the ConsensusXML centroids, IdXML, TraML
+       * cvParams and mzTab) still transcode them and only use the fast path
+       * of String::toDouble().
+       *
+       * @return false if @p str is not ASCII, too long or not completely explained by a double, in which case @p value is undefined
+       *
+      */
+      static bool parseDouble(const XMLCh * str, double & value);
+
     };
 
     /**
@@ -250,6 +285,19 @@ public:
       /// Should be called before writing any ProtIDs to file
       void checkUniqueIdentifiers_(const std::vector<ProteinIdentification>& prot_ids);
 
+      /// Longest string UserParam value (in characters) which is interned by stringUserParamValue_()
+      static const Size MAX_INTERNED_USERPARAM_LENGTH = 32;
+
+      /**
+        @brief Creates the DataValue for a string UserParam read from file
+
+        Short values (up to MAX_INTERNED_USERPARAM_LENGTH characters) are typically labels repeated
+        across many features or hits (e.g. "target", score names, file origins) and are interned, see
+        DataValue::interned(). Longer values (sequences, native ids, free text) are mostly unique and
+        are stored as a plain DataValue, so that they do not grow the pool of interned strings.
+      */
+      static DataValue stringUserParamValue_(const String& value);
+
 protected:
       /// Error message of the last error
       mutable String error_message_;
@@ -373,6 +421,14 @@ protected:
         return res;
       }
 
+      /// Conversion of a Xerces string to a double value
+      inline double asDouble_(const XMLCh * in)
+      {
+        double res;
+        if (StringManager::parseDouble(in, res)) return res;
+        return asDouble_(sm_.convert(in)); // general case (and error reporting)
+      }
+
       /// Conversion of a String to a float value
       inline float asFloat_(const String & in)
       {
@@ -459,6 +515,8 @@ protected:
       {
         const XMLCh * val = a.getValue(sm_.convert(name).c_str());
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
+        double value;
+        if (StringManager::parseDouble(val, value)) return value;
         return String(sm_.convert(val)).toDouble();
       }
 
@@ -541,7 +599,7 @@ protected:
         const XMLCh * val = a.getValue(sm_.convert(name).c_str());
         if (val != nullptr)
         {
-          value = String(sm_.convert(val)).toDouble();
+          if (!StringManager::parseDouble(val, value)) value = String(sm_.convert(val)).toDouble();
           return true;
         }
         return false;
@@ -616,6 +674,8 @@ protected:
       {
         const XMLCh * val = a.getValue(name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + sm_.convert(name) + "' not present!");
+        double value;
+        if (StringManager::parseDouble(val, value)) return value;
         return sm_.convert(val).toDouble();
       }
 
@@ -682,7 +742,7 @@ protected:
         const XMLCh * val = a.getValue(name);
         if (val != nullptr)
         {
-          value = sm_.convert(val).toDouble();
+          if (!StringManager::parseDouble(val, value)) value = sm_.convert(val).toDouble();
           return true;
         }
         return false;
@@ -39,6 +39,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
+#include <OpenMS/INTERFACES/IIdentificationConsumer.h>
 
 #include <vector>
 
@@ -105,6 +106,26 @@ public:
     */
     void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id = "");
 
+    /**
+        @brief Reads an idXML file and passes its content to a consumer while parsing
+
+        Instead of collecting all identifications in memory (like load()),
+        each protein identification is handed to @p consumer as soon as it has been
+        read, and peptide identifications are handed over in batches of (at most)
+        @p batch_size. Memory use is therefore bounded by the size of a batch
+        (plus the protein identification of the current run), independent of the
+        size of the file.
+
+        @param filename The idXML file to read
+        @param consumer The consumer of the identifications
+        @param batch_size Maximal number of peptide identifications per call of IIdentificationConsumer::consumePeptideIdentifications()
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+        @exception Exception::IllegalArgument is thrown if @p batch_size is 0
+    */
+    void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, Size batch_size = 1000);
+
 
 protected:
     // Docu in base class
@@ -145,6 +166,18 @@ protected:
       * Helper function to parse fragment annotations from string
       */  
     static void parseFragmentAnnotation_(const String& s, std::vector<PeptideHit::PeakAnnotation> & annotations);
+
+    /// Resets the members used during loading
+    void resetLoadMembers_();
+
+    /// Called after a protein identification was added to @p prot_ids_; passes it to the consumer (if streaming)
+    void proteinIdentificationAdded_();
+
+    /// Called after a peptide identification was added to @p pep_ids_; passes a full batch to the consumer (if streaming)
+    void peptideIdentificationAdded_();
+
+    /// Passes all peptide identifications in @p pep_ids_ to the consumer and clears them
+    void flushPeptideIdentifications_();
     
 
     /// @name members for loading data
@@ -179,6 +212,10 @@ protected:
     String* document_id_;
     /// true if a prot id is contained in the current run
     bool prot_id_in_run_;
+    /// Consumer for streaming (see transform()), nullptr when loading into vectors
+    Interfaces::IIdentificationConsumer* consumer_;
+    /// Number of peptide identifications passed to the consumer at once
+    Size batch_size_;
     //@}
   };
 
@@ -35,6 +35,7 @@
 #pragma once
 
 #include <OpenMS/FORMAT/MzTab.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 
 #include <OpenMS/METADATA/PeptideHit.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
@@ -45,6 +46,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <exception>
+#include <ostream>
 
 namespace OpenMS
 {
@@ -155,16 +158,72 @@ namespace OpenMS
 
     String generateMzTabSectionRow_(const MzTabOSMSectionRow& row, const std::vector<String>& optional_columns, const MzTabMetaData& meta, size_t& n_columns) const;
 
-    /// Generate an mzTab section comprising multiple rows of the same type and perform sanity check
+    /**
+      @brief Generate an mzTab section comprising multiple rows of the same type and perform sanity check
+
+      Rows are independent of each other and are therefore formatted in parallel (if OpenMP is enabled).
+      The lines are appended to @p output in the order of @p rows.
+
+      @exception Exception::Postcondition is thrown if the number of columns of a row differs from @p n_header_columns (the column count of the first such row is logged)
+    */
     template <typename SectionRow> void generateMzTabSection_(const std::vector<SectionRow>& rows, const std::vector<String>& optional_columns, const MzTabMetaData& meta, StringList& output, size_t n_header_columns) const
     {
-      output.reserve(output.size() + rows.size() + 1);
-      for (const auto& row : rows)
+      const Size offset = output.size();
+      output.resize(offset + rows.size());
+      std::vector<size_t> n_section_columns(rows.size(), 0);
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)rows.size(); ++i)
+      {
+        try
+        {
+          output[offset + i] = generateMzTabSectionRow_(rows[i], optional_columns, meta, n_section_columns[i]);
+        }
+        catch (...)
+        {
+          // exceptions must not leave the parallel region, rethrow the first one afterwards
+#ifdef _OPENMP
+#pragma omp critical (MzTabFile_generateMzTabSection)
+#endif
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error) std::rethrow_exception(error);
+
+      // check the column counts in row order, so the reported row does not depend on the number of threads
+      Size n_mismatched_rows(0);
+      for (Size i = 0; i < n_section_columns.size(); ++i)
+      {
+        if (n_header_columns == n_section_columns[i]) continue;
+        if (n_mismatched_rows == 0)
+        {
+          OPENMS_LOG_ERROR << "Number of columns in header/section: " << n_header_columns << "/" << n_section_columns[i] << std::endl;
+        }
+        ++n_mismatched_rows;
+      }
+      if (n_mismatched_rows != 0)
+      {
+        throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Header and content differs in columns (" + String(n_mismatched_rows) + " of " + String(rows.size()) + " rows affected). Please report this bug to the OpenMS developers.");
+      }
+    }
+
+    /**
+      @brief Format a chunk of rows (see generateMzTabSection_), write them to @p os and clear @p chunk
+
+      Used by the streaming store() methods to format rows in parallel while keeping only a bounded number of rows in memory.
+    */
+    template <typename SectionRow> void writeMzTabSectionRows_(std::ostream& os, std::vector<SectionRow>& chunk, const std::vector<String>& optional_columns, const MzTabMetaData& meta, size_t n_header_columns) const
+    {
+      if (chunk.empty()) return;
+      StringList lines;
+      generateMzTabSection_(chunk, optional_columns, meta, lines, n_header_columns);
+      for (const String& line : lines)
       {
-        size_t n_section_columns = 0;
-        output.push_back(generateMzTabSectionRow_(row, optional_columns, meta, n_section_columns));
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Header and content differs in columns. Please report this bug to the OpenMS developers.");
+        os << line << "\n";
       }
+      chunk.clear();
     }
 
     // auxiliary functions
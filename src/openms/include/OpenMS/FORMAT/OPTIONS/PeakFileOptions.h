@@ -212,7 +212,9 @@ public:
         reading in parts of the file and keeping it in memory and then process
         this partial data in parallel. This parameter specifies how many
         data points (spectra/chromatograms) should be read before parallel
-        processing is initiated.
+        processing is initiated. When writing mzML, it is the number of
+        spectra/chromatograms whose binary data is encoded in parallel before
+        being written out.
     */
     //@{
     /// Get maximal size of the data pool
@@ -0,0 +1,85 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ProteinIdentification;
+  class PeptideIdentification;
+
+namespace Interfaces
+{
+
+    /**
+      @brief The interface of a consumer of identifications
+
+      The consumer receives protein and peptide identifications while they
+      are read sequentially (e.g. by IdXMLFile::transform), so that large
+      identification files can be processed without ever holding all
+      identifications in memory.
+
+      Each ProteinIdentification (identification run) is passed to the
+      consumer before the peptide identifications that reference it.
+      Peptide identifications are passed in batches, in file order.
+
+      The consumer may modify or move from the objects it receives; they are
+      discarded by the caller afterwards.
+    */
+    class OPENMS_DLLAPI IIdentificationConsumer
+    {
+    public:
+      virtual ~IIdentificationConsumer() {}
+
+      /**
+        @brief Consume the protein identification of an identification run
+
+        @param prot_id The protein identification (with its protein hits and search parameters)
+      */
+      virtual void consumeProteinIdentification(ProteinIdentification& prot_id) = 0;
+
+      /**
+        @brief Consume a batch of peptide identifications
+
+        @param pep_ids The peptide identifications (never empty)
+      */
+      virtual void consumePeptideIdentifications(std::vector<PeptideIdentification>& pep_ids) = 0;
+    };
+
+} //end namespace Interfaces
+} //end namespace OpenMS
@@ -0,0 +1,238 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Peak data of a spectrum stored as structure of arrays (SoA)
+
+    MSSpectrum stores its peaks as an array of Peak1D, i.e. m/z and intensity
+    values are interleaved. Kernels that only need the m/z values (e.g.
+    binary searches or peak matching) still have to load the intensities.
+    This class stores the m/z and intensity values in two separate
+    contiguous arrays instead. Searches run on the m/z array alone, and
+    vectorized kernels can process the arrays directly.
+
+    Both arrays hold double values, which is the layout of
+    OpenSwath::BinaryDataArray. The arrays can therefore be moved into OpenSwath
+    spectra without another copy (see OpenSwathDataAccessHelper::convertToSpectrumPtr).
+
+    Only the peaks are stored. The metadata (RT, MS level, precursors,
+    data arrays, ...) remains in the MSSpectrum. The m/z search functions
+    mirror those of MSSpectrum, but return indices. They require the
+    peaks to be sorted by m/z.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI MSSpectrumSoA
+  {
+public:
+    /// Coordinate (m/z) type
+    typedef double CoordinateType;
+    /// Intensity type (double, to match OpenSwath::BinaryDataArray)
+    typedef double IntensityType;
+
+    /// Default constructor
+    MSSpectrumSoA() = default;
+
+    /// Copy constructor
+    MSSpectrumSoA(const MSSpectrumSoA& source) = default;
+
+    /// Move constructor
+    MSSpectrumSoA(MSSpectrumSoA&& source) = default;
+
+    /// Constructor from the peaks of @p spectrum (one pass over the peaks)
+    explicit MSSpectrumSoA(const MSSpectrum& spectrum);
+
+    /// Destructor
+    ~MSSpectrumSoA() = default;
+
+    /// Assignment operator
+    MSSpectrumSoA& operator=(const MSSpectrumSoA& source) = default;
+
+    /// Move assignment operator
+    MSSpectrumSoA& operator=(MSSpectrumSoA&& source) = default;
+
+    /// Equality operator
+    bool operator==(const MSSpectrumSoA& rhs) const;
+
+    /// Inequality operator
+    bool operator!=(const MSSpectrumSoA& rhs) const;
+
+    /// Replaces the content with the peaks of @p spectrum
+    void assign(const MSSpectrum& spectrum);
+
+    /**
+      @brief Writes the peaks back to @p spectrum
+
+      The peaks of @p spectrum are replaced; its metadata and data arrays are kept.
+    */
+    void toMSSpectrum(MSSpectrum& spectrum) const;
+
+    /// @name Peak access
+    ///@{
+    /// Returns the number of peaks
+    Size size() const
+    {
+      return mz_.size();
+    }
+
+    /// Returns whether there are no peaks
+    bool empty() const
+    {
+      return mz_.empty();
+    }
+
+    /// Removes all peaks
+    void clear();
+
+    /// Reserves memory for @p n peaks
+    void reserve(Size n);
+
+    /// Appends a peak
+    void push_back(CoordinateType mz, IntensityType intensity)
+    {
+      mz_.push_back(mz);
+      intensity_.push_back(intensity);
+    }
+
+    /// Returns the m/z of peak @p i
+    CoordinateType getMZ(Size i) const
+    {
+      return mz_[i];
+    }
+
+    /// Returns the intensity of peak @p i
+    IntensityType getIntensity(Size i) const
+    {
+      return intensity_[i];
+    }
+
+    /// Returns the contiguous m/z array
+    const std::vector<CoordinateType>& getMZArray() const
+    {
+      return mz_;
+    }
+
+    /**
+      @brief Returns the contiguous m/z array (mutable)
+
+      Can be used to move the array out of this object. Both arrays must be
+      of equal size when searching or converting.
+    */
+    std::vector<CoordinateType>& getMZArray()
+    {
+      return mz_;
+    }
+
+    /// Returns the contiguous intensity array
+    const std::vector<IntensityType>& getIntensityArray() const
+    {
+      return intensity_;
+    }
+
+    /// Returns the contiguous intensity array (mutable, see getMZArray())
+    std::vector<IntensityType>& getIntensityArray()
+    {
+      return intensity_;
+    }
+    ///@}
+
+    /// @name Sorting
+    ///@{
+    /// Checks whether the peaks are sorted by ascending m/z
+    bool isSorted() const;
+
+    /// Sorts the peaks by ascending m/z (stable)
+    void sortByPosition();
+    ///@}
+
+    /// @name Searching (on the m/z array only)
+    ///@{
+    /**
+      @brief Binary search for the peak nearest to a specific m/z
+
+      @exception Exception::Precondition is thrown if there are no peaks
+    */
+    Size findNearest(CoordinateType mz) const;
+
+    /**
+      @brief Binary search for the peak nearest to a specific m/z given a +/- tolerance window in Th
+
+      @return Returns the index of the peak or -1 if no peak is present in the tolerance window
+    */
+    Int findNearest(CoordinateType mz, CoordinateType tolerance) const;
+
+    /**
+      @brief Search for the peak nearest to a specific m/z given two +/- tolerance windows in Th
+
+      @return Returns the index of the peak or -1 if no peak is present in the tolerance window
+    */
+    Int findNearest(CoordinateType mz, CoordinateType tolerance_left, CoordinateType tolerance_right) const;
+
+    /**
+      @brief Finds the nearest peak for each of many m/z values in one pass
+
+      Equivalent to calling findNearest(mz, tolerance) for each element of
+      @p mz, but runs as a linear merge of the two sorted arrays instead of
+      one binary search per value.
+
+      @param mz  query m/z values, sorted ascending
+      @param tolerance  non-negative tolerance applied to both sides (in Th)
+      @param indices  for each query, the index of the nearest peak or -1 (resized to the number of queries)
+    */
+    void findNearest(const std::vector<CoordinateType>& mz, CoordinateType tolerance, std::vector<Int>& indices) const;
+
+    /// Returns the index of the first peak with m/z not less than @p mz
+    Size MZBegin(CoordinateType mz) const;
+
+    /// Returns the index past the last peak with m/z not greater than @p mz
+    Size MZEnd(CoordinateType mz) const;
+    ///@}
+
+protected:
+    /// m/z values
+    std::vector<CoordinateType> mz_;
+
+    /// intensity values
+    std::vector<IntensityType> intensity_;
+  };
+
+} // namespace OpenMS
@@ -56,14 +56,29 @@ namespace OpenMS
 
     @ingroup Kernel
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. Please provide a separate copy to each thread, e.g. 
+    @note By default, this implementation is @a not thread-safe since it
+    keeps internally a single file access pointer which it moves when
+    accessing a specific data item. Please provide a separate copy to each
+    thread, e.g. 
 
     @code
     #pragma omp parallel for firstprivate(ondisc_map) 
     @endcode
 
+    Alternatively, enable memory-mapped access through setMemoryMapping(true),
+    in which case a single object can be shared by all threads:
+
+    @code
+    OnDiscPeakMap ondisc_map;
+    ondisc_map.setMemoryMapping(true);
+    ondisc_map.openFile(filename);
+    #pragma omp parallel for
+    for (SignedSize i = 0; i < (SignedSize)ondisc_map.size(); ++i)
+    {
+      MSSpectrum s = ondisc_map.getSpectrum(i);
+    }
+    @endcode
+
   */
   class OPENMS_DLLAPI OnDiscMSExperiment
   {
@@ -253,6 +268,23 @@ public:
       indexed_mzml_file_.setSkipXMLChecks(skip);
     }
 
+    /**
+      @brief sets whether to access the file through a read-only memory mapping
+
+      In this mode, all data access functions may be called concurrently on
+      the same object (see Internal::IndexedMzMLHandler::setMemoryMapping).
+    */
+    void setMemoryMapping(bool use_mmap)
+    {
+      indexed_mzml_file_.setMemoryMapping(use_mmap);
+    }
+
+    /// returns whether the file is accessed through a memory mapping
+    bool getMemoryMapping() const
+    {
+      return indexed_mzml_file_.getMemoryMapping();
+    }
+
 private:
 
     /// Private Assignment operator -> we cannot copy file streams in IndexedMzMLHandler
@@ -22,6 +22,7 @@ MRMTransitionGroup.h
 MSChromatogram.h
 MSExperiment.h
 MSSpectrum.h
+MSSpectrumSoA.h
 OnDiscMSExperiment.h
 Peak1D.h
 Peak2D.h
@@ -63,6 +63,10 @@ namespace OpenMS
       member. MetaInfoInterface implements a full interface to a MetaInfo
       member and is more memory efficient if no meta info gets added.
 
+      For string values that are repeated in many objects (e.g. when loading
+      large feature maps or identification files), store values created with
+      DataValue::interned(), which share a single copy of the string.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI MetaInfo
@@ -47,6 +47,11 @@ namespace OpenMS
   class MSChromatogram;
   class OnDiscMSExperiment;
 
+  namespace Interfaces
+  {
+    class IMSDataConsumer;
+  }
+
   /**
     @brief This class implements a fast peak-picking algorithm best suited for
     high resolution MS data (FT-ICR-MS, Orbitrap). In high resolution data, the
@@ -68,6 +73,12 @@ namespace OpenMS
 
     @note The peaks must be sorted according to ascending m/z!
 
+    When OpenMS is built with OpenMP support, the pickExperiment() methods
+    process spectra and chromatograms in parallel. Each spectrum is picked
+    independently and results are stored at the index of their input, so the
+    output (including the reported peak boundaries) is identical to a
+    sequential run, independent of the number of threads.
+
     @ingroup PeakPicking
   */
   class OPENMS_DLLAPI PeakPickerHiRes :
@@ -162,15 +173,48 @@ public:
       method picks peaks for each scan in the map consecutively. The resulting
       picked peaks are written to the output map.
 
+      Spectra are read and picked in parallel. Unless memory mapping is
+      enabled on @p input (see OnDiscMSExperiment::setMemoryMapping), reading
+      from disk is serialized but overlaps with picking in the other threads.
+
       Currently we have to give up const-correctness but we know that everything on disc is constant
     */
     void pickExperiment(/* const */ OnDiscMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const;
 
+    /**
+      @brief Applies the peak-picking algorithm to a map on disc and passes
+      the picked spectra and chromatograms to a consumer (e.g. a MSDataWritingConsumer).
+
+      The input is processed in chunks of @p chunk_size spectra (or chromatograms):
+      while the threads read and pick the current chunk, one thread hands the
+      previously picked chunk to @p output. Thus disk I/O on both ends overlaps
+      with picking, while memory usage is bounded by two chunks. The consumer
+      receives all spectra (and then all chromatograms) in input order and is
+      only ever called from one thread at a time.
+
+      @param input  input map in profile mode
+      @param output  consumer receiving the picked data
+      @param check_spectrum_type  if set, checks spectrum type and throws an exception if a centroided spectrum is passed
+      @param chunk_size  number of spectra or chromatograms picked per chunk
+
+      @throw Exception::IllegalArgument if a centroided spectrum is passed and @p check_spectrum_type is set
+    */
+    void pickExperiment(/* const */ OnDiscMSExperiment& input, Interfaces::IMSDataConsumer& output, const bool check_spectrum_type = true, Size chunk_size = 1000) const;
+
 protected:
 
     template <typename ContainerType>
     void pick_(const ContainerType& input, ContainerType& output, std::vector<PeakBoundary>& boundaries, bool check_spacings = true) const;
 
+    /**
+      @brief Picks a single spectrum of a map or copies it unchanged, depending on its MS level and type
+
+      @return true if the spectrum was picked, false if it was copied
+
+      @throw Exception::IllegalArgument if a centroided spectrum is passed and @p check_spectrum_type is set
+    */
+    bool pickSpectrumOfMap_(const MSSpectrum& input, MSSpectrum& output, std::vector<PeakBoundary>& boundaries, const bool check_spectrum_type) const;
+
     // signal-to-noise parameter
     double signal_to_noise_;
 
@@ -0,0 +1,448 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+#define FRAGMENT_INDEX_FILE_IDENTIFIER 8095
+#define FRAGMENT_INDEX_FILE_VERSION 1
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    // binary (de)serialization of PODs, strings and vectors of PODs
+    template <typename T>
+    void writeValue(ofstream& ofs, const T& value)
+    {
+      ofs.write((const char*)&value, sizeof(value));
+    }
+
+    template <typename T>
+    bool readValue(ifstream& ifs, T& value)
+    {
+      ifs.read((char*)&value, sizeof(value));
+      return bool(ifs);
+    }
+
+    // number of bytes left in the stream; lengths read from the file are checked against it before allocating
+    Size remainingBytes(ifstream& ifs, Size file_size)
+    {
+      const std::streamoff pos = ifs.tellg();
+      return (pos < 0 || Size(pos) > file_size) ? 0 : file_size - Size(pos);
+    }
+
+    void writeString(ofstream& ofs, const String& s)
+    {
+      Size len = s.size();
+      writeValue(ofs, len);
+      ofs.write(s.data(), len);
+    }
+
+    bool readString(ifstream& ifs, Size file_size, String& s)
+    {
+      Size len = 0;
+      if (!readValue(ifs, len) || len > remainingBytes(ifs, file_size)) return false;
+      s.resize(len);
+      if (len > 0) ifs.read(&s[0], len);
+      return bool(ifs);
+    }
+
+    template <typename T>
+    void writeVector(ofstream& ofs, const vector<T>& v)
+    {
+      Size len = v.size();
+      writeValue(ofs, len);
+      if (len > 0) ofs.write((const char*)v.data(), len * sizeof(T));
+    }
+
+    template <typename T>
+    bool readVector(ifstream& ifs, Size file_size, vector<T>& v)
+    {
+      Size len = 0;
+      if (!readValue(ifs, len) || len > remainingBytes(ifs, file_size) / sizeof(T)) return false;
+      v.resize(len);
+      if (len > 0) ifs.read((char*)v.data(), len * sizeof(T));
+      return bool(ifs);
+    }
+  }
+
+  FragmentIndex::FragmentIndex(double bin_size) :
+    bin_size_(bin_size),
+    settings_(),
+    finalized_(false)
+  {
+    if (!(bin_size_ > 0.0))
+    {
+      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Fragment bin size must be positive.");
+    }
+  }
+
+  double FragmentIndex::getBinSize() const
+  {
+    return bin_size_;
+  }
+
+  void FragmentIndex::setSettings(const String& settings)
+  {
+    settings_ = settings;
+  }
+
+  const String& FragmentIndex::getSettings() const
+  {
+    return settings_;
+  }
+
+  Size FragmentIndex::addSequence(const String& sequence)
+  {
+    sequences_.push_back(sequence);
+    return sequences_.size() - 1;
+  }
+
+  void FragmentIndex::addPeptide(Size sequence_index, Size modification_index, double mass, const MSSpectrum& theoretical_spectrum)
+  {
+    if (finalized_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Peptides cannot be added to a finalized fragment index.");
+    }
+
+    if (fragment_offsets_.empty()) fragment_offsets_.push_back(0);
+
+    const MSSpectrum::StringDataArray* ion_names = theoretical_spectrum.getStringDataArrays().empty() ? nullptr : &theoretical_spectrum.getStringDataArrays()[0];
+    for (Size i = 0; i < theoretical_spectrum.size(); ++i)
+    {
+      fragment_mz_.push_back(static_cast<float>(theoretical_spectrum[i].getMZ()));
+      char ion_type = '?';
+      if (ion_names != nullptr && i < ion_names->size() && !(*ion_names)[i].empty())
+      {
+        ion_type = (*ion_names)[i][0];
+      }
+      fragment_ion_types_.push_back(ion_type);
+    }
+    fragment_offsets_.push_back(fragment_mz_.size());
+    peptides_.push_back(Peptide{sequence_index, modification_index, mass});
+  }
+
+  void FragmentIndex::finalize()
+  {
+    if (finalized_) return;
+
+    if (peptides_.size() > std::numeric_limits<UInt32>::max())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Too many peptides for a fragment index: " + String(peptides_.size()));
+    }
+    if (fragment_offsets_.empty()) fragment_offsets_.push_back(0);
+
+    // order peptides by mass (ties by sequence and modification index, to be independent of insertion order)
+    vector<Size> order(peptides_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](Size a, Size b)
+    {
+      const Peptide& pa = peptides_[a];
+      const Peptide& pb = peptides_[b];
+      if (pa.mass != pb.mass) return pa.mass < pb.mass;
+      if (pa.sequence_index != pb.sequence_index)
+      {
+        const String& sa = sequences_[pa.sequence_index];
+        const String& sb = sequences_[pb.sequence_index];
+        if (sa != sb) return sa < sb;
+      }
+      return pa.modification_index < pb.modification_index;
+    });
+
+    vector<Peptide> peptides;
+    vector<Size> fragment_offsets(1, 0);
+    vector<float> fragment_mz;
+    vector<char> fragment_ion_types;
+    peptides.reserve(peptides_.size());
+    fragment_offsets.reserve(peptides_.size() + 1);
+    fragment_mz.reserve(fragment_mz_.size());
+    fragment_ion_types.reserve(fragment_ion_types_.size());
+    for (Size i : order)
+    {
+      peptides.push_back(peptides_[i]);
+      fragment_mz.insert(fragment_mz.end(), fragment_mz_.begin() + fragment_offsets_[i], fragment_mz_.begin() + fragment_offsets_[i + 1]);
+      fragment_ion_types.insert(fragment_ion_types.end(), fragment_ion_types_.begin() + fragment_offsets_[i], fragment_ion_types_.begin() + fragment_offsets_[i + 1]);
+      fragment_offsets.push_back(fragment_mz.size());
+    }
+    peptides_.swap(peptides);
+    fragment_offsets_.swap(fragment_offsets);
+    fragment_mz_.swap(fragment_mz);
+    fragment_ion_types_.swap(fragment_ion_types);
+
+    // counting sort of (bin, peptide) pairs; iterating peptides in ascending order keeps each bin sorted
+    float max_mz = fragment_mz_.empty() ? 0.0f : *std::max_element(fragment_mz_.begin(), fragment_mz_.end());
+    bin_offsets_.assign(bin_(std::max(max_mz, 0.0f)) + 2, 0);
+    for (float mz : fragment_mz_)
+    {
+      ++bin_offsets_[bin_(mz) + 1];
+    }
+    std::partial_sum(bin_offsets_.begin(), bin_offsets_.end(), bin_offsets_.begin());
+
+    bin_peptides_.resize(fragment_mz_.size());
+    vector<Size> insert_pos(bin_offsets_.begin(), bin_offsets_.end() - 1);
+    for (Size p = 0; p < peptides_.size(); ++p)
+    {
+      for (Size f = fragment_offsets_[p]; f < fragment_offsets_[p + 1]; ++f)
+      {
+        bin_peptides_[insert_pos[bin_(fragment_mz_[f])]++] = static_cast<UInt32>(p);
+      }
+    }
+
+    finalized_ = true;
+  }
+
+  bool FragmentIndex::isFinalized() const
+  {
+    return finalized_;
+  }
+
+  Size FragmentIndex::size() const
+  {
+    return peptides_.size();
+  }
+
+  const vector<String>& FragmentIndex::getSequences() const
+  {
+    return sequences_;
+  }
+
+  const vector<FragmentIndex::Peptide>& FragmentIndex::getPeptides() const
+  {
+    return peptides_;
+  }
+
+  pair<Size, Size> FragmentIndex::getPeptideRange(double min_mass, double max_mass) const
+  {
+    auto first = std::lower_bound(peptides_.begin(), peptides_.end(), min_mass, [](const Peptide& p, double m) { return p.mass < m; });
+    auto last = std::upper_bound(first, peptides_.end(), max_mass, [](double m, const Peptide& p) { return m < p.mass; });
+    return make_pair(Size(first - peptides_.begin()), Size(last - peptides_.begin()));
+  }
+
+  void FragmentIndex::query(const MSSpectrum& spectrum,
+    double fragment_mass_tolerance,
+    bool fragment_mass_tolerance_unit_ppm,
+    Size peptide_begin,
+    Size peptide_end,
+    Size min_shared_fragments,
+    vector<Size>& candidates) const
+  {
+    if (!finalized_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Fragment index needs to be finalized before querying.");
+    }
+
+    peptide_end = std::min(peptide_end, peptides_.size());
+    if (peptide_begin >= peptide_end || bin_offsets_.size() < 2) return;
+
+    const Size n_bins = bin_offsets_.size() - 1;
+    const UInt32 first_peptide = static_cast<UInt32>(peptide_begin);
+    const UInt32 last_peptide = static_cast<UInt32>(peptide_end);
+
+    // collect all (peptide) hits of the spectrum peaks, then count them
+    vector<UInt32> hits;
+    for (const Peak1D& peak : spectrum)
+    {
+      const double mz = peak.getMZ();
+      // in ppm mode, use the larger of the tolerances relative to the experimental or the theoretical m/z
+      const double tolerance = fragment_mass_tolerance_unit_ppm ?
+        mz * fragment_mass_tolerance * 1e-6 / (1.0 - fragment_mass_tolerance * 1e-6) : fragment_mass_tolerance;
+
+      const Size first_bin = bin_(std::max(mz - tolerance, 0.0));
+      if (first_bin >= n_bins) continue;
+      const Size last_bin = std::min(bin_(mz + tolerance), n_bins - 1);
+
+      for (Size b = first_bin; b <= last_bin; ++b)
+      {
+        auto bin_begin = bin_peptides_.begin() + bin_offsets_[b];
+        auto bin_end = bin_peptides_.begin() + bin_offsets_[b + 1];
+        auto lo = std::lower_bound(bin_begin, bin_end, first_peptide);
+        auto hi = std::lower_bound(lo, bin_end, last_peptide);
+        hits.insert(hits.end(), lo, hi);
+      }
+    }
+
+    std::sort(hits.begin(), hits.end());
+    min_shared_fragments = std::max(min_shared_fragments, Size(1));
+    for (Size i = 0; i < hits.size(); )
+    {
+      Size j = i + 1;
+      while (j < hits.size() && hits[j] == hits[i]) ++j;
+      if (j - i >= min_shared_fragments) candidates.push_back(hits[i]);
+      i = j;
+    }
+  }
+
+  void FragmentIndex::getTheoreticalSpectrum(Size peptide_index, MSSpectrum& spectrum) const
+  {
+    spectrum.clear(true);
+    const Size first = fragment_offsets_[peptide_index];
+    const Size last = fragment_offsets_[peptide_index + 1];
+
+    spectrum.reserve(last - first);
+    MSSpectrum::StringDataArray ion_names;
+    ion_names.setName("IonNames");
+    ion_names.reserve(last - first);
+    for (Size f = first; f < last; ++f)
+    {
+      spectrum.emplace_back(fragment_mz_[f], 1.0);
+      ion_names.emplace_back(1, fragment_ion_types_[f]);
+    }
+    spectrum.getStringDataArrays().push_back(std::move(ion_names));
+  }
+
+  void FragmentIndex::store(const String& filename) const
+  {
+    if (!finalized_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Fragment index needs to be finalized before storing.");
+    }
+
+    ofstream ofs(filename.c_str(), std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    writeValue(ofs, int(FRAGMENT_INDEX_FILE_IDENTIFIER));
+    writeValue(ofs, int(FRAGMENT_INDEX_FILE_VERSION));
+    writeValue(ofs, bin_size_);
+    writeString(ofs, settings_);
+
+    writeValue(ofs, sequences_.size());
+    for (const String& s : sequences_)
+    {
+      writeString(ofs, s);
+    }
+
+    writeVector(ofs, peptides_);
+    writeVector(ofs, fragment_offsets_);
+    writeVector(ofs, fragment_mz_);
+    writeVector(ofs, fragment_ion_types_);
+    writeVector(ofs, bin_offsets_);
+    writeVector(ofs, bin_peptides_);
+
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing fragment index.");
+    }
+  }
+
+  void FragmentIndex::load(const String& filename)
+  {
+    // drop the current tables first, so that a failed load never leaves a stale index behind
+    finalized_ = false;
+    settings_.clear();
+    sequences_.clear();
+    peptides_.clear();
+    fragment_offsets_.clear();
+    fragment_mz_.clear();
+    fragment_ion_types_.clear();
+    bin_offsets_.clear();
+    bin_peptides_.clear();
+
+    ifstream ifs(filename.c_str(), std::ios::binary);
+    if (ifs.fail())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    ifs.seekg(0, std::ios::end);
+    const Size file_size = Size(ifs.tellg());
+    ifs.seekg(0, std::ios::beg);
+
+    int file_identifier = 0, file_version = 0;
+    readValue(ifs, file_identifier);
+    readValue(ifs, file_version);
+    if (file_identifier != FRAGMENT_INDEX_FILE_IDENTIFIER || file_version != FRAGMENT_INDEX_FILE_VERSION)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "File might not be a fragment index file (wrong file magic number or version). Aborting!", filename);
+    }
+
+    bool ok = readValue(ifs, bin_size_) && bin_size_ > 0.0 && readString(ifs, file_size, settings_);
+
+    // every sequence takes at least the bytes of its length
+    Size n_sequences = 0;
+    ok = ok && readValue(ifs, n_sequences) && n_sequences <= remainingBytes(ifs, file_size) / sizeof(Size);
+    sequences_.resize(ok ? n_sequences : 0);
+    for (String& s : sequences_)
+    {
+      ok = ok && readString(ifs, file_size, s);
+    }
+
+    ok = ok && readVector(ifs, file_size, peptides_)
+      && readVector(ifs, file_size, fragment_offsets_)
+      && readVector(ifs, file_size, fragment_mz_)
+      && readVector(ifs, file_size, fragment_ion_types_)
+      && readVector(ifs, file_size, bin_offsets_)
+      && readVector(ifs, file_size, bin_peptides_);
+
+    // check the invariants that query() and getTheoreticalSpectrum() rely on
+    ok = ok && fragment_offsets_.size() == peptides_.size() + 1 && fragment_mz_.size() == fragment_ion_types_.size()
+      && bin_peptides_.size() == fragment_mz_.size()
+      && fragment_offsets_.front() == 0 && fragment_offsets_.back() == fragment_mz_.size()
+      && std::is_sorted(fragment_offsets_.begin(), fragment_offsets_.end())
+      && !bin_offsets_.empty() && bin_offsets_.front() == 0 && bin_offsets_.back() == bin_peptides_.size()
+      && std::is_sorted(bin_offsets_.begin(), bin_offsets_.end());
+    for (Size i = 0; ok && i < peptides_.size(); ++i)
+    {
+      ok = peptides_[i].sequence_index < sequences_.size();
+    }
+    for (Size i = 0; ok && i < bin_peptides_.size(); ++i)
+    {
+      ok = bin_peptides_[i] < peptides_.size();
+    }
+
+    if (!ok)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Truncated or corrupt fragment index file.", filename);
+    }
+    finalized_ = true;
+  }
+
+  Size FragmentIndex::bin_(double mz) const
+  {
+    return static_cast<Size>(mz / bin_size_);
+  }
+
+} // namespace OpenMS
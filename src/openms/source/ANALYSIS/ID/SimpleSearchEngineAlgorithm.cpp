@@ -59,6 +59,9 @@
 
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+
+#include <OpenMS/SYSTEM/File.h>
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -146,6 +149,15 @@ namespace OpenMS
     defaults_.setValue("report:top_hits", 1, "Maximum number of top scoring hits per spectrum that are reported.");
     defaults_.setSectionDescription("report", "Reporting Options");
 
+    defaults_.setValue("fragment_index:enable", "false", "Use a fragment ion index to preselect the peptides scored for each spectrum, instead of scoring all peptides within the precursor mass tolerance. Recommended for large databases and wide precursor mass tolerances (e.g. open searches).");
+    defaults_.setValidStrings("fragment_index:enable", {"true","false"} );
+    defaults_.setValue("fragment_index:bin_size", 0.05, "Width of the fragment m/z bins (in Th). Should be in the order of the fragment mass tolerance.");
+    defaults_.setMinFloat("fragment_index:bin_size", 0.0001);
+    defaults_.setValue("fragment_index:min_shared_fragments", 3, "Minimum number of fragments a peptide needs to share with a spectrum to be scored. Set to 1 to score the same peptides as without the index.");
+    defaults_.setMinInt("fragment_index:min_shared_fragments", 1);
+    defaults_.setValue("fragment_index:file", "", "Optional file to persist the fragment index. If it exists and was built from the same database contents with the same digestion, modification and fragment settings, the index is loaded from it. Otherwise (including files of other versions or corrupt files), the index is rebuilt and the file is overwritten.");
+    defaults_.setSectionDescription("fragment_index", "Fragment Index Options");
+
     defaultsToParam_();
   }
 
@@ -180,6 +192,11 @@ namespace OpenMS
 
     decoys_ = param_.getValue("decoys") == "true";
     annotate_psm_ = param_.getValue("annotate:PSM");
+
+    fragment_index_ = param_.getValue("fragment_index:enable") == "true";
+    fragment_index_bin_size_ = param_.getValue("fragment_index:bin_size");
+    fragment_index_min_shared_fragments_ = param_.getValue("fragment_index:min_shared_fragments");
+    fragment_index_file_ = param_.getValue("fragment_index:file");
   }
 
   // static
@@ -229,6 +246,191 @@ namespace OpenMS
     }
   }
 
+  void SimpleSearchEngineAlgorithm::buildFragmentIndex_(FragmentIndex& fragment_index,
+    const vector<FASTAFile::FASTAEntry>& fasta_db,
+    const ProteaseDigestion& digestor,
+    const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+    const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+    const TheoreticalSpectrumGenerator& spectrum_generator) const
+  {
+    boost::regex peptide_motif_regex(peptide_motif_);
+
+    startProgress(0, fasta_db.size(), "Building fragment index...");
+
+    // lookup for processed peptides. must be defined outside of omp section and synchronized
+    set<StringView> processed_peptides;
+
+    Size count_proteins(0);
+
+#pragma omp parallel for schedule(static)
+    for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
+    {
+      #pragma omp atomic
+      ++count_proteins;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(count_proteins);
+      }
+
+      vector<StringView> current_digest;
+      digestor.digestUnmodified(fasta_db[fasta_index].sequence, current_digest, peptide_min_size_, peptide_max_size_);
+
+      for (auto const & c : current_digest)
+      {
+        const String current_peptide = c.getString();
+        if (current_peptide.find_first_of("XBZ") != std::string::npos) { continue; }
+
+        // if a peptide motif is provided skip all peptides without match
+        if (!peptide_motif_.empty() && !boost::regex_match(current_peptide, peptide_motif_regex)) { continue; }
+
+        bool already_processed = false;
+        #pragma omp critical (processed_peptides_access)
+        {
+          already_processed = !processed_peptides.insert(c).second;
+        }
+        if (already_processed) { continue; }
+
+        vector<AASequence> all_modified_peptides;
+
+        // this critial section is because ResidueDB is not thread safe and new residues are created based on the PTMs
+        #pragma omp critical (residuedb_access)
+        {
+          AASequence aas = AASequence::fromString(current_peptide);
+          ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
+        }
+
+        // generate the fragments outside of the critical section, only insertion is serialized
+        vector<PeakSpectrum> theo_spectra(all_modified_peptides.size());
+        for (Size mod_pep_idx = 0; mod_pep_idx < all_modified_peptides.size(); ++mod_pep_idx)
+        {
+          spectrum_generator.getSpectrum(theo_spectra[mod_pep_idx], all_modified_peptides[mod_pep_idx], 1, 1);
+          theo_spectra[mod_pep_idx].sortByPosition();
+        }
+
+        #pragma omp critical (fragment_index_access)
+        {
+          Size sequence_index = fragment_index.addSequence(current_peptide);
+          for (Size mod_pep_idx = 0; mod_pep_idx < all_modified_peptides.size(); ++mod_pep_idx)
+          {
+            fragment_index.addPeptide(sequence_index, mod_pep_idx, all_modified_peptides[mod_pep_idx].getMonoWeight(), theo_spectra[mod_pep_idx]);
+          }
+        }
+      }
+    }
+    endProgress();
+
+    startProgress(0, 1, "Sorting fragment index...");
+    fragment_index.finalize();
+    endProgress();
+
+    OPENMS_LOG_INFO << "Peptides: " << fragment_index.getSequences().size() << endl;
+    OPENMS_LOG_INFO << "Indexed peptide variants: " << fragment_index.size() << endl;
+  }
+
+  void SimpleSearchEngineAlgorithm::searchFragmentIndex_(const FragmentIndex& fragment_index,
+    const PeakMap& spectra,
+    vector<vector<AnnotatedHit_> >& annotated_hits,
+    bool precursor_mass_tolerance_unit_ppm,
+    bool fragment_mass_tolerance_unit_ppm) const
+  {
+    startProgress(0, spectra.size(), "Scoring fragment index candidates against spectra...");
+
+    Size count_spectra(0), count_candidates(0);
+
+    // each thread works on its own spectra, so no locking of the hits is required
+#pragma omp parallel for schedule(dynamic, 10)
+    for (SignedSize scan_index = 0; scan_index < (SignedSize)spectra.size(); ++scan_index)
+    {
+      #pragma omp atomic
+      ++count_spectra;
+
+      IF_MASTERTHREAD
+      {
+        setProgress(count_spectra);
+      }
+
+      const PeakSpectrum& exp_spectrum = spectra[scan_index];
+      const vector<Precursor>& precursor = exp_spectrum.getPrecursors();
+
+      // same spectrum filter as in the peptide-centric search
+      if (precursor.size() != 1 || exp_spectrum.size() < peptide_min_size_) { continue; }
+
+      Size precursor_charge = precursor[0].getCharge();
+      if (precursor_charge < precursor_min_charge_ || precursor_charge > precursor_max_charge_) { continue; }
+
+      double precursor_mz = precursor[0].getMZ();
+
+      // peptide ranges for all (optionally misassignment corrected) precursor masses
+      vector<pair<Size, Size> > peptide_ranges;
+      for (int isotope_number : precursor_isotopes_)
+      {
+        double precursor_mass = (double) precursor_charge * precursor_mz - (double) precursor_charge * Constants::PROTON_MASS_U;
+        if (isotope_number != 0) { precursor_mass -= isotope_number * Constants::C13C12_MASSDIFF_U; }
+
+        // peptide masses whose tolerance window (as in the peptide-centric search) contains the precursor mass
+        double min_mass, max_mass;
+        if (precursor_mass_tolerance_unit_ppm) // ppm
+        {
+          min_mass = precursor_mass / (1.0 + 0.5 * precursor_mass_tolerance_ * 1e-6);
+          max_mass = precursor_mass / (1.0 - 0.5 * precursor_mass_tolerance_ * 1e-6);
+        }
+        else // Dalton
+        {
+          min_mass = precursor_mass - 0.5 * precursor_mass_tolerance_;
+          max_mass = precursor_mass + 0.5 * precursor_mass_tolerance_;
+        }
+        peptide_ranges.push_back(fragment_index.getPeptideRange(min_mass, max_mass));
+      }
+
+      // merge overlapping ranges so that no candidate is scored twice
+      std::sort(peptide_ranges.begin(), peptide_ranges.end());
+      vector<Size> candidates;
+      Size range_begin(0), range_end(0);
+      for (const auto& r : peptide_ranges)
+      {
+        if (r.first > range_end)
+        {
+          fragment_index.query(exp_spectrum, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, range_begin, range_end, fragment_index_min_shared_fragments_, candidates);
+          range_begin = r.first;
+        }
+        range_end = std::max(range_end, r.second);
+      }
+      fragment_index.query(exp_spectrum, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, range_begin, range_end, fragment_index_min_shared_fragments_, candidates);
+
+      #pragma omp atomic
+      count_candidates += candidates.size();
+
+      PeakSpectrum theo_spectrum;
+      for (Size peptide_index : candidates)
+      {
+        fragment_index.getTheoreticalSpectrum(peptide_index, theo_spectrum);
+        const double score = HyperScore::compute(fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm, exp_spectrum, theo_spectrum);
+
+        if (score == 0) { continue; } // no hit?
+
+        // add peptide hit
+        const FragmentIndex::Peptide& peptide = fragment_index.getPeptides()[peptide_index];
+        AnnotatedHit_ ah;
+        ah.sequence = StringView(fragment_index.getSequences()[peptide.sequence_index]);
+        ah.peptide_mod_index = peptide.modification_index;
+        ah.score = score;
+        annotated_hits[scan_index].push_back(ah);
+
+        // prevent vector from growing indefinitly (memory) but don't shrink the vector every time
+        if (annotated_hits[scan_index].size() >= 2 * report_top_hits_)
+        {
+          std::partial_sort(annotated_hits[scan_index].begin(), annotated_hits[scan_index].begin() + report_top_hits_, annotated_hits[scan_index].end(), AnnotatedHit_::hasBetterScore);
+          annotated_hits[scan_index].resize(report_top_hits_);
+        }
+      }
+    }
+    endProgress();
+
+    OPENMS_LOG_INFO << "Scored candidates: " << count_candidates << endl;
+  }
+
 void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp, 
       std::vector<std::vector<SimpleSearchEngineAlgorithm::AnnotatedHit_> >& annotated_hits, 
       std::vector<ProteinIdentification>& protein_ids, 
@@ -375,6 +577,154 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     protein_ids[0].setSearchParameters(std::move(search_parameters));
   }
 
+  SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::postProcessAndIndexHits_(const String& in_mzML,
+    const String& in_db,
+    PeakMap& spectra,
+    vector<FASTAFile::FASTAEntry>& fasta_db,
+    const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+    const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+    vector<vector<AnnotatedHit_> >& annotated_hits,
+    vector<ProteinIdentification>& protein_ids,
+    vector<PeptideIdentification>& peptide_ids) const
+  {
+    startProgress(0, 1, "Post-processing PSMs...");
+    SimpleSearchEngineAlgorithm::postProcessHits_(spectra, 
+      annotated_hits, 
+      protein_ids, 
+      peptide_ids, 
+      report_top_hits_,
+      fixed_modifications, 
+      variable_modifications, 
+      modifications_max_variable_mods_per_peptide_,
+      modifications_fixed_,
+      modifications_variable_,
+      peptide_missed_cleavages_,
+      precursor_mass_tolerance_,
+      fragment_mass_tolerance_,
+      precursor_mass_tolerance_unit_,
+      fragment_mass_tolerance_unit_,
+      precursor_min_charge_,
+      precursor_max_charge_,
+      enzyme_,
+      in_db
+      );
+    endProgress();
+
+    // add meta data on spectra file
+    protein_ids[0].setPrimaryMSRunPath({in_mzML}, spectra);
+
+    // reindex peptides to proteins
+    PeptideIndexing indexer;
+    Param param_pi = indexer.getParameters();
+    param_pi.setValue("decoy_string", "DECOY_");
+    param_pi.setValue("decoy_string_position", "prefix");
+    param_pi.setValue("enzyme:name", enzyme_);
+    param_pi.setValue("enzyme:specificity", "full");
+    param_pi.setValue("missing_decoy_action", "silent");
+    indexer.setParameters(param_pi);
+
+    PeptideIndexing::ExitCodes indexer_exit = indexer.run(fasta_db, protein_ids, peptide_ids);
+
+    if ((indexer_exit != PeptideIndexing::EXECUTION_OK) &&
+        (indexer_exit != PeptideIndexing::PEPTIDE_IDS_EMPTY))
+    {
+      if (indexer_exit == PeptideIndexing::DATABASE_EMPTY)
+      {
+        return ExitCodes::INPUT_FILE_EMPTY;       
+      }
+      else if (indexer_exit == PeptideIndexing::UNEXPECTED_RESULT)
+      {
+        return ExitCodes::UNEXPECTED_RESULT;
+      }
+      else
+      {
+        return ExitCodes::UNKNOWN_ERROR;
+      }
+    } 
+
+    return ExitCodes::EXECUTION_OK;
+  }
+
+  SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::searchWithFragmentIndex_(const String& in_mzML,
+    const String& in_db,
+    PeakMap& spectra,
+    vector<FASTAFile::FASTAEntry>& fasta_db,
+    const ProteaseDigestion& digestor,
+    const ModifiedPeptideGenerator::MapToResidueType& fixed_modifications,
+    const ModifiedPeptideGenerator::MapToResidueType& variable_modifications,
+    const TheoreticalSpectrumGenerator& spectrum_generator,
+    vector<vector<AnnotatedHit_> >& annotated_hits,
+    vector<ProteinIdentification>& protein_ids,
+    vector<PeptideIdentification>& peptide_ids) const
+  {
+    bool precursor_mass_tolerance_unit_ppm = (precursor_mass_tolerance_unit_ == "ppm");
+    bool fragment_mass_tolerance_unit_ppm = (fragment_mass_tolerance_unit_ == "ppm");
+
+    // the fragment index needs to outlive the hits, which refer to its sequences
+    FragmentIndex fragment_index(fragment_index_bin_size_);
+
+    // Everything that determines the content of the index: the database contents (not just its
+    // name, so edited databases are detected), digestion, modification and fragment generation settings.
+    // This key is stored in the index file and an existing file is only reused if it matches.
+    String index_settings = "database_sha1=" + FileHandler::computeFileHash(in_db)
+      + ";entries=" + String(fasta_db.size())
+      + ";decoys=" + String(decoys_)
+      + ";enzyme=" + enzyme_
+      + ";missed_cleavages=" + String(peptide_missed_cleavages_)
+      + ";size=" + String(peptide_min_size_) + "-" + String(peptide_max_size_)
+      + ";motif=" + peptide_motif_
+      + ";fixed=" + ListUtils::concatenate(modifications_fixed_, ",")
+      + ";variable=" + ListUtils::concatenate(modifications_variable_, ",")
+      + ";max_variable_mods=" + String(modifications_max_variable_mods_per_peptide_)
+      + ";bin_size=" + String(fragment_index_bin_size_);
+    const Param& generator_param = spectrum_generator.getParameters();
+    for (Param::ParamIterator it = generator_param.begin(); it != generator_param.end(); ++it)
+    {
+      index_settings += ";" + it.getName() + "=" + it->value.toString();
+    }
+
+    bool index_loaded = false;
+    if (!fragment_index_file_.empty() && File::exists(fragment_index_file_))
+    {
+      startProgress(0, 1, "Loading fragment index...");
+      try
+      {
+        fragment_index.load(fragment_index_file_);
+        index_loaded = fragment_index.getSettings() == index_settings;
+        if (!index_loaded)
+        {
+          OPENMS_LOG_WARN << "Fragment index '" << fragment_index_file_ << "' was built with different settings or database. Rebuilding it." << endl;
+        }
+      }
+      catch (Exception::ParseError& e)
+      {
+        // written by another version or corrupt: rebuild as for a stale index
+        OPENMS_LOG_WARN << "Fragment index '" << fragment_index_file_ << "' could not be read (" << e.what() << "). Rebuilding it." << endl;
+      }
+      endProgress();
+      if (!index_loaded)
+      {
+        fragment_index = FragmentIndex(fragment_index_bin_size_);
+      }
+    }
+
+    if (!index_loaded)
+    {
+      fragment_index.setSettings(index_settings);
+      buildFragmentIndex_(fragment_index, fasta_db, digestor, fixed_modifications, variable_modifications, spectrum_generator);
+      if (!fragment_index_file_.empty())
+      {
+        startProgress(0, 1, "Storing fragment index...");
+        fragment_index.store(fragment_index_file_);
+        endProgress();
+      }
+    }
+
+    searchFragmentIndex_(fragment_index, spectra, annotated_hits, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm);
+
+    return postProcessAndIndexHits_(in_mzML, in_db, spectra, fasta_db, fixed_modifications, variable_modifications, annotated_hits, protein_ids, peptide_ids);
+  }
+
   SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::search(const String& in_mzML, const String& in_db, vector<ProteinIdentification>& protein_ids, vector<PeptideIdentification>& peptide_ids) const
   {
     boost::regex peptide_motif_regex(peptide_motif_);
@@ -460,12 +810,6 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     vector<vector<AnnotatedHit_> > annotated_hits(spectra.size(), vector<AnnotatedHit_>());
     for (auto & a : annotated_hits) { a.reserve(2 * report_top_hits_); }
 
-#ifdef _OPENMP
-    // we want to do locking at the spectrum level so we get good parallelisation 
-    vector<omp_lock_t> annotated_hits_lock(annotated_hits.size());
-    for (size_t i = 0; i != annotated_hits_lock.size(); i++) { omp_init_lock(&(annotated_hits_lock[i])); }
-#endif
-
     startProgress(0, 1, "Load database from FASTA file...");
     vector<FASTAFile::FASTAEntry> fasta_db;
     FASTAFile::load(in_db, fasta_db);
@@ -496,6 +840,18 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
       endProgress();
       digestor.setMissedCleavages(peptide_missed_cleavages_);
     }
+
+    if (fragment_index_)
+    {
+      return searchWithFragmentIndex_(in_mzML, in_db, spectra, fasta_db, digestor, fixed_modifications, variable_modifications, spectrum_generator, annotated_hits, protein_ids, peptide_ids);
+    }
+
+#ifdef _OPENMP
+    // we want to do locking at the spectrum level so we get good parallelisation 
+    vector<omp_lock_t> annotated_hits_lock(annotated_hits.size());
+    for (size_t i = 0; i != annotated_hits_lock.size(); i++) { omp_init_lock(&(annotated_hits_lock[i])); }
+#endif
+
     startProgress(0, fasta_db.size(), "Scoring peptide models against spectra...");
 
     // lookup for processed peptides. must be defined outside of omp section and synchronized
@@ -629,67 +985,12 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
     OPENMS_LOG_INFO << "Processed peptides: " << processed_petides.size() << endl;
 
-    startProgress(0, 1, "Post-processing PSMs...");
-    SimpleSearchEngineAlgorithm::postProcessHits_(spectra, 
-      annotated_hits, 
-      protein_ids, 
-      peptide_ids, 
-      report_top_hits_,
-      fixed_modifications, 
-      variable_modifications, 
-      modifications_max_variable_mods_per_peptide_,
-      modifications_fixed_,
-      modifications_variable_,
-      peptide_missed_cleavages_,
-      precursor_mass_tolerance_,
-      fragment_mass_tolerance_,
-      precursor_mass_tolerance_unit_,
-      fragment_mass_tolerance_unit_,
-      precursor_min_charge_,
-      precursor_max_charge_,
-      enzyme_,
-      in_db
-      );
-    endProgress();
-
-    // add meta data on spectra file
-    protein_ids[0].setPrimaryMSRunPath({in_mzML}, spectra);
-
-    // reindex peptides to proteins
-    PeptideIndexing indexer;
-    Param param_pi = indexer.getParameters();
-    param_pi.setValue("decoy_string", "DECOY_");
-    param_pi.setValue("decoy_string_position", "prefix");
-    param_pi.setValue("enzyme:name", enzyme_);
-    param_pi.setValue("enzyme:specificity", "full");
-    param_pi.setValue("missing_decoy_action", "silent");
-    indexer.setParameters(param_pi);
-
-    PeptideIndexing::ExitCodes indexer_exit = indexer.run(fasta_db, protein_ids, peptide_ids);
-
-    if ((indexer_exit != PeptideIndexing::EXECUTION_OK) &&
-        (indexer_exit != PeptideIndexing::PEPTIDE_IDS_EMPTY))
-    {
-      if (indexer_exit == PeptideIndexing::DATABASE_EMPTY)
-      {
-        return ExitCodes::INPUT_FILE_EMPTY;       
-      }
-      else if (indexer_exit == PeptideIndexing::UNEXPECTED_RESULT)
-      {
-        return ExitCodes::UNEXPECTED_RESULT;
-      }
-      else
-      {
-        return ExitCodes::UNKNOWN_ERROR;
-      }
-    } 
-
 #ifdef _OPENMP
     // free locks
     for (size_t i = 0; i != annotated_hits_lock.size(); i++) { omp_destroy_lock(&(annotated_hits_lock[i])); }
 #endif
 
-    return ExitCodes::EXECUTION_OK;
+    return postProcessAndIndexHits_(in_mzML, in_db, spectra, fasta_db, fixed_modifications, variable_modifications, annotated_hits, protein_ids, peptide_ids);
   }
 
 } // namespace OpenMS
@@ -19,6 +19,7 @@ ConsensusIDAlgorithmSimilarity.cpp
 ConsensusIDAlgorithmWorst.cpp
 ConsensusMapMergerAlgorithm.cpp
 FalseDiscoveryRate.cpp
+FragmentIndex.cpp
 FIAMSDataProcessor.cpp
 FIAMSScheduler.cpp
 HiddenMarkovModel.cpp
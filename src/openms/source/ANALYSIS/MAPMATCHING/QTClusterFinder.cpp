@@ -239,6 +239,11 @@ namespace OpenMS
       }
     }
 
+    // store the grid contiguously for the neighbourhood queries (same
+    // iteration order as the hash grid)
+    const FlatGrid flat_grid(grid);
+    grid.clear();
+
     // compute QT clustering:
     // std::cout << "Clustering..." << std::endl;
 
@@ -254,7 +259,7 @@ namespace OpenMS
     // map to get ids from clusters, who contain a certain grid feature
     ElementMapping element_mapping;
 
-    computeClustering_(grid, cluster_heads, cluster_data, handles, element_mapping);
+    computeClustering_(flat_grid, cluster_heads, cluster_data, handles, element_mapping);
 
     // number of clusters == number of data points:
     Size size = cluster_heads.size();
@@ -273,7 +278,7 @@ namespace OpenMS
 
       ConsensusFeature consensus_feature;
       bool made_feature = makeConsensusFeature_(cluster_heads, consensus_feature, 
-                                                element_mapping, grid, handles);
+                                                element_mapping, flat_grid, handles);
 
       if (made_feature)
       {
@@ -288,7 +293,7 @@ namespace OpenMS
   bool QTClusterFinder::makeConsensusFeature_(Heap& cluster_heads,
                                               ConsensusFeature& feature,
                                               ElementMapping& element_mapping,
-                                              const Grid& grid,
+                                              const FlatGrid& grid,
                                               const vector<Heap::handle_type>& handles)
   {
     // pop until the top is valid
@@ -370,7 +375,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
   }
 
   void QTClusterFinder::updateClustering_(ElementMapping& element_mapping,
-                                          const Grid& grid, 
+                                          const FlatGrid& grid, 
                                           const QTCluster::Elements& elements,
                                           Heap& cluster_heads,
                                           const vector<Heap::handle_type>& handles,
@@ -461,7 +466,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     cluster_heads.pop();
   }
 
-  void QTClusterFinder::addClusterElements_(const Grid& grid, QTCluster& cluster)
+  void QTClusterFinder::addClusterElements_(const FlatGrid& grid, QTCluster& cluster)
   {
     cluster.initializeCluster();
 
@@ -477,46 +482,39 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     const int y = cluster.getYCoord(); 
     const GridFeature* center_feature = cluster.getCenterPoint();
 
-    // iterate over neighboring grid cells (1st dimension):
-    for (int i = x - 1; i <= x + 1; ++i)
+    // iterate over neighboring grid cells (3 x 3 cells around the center,
+    // contents of each cell are contiguous in memory):
+    FlatGrid::Range neighbourhood[FlatGrid::NEIGHBOURHOOD_SIZE];
+    const Size n_cells = grid.neighbourhood(FlatGrid::CellIndex(x, y), neighbourhood);
+    for (Size c = 0; c < n_cells; ++c)
     {
-      // iterate over neighboring grid cells (2nd dimension):
-      for (int j = y - 1; j <= y + 1; ++j)
+      for (const auto& grid_element : neighbourhood[c])
       {
-        auto act_pos = grid.grid_find(Grid::CellIndex(i, j));
-
-        if (act_pos != grid.grid_end())
-        {
-          for (Grid::const_cell_iterator it_cell = act_pos->second.begin();
-               it_cell != act_pos->second.end(); ++it_cell)
-          {
-            OpenMS::GridFeature* neighbor_feature = it_cell->second;
+        OpenMS::GridFeature* neighbor_feature = grid_element.second;
 
 #ifdef DEBUG_QTCLUSTERFINDER
-            std::cout << " considering to add feature " << neighbor_feature->getFeature().getUniqueId() << " to cluster " <<  center_feature->getFeature().getUniqueId()<< std::endl;
+        std::cout << " considering to add feature " << neighbor_feature->getFeature().getUniqueId() << " to cluster " <<  center_feature->getFeature().getUniqueId()<< std::endl;
 #endif
 
-            // Skip features that we have already used -> we cannot add them to
-            // be neighbors any more
-            if (already_used_.find(neighbor_feature) != already_used_.end() )
-            {
-              continue;
-            }
+        // Skip features that we have already used -> we cannot add them to
+        // be neighbors any more
+        if (already_used_.find(neighbor_feature) != already_used_.end() )
+        {
+          continue;
+        }
 
-            // consider only "real" neighbors, not the element itself:
-            if (center_feature != neighbor_feature)
-            {
-              // NOTE: this actually caches the distance -> memory problem
-              double dist = getDistance_(center_feature, neighbor_feature);
-
-              if (dist == FeatureDistance::infinity)
-              {
-                continue; // conditions not satisfied
-              }
-              // if neighbor point is a possible cluster point, add it:
-              cluster.add(neighbor_feature, dist);
-            }
+        // consider only "real" neighbors, not the element itself:
+        if (center_feature != neighbor_feature)
+        {
+          // NOTE: this actually caches the distance -> memory problem
+          double dist = getDistance_(center_feature, neighbor_feature);
+
+          if (dist == FeatureDistance::infinity)
+          {
+            continue; // conditions not satisfied
           }
+          // if neighbor point is a possible cluster point, add it:
+          cluster.add(neighbor_feature, dist);
         }
       }
     }
@@ -555,7 +553,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     run_(input_maps, result_map);
   }
 
-  void QTClusterFinder::computeClustering_(const Grid& grid,
+  void QTClusterFinder::computeClustering_(const FlatGrid& grid,
                                            Heap& cluster_heads,
                                            vector<QTCluster::BulkData>& cluster_data,
                                            vector<Heap::handle_type>& handles,
@@ -580,33 +578,36 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     const double max_distance = 1.0;
 
     // iterate over all grid cells:
-    for (Grid::const_iterator it = grid.begin(); it != grid.end(); ++it)
+    for (Size cell = 0; cell < grid.cellCount(); ++cell)
     {
-      const Grid::CellIndex& act_coords = it.index();
+      const FlatGrid::CellIndex& act_coords = grid.cellIndex(cell);
       const Int x = act_coords[0], y = act_coords[1];
 
-      const OpenMS::GridFeature* const center_feature = it->second;
+      for (const auto& grid_element : grid.cellContents(cell))
+      {
+        const OpenMS::GridFeature* const center_feature = grid_element.second;
 
-      // construct empty data body for the new cluster and create the head afterwards
-      cluster_data.emplace_back(center_feature, num_maps_, 
-                                max_distance, x, y, id);
-      
-      QTCluster cluster(&cluster_data.back(), use_IDs_);
+        // construct empty data body for the new cluster and create the head afterwards
+        cluster_data.emplace_back(center_feature, num_maps_, 
+                                  max_distance, x, y, id);
+        
+        QTCluster cluster(&cluster_data.back(), use_IDs_);
 
-      addClusterElements_(grid, cluster);
+        addClusterElements_(grid, cluster);
 
-      // push the cluster head of the new cluster into the heap
-      // and the returned handle into our handle vector
-      handles.push_back(cluster_heads.push(cluster));
+        // push the cluster head of the new cluster into the heap
+        // and the returned handle into our handle vector
+        handles.push_back(cluster_heads.push(cluster));
 
-      // register the new cluster for all its elements in the element mapping
-      for (const auto& element : (*handles.back()).getElements())
-      {
-        element_mapping[element.feature].insert(id);
-      }
+        // register the new cluster for all its elements in the element mapping
+        for (const auto& element : (*handles.back()).getElements())
+        {
+          element_mapping[element.feature].insert(id);
+        }
 
-      // next cluster gets the next id
-      ++id;
+        // next cluster gets the next id
+        ++id;
+      }
     }
   }
 
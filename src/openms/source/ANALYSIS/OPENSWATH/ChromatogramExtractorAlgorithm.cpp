@@ -34,116 +34,467 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSCached.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
 #include <iostream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENMS_EXTRACTOR_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace OpenMS
 {
 
-  void ChromatogramExtractorAlgorithm::extract_value_tophat(
-      const std::vector<double>::const_iterator& mz_start,
-            std::vector<double>::const_iterator& mz_it,
-      const std::vector<double>::const_iterator& mz_end,
-            std::vector<double>::const_iterator& int_it,
-      const double mz,
-      double& integrated_intensity,
-      const double mz_extraction_window,
-      const bool ppm)
+  namespace
   {
-    integrated_intensity = 0;
-    if (mz_start == mz_end)
+    /// tophat extraction, see ChromatogramExtractorAlgorithm::extract_value_tophat
+    template <typename IteratorT>
+    void extractValueTophat(const IteratorT& mz_start,
+                                  IteratorT& mz_it,
+                            const IteratorT& mz_end,
+                                  IteratorT& int_it,
+                            const double mz,
+                            double& integrated_intensity,
+                            const double mz_extraction_window,
+                            const bool ppm)
     {
-      return;
-    }
+      integrated_intensity = 0;
+      if (mz_start == mz_end)
+      {
+        return;
+      }
 
-    // calculate extraction window
-    double left, right;
-    if (ppm)
-    {
-      left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
-      right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
+      // calculate extraction window
+      double left, right;
+      if (ppm)
+      {
+        left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
+        right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
+      }
+      else
+      {
+        left  = mz - mz_extraction_window / 2.0;
+        right = mz + mz_extraction_window / 2.0;
+      }
+
+      IteratorT mz_walker;
+      IteratorT int_walker;
+
+      // advance the mz / int iterator until we hit the m/z value of the next transition
+      while (mz_it != mz_end && (*mz_it) < mz)
+      {
+        mz_it++;
+        int_it++;
+      }
+
+      // walk right and left and add to our intensity
+      mz_walker  = mz_it;
+      int_walker = int_it;
+
+      // if we moved past the end of the spectrum, we need to try the last peak
+      // of the spectrum (it could still be within the window)
+      if (mz_it == mz_end)
+      {
+        --mz_walker;
+        --int_walker;
+      }
+
+      // add the current peak if it is between right and left
+      if ((*mz_walker) > left && (*mz_walker) < right)
+      {
+        integrated_intensity += (*int_walker);
+      }
+
+      // (i) Walk to the left one step and then keep walking left until we go
+      // outside the window. Note for the first step to the left we have to
+      // check for the walker becoming equal to the first data point.
+      mz_walker  = mz_it;
+      int_walker = int_it;
+      if (mz_it != mz_start)
+      {
+        --mz_walker;
+        --int_walker;
+
+        // Special case: target m/z is larger than first data point but the first
+        // data point is inside the window.
+        // Then, mz_it is the second data point, mz_walker now points to the very
+        // first data point. If mz_it was the first data point, we already added
+        // it above. We still need to add this point if it is inside the window
+        // (while loop below will not catch it)
+        if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right)
+        {
+          integrated_intensity += (*int_walker);
+        }
+      }
+      while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        integrated_intensity += (*int_walker);
+        --mz_walker;
+        --int_walker;
+      }
+
+      // (ii) Walk to the right one step and then keep walking right until we are
+      // outside the window
+      mz_walker  = mz_it;
+      int_walker = int_it;
+      if (mz_it != mz_end)
+      {
+        ++mz_walker;
+        ++int_walker;
+      }
+      while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        integrated_intensity += (*int_walker);
+        ++mz_walker;
+        ++int_walker;
+      }
     }
-    else
+
+    /// tophat extraction with ion mobility, see ChromatogramExtractorAlgorithm::extract_value_tophat
+    template <typename IteratorT>
+    void extractValueTophat(const IteratorT& mz_start,
+                                  IteratorT& mz_it,
+                            const IteratorT& mz_end,
+                                  IteratorT& int_it,
+                                  IteratorT& im_it,
+                            const double mz,
+                            const double im,
+                            double& integrated_intensity,
+                            const double mz_extraction_window,
+                            const double im_extraction_window,
+                            const bool ppm)
     {
-      left  = mz - mz_extraction_window / 2.0;
-      right = mz + mz_extraction_window / 2.0;
-    }
+      // Note that we have a 3D spectrum with m/z, intensity and ion mobility.
+      // The spectrum is sorted by m/z but we expect to have ion mobility
+      // information for each m/z point as well. Right now we simply filter by
+      // ion mobility and skip data that does not fall within the ion mobility
+      // window.
+
+      integrated_intensity = 0;
+      if (mz_start == mz_end)
+      {
+        return;
+      }
 
-    std::vector<double>::const_iterator mz_walker;
-    std::vector<double>::const_iterator int_walker;
+      // calculate extraction window
+      double left, right;
+      if (ppm)
+      {
+        left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
+        right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
+      }
+      else
+      {
+        left  = mz - mz_extraction_window / 2.0;
+        right = mz + mz_extraction_window / 2.0;
+      }
+      double left_im  = im - im_extraction_window / 2.0;
+      double right_im = im + im_extraction_window / 2.0;
 
-    // advance the mz / int iterator until we hit the m/z value of the next transition
-    while (mz_it != mz_end && (*mz_it) < mz)
-    {
-      mz_it++;
-      int_it++;
+      IteratorT mz_walker;
+      IteratorT im_walker;
+      IteratorT int_walker;
+
+      // advance the mz / int iterator until we hit the m/z value of the next transition
+      while (mz_it != mz_end && (*mz_it) < mz)
+      {
+        mz_it++;
+        im_it++;
+        int_it++;
+      }
+
+      // walk right and left and add to our intensity
+      mz_walker  = mz_it;
+      im_walker  = im_it;
+      int_walker = int_it;
+
+      // if we moved past the end of the spectrum, we need to try the last peak
+      // of the spectrum (it could still be within the window)
+      if (mz_it == mz_end)
+      {
+        --mz_walker;
+        --im_walker;
+        --int_walker;
+      }
+
+      // add the current peak if it is between right and left
+      if ((*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
+      {
+        integrated_intensity += (*int_walker);
+      }
+
+      // (i) Walk to the left one step and then keep walking left until we go
+      // outside the window. Note for the first step to the left we have to
+      // check for the walker becoming equal to the first data point.
+      mz_walker  = mz_it;
+      int_walker = int_it;
+      im_walker = im_it;
+      if (mz_it != mz_start)
+      {
+        --mz_walker;
+        --im_walker;
+        --int_walker;
+
+        // Special case: target m/z is larger than first data point but the first
+        // data point is inside the window.
+        // Then, mz_it is the second data point, mz_walker now points to the very
+        // first data point. If mz_it was the first data point, we already added
+        // it above. We still need to add this point if it is inside the window
+        // (while loop below will not catch it)
+        if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
+        {
+          integrated_intensity += (*int_walker);
+        }
+      }
+      while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
+        --mz_walker;
+        --im_walker;
+        --int_walker;
+      }
+
+      // (ii) Walk to the right one step and then keep walking right until we are
+      // outside the window
+      mz_walker  = mz_it;
+      im_walker  = im_it;
+      int_walker = int_it;
+      if (mz_it != mz_end)
+      {
+        ++im_walker;
+        ++mz_walker;
+        ++int_walker;
+      }
+      while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
+      {
+        if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
+        ++mz_walker;
+        ++im_walker;
+        ++int_walker;
+      }
     }
 
-    // walk right and left and add to our intensity
-    mz_walker  = mz_it;
-    int_walker = int_it;
+    typedef Internal::CachedMzMLHandler::DataArrayView ArrayView;
 
-    // if we moved past the end of the spectrum, we need to try the last peak
-    // of the spectrum (it could still be within the window)
-    if (mz_it == mz_end)
+    /// a view on an in-memory array (the view does not require aligned data but works with any array of doubles)
+    inline ArrayView viewOf(const std::vector<double>& data)
     {
-      --mz_walker;
-      --int_walker;
+      ArrayView view;
+      view.data = reinterpret_cast<const char*>(data.data());
+      view.size = data.size();
+      return view;
     }
 
-    // add the current peak if it is between right and left
-    if ((*mz_walker) > left && (*mz_walker) < right)
+#ifdef OPENMS_EXTRACTOR_SSE2
+    inline __m128d load2(const ArrayView& arr, Size idx)
     {
-      integrated_intensity += (*int_walker);
+      return _mm_loadu_pd(reinterpret_cast<const double*>(arr.data + idx * sizeof(double)));
     }
-
-    // (i) Walk to the left one step and then keep walking left until we go
-    // outside the window. Note for the first step to the left we have to
-    // check for the walker becoming equal to the first data point.
-    mz_walker  = mz_it;
-    int_walker = int_it;
-    if (mz_it != mz_start)
+#endif
+
+    /*
+      Returns the first index >= idx whose value is not smaller than (or, if
+      inclusive is set, not smaller or equal to) bound. The array needs to be
+      sorted. Two values are compared at once using SSE2 if available.
+    */
+    template <bool inclusive>
+    inline Size advanceTo(const ArrayView& arr, Size idx, const double bound)
     {
-      --mz_walker;
-      --int_walker;
-
-      // Special case: target m/z is larger than first data point but the first
-      // data point is inside the window.
-      // Then, mz_it is the second data point, mz_walker now points to the very
-      // first data point. If mz_it was the first data point, we already added
-      // it above. We still need to add this point if it is inside the window
-      // (while loop below will not catch it)
-      if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right)
+#ifdef OPENMS_EXTRACTOR_SSE2
+      const __m128d b = _mm_set1_pd(bound);
+      while (idx + 2 <= arr.size)
       {
-        integrated_intensity += (*int_walker);
+        const __m128d v = load2(arr, idx);
+        const int mask = _mm_movemask_pd(inclusive ? _mm_cmple_pd(v, b) : _mm_cmplt_pd(v, b));
+        // since the data is sorted, the mask is either 0, 1 or 3
+        if (mask != 3) return idx + (mask & 1);
+        idx += 2;
       }
+#endif
+      while (idx < arr.size && (inclusive ? arr[idx] <= bound : arr[idx] < bound)) ++idx;
+      return idx;
     }
-    while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
+
+    /// Sum of the values in [begin, end)
+    inline double sumRange(const ArrayView& arr, Size begin, const Size end)
     {
-      integrated_intensity += (*int_walker);
-      --mz_walker;
-      --int_walker;
+      double sum = 0.0;
+#ifdef OPENMS_EXTRACTOR_SSE2
+      if (begin + 2 <= end)
+      {
+        __m128d acc = _mm_setzero_pd();
+        for (; begin + 2 <= end; begin += 2) acc = _mm_add_pd(acc, load2(arr, begin));
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc);
+        sum = lanes[0] + lanes[1];
+      }
+#endif
+      for (; begin < end; ++begin) sum += arr[begin];
+      return sum;
     }
 
-    // (ii) Walk to the right one step and then keep walking right until we are
-    // outside the window
-    mz_walker  = mz_it;
-    int_walker = int_it;
-    if (mz_it != mz_end)
+    /*
+      Tophat extraction for many sorted target m/z values in a single merge
+      pass over the spectrum: since the targets are sorted, so are the left
+      and right window borders and we only need to advance three indices
+      (window start, window end and the position of the target itself)
+      through the spectrum.
+
+      The peaks summed up are exactly the ones extractValueTophat adds when
+      walking left and right from the position of the target, including its
+      behaviour at the spectrum borders: the very first data point is only
+      reached if the target lies before the third data point and, for targets
+      past the end of the spectrum, the last data point is counted twice.
+      The sums are accumulated in two lanes, so they can differ from the
+      scalar walk in the last bits.
+    */
+    void extractTophatBatch(const ArrayView& mz,
+                            const ArrayView& intensity,
+                            const std::vector<double>& mz_targets,
+                            std::vector<double>& integrated_intensities,
+                            const double mz_extraction_window,
+                            const bool ppm)
     {
-      ++mz_walker;
-      ++int_walker;
+      integrated_intensities.assign(mz_targets.size(), 0.0);
+      const Size n = mz.size;
+      if (n == 0)
+      {
+        return;
+      }
+
+      Size lo = 0; // first data point > left
+      Size hi = 0; // first data point >= right
+      Size pos = 0; // first data point >= target
+      for (Size k = 0; k < mz_targets.size(); ++k)
+      {
+        const double target = mz_targets[k];
+        double left, right;
+        if (ppm)
+        {
+          left  = target - target * mz_extraction_window / 2.0 * 1.0e-6;
+          right = target + target * mz_extraction_window / 2.0 * 1.0e-6;
+        }
+        else
+        {
+          left  = target - mz_extraction_window / 2.0;
+          right = target + mz_extraction_window / 2.0;
+        }
+
+        pos = advanceTo<false>(mz, pos, target);
+        lo = advanceTo<true>(mz, lo, left);
+        hi = advanceTo<false>(mz, std::max(hi, lo), right);
+
+        const Size first = (pos >= 2 && lo == 0) ? 1 : lo;
+        if (first < hi)
+        {
+          integrated_intensities[k] = sumRange(intensity, first, hi);
+        }
+        if (pos == n && hi == n && first < n)
+        {
+          integrated_intensities[k] += intensity[n - 1];
+        }
+      }
     }
-    while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
+
+    /*
+      Extracts the signal of a single spectrum for all extraction coordinates
+      and appends one data point per coordinate to the output chromatograms.
+      Without ion mobility, all coordinates are extracted in a single pass
+      (the results for coordinates outside of their RT range are ignored).
+    */
+    void extractSpectrum(const ArrayView& mz,
+                         const ArrayView& intensity,
+                         const ArrayView& im,
+                         const bool has_im,
+                         const double current_rt,
+                         std::vector< OpenSwath::ChromatogramPtr >& output,
+                         const std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& extraction_coordinates,
+                         const std::vector<double>& mz_targets,
+                         std::vector<double>& batch_intensities,
+                         const double mz_extraction_window,
+                         const bool ppm,
+                         const double im_extraction_window,
+                         const int used_filter)
     {
-      integrated_intensity += (*int_walker);
-      ++mz_walker;
-      ++int_walker;
+      if (used_filter == 2)
+      {
+        throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+      }
+
+      if (!has_im)
+      {
+        extractTophatBatch(mz, intensity, mz_targets, batch_intensities, mz_extraction_window, ppm);
+        for (Size k = 0; k < extraction_coordinates.size(); ++k)
+        {
+          if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
+               (current_rt < extraction_coordinates[k].rt_start ||
+                current_rt > extraction_coordinates[k].rt_end) )
+          {
+            continue;
+          }
+          output[k]->getTimeArray()->data.push_back(current_rt);
+          output[k]->getIntensityArray()->data.push_back(batch_intensities[k]);
+        }
+        return;
+      }
+
+      const ArrayView::ConstIterator mz_start = mz.begin();
+      const ArrayView::ConstIterator mz_end = mz.end();
+      ArrayView::ConstIterator mz_it = mz_start;
+      ArrayView::ConstIterator int_it = intensity.begin();
+      ArrayView::ConstIterator im_it = im.begin();
+
+      // go through all transitions / chromatograms which are sorted by
+      // ProductMZ. We can use this to step through the spectrum and at the
+      // same time step through the transitions. We increase the peak counter
+      // until we hit the next transition and then extract the signal.
+      for (Size k = 0; k < extraction_coordinates.size(); ++k)
+      {
+        double integrated_intensity = 0;
+        if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
+             (current_rt < extraction_coordinates[k].rt_start ||
+              current_rt > extraction_coordinates[k].rt_end) )
+        {
+          continue;
+        }
+
+        const bool use_im = (extraction_coordinates[k].ion_mobility >= 0.0);
+        if (!use_im)
+        {
+          extractValueTophat(mz_start, mz_it, mz_end, int_it,
+                             extraction_coordinates[k].mz, integrated_intensity, mz_extraction_window, ppm);
+        }
+        else
+        {
+          extractValueTophat(mz_start, mz_it, mz_end, int_it, im_it,
+                             extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
+                             integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
+        }
+
+        output[k]->getTimeArray()->data.push_back(current_rt);
+        output[k]->getIntensityArray()->data.push_back(integrated_intensity);
+      }
     }
   }
 
+  void ChromatogramExtractorAlgorithm::extract_value_tophat(
+      const std::vector<double>::const_iterator& mz_start,
+            std::vector<double>::const_iterator& mz_it,
+      const std::vector<double>::const_iterator& mz_end,
+            std::vector<double>::const_iterator& int_it,
+      const double mz,
+      double& integrated_intensity,
+      const double mz_extraction_window,
+      const bool ppm)
+  {
+    extractValueTophat(mz_start, mz_it, mz_end, int_it, mz, integrated_intensity, mz_extraction_window, ppm);
+  }
+
   void ChromatogramExtractorAlgorithm::extract_value_tophat(
       const std::vector<double>::const_iterator& mz_start,
             std::vector<double>::const_iterator& mz_it,
@@ -157,114 +508,26 @@ namespace OpenMS
       const double im_extraction_window,
       const bool ppm)
   {
-    // Note that we have a 3D spectrum with m/z, intensity and ion mobility.
-    // The spectrum is sorted by m/z but we expect to have ion mobility
-    // information for each m/z point as well. Right now we simply filter by
-    // ion mobility and skip data that does not fall within the ion mobility
-    // window.
-
-    integrated_intensity = 0;
-    if (mz_start == mz_end)
-    {
-      return;
-    }
-
-    // calculate extraction window
-    double left, right;
-    if (ppm)
-    {
-      left  = mz - mz * mz_extraction_window / 2.0 * 1.0e-6;
-      right = mz + mz * mz_extraction_window / 2.0 * 1.0e-6;
-    }
-    else
-    {
-      left  = mz - mz_extraction_window / 2.0;
-      right = mz + mz_extraction_window / 2.0;
-    }
-    double left_im  = im - im_extraction_window / 2.0;
-    double right_im = im + im_extraction_window / 2.0;
-
-    std::vector<double>::const_iterator mz_walker;
-    std::vector<double>::const_iterator im_walker;
-    std::vector<double>::const_iterator int_walker;
-
-    // advance the mz / int iterator until we hit the m/z value of the next transition
-    while (mz_it != mz_end && (*mz_it) < mz)
-    {
-      mz_it++;
-      im_it++;
-      int_it++;
-    }
-
-    // walk right and left and add to our intensity
-    mz_walker  = mz_it;
-    im_walker  = im_it;
-    int_walker = int_it;
-
-    // if we moved past the end of the spectrum, we need to try the last peak
-    // of the spectrum (it could still be within the window)
-    if (mz_it == mz_end)
-    {
-      --mz_walker;
-      --im_walker;
-      --int_walker;
-    }
-
-    // add the current peak if it is between right and left
-    if ((*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
-    {
-      integrated_intensity += (*int_walker);
-    }
+    extractValueTophat(mz_start, mz_it, mz_end, int_it, im_it, mz, im, integrated_intensity,
+                       mz_extraction_window, im_extraction_window, ppm);
+  }
 
-    // (i) Walk to the left one step and then keep walking left until we go
-    // outside the window. Note for the first step to the left we have to
-    // check for the walker becoming equal to the first data point.
-    mz_walker  = mz_it;
-    int_walker = int_it;
-    im_walker = im_it;
-    if (mz_it != mz_start)
-    {
-      --mz_walker;
-      --im_walker;
-      --int_walker;
-
-      // Special case: target m/z is larger than first data point but the first
-      // data point is inside the window.
-      // Then, mz_it is the second data point, mz_walker now points to the very
-      // first data point. If mz_it was the first data point, we already added
-      // it above. We still need to add this point if it is inside the window
-      // (while loop below will not catch it)
-      if (mz_walker == mz_start && (*mz_walker) > left && (*mz_walker) < right && (*im_walker) > left_im && (*im_walker) < right_im)
-      {
-        integrated_intensity += (*int_walker);
-      }
-    }
-    while (mz_walker != mz_start && (*mz_walker) > left && (*mz_walker) < right)
+  void ChromatogramExtractorAlgorithm::extract_value_tophat(
+      const std::vector<double>& mz_array,
+      const std::vector<double>& int_array,
+      const std::vector<double>& mz_targets,
+      std::vector<double>& integrated_intensities,
+      const double mz_extraction_window,
+      const bool ppm)
+  {
+    if (mz_array.size() != int_array.size())
     {
-      if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
-      --mz_walker;
-      --im_walker;
-      --int_walker;
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "m/z and intensity array need to have the same size: " + String(mz_array.size()) + " != " + String(int_array.size()));
     }
+    OPENMS_PRECONDITION(std::is_sorted(mz_targets.begin(), mz_targets.end()), "Target m/z values need to be sorted")
 
-    // (ii) Walk to the right one step and then keep walking right until we are
-    // outside the window
-    mz_walker  = mz_it;
-    im_walker  = im_it;
-    int_walker = int_it;
-    if (mz_it != mz_end)
-    {
-      ++im_walker;
-      ++mz_walker;
-      ++int_walker;
-    }
-    while (mz_walker != mz_end && (*mz_walker) > left && (*mz_walker) < right)
-    {
-      if (*im_walker > left_im && *im_walker < right_im) integrated_intensity += (*int_walker);
-      ++mz_walker;
-      ++im_walker;
-      ++int_walker;
-    }
+    extractTophatBatch(viewOf(mz_array), viewOf(int_array), mz_targets, integrated_intensities, mz_extraction_window, ppm);
   }
 
   void ChromatogramExtractorAlgorithm::extractChromatograms(const OpenSwath::SpectrumAccessPtr input,
@@ -296,6 +559,56 @@ namespace OpenMS
         "Input to extractChromatogram needs to be sorted by m/z");
     }
 
+    // Look for ion mobility array
+    const bool has_im = (im_extraction_window > 0.0);
+
+    // target m/z values and result buffer for the single pass extraction
+    std::vector<double> mz_targets;
+    mz_targets.reserve(extraction_coordinates.size());
+    for (const auto& coord : extraction_coordinates) mz_targets.push_back(coord.mz);
+    std::vector<double> batch_intensities;
+
+    // A memory-mapped cached file allows us to read the spectra in place
+    // without copying each of them into freshly allocated arrays first. Only
+    // a bare SpectrumAccessOpenMSCached qualifies: wrappers such as
+    // SpectrumAccessTransforming may change the spectra in getSpectrumById
+    // and therefore always go through the generic loop below.
+    boost::shared_ptr<SpectrumAccessOpenMSCached> cached = boost::dynamic_pointer_cast<SpectrumAccessOpenMSCached>(input);
+    if (cached != nullptr && cached->getMemoryMapping())
+    {
+      Internal::CachedMzMLHandler::DataView view;
+      startProgress(0, input_size, "Extracting chromatograms");
+      for (Size scan_idx = 0; scan_idx < input_size; ++scan_idx)
+      {
+        setProgress(scan_idx);
+
+        cached->getSpectrumView(scan_idx, view);
+        if (view.first.size == 0)
+        {
+          continue;
+        }
+
+        ArrayView im;
+        if (has_im)
+        {
+          auto im_arr = std::find_if(view.additional.begin(), view.additional.end(),
+              [](const ArrayView& arr) { return arr.nameStartsWith("Ion Mobility"); });
+          if (im_arr == view.additional.end())
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Requested ion mobility extraction but no ion mobility array found.");
+          }
+          im = *im_arr;
+        }
+
+        extractSpectrum(view.first, view.second, im, has_im,
+                        cached->getSpectrumMetaById(scan_idx).RT, output, extraction_coordinates,
+                        mz_targets, batch_intensities, mz_extraction_window, ppm, im_extraction_window, used_filter);
+      }
+      endProgress();
+      return;
+    }
+
     //go through all spectra
     startProgress(0, input_size, "Extracting chromatograms");
     for (Size scan_idx = 0; scan_idx < input_size; ++scan_idx)
@@ -307,25 +620,19 @@ namespace OpenMS
 
       OpenSwath::BinaryDataArrayPtr mz_arr = sptr->getMZArray();
       OpenSwath::BinaryDataArrayPtr int_arr = sptr->getIntensityArray();
-      std::vector<double>::const_iterator mz_start = mz_arr->data.begin();
-      std::vector<double>::const_iterator mz_end = mz_arr->data.end();
-      std::vector<double>::const_iterator mz_it = mz_arr->data.begin();
-      std::vector<double>::const_iterator int_it = int_arr->data.begin();
-      std::vector<double>::const_iterator im_it;
 
-      if (sptr->getMZArray()->data.size() == 0)
+      if (mz_arr->data.size() == 0)
       {
         continue;
       }
 
-      // Look for ion mobility array
-      bool has_im = (im_extraction_window > 0.0);
+      ArrayView im;
       if (has_im)
       {
         OpenSwath::BinaryDataArrayPtr im_arr = sptr->getDriftTimeArray();
         if (im_arr != nullptr)
         {
-          im_it = im_arr->data.begin();
+          im = viewOf(im_arr->data);
         }
         else
         {
@@ -334,45 +641,9 @@ namespace OpenMS
         }
       }
 
-      // go through all transitions / chromatograms which are sorted by
-      // ProductMZ. We can use this to step through the spectrum and at the
-      // same time step through the transitions. We increase the peak counter
-      // until we hit the next transition and then extract the signal.
-      for (Size k = 0; k < extraction_coordinates.size(); ++k)
-      {
-        double integrated_intensity = 0;
-        double current_rt = s_meta.RT;
-        if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
-             (current_rt < extraction_coordinates[k].rt_start ||
-              current_rt > extraction_coordinates[k].rt_end) )
-        {
-          continue;
-        }
-
-        const bool use_im = (extraction_coordinates[k].ion_mobility >= 0.0 && has_im);
-        if (!use_im && used_filter == 1)
-        {
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it,
-                               extraction_coordinates[k].mz, integrated_intensity, mz_extraction_window, ppm);
-        }
-        else if (use_im && used_filter == 1)
-        {
-          if (extraction_coordinates[k].ion_mobility < 0)
-          {
-            std::cerr << "WARNING : Drift time of ion is negative!" << std::endl;
-          }
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it, im_it,
-                               extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
-                               integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
-        }
-        else if (used_filter == 2)
-        {
-          throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
-        }
-
-        output[k]->getTimeArray()->data.push_back(current_rt);
-        output[k]->getIntensityArray()->data.push_back(integrated_intensity);
-      }
+      extractSpectrum(viewOf(mz_arr->data), viewOf(int_arr->data), im, has_im,
+                      s_meta.RT, output, extraction_coordinates,
+                      mz_targets, batch_intensities, mz_extraction_window, ppm, im_extraction_window, used_filter);
     }
     endProgress();
   }
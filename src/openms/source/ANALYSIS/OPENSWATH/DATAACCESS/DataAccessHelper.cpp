@@ -71,6 +71,15 @@ namespace OpenMS
     return sptr;
   }
 
+  OpenSwath::SpectrumPtr OpenSwathDataAccessHelper::convertToSpectrumPtr(OpenMS::MSSpectrumSoA && spectrum)
+  {
+    OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+    sptr->getMZArray()->data.swap(spectrum.getMZArray());
+    sptr->getIntensityArray()->data.swap(spectrum.getIntensityArray());
+    spectrum.clear();
+    return sptr;
+  }
+
   OpenSwath::ChromatogramPtr OpenSwathDataAccessHelper::convertToChromatogramPtr(const OpenMS::MSChromatogram & chromatogram)
   {
     OpenSwath::ChromatogramPtr cptr(new OpenSwath::Chromatogram);
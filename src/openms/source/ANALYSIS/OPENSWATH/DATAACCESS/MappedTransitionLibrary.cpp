@@ -0,0 +1,503 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/MappedTransitionLibrary.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+namespace OpenMS
+{
+  MappedTransitionLibrary::MappedTransitionLibrary() :
+    columns_(TransitionBinFile::SIZE_OF_COLUMN, nullptr),
+    column_sizes_(TransitionBinFile::SIZE_OF_COLUMN, 0)
+  {
+    std::memset(&header_, 0, sizeof(header_));
+  }
+
+  MappedTransitionLibrary::MappedTransitionLibrary(const String& filename) :
+    MappedTransitionLibrary()
+  {
+    open(filename);
+  }
+
+  MappedTransitionLibrary::~MappedTransitionLibrary() = default;
+
+  void MappedTransitionLibrary::open(const String& filename)
+  {
+    *this = MappedTransitionLibrary();
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    filename_ = filename;
+    try
+    {
+      mapped_file_ = std::make_shared<boost::iostreams::mapped_file_source>(filename_);
+    }
+    catch (std::exception& /* e */)
+    {
+      mapped_file_.reset();
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+    }
+
+    try
+    {
+      validate_();
+    }
+    catch (...)
+    {
+      *this = MappedTransitionLibrary();
+      throw;
+    }
+  }
+
+  void MappedTransitionLibrary::validate_()
+  {
+    const char* data = mapped_file_->data();
+    const UInt64 file_size = mapped_file_->size();
+
+    if (file_size < sizeof(TransitionBinFile::Header))
+    {
+      parseError_("File is too short for a binary transition library");
+    }
+    std::memcpy(&header_, data, sizeof(TransitionBinFile::Header));
+    if (std::memcmp(header_.magic, TransitionBinFile::MAGIC, sizeof(header_.magic)) != 0)
+    {
+      parseError_("Not a binary transition library");
+    }
+    if (header_.byte_order_mark != TransitionBinFile::BYTE_ORDER_MARK)
+    {
+      parseError_("Binary transition library was written on a machine with a different byte order");
+    }
+    if (header_.version > TransitionBinFile::VERSION)
+    {
+      parseError_("Binary transition library version " + String(header_.version) + " is not supported (supported up to version " +
+        String(TransitionBinFile::VERSION) + ")");
+    }
+    if (header_.nr_columns < TransitionBinFile::SIZE_OF_COLUMN ||
+        header_.nr_columns > (file_size - sizeof(TransitionBinFile::Header)) / sizeof(TransitionBinFile::ColumnEntry))
+    {
+      parseError_("Column directory is incomplete (corrupt file?)");
+    }
+
+    for (Size c = 0; c < TransitionBinFile::SIZE_OF_COLUMN; ++c)
+    {
+      TransitionBinFile::ColumnEntry entry;
+      std::memcpy(&entry, data + sizeof(TransitionBinFile::Header) + c * sizeof(TransitionBinFile::ColumnEntry), sizeof(entry));
+      if (entry.offset % 8 != 0 || entry.offset > file_size || entry.size > file_size - entry.offset)
+      {
+        parseError_("Column " + String(c) + " lies outside of the file (corrupt file?)");
+      }
+      columns_[c] = data + entry.offset;
+      column_sizes_[c] = entry.size;
+    }
+
+    // every transition, compound and protein takes at least one byte, so larger
+    // counts are corrupt (and checking this first keeps n + 1 below from wrapping)
+    if (header_.nr_transitions > file_size || header_.nr_compounds > file_size || header_.nr_proteins > file_size)
+    {
+      parseError_("Number of entries exceeds the file size (corrupt file?)");
+    }
+
+    // check that the column sizes match the number of entries
+    auto expectSize = [this, file_size](TransitionBinFile::Column c, UInt64 count, UInt64 element_size)
+    {
+      if (count > file_size / element_size ||
+          column_sizes_[c] / element_size != count || column_sizes_[c] % element_size != 0)
+      {
+        parseError_("Column " + String(Size(c)) + " has an unexpected size (corrupt file?)");
+      }
+    };
+    // check that a table of n + 1 offsets starts at 0 and ends at @p end
+    auto expectOffsets = [this, file_size, &expectSize](TransitionBinFile::Column c, UInt64 n, UInt64 end)
+    {
+      if (n >= file_size / sizeof(UInt64))
+      {
+        parseError_("Column " + String(Size(c)) + " has an unexpected size (corrupt file?)");
+      }
+      expectSize(c, n + 1, sizeof(UInt64));
+      const UInt64* offsets = column_<UInt64>(c);
+      if (offsets[0] != 0 || offsets[n] != end)
+      {
+        parseError_("Column " + String(Size(c)) + " contains invalid offsets (corrupt file?)");
+      }
+    };
+    auto expectStrings = [this, &expectOffsets](TransitionBinFile::Column c, UInt64 n)
+    {
+      expectOffsets(c, n, column_sizes_[c + 1]);
+    };
+
+    const UInt64 nt = header_.nr_transitions;
+    const UInt64 nc = header_.nr_compounds;
+    const UInt64 np = header_.nr_proteins;
+
+    expectSize(TransitionBinFile::TRANSITION_PRECURSOR_MZ, nt, sizeof(double));
+    expectSize(TransitionBinFile::TRANSITION_PRODUCT_MZ, nt, sizeof(double));
+    expectSize(TransitionBinFile::TRANSITION_LIBRARY_INTENSITY, nt, sizeof(double));
+    expectSize(TransitionBinFile::TRANSITION_FRAGMENT_CHARGE, nt, sizeof(Int32));
+    expectSize(TransitionBinFile::TRANSITION_COMPOUND, nt, sizeof(UInt32));
+    expectSize(TransitionBinFile::TRANSITION_FLAGS, nt, sizeof(unsigned char));
+    expectStrings(TransitionBinFile::TRANSITION_NAME_OFFSETS, nt);
+    if (column_sizes_[TransitionBinFile::TRANSITION_BY_PRECURSOR_MZ] % sizeof(UInt32) != 0 ||
+        column_sizes_[TransitionBinFile::TRANSITION_BY_PRECURSOR_MZ] / sizeof(UInt32) > nt)
+    {
+      parseError_("Precursor m/z index has an unexpected size (corrupt file?)");
+    }
+
+    expectSize(TransitionBinFile::COMPOUND_RT, nc, sizeof(double));
+    expectSize(TransitionBinFile::COMPOUND_DRIFT_TIME, nc, sizeof(double));
+    expectSize(TransitionBinFile::COMPOUND_CHARGE, nc, sizeof(Int32));
+    expectStrings(TransitionBinFile::COMPOUND_ID_OFFSETS, nc);
+    expectStrings(TransitionBinFile::COMPOUND_SEQUENCE_OFFSETS, nc);
+    expectStrings(TransitionBinFile::COMPOUND_GROUP_LABEL_OFFSETS, nc);
+    expectStrings(TransitionBinFile::COMPOUND_GENE_NAME_OFFSETS, nc);
+    expectStrings(TransitionBinFile::COMPOUND_SUM_FORMULA_OFFSETS, nc);
+    expectStrings(TransitionBinFile::COMPOUND_NAME_OFFSETS, nc);
+    if (column_sizes_[TransitionBinFile::COMPOUND_PROTEIN_REF_OFFSETS] < sizeof(UInt64))
+    {
+      parseError_("Protein reference table is missing (corrupt file?)");
+    }
+    const UInt64 nr_refs = column_sizes_[TransitionBinFile::COMPOUND_PROTEIN_REF_OFFSETS] / sizeof(UInt64) - 1;
+    expectOffsets(TransitionBinFile::COMPOUND_PROTEIN_REF_RANGES, nc, nr_refs);
+    expectStrings(TransitionBinFile::COMPOUND_PROTEIN_REF_OFFSETS, nr_refs);
+    if (column_sizes_[TransitionBinFile::COMPOUND_MODIFICATIONS] % (2 * sizeof(Int32)) != 0)
+    {
+      parseError_("Modification table has an unexpected size (corrupt file?)");
+    }
+    expectOffsets(TransitionBinFile::COMPOUND_MODIFICATION_RANGES, nc,
+      column_sizes_[TransitionBinFile::COMPOUND_MODIFICATIONS] / (2 * sizeof(Int32)));
+
+    expectStrings(TransitionBinFile::PROTEIN_ID_OFFSETS, np);
+    expectStrings(TransitionBinFile::PROTEIN_SEQUENCE_OFFSETS, np);
+
+    protein_index_.reserve(np);
+    for (Size i = 0; i < np; ++i)
+    {
+      protein_index_.emplace(getProteinId(i), i);
+    }
+  }
+
+  void MappedTransitionLibrary::parseError_(const String& message) const
+  {
+    throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, message, filename_);
+  }
+
+  bool MappedTransitionLibrary::isOpen() const
+  {
+    return mapped_file_ != nullptr;
+  }
+
+  const String& MappedTransitionLibrary::getFilename() const
+  {
+    return filename_;
+  }
+
+  Size MappedTransitionLibrary::getNrTransitions() const
+  {
+    return header_.nr_transitions;
+  }
+
+  Size MappedTransitionLibrary::getNrCompounds() const
+  {
+    return header_.nr_compounds;
+  }
+
+  Size MappedTransitionLibrary::getNrProteins() const
+  {
+    return header_.nr_proteins;
+  }
+
+  const double* MappedTransitionLibrary::getPrecursorMZs() const
+  {
+    return column_<double>(TransitionBinFile::TRANSITION_PRECURSOR_MZ);
+  }
+
+  const double* MappedTransitionLibrary::getProductMZs() const
+  {
+    return column_<double>(TransitionBinFile::TRANSITION_PRODUCT_MZ);
+  }
+
+  const double* MappedTransitionLibrary::getLibraryIntensities() const
+  {
+    return column_<double>(TransitionBinFile::TRANSITION_LIBRARY_INTENSITY);
+  }
+
+  const Int32* MappedTransitionLibrary::getFragmentCharges() const
+  {
+    return column_<Int32>(TransitionBinFile::TRANSITION_FRAGMENT_CHARGE);
+  }
+
+  const UInt32* MappedTransitionLibrary::getCompoundIndices() const
+  {
+    return column_<UInt32>(TransitionBinFile::TRANSITION_COMPOUND);
+  }
+
+  const unsigned char* MappedTransitionLibrary::getFlags() const
+  {
+    return column_<unsigned char>(TransitionBinFile::TRANSITION_FLAGS);
+  }
+
+  const double* MappedTransitionLibrary::getNormalizedRTs() const
+  {
+    return column_<double>(TransitionBinFile::COMPOUND_RT);
+  }
+
+  const double* MappedTransitionLibrary::getDriftTimes() const
+  {
+    return column_<double>(TransitionBinFile::COMPOUND_DRIFT_TIME);
+  }
+
+  const Int32* MappedTransitionLibrary::getCharges() const
+  {
+    return column_<Int32>(TransitionBinFile::COMPOUND_CHARGE);
+  }
+
+  std::string MappedTransitionLibrary::getString_(TransitionBinFile::Column offsets_column, Size index) const
+  {
+    const UInt64* offsets = column_<UInt64>(offsets_column);
+    const TransitionBinFile::Column data_column = TransitionBinFile::Column(offsets_column + 1);
+    const UInt64 begin = offsets[index];
+    const UInt64 end = offsets[index + 1];
+    if (begin > end || end > column_sizes_[data_column])
+    {
+      parseError_("String table " + String(Size(offsets_column)) + " contains invalid offsets (corrupt file?)");
+    }
+    return std::string(columns_[data_column] + begin, end - begin);
+  }
+
+  std::vector<std::string> MappedTransitionLibrary::getStrings_(TransitionBinFile::Column offsets_column, Size first, Size last) const
+  {
+    std::vector<std::string> result;
+    result.reserve(last - first);
+    for (Size i = first; i < last; ++i)
+    {
+      result.push_back(getString_(offsets_column, i));
+    }
+    return result;
+  }
+
+  std::string MappedTransitionLibrary::getTransitionName(Size index) const
+  {
+    OPENMS_PRECONDITION(index < getNrTransitions(), "Transition index out of range")
+    return getString_(TransitionBinFile::TRANSITION_NAME_OFFSETS, index);
+  }
+
+  std::string MappedTransitionLibrary::getCompoundId(Size index) const
+  {
+    OPENMS_PRECONDITION(index < getNrCompounds(), "Compound index out of range")
+    return getString_(TransitionBinFile::COMPOUND_ID_OFFSETS, index);
+  }
+
+  std::string MappedTransitionLibrary::getProteinId(Size index) const
+  {
+    OPENMS_PRECONDITION(index < getNrProteins(), "Protein index out of range")
+    return getString_(TransitionBinFile::PROTEIN_ID_OFFSETS, index);
+  }
+
+  void MappedTransitionLibrary::getTransition(Size index, OpenSwath::LightTransition& transition) const
+  {
+    OPENMS_PRECONDITION(index < getNrTransitions(), "Transition index out of range")
+    const UInt32 compound = getCompoundIndices()[index];
+    if (compound >= getNrCompounds())
+    {
+      parseError_("Transition " + String(index) + " refers to a compound that does not exist (corrupt file?)");
+    }
+    const unsigned char flags = getFlags()[index];
+
+    transition.transition_name = getTransitionName(index);
+    transition.peptide_ref = getCompoundId(compound);
+    transition.library_intensity = getLibraryIntensities()[index];
+    transition.product_mz = getProductMZs()[index];
+    transition.precursor_mz = getPrecursorMZs()[index];
+    transition.fragment_charge = getFragmentCharges()[index];
+    transition.decoy = (flags & TransitionBinFile::FLAG_DECOY) != 0;
+    transition.detecting_transition = (flags & TransitionBinFile::FLAG_DETECTING) != 0;
+    transition.quantifying_transition = (flags & TransitionBinFile::FLAG_QUANTIFYING) != 0;
+    transition.identifying_transition = (flags & TransitionBinFile::FLAG_IDENTIFYING) != 0;
+  }
+
+  void MappedTransitionLibrary::getCompound(Size index, OpenSwath::LightCompound& compound) const
+  {
+    OPENMS_PRECONDITION(index < getNrCompounds(), "Compound index out of range")
+    compound.drift_time = getDriftTimes()[index];
+    compound.rt = getNormalizedRTs()[index];
+    compound.charge = getCharges()[index];
+    compound.id = getCompoundId(index);
+    compound.sequence = getString_(TransitionBinFile::COMPOUND_SEQUENCE_OFFSETS, index);
+    compound.peptide_group_label = getString_(TransitionBinFile::COMPOUND_GROUP_LABEL_OFFSETS, index);
+    compound.gene_name = getString_(TransitionBinFile::COMPOUND_GENE_NAME_OFFSETS, index);
+    compound.sum_formula = getString_(TransitionBinFile::COMPOUND_SUM_FORMULA_OFFSETS, index);
+    compound.compound_name = getString_(TransitionBinFile::COMPOUND_NAME_OFFSETS, index);
+
+    const UInt64* ref_ranges = column_<UInt64>(TransitionBinFile::COMPOUND_PROTEIN_REF_RANGES);
+    const UInt64 nr_refs = column_sizes_[TransitionBinFile::COMPOUND_PROTEIN_REF_OFFSETS] / sizeof(UInt64) - 1;
+    if (ref_ranges[index] > ref_ranges[index + 1] || ref_ranges[index + 1] > nr_refs)
+    {
+      parseError_("Protein references of compound " + String(index) + " are invalid (corrupt file?)");
+    }
+    compound.protein_refs = getStrings_(TransitionBinFile::COMPOUND_PROTEIN_REF_OFFSETS, ref_ranges[index], ref_ranges[index + 1]);
+
+    const UInt64* mod_ranges = column_<UInt64>(TransitionBinFile::COMPOUND_MODIFICATION_RANGES);
+    const UInt64 nr_mods = column_sizes_[TransitionBinFile::COMPOUND_MODIFICATIONS] / (2 * sizeof(Int32));
+    if (mod_ranges[index] > mod_ranges[index + 1] || mod_ranges[index + 1] > nr_mods)
+    {
+      parseError_("Modifications of compound " + String(index) + " are invalid (corrupt file?)");
+    }
+    const Int32* mods = column_<Int32>(TransitionBinFile::COMPOUND_MODIFICATIONS);
+    compound.modifications.clear();
+    compound.modifications.reserve(mod_ranges[index + 1] - mod_ranges[index]);
+    for (UInt64 m = mod_ranges[index]; m < mod_ranges[index + 1]; ++m)
+    {
+      OpenSwath::LightModification mod;
+      mod.location = mods[2 * m];
+      mod.unimod_id = mods[2 * m + 1];
+      compound.modifications.push_back(mod);
+    }
+  }
+
+  void MappedTransitionLibrary::getProtein(Size index, OpenSwath::LightProtein& protein) const
+  {
+    OPENMS_PRECONDITION(index < getNrProteins(), "Protein index out of range")
+    protein.id = getProteinId(index);
+    protein.sequence = getString_(TransitionBinFile::PROTEIN_SEQUENCE_OFFSETS, index);
+  }
+
+  void MappedTransitionLibrary::selectTransitions(const std::vector<Size>& indices,
+                                                  OpenSwath::LightTargetedExperiment& transition_exp_used) const
+  {
+    OPENMS_PRECONDITION(std::is_sorted(indices.begin(), indices.end()), "Transition indices need to be sorted")
+
+    std::vector<UInt32> compounds;
+    compounds.reserve(indices.size());
+    transition_exp_used.transitions.reserve(transition_exp_used.transitions.size() + indices.size());
+    for (Size index : indices)
+    {
+      transition_exp_used.transitions.emplace_back();
+      getTransition(index, transition_exp_used.transitions.back());
+      compounds.push_back(getCompoundIndices()[index]);
+    }
+    std::sort(compounds.begin(), compounds.end());
+    compounds.erase(std::unique(compounds.begin(), compounds.end()), compounds.end());
+
+    std::unordered_set<std::string> matching_proteins;
+    transition_exp_used.compounds.reserve(transition_exp_used.compounds.size() + compounds.size());
+    for (UInt32 index : compounds)
+    {
+      transition_exp_used.compounds.emplace_back();
+      getCompound(index, transition_exp_used.compounds.back());
+      matching_proteins.insert(transition_exp_used.compounds.back().protein_refs.begin(),
+                               transition_exp_used.compounds.back().protein_refs.end());
+    }
+
+    std::vector<Size> proteins;
+    for (const std::string& protein_ref : matching_proteins)
+    {
+      auto range = protein_index_.equal_range(protein_ref);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        proteins.push_back(it->second);
+      }
+    }
+    std::sort(proteins.begin(), proteins.end());
+    transition_exp_used.proteins.reserve(transition_exp_used.proteins.size() + proteins.size());
+    for (Size index : proteins)
+    {
+      transition_exp_used.proteins.emplace_back();
+      getProtein(index, transition_exp_used.proteins.back());
+    }
+  }
+
+  void MappedTransitionLibrary::selectSwathTransitions(OpenSwath::LightTargetedExperiment& transition_exp_used,
+                                                       double min_upper_edge_dist, double lower, double upper) const
+  {
+    if (!isOpen()) return;
+
+    const double* precursor_mz = getPrecursorMZs();
+    const UInt32* by_precursor = column_<UInt32>(TransitionBinFile::TRANSITION_BY_PRECURSOR_MZ);
+    const UInt32* by_precursor_end = by_precursor + column_sizes_[TransitionBinFile::TRANSITION_BY_PRECURSOR_MZ] / sizeof(UInt32);
+    const Size nr_transitions = getNrTransitions();
+    auto precursorOf = [this, precursor_mz, nr_transitions](UInt32 index)
+    {
+      if (index >= nr_transitions)
+      {
+        parseError_("Precursor m/z index refers to a transition that does not exist (corrupt file?)");
+      }
+      return precursor_mz[index];
+    };
+
+    // first transition with a precursor m/z above the lower edge of the window
+    const UInt32* it = std::upper_bound(by_precursor, by_precursor_end, lower,
+      [&precursorOf](double value, UInt32 index) { return value < precursorOf(index); });
+
+    std::vector<Size> indices;
+    for (; it != by_precursor_end && precursorOf(*it) < upper; ++it)
+    {
+      if (std::fabs(upper - precursorOf(*it)) >= min_upper_edge_dist)
+      {
+        indices.push_back(*it);
+      }
+    }
+    std::sort(indices.begin(), indices.end());
+    selectTransitions(indices, transition_exp_used);
+  }
+
+  void MappedTransitionLibrary::getLightTargetedExperiment(OpenSwath::LightTargetedExperiment& transition_exp) const
+  {
+    transition_exp.transitions.resize(getNrTransitions());
+    for (Size i = 0; i < getNrTransitions(); ++i)
+    {
+      getTransition(i, transition_exp.transitions[i]);
+    }
+    transition_exp.compounds.resize(getNrCompounds());
+    for (Size i = 0; i < getNrCompounds(); ++i)
+    {
+      getCompound(i, transition_exp.compounds[i]);
+    }
+    transition_exp.proteins.resize(getNrProteins());
+    for (Size i = 0; i < getNrProteins(); ++i)
+    {
+      getProtein(i, transition_exp.proteins[i]);
+    }
+  }
+
+} // namespace OpenMS
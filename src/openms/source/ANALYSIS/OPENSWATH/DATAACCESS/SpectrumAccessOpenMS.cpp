@@ -34,6 +34,8 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+
 namespace OpenMS
 {
   SpectrumAccessOpenMS::SpectrumAccessOpenMS(boost::shared_ptr<MSExperimentType> ms_experiment)
@@ -64,19 +66,9 @@ namespace OpenMS
     OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
 
     const MSSpectrumType& spectrum = (*ms_experiment_)[id];
-    OpenSwath::BinaryDataArrayPtr intensity_array(new OpenSwath::BinaryDataArray);
-    OpenSwath::BinaryDataArrayPtr mz_array(new OpenSwath::BinaryDataArray);
-    mz_array->data.reserve(spectrum.size());
-    intensity_array->data.reserve(spectrum.size());
-    for (const auto& it : spectrum)
-    {
-      mz_array->data.push_back(it.getMZ());
-      intensity_array->data.push_back(it.getIntensity());
-    }
 
-    OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-    sptr->setMZArray(mz_array);
-    sptr->setIntensityArray(intensity_array);
+    // gather the peaks into contiguous arrays once and hand them over without further copies
+    OpenSwath::SpectrumPtr sptr = OpenSwathDataAccessHelper::convertToSpectrumPtr(MSSpectrumSoA(spectrum));
 
     for (const auto& fda : spectrum.getFloatDataArrays() )
     {
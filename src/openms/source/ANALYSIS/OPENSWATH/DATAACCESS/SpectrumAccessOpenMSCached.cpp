@@ -65,6 +65,16 @@ namespace OpenMS
     OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
     OPENMS_PRECONDITION(id < (int)getNrSpectra(), "Id cannot be larger than number of spectra");
 
+    if (use_mmap_)
+    {
+      // no stream state is modified, this is safe to call from multiple threads
+      Internal::CachedMzMLHandler::DataView view;
+      getSpectrumView(id, view);
+      OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+      sptr->getDataArrays() = Internal::CachedMzMLHandler::copyDataView(view);
+      return sptr;
+    }
+
     int ms_level = -1;
     double rt = -1.0;
 
@@ -98,6 +108,15 @@ namespace OpenMS
     OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
     OPENMS_PRECONDITION(id < (int)getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
+    if (use_mmap_)
+    {
+      Internal::CachedMzMLHandler::DataView view;
+      getChromatogramView(id, view);
+      OpenSwath::ChromatogramPtr cptr(new OpenSwath::Chromatogram);
+      cptr->getDataArrays() = Internal::CachedMzMLHandler::copyDataView(view);
+      return cptr;
+    }
+
     if ( !ifs_.seekg(chrom_index_[id]) )
     {
       std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
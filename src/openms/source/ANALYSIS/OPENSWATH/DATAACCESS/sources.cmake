@@ -12,6 +12,7 @@ SpectrumAccessTransforming.cpp
 SpectrumAccessQuadMZTransforming.cpp
 DataAccessHelper.cpp
 SimpleOpenMSSpectraAccessFactory.cpp
+MappedTransitionLibrary.cpp
 )
 
 ### add path to the filenames
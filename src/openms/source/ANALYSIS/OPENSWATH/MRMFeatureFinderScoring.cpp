@@ -50,6 +50,14 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/foreach.hpp>
 
+#include <exception>
+#include <iterator>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define run_identifier "unique_run_identifier"
 
 bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std::pair<double, double>& right)
@@ -227,31 +235,119 @@ namespace OpenMS
     // Step 3
     //
     // Go through all transition groups: first create consensus features, then score them
-    MRMTransitionGroupPicker trgroup_picker;
     Param trgroup_picker_param = param_.copy("TransitionGroupPicker:", true);
     // If use_total_mi_score is defined, we need to instruct MRMTransitionGroupPicker to compute the score
     if (su_.use_total_mi_score_)
     {
       trgroup_picker_param.setValue("compute_total_mi", "true");
     }
-    trgroup_picker.setParameters(trgroup_picker_param);
 
-    Size progress = 0;
-    startProgress(0, transition_group_map.size(), "picking peaks");
+    // Transition groups are independent of each other and are processed in parallel. The features
+    // of each group are collected separately and appended in the order of the transition group map,
+    // so the output does not depend on the number of threads.
+    std::vector<TransitionGroupMapType::iterator> trgroups;
+    trgroups.reserve(transition_group_map.size());
     for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
     {
+      trgroups.push_back(trgroup_it);
+    }
+    std::vector<std::vector<Feature> > trgroup_features(trgroups.size());
+    std::exception_ptr error;
 
-      setProgress(++progress);
-      MRMTransitionGroupType& transition_group = trgroup_it->second;
-      if (transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
+    Size progress = 0;
+    startProgress(0, trgroups.size(), "picking peaks");
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // per-thread picker and scoring (DIA, SONAR and EMG scoring keep internal state), spectrum access
+      // objects need to be cloned for thread-safe access. Setting them up can throw as well; every thread
+      // still has to reach the worksharing loop below, a thread without its objects skips its groups.
+      std::unique_ptr<MRMTransitionGroupPicker> trgroup_picker;
+      std::unique_ptr<MRMFeatureFinderScoring> thread_scoring;
+      std::vector<OpenSwath::SwathMap> thread_swath_maps;
+      try
       {
-        continue;
+        trgroup_picker.reset(new MRMTransitionGroupPicker());
+        trgroup_picker->setParameters(trgroup_picker_param);
+        thread_scoring.reset(new MRMFeatureFinderScoring());
+        thread_scoring->setParameters(param_);
+        thread_scoring->setStrictFlag(strict_);
+        if (ms1_map_)
+        {
+          thread_scoring->setMS1Map(ms1_map_->lightClone());
+        }
+        thread_swath_maps = swath_maps;
+        for (OpenSwath::SwathMap& swath_map : thread_swath_maps)
+        {
+          if (swath_map.sptr) swath_map.sptr = swath_map.sptr->lightClone();
+        }
       }
+      catch (...)
+      {
+        thread_scoring.reset();
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_pickExperiment)
+#endif
+        if (!error) error = std::current_exception();
+      }
+      FeatureMap thread_output;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)trgroups.size(); ++i)
+      {
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+
+        MRMTransitionGroupType& transition_group = trgroups[i]->second;
+        if (!thread_scoring || transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
+        {
+          continue;
+        }
+
+        try
+        {
+          trgroup_picker->pickTransitionGroup(transition_group);
 
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_maps, output);
+          // the thread-local scoring only needs the reference of the current group
+          thread_scoring->PeptideRefMap_.clear();
+          auto pep_it = PeptideRefMap_.find(transition_group.getTransitionGroupID());
+          if (pep_it == PeptideRefMap_.end())
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                             "Error: Transition group " + transition_group.getTransitionGroupID() + " has no corresponding peptide.");
+          }
+          thread_scoring->PeptideRefMap_.insert(*pep_it);
+
+          thread_scoring->scorePeakgroups(transition_group, trafo, thread_swath_maps, thread_output);
+          trgroup_features[i].assign(std::make_move_iterator(thread_output.begin()), std::make_move_iterator(thread_output.end()));
+          thread_output.clear(true);
+        }
+        catch (...)
+        {
+          // exceptions must not leave the parallel region, rethrow the first one afterwards
+#ifdef _OPENMP
+#pragma omp critical (MRMFeatureFinderScoring_pickExperiment)
+#endif
+          if (!error) error = std::current_exception();
+        }
+      }
     }
     endProgress();
+    if (error) std::rethrow_exception(error);
+
+    for (std::vector<Feature>& features : trgroup_features)
+    {
+      for (Feature& feature : features)
+      {
+        output.push_back(std::move(feature));
+      }
+    }
 
     //output.sortByPosition(); // if the exact same order is needed
     return;
@@ -259,6 +355,7 @@ namespace OpenMS
 
   void MRMFeatureFinderScoring::prepareProteinPeptideMaps_(const OpenSwath::LightTargetedExperiment& transition_exp)
   {
+    PeptideRefMap_.reserve(PeptideRefMap_.size() + transition_exp.getCompounds().size());
     for (Size i = 0; i < transition_exp.getCompounds().size(); i++)
     {
       PeptideRefMap_[transition_exp.getCompounds()[i].id] = &transition_exp.getCompounds()[i];
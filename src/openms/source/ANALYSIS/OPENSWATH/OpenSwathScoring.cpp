@@ -385,27 +385,33 @@ namespace OpenMS
       }
     }
 
+    // check that the MS1 feature is present and that the MS1 MI should be calculated
+    const bool use_ms1_mi = imrmfeature->getPrecursorIDs().size() > 0 && su_.use_ms1_mi;
+    if (use_ms1_mi)
+    {
+      // the combined MS1 matrix contains all other MI matrices, rank each chromatogram only once
+      mrmscore_.initializeMIMatrices(imrmfeature, native_ids, precursor_ids);
+    }
+    else if (su_.use_mi_score_)
+    {
+      mrmscore_.initializeMIMatrix(imrmfeature, native_ids);
+    }
+
     // Mutual information scoring
     if (su_.use_mi_score_)
     {
-      mrmscore_.initializeMIMatrix(imrmfeature, native_ids);
       scores.mi_score = mrmscore_.calcMIScore();
       scores.weighted_mi_score = mrmscore_.calcMIWeightedScore(normalized_library_intensity);
     }
 
-    // check that the MS1 feature is present and that the MS1 MI should be calculated
-    if (imrmfeature->getPrecursorIDs().size() > 0 && su_.use_ms1_mi)
+    if (use_ms1_mi)
     {
       // we need at least two precursor isotopes
       if (precursor_ids.size() > 1)
       {
-        mrmscore_.initializeMIPrecursorMatrix(imrmfeature, precursor_ids);
         scores.ms1_mi_score = mrmscore_.calcMIPrecursorScore();
       }
-      mrmscore_.initializeMIPrecursorContrastMatrix(imrmfeature, precursor_ids, native_ids);
       scores.ms1_mi_contrast_score = mrmscore_.calcMIPrecursorContrastScore();
-
-      mrmscore_.initializeMIPrecursorCombinedMatrix(imrmfeature, precursor_ids, native_ids);
       scores.ms1_mi_combined_score = mrmscore_.calcMIPrecursorCombinedScore();
     }
   }
@@ -34,6 +34,11 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathWorkflow.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionLibraryIndex.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
 // OpenSwathCalibrationWorkflow
 namespace OpenMS
 {
@@ -454,6 +459,50 @@ namespace OpenMS
     int ms1_isotopes,
     bool load_into_memory)
   {
+    performExtraction_(swath_maps, trafo, cp, cp_ms1, feature_finder_param, &transition_exp, nullptr,
+        out_featureFile, store_features, tsv_writer, osw_writer, chromConsumer, batchSize, ms1_isotopes, load_into_memory);
+  }
+
+  void OpenSwathWorkflow::performExtraction(
+    const std::vector< OpenSwath::SwathMap > & swath_maps,
+    const TransformationDescription trafo,
+    const ChromExtractParams & cp,
+    const ChromExtractParams & cp_ms1,
+    const Param & feature_finder_param,
+    const MappedTransitionLibrary& library,
+    FeatureMap& out_featureFile,
+    bool store_features,
+    OpenSwathTSVWriter & tsv_writer,
+    OpenSwathOSWWriter & osw_writer,
+    Interfaces::IMSDataConsumer * chromConsumer,
+    int batchSize,
+    int ms1_isotopes,
+    bool load_into_memory)
+  {
+    performExtraction_(swath_maps, trafo, cp, cp_ms1, feature_finder_param, nullptr, &library,
+        out_featureFile, store_features, tsv_writer, osw_writer, chromConsumer, batchSize, ms1_isotopes, load_into_memory);
+  }
+
+  void OpenSwathWorkflow::performExtraction_(
+    const std::vector< OpenSwath::SwathMap > & swath_maps,
+    const TransformationDescription& trafo,
+    const ChromExtractParams & cp,
+    const ChromExtractParams & cp_ms1,
+    const Param & feature_finder_param,
+    const OpenSwath::LightTargetedExperiment* transition_exp,
+    const MappedTransitionLibrary* library,
+    FeatureMap& out_featureFile,
+    bool store_features,
+    OpenSwathTSVWriter & tsv_writer,
+    OpenSwathOSWWriter & osw_writer,
+    Interfaces::IMSDataConsumer * chromConsumer,
+    int batchSize,
+    int ms1_isotopes,
+    bool load_into_memory)
+  {
+    OPENMS_PRECONDITION((transition_exp != nullptr) != (library != nullptr), "Either a transition list or a mapped library needs to be given")
+    const Size nr_transitions = (library != nullptr) ? library->getNrTransitions() : transition_exp->transitions.size();
+
     tsv_writer.writeHeader();
     osw_writer.writeHeader();
 
@@ -463,7 +512,7 @@ namespace OpenMS
     TransformationDescription trafo_inverse = trafo;
     trafo_inverse.invert();
 
-    std::cout << "Will analyze " << transition_exp.transitions.size() << " transitions in total." << std::endl;
+    std::cout << "Will analyze " << nr_transitions << " transitions in total." << std::endl;
     int progress = 0;
     this->startProgress(0, swath_maps.size(), "Extracting and scoring transitions");
 
@@ -485,14 +534,24 @@ namespace OpenMS
     // (ii) Precursor extraction only
     if (ms1_only)
     {
+      // all precursors are extracted from the single MS1 map, so the complete library is needed
+      OpenSwath::LightTargetedExperiment transition_exp_used;
+      if (library != nullptr)
+      {
+        library->getLightTargetedExperiment(transition_exp_used);
+      }
+      else
+      {
+        transition_exp_used = *transition_exp;
+      }
+
       std::vector< MSChromatogram > ms1_chromatograms;
       MS1Extraction_(ms1_map_, swath_maps, ms1_chromatograms, chromConsumer, ms1_cp,
-                     transition_exp, trafo_inverse, ms1_only, ms1_isotopes);
+                     transition_exp_used, trafo_inverse, ms1_only, ms1_isotopes);
 
       FeatureMap featureFile;
       boost::shared_ptr<MSExperiment> empty_exp = boost::shared_ptr<MSExperiment>(new MSExperiment);
 
-      OpenSwath::LightTargetedExperiment transition_exp_used = transition_exp;
       scoreAllChromatograms_(std::vector<MSChromatogram>(), ms1_chromatograms, swath_maps, transition_exp_used, 
                             feature_finder_param, trafo,
                             cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes, true);
@@ -502,6 +561,14 @@ namespace OpenMS
       writeOutFeaturesAndChroms_(chromatograms, featureFile, out_featureFile, store_features, chromConsumer);
     }
 
+    // integer index over the references of the library, built once and shared by all windows
+    // (a mapped library has its own index)
+    TransitionLibraryIndex library_index;
+    if (transition_exp != nullptr)
+    {
+      library_index.build(*transition_exp);
+    }
+
     std::vector<int> prm_map;
     if (prm_)
     {
@@ -509,24 +576,24 @@ namespace OpenMS
       // each peptide from a single window and we assume that PRM windows are
       // centered around the target peptide. We therefore select for each peptide
       // the best-matching PRM / DIA window:
-      prm_map.resize(transition_exp.transitions.size(), -1);
+      prm_map.resize(nr_transitions, -1);
       for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
       {
-        for (Size k = 0; k < transition_exp.transitions.size(); k++)
+        for (Size k = 0; k < nr_transitions; k++)
         {
-          const OpenSwath::LightTransition& tr = transition_exp.transitions[k];
+          const double precursor_mz = (library != nullptr) ? library->getPrecursorMZs()[k] : transition_exp->transitions[k].getPrecursorMZ();
 
           // If the transition falls inside the current PRM / DIA window, check
           // if the window is potentially a better match for extraction than
           // the one previously stored in the map:
-          if (swath_maps[i].lower < tr.getPrecursorMZ() && tr.getPrecursorMZ() < swath_maps[i].upper &&
-              std::fabs(swath_maps[i].upper - tr.getPrecursorMZ()) >= cp.min_upper_edge_dist)
+          if (swath_maps[i].lower < precursor_mz && precursor_mz < swath_maps[i].upper &&
+              std::fabs(swath_maps[i].upper - precursor_mz) >= cp.min_upper_edge_dist)
           {
 
             if (prm_map[k] == -1) prm_map[k] = i;
             if (
-                std::fabs(swath_maps[ prm_map[k] ].center - tr.getPrecursorMZ() ) > 
-                std::fabs(swath_maps[ i ].center - tr.getPrecursorMZ() ) )
+                std::fabs(swath_maps[ prm_map[k] ].center - precursor_mz ) > 
+                std::fabs(swath_maps[ i ].center - precursor_mz ) )
             {
               // current PRM / DIA window "i" is a better match
               prm_map[k] = i;
@@ -568,41 +635,32 @@ namespace OpenMS
         if (!prm_)
         {
           // Step 1.1: select transitions matching the window
-          OpenSwathHelper::selectSwathTransitions(transition_exp, transition_exp_used_all,
-              cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+          if (library != nullptr)
+          {
+            library->selectSwathTransitions(transition_exp_used_all,
+                cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+          }
+          else
+          {
+            library_index.selectSwathTransitions(*transition_exp, transition_exp_used_all,
+                cp.min_upper_edge_dist, swath_maps[i].lower, swath_maps[i].upper);
+          }
         }
         else
         {
           // Step 1.2: select transitions based on matching PRM window (best window)
-          std::set<std::string> matching_compounds;
+          std::vector<Size> matching_transitions;
           for (Size k = 0; k < prm_map.size(); k++)
           {
-            if (prm_map[k] == i)
-            {
-               const OpenSwath::LightTransition& tr = transition_exp.transitions[k];
-               transition_exp_used_all.transitions.push_back(tr);
-               matching_compounds.insert(tr.getPeptideRef());
-            }
+            if (prm_map[k] == i) matching_transitions.push_back(k);
           }
-
-          std::set<std::string> matching_proteins;
-          for (Size i = 0; i < transition_exp.compounds.size(); i++)
+          if (library != nullptr)
           {
-            if (matching_compounds.find(transition_exp.compounds[i].id) != matching_compounds.end())
-            {
-              transition_exp_used_all.compounds.push_back( transition_exp.compounds[i] );
-              for (Size j = 0; j < transition_exp.compounds[i].protein_refs.size(); j++)
-              {
-                matching_proteins.insert(transition_exp.compounds[i].protein_refs[j]);
-              }
-            }
+            library->selectTransitions(matching_transitions, transition_exp_used_all);
           }
-          for (Size i = 0; i < transition_exp.proteins.size(); i++)
+          else
           {
-            if (matching_proteins.find(transition_exp.proteins[i].id) != matching_proteins.end())
-            {
-              transition_exp_used_all.proteins.push_back( transition_exp.proteins[i] );
-            }
+            library_index.selectTransitions(*transition_exp, matching_transitions, transition_exp_used_all);
           }
         }
 
@@ -856,20 +914,23 @@ namespace OpenMS
     featureFinder.prepareProteinPeptideMaps_(transition_exp);
 
     // Map ms1 chromatogram id to sequence number
-    std::map<String, int> ms1_chromatogram_map;
+    std::unordered_map<String, int> ms1_chromatogram_map;
+    ms1_chromatogram_map.reserve(ms1_chromatograms.size());
     for (Size i = 0; i < ms1_chromatograms.size(); i++)
     {
       ms1_chromatogram_map[ms1_chromatograms[i].getNativeID()] = boost::numeric_cast<int>(i);
     }
 
     // Map chromatogram id to sequence number
-    std::map<String, int> chromatogram_map;
+    std::unordered_map<String, int> chromatogram_map;
+    chromatogram_map.reserve(ms2_chromatograms.size());
     for (Size i = 0; i < ms2_chromatograms.size(); i++)
     {
       chromatogram_map[ms2_chromatograms[i].getNativeID()] = boost::numeric_cast<int>(i);
     }
     // Map peptide id to sequence number
-    std::map<String, int> assay_peptide_map;
+    std::unordered_map<String, int> assay_peptide_map;
+    assay_peptide_map.reserve(transition_exp.getCompounds().size());
     for (Size i = 0; i < transition_exp.getCompounds().size(); i++)
     {
       assay_peptide_map[transition_exp.getCompounds()[i].id] = boost::numeric_cast<int>(i);
@@ -916,14 +977,15 @@ namespace OpenMS
         // the transitions)
         if (ms1only) {continue;}
 
-        if (chromatogram_map.find(transition->getNativeID()) == chromatogram_map.end())
+        const auto chrom_it = chromatogram_map.find(transition->getNativeID());
+        if (chrom_it == chromatogram_map.end())
         {
           throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
               "Error, did not find chromatogram for transition " + transition->getNativeID() );
         }
 
         // Convert chromatogram to MSChromatogram and filter
-        auto chromatogram = ms2_chromatograms[ chromatogram_map[transition->getNativeID()] ];
+        auto chromatogram = ms2_chromatograms[ chrom_it->second ];
         chromatogram.setNativeID(transition->getNativeID());
         if (rt_extraction_window > 0)
         {
@@ -950,9 +1012,10 @@ namespace OpenMS
       for (int iso = 0; iso <= nr_ms1_isotopes; iso++)
       {
         String prec_id = OpenSwathHelper::computePrecursorId(transition_group.getTransitionGroupID(), iso);
-        if (!ms1_chromatograms.empty() && ms1_chromatogram_map.find(prec_id) != ms1_chromatogram_map.end())
+        const auto ms1_chrom_it = ms1_chromatogram_map.find(prec_id);
+        if (ms1_chrom_it != ms1_chromatogram_map.end())
         {
-          MSChromatogram chromatogram = ms1_chromatograms[ ms1_chromatogram_map[prec_id] ];
+          MSChromatogram chromatogram = ms1_chromatograms[ ms1_chrom_it->second ];
           transition_group.addPrecursorChromatogram(chromatogram, chromatogram.getNativeID());
         }
       }
@@ -1032,7 +1095,8 @@ namespace OpenMS
     const std::vector<OpenSwath::LightTransition>& all_transitions,
     std::vector<OpenSwath::LightTransition>& output)
   {
-    std::set<std::string> selected_compounds;
+    std::unordered_set<std::string> selected_compounds;
+    selected_compounds.reserve(used_compounds.size());
     for (Size i = 0; i < used_compounds.size(); i++)
     {
       selected_compounds.insert(used_compounds[i].id);
@@ -0,0 +1,314 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinFile.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/MappedTransitionLibrary.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+
+namespace OpenMS
+{
+  const char TransitionBinFile::MAGIC[8] = {'O', 'M', 'S', 'T', 'R', 'L', 'I', 'B'};
+
+  const UInt32 TransitionBinFile::VERSION = 1;
+
+  const UInt32 TransitionBinFile::BYTE_ORDER_MARK = 0x01020304;
+
+  namespace
+  {
+    /// Writes the columns of a binary transition library and records their position in the column directory
+    class ColumnWriter
+    {
+public:
+      ColumnWriter(std::ostream& os, std::vector<TransitionBinFile::ColumnEntry>& directory) :
+        os_(os),
+        directory_(directory)
+      {
+      }
+
+      template <typename T>
+      void writeColumn(TransitionBinFile::Column column, const std::vector<T>& values)
+      {
+        static_assert(std::is_arithmetic<T>::value, "only arrays of arithmetic types can be written directly");
+        beginColumn_(column);
+        if (!values.empty()) os_.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+        endColumn_(column);
+      }
+
+      /// Writes the strings get(0), ..., get(n - 1) as string table (offsets in @p offsets_column, characters in the next column)
+      template <typename Getter>
+      void writeStrings(TransitionBinFile::Column offsets_column, Size n, Getter get)
+      {
+        std::vector<UInt64> offsets(n + 1, 0);
+        for (Size i = 0; i < n; ++i)
+        {
+          offsets[i + 1] = offsets[i] + get(i).size();
+        }
+        writeColumn(offsets_column, offsets);
+
+        TransitionBinFile::Column data_column = TransitionBinFile::Column(offsets_column + 1);
+        beginColumn_(data_column);
+        for (Size i = 0; i < n; ++i)
+        {
+          const std::string& s = get(i);
+          os_.write(s.data(), s.size());
+        }
+        endColumn_(data_column);
+      }
+
+private:
+      void beginColumn_(TransitionBinFile::Column column)
+      {
+        // align every column to 8 bytes so it can be used in place after mapping the file
+        const char padding[8] = {0};
+        UInt64 pos = os_.tellp();
+        if (pos % 8 != 0) os_.write(padding, 8 - pos % 8);
+        directory_[column].offset = os_.tellp();
+      }
+
+      void endColumn_(TransitionBinFile::Column column)
+      {
+        directory_[column].size = UInt64(os_.tellp()) - directory_[column].offset;
+      }
+
+      std::ostream& os_;
+      std::vector<TransitionBinFile::ColumnEntry>& directory_;
+    };
+  }
+
+  TransitionBinFile::TransitionBinFile() :
+    ProgressLogger()
+  {
+  }
+
+  TransitionBinFile::~TransitionBinFile() = default;
+
+  void TransitionBinFile::store(const String& filename, const OpenSwath::LightTargetedExperiment& transition_exp)
+  {
+    const std::vector<OpenSwath::LightTransition>& transitions = transition_exp.getTransitions();
+    const std::vector<OpenSwath::LightCompound>& compounds = transition_exp.getCompounds();
+    const std::vector<OpenSwath::LightProtein>& proteins = transition_exp.getProteins();
+
+    if (transitions.size() >= std::numeric_limits<UInt32>::max() || compounds.size() >= std::numeric_limits<UInt32>::max())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Binary transition libraries are limited to 2^32 - 1 transitions and compounds.");
+    }
+
+    // link transitions to their compound by index (the first compound with a given identifier)
+    std::unordered_map<std::string, UInt32> compound_index;
+    compound_index.reserve(compounds.size());
+    for (Size i = 0; i < compounds.size(); ++i)
+    {
+      compound_index.emplace(compounds[i].id, UInt32(i));
+    }
+    std::vector<UInt32> transition_compound(transitions.size());
+    for (Size i = 0; i < transitions.size(); ++i)
+    {
+      auto it = compound_index.find(transitions[i].peptide_ref);
+      if (it == compound_index.end())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Transition '" + transitions[i].transition_name + "' refers to compound '" + transitions[i].peptide_ref +
+          "' which is not part of the library.");
+      }
+      transition_compound[i] = it->second;
+    }
+    compound_index.clear();
+
+    std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    startProgress(0, SIZE_OF_COLUMN, "Storing binary transition library");
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.byte_order_mark = BYTE_ORDER_MARK;
+    header.nr_transitions = transitions.size();
+    header.nr_compounds = compounds.size();
+    header.nr_proteins = proteins.size();
+    header.nr_columns = SIZE_OF_COLUMN;
+
+    // header and directory are written again once the column positions are known
+    std::vector<ColumnEntry> directory(SIZE_OF_COLUMN, ColumnEntry{0, 0});
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    os.write(reinterpret_cast<const char*>(&directory[0]), directory.size() * sizeof(ColumnEntry));
+
+    ColumnWriter writer(os, directory);
+
+    // transitions
+    {
+      std::vector<double> values(transitions.size());
+      for (Size i = 0; i < transitions.size(); ++i) values[i] = transitions[i].precursor_mz;
+      writer.writeColumn(TRANSITION_PRECURSOR_MZ, values);
+      for (Size i = 0; i < transitions.size(); ++i) values[i] = transitions[i].product_mz;
+      writer.writeColumn(TRANSITION_PRODUCT_MZ, values);
+      for (Size i = 0; i < transitions.size(); ++i) values[i] = transitions[i].library_intensity;
+      writer.writeColumn(TRANSITION_LIBRARY_INTENSITY, values);
+    }
+    {
+      std::vector<Int32> charges(transitions.size());
+      for (Size i = 0; i < transitions.size(); ++i) charges[i] = transitions[i].fragment_charge;
+      writer.writeColumn(TRANSITION_FRAGMENT_CHARGE, charges);
+    }
+    writer.writeColumn(TRANSITION_COMPOUND, transition_compound);
+    {
+      std::vector<unsigned char> flags(transitions.size(), 0);
+      for (Size i = 0; i < transitions.size(); ++i)
+      {
+        const OpenSwath::LightTransition& tr = transitions[i];
+        if (tr.decoy) flags[i] |= FLAG_DECOY;
+        if (tr.detecting_transition) flags[i] |= FLAG_DETECTING;
+        if (tr.quantifying_transition) flags[i] |= FLAG_QUANTIFYING;
+        if (tr.identifying_transition) flags[i] |= FLAG_IDENTIFYING;
+      }
+      writer.writeColumn(TRANSITION_FLAGS, flags);
+    }
+    writer.writeStrings(TRANSITION_NAME_OFFSETS, transitions.size(),
+      [&transitions](Size i) -> const std::string& { return transitions[i].transition_name; });
+    {
+      // transitions without a valid precursor m/z can never be selected and are left out of the index
+      std::vector<UInt32> by_precursor;
+      by_precursor.reserve(transitions.size());
+      for (Size i = 0; i < transitions.size(); ++i)
+      {
+        if (!std::isnan(transitions[i].precursor_mz)) by_precursor.push_back(UInt32(i));
+      }
+      std::stable_sort(by_precursor.begin(), by_precursor.end(),
+        [&transitions](UInt32 a, UInt32 b) { return transitions[a].precursor_mz < transitions[b].precursor_mz; });
+      writer.writeColumn(TRANSITION_BY_PRECURSOR_MZ, by_precursor);
+    }
+    setProgress(TRANSITION_BY_PRECURSOR_MZ);
+
+    // compounds
+    {
+      std::vector<double> values(compounds.size());
+      for (Size i = 0; i < compounds.size(); ++i) values[i] = compounds[i].rt;
+      writer.writeColumn(COMPOUND_RT, values);
+      for (Size i = 0; i < compounds.size(); ++i) values[i] = compounds[i].drift_time;
+      writer.writeColumn(COMPOUND_DRIFT_TIME, values);
+    }
+    {
+      std::vector<Int32> charges(compounds.size());
+      for (Size i = 0; i < compounds.size(); ++i) charges[i] = compounds[i].charge;
+      writer.writeColumn(COMPOUND_CHARGE, charges);
+    }
+    writer.writeStrings(COMPOUND_ID_OFFSETS, compounds.size(),
+      [&compounds](Size i) -> const std::string& { return compounds[i].id; });
+    writer.writeStrings(COMPOUND_SEQUENCE_OFFSETS, compounds.size(),
+      [&compounds](Size i) -> const std::string& { return compounds[i].sequence; });
+    writer.writeStrings(COMPOUND_GROUP_LABEL_OFFSETS, compounds.size(),
+      [&compounds](Size i) -> const std::string& { return compounds[i].peptide_group_label; });
+    writer.writeStrings(COMPOUND_GENE_NAME_OFFSETS, compounds.size(),
+      [&compounds](Size i) -> const std::string& { return compounds[i].gene_name; });
+    writer.writeStrings(COMPOUND_SUM_FORMULA_OFFSETS, compounds.size(),
+      [&compounds](Size i) -> const std::string& { return compounds[i].sum_formula; });
+    writer.writeStrings(COMPOUND_NAME_OFFSETS, compounds.size(),
+      [&compounds](Size i) -> const std::string& { return compounds[i].compound_name; });
+    {
+      std::vector<UInt64> ranges(compounds.size() + 1, 0);
+      std::vector<const std::string*> refs;
+      for (Size i = 0; i < compounds.size(); ++i)
+      {
+        for (const std::string& ref : compounds[i].protein_refs) refs.push_back(&ref);
+        ranges[i + 1] = refs.size();
+      }
+      writer.writeColumn(COMPOUND_PROTEIN_REF_RANGES, ranges);
+      writer.writeStrings(COMPOUND_PROTEIN_REF_OFFSETS, refs.size(),
+        [&refs](Size i) -> const std::string& { return *refs[i]; });
+    }
+    {
+      std::vector<UInt64> ranges(compounds.size() + 1, 0);
+      std::vector<Int32> modifications;
+      for (Size i = 0; i < compounds.size(); ++i)
+      {
+        for (const OpenSwath::LightModification& mod : compounds[i].modifications)
+        {
+          modifications.push_back(mod.location);
+          modifications.push_back(mod.unimod_id);
+        }
+        ranges[i + 1] = modifications.size() / 2;
+      }
+      writer.writeColumn(COMPOUND_MODIFICATION_RANGES, ranges);
+      writer.writeColumn(COMPOUND_MODIFICATIONS, modifications);
+    }
+    setProgress(COMPOUND_MODIFICATIONS);
+
+    // proteins
+    writer.writeStrings(PROTEIN_ID_OFFSETS, proteins.size(),
+      [&proteins](Size i) -> const std::string& { return proteins[i].id; });
+    writer.writeStrings(PROTEIN_SEQUENCE_OFFSETS, proteins.size(),
+      [&proteins](Size i) -> const std::string& { return proteins[i].sequence; });
+
+    os.seekp(0);
+    os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    os.write(reinterpret_cast<const char*>(&directory[0]), directory.size() * sizeof(ColumnEntry));
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing the file.");
+    }
+    endProgress();
+  }
+
+  void TransitionBinFile::load(const String& filename, OpenSwath::LightTargetedExperiment& transition_exp)
+  {
+    startProgress(0, 1, "Loading binary transition library");
+    MappedTransitionLibrary library(filename);
+    transition_exp = OpenSwath::LightTargetedExperiment();
+    library.getLightTargetedExperiment(transition_exp);
+    endProgress();
+  }
+
+  bool TransitionBinFile::isTransitionBinFile(const String& filename)
+  {
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+    char magic[8] = {0};
+    is.read(magic, sizeof(magic));
+    return is.gcount() == sizeof(magic) && std::memcmp(magic, MAGIC, sizeof(magic)) == 0;
+  }
+
+} // namespace OpenMS
@@ -0,0 +1,267 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionLibraryIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace OpenMS
+{
+  const Size TransitionLibraryIndex::NOT_FOUND = std::numeric_limits<Size>::max();
+  const UInt32 TransitionLibraryIndex::NOT_FOUND_KEY_ = std::numeric_limits<UInt32>::max();
+
+  TransitionLibraryIndex::TransitionLibraryIndex() :
+    nr_transitions_(0),
+    nr_compounds_(0),
+    nr_proteins_(0)
+  {
+    compound_offsets_.assign(1, 0);
+    compound_protein_offsets_.assign(1, 0);
+    protein_offsets_.assign(1, 0);
+  }
+
+  TransitionLibraryIndex::TransitionLibraryIndex(const OpenSwath::LightTargetedExperiment& library) :
+    TransitionLibraryIndex()
+  {
+    build(library);
+  }
+
+  UInt32 TransitionLibraryIndex::intern_(const std::string& id, std::unordered_map<std::string, UInt32>& keys)
+  {
+    return keys.emplace(id, static_cast<UInt32>(keys.size())).first->second;
+  }
+
+  void TransitionLibraryIndex::group_(const std::vector<UInt32>& entry_keys, Size nr_keys, std::vector<Size>& offsets, std::vector<UInt32>& members)
+  {
+    // counting sort of the entries by key, entries of a key stay in ascending order
+    offsets.assign(nr_keys + 1, 0);
+    for (UInt32 key : entry_keys) ++offsets[key + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    members.resize(entry_keys.size());
+    std::vector<Size> insert_pos(offsets.begin(), offsets.end() - 1);
+    for (Size i = 0; i < entry_keys.size(); ++i)
+    {
+      members[insert_pos[entry_keys[i]]++] = static_cast<UInt32>(i);
+    }
+  }
+
+  void TransitionLibraryIndex::build(const OpenSwath::LightTargetedExperiment& library)
+  {
+    if (library.transitions.size() >= NOT_FOUND_KEY_ || library.compounds.size() >= NOT_FOUND_KEY_ || library.proteins.size() >= NOT_FOUND_KEY_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Transition library is too large to be indexed.");
+    }
+
+    nr_transitions_ = library.transitions.size();
+    nr_compounds_ = library.compounds.size();
+    nr_proteins_ = library.proteins.size();
+
+    // proteins
+    protein_keys_.clear();
+    protein_keys_.reserve(nr_proteins_);
+    std::vector<UInt32> protein_entry_keys(nr_proteins_);
+    for (Size i = 0; i < nr_proteins_; ++i)
+    {
+      protein_entry_keys[i] = intern_(library.proteins[i].id, protein_keys_);
+    }
+    group_(protein_entry_keys, protein_keys_.size(), protein_offsets_, protein_members_);
+
+    // compounds and their protein references
+    compound_keys_.clear();
+    compound_keys_.reserve(nr_compounds_);
+    std::vector<UInt32> compound_entry_keys(nr_compounds_);
+    compound_protein_offsets_.assign(1, 0);
+    compound_protein_offsets_.reserve(nr_compounds_ + 1);
+    compound_proteins_.clear();
+    for (Size i = 0; i < nr_compounds_; ++i)
+    {
+      const OpenSwath::LightCompound& compound = library.compounds[i];
+      compound_entry_keys[i] = intern_(compound.id, compound_keys_);
+      for (const std::string& ref : compound.protein_refs)
+      {
+        auto it = protein_keys_.find(ref);
+        if (it != protein_keys_.end()) compound_proteins_.push_back(it->second);
+      }
+      compound_protein_offsets_.push_back(compound_proteins_.size());
+    }
+    group_(compound_entry_keys, compound_keys_.size(), compound_offsets_, compound_members_);
+
+    // transitions
+    transition_compound_keys_.resize(nr_transitions_);
+    precursor_order_.clear();
+    for (Size i = 0; i < nr_transitions_; ++i)
+    {
+      auto it = compound_keys_.find(library.transitions[i].peptide_ref);
+      transition_compound_keys_[i] = (it != compound_keys_.end()) ? it->second : NOT_FOUND_KEY_;
+      // transitions without a valid precursor m/z never fall into a window
+      if (!std::isnan(library.transitions[i].precursor_mz)) precursor_order_.push_back(static_cast<UInt32>(i));
+    }
+    std::stable_sort(precursor_order_.begin(), precursor_order_.end(), [&library](UInt32 a, UInt32 b)
+    {
+      return library.transitions[a].precursor_mz < library.transitions[b].precursor_mz;
+    });
+    precursor_mzs_.resize(precursor_order_.size());
+    for (Size i = 0; i < precursor_order_.size(); ++i)
+    {
+      precursor_mzs_[i] = library.transitions[precursor_order_[i]].precursor_mz;
+    }
+  }
+
+  Size TransitionLibraryIndex::getNrTransitions() const
+  {
+    return nr_transitions_;
+  }
+
+  Size TransitionLibraryIndex::getNrCompounds() const
+  {
+    return nr_compounds_;
+  }
+
+  Size TransitionLibraryIndex::getNrProteins() const
+  {
+    return nr_proteins_;
+  }
+
+  Size TransitionLibraryIndex::getCompoundIndex(const std::string& id) const
+  {
+    auto it = compound_keys_.find(id);
+    return (it != compound_keys_.end()) ? compound_members_[compound_offsets_[it->second]] : NOT_FOUND;
+  }
+
+  Size TransitionLibraryIndex::getProteinIndex(const std::string& id) const
+  {
+    auto it = protein_keys_.find(id);
+    return (it != protein_keys_.end()) ? protein_members_[protein_offsets_[it->second]] : NOT_FOUND;
+  }
+
+  Size TransitionLibraryIndex::getTransitionCompound(Size transition_index) const
+  {
+    OPENMS_PRECONDITION(transition_index < nr_transitions_, "Transition index out of range")
+    const UInt32 key = transition_compound_keys_[transition_index];
+    return (key != NOT_FOUND_KEY_) ? compound_members_[compound_offsets_[key]] : NOT_FOUND;
+  }
+
+  std::vector<Size> TransitionLibraryIndex::getCompoundProteins(Size compound_index) const
+  {
+    OPENMS_PRECONDITION(compound_index < nr_compounds_, "Compound index out of range")
+    std::vector<Size> proteins;
+    for (Size r = compound_protein_offsets_[compound_index]; r < compound_protein_offsets_[compound_index + 1]; ++r)
+    {
+      proteins.push_back(protein_members_[protein_offsets_[compound_proteins_[r]]]);
+    }
+    return proteins;
+  }
+
+  void TransitionLibraryIndex::selectCompounds_(const OpenSwath::LightTargetedExperiment& library, std::vector<UInt32>& compound_keys,
+                                                OpenSwath::LightTargetedExperiment& selected) const
+  {
+    std::sort(compound_keys.begin(), compound_keys.end());
+    compound_keys.erase(std::unique(compound_keys.begin(), compound_keys.end()), compound_keys.end());
+    if (!compound_keys.empty() && compound_keys.back() == NOT_FOUND_KEY_) compound_keys.pop_back();
+
+    // all compounds with a matching identifier, in library order
+    std::vector<UInt32> compounds;
+    for (UInt32 key : compound_keys)
+    {
+      compounds.insert(compounds.end(), compound_members_.begin() + compound_offsets_[key], compound_members_.begin() + compound_offsets_[key + 1]);
+    }
+    std::sort(compounds.begin(), compounds.end());
+
+    std::vector<UInt32> protein_keys;
+    selected.compounds.reserve(selected.compounds.size() + compounds.size());
+    for (UInt32 c : compounds)
+    {
+      selected.compounds.push_back(library.compounds[c]);
+      protein_keys.insert(protein_keys.end(), compound_proteins_.begin() + compound_protein_offsets_[c], compound_proteins_.begin() + compound_protein_offsets_[c + 1]);
+    }
+    std::sort(protein_keys.begin(), protein_keys.end());
+    protein_keys.erase(std::unique(protein_keys.begin(), protein_keys.end()), protein_keys.end());
+
+    // all proteins with a matching identifier, in library order
+    std::vector<UInt32> proteins;
+    for (UInt32 key : protein_keys)
+    {
+      proteins.insert(proteins.end(), protein_members_.begin() + protein_offsets_[key], protein_members_.begin() + protein_offsets_[key + 1]);
+    }
+    std::sort(proteins.begin(), proteins.end());
+    selected.proteins.reserve(selected.proteins.size() + proteins.size());
+    for (UInt32 p : proteins)
+    {
+      selected.proteins.push_back(library.proteins[p]);
+    }
+  }
+
+  void TransitionLibraryIndex::selectTransitions(const OpenSwath::LightTargetedExperiment& library, const std::vector<Size>& transition_indices,
+                                                 OpenSwath::LightTargetedExperiment& selected) const
+  {
+    OPENMS_PRECONDITION(library.transitions.size() == nr_transitions_ && library.compounds.size() == nr_compounds_ && library.proteins.size() == nr_proteins_,
+                        "Index was built for a different library")
+    OPENMS_PRECONDITION(std::is_sorted(transition_indices.begin(), transition_indices.end()), "Transition indices need to be sorted")
+
+    std::vector<UInt32> compound_keys;
+    compound_keys.reserve(transition_indices.size());
+    selected.transitions.reserve(selected.transitions.size() + transition_indices.size());
+    for (Size t : transition_indices)
+    {
+      selected.transitions.push_back(library.transitions[t]);
+      compound_keys.push_back(transition_compound_keys_[t]);
+    }
+    selectCompounds_(library, compound_keys, selected);
+  }
+
+  void TransitionLibraryIndex::selectSwathTransitions(const OpenSwath::LightTargetedExperiment& library, OpenSwath::LightTargetedExperiment& selected,
+                                                      double min_upper_edge_dist, double lower, double upper) const
+  {
+    // transitions with lower < precursor m/z < upper
+    auto first = std::upper_bound(precursor_mzs_.begin(), precursor_mzs_.end(), lower);
+    auto last = std::lower_bound(first, precursor_mzs_.end(), upper);
+
+    std::vector<Size> transition_indices;
+    for (auto it = first; it != last; ++it)
+    {
+      if (std::fabs(upper - *it) >= min_upper_edge_dist)
+      {
+        transition_indices.push_back(precursor_order_[it - precursor_mzs_.begin()]);
+      }
+    }
+    std::sort(transition_indices.begin(), transition_indices.end());
+    selectTransitions(library, transition_indices, selected);
+  }
+
+} // namespace OpenMS
@@ -36,6 +36,8 @@ set(sources_list
   SwathQC.cpp
   SpectrumAddition.cpp
   TargetedSpectraExtractor.cpp
+  TransitionBinFile.cpp
+  TransitionLibraryIndex.cpp
   TransitionTSVFile.cpp
   TransitionPQPFile.cpp
 )
@@ -314,7 +314,7 @@ namespace OpenMS
       createProteinReferenceMap_();
     }
     OPENMS_PRECONDITION(protein_reference_map_.find(ref) != protein_reference_map_.end(), "Could not find protein in map")
-    return *(protein_reference_map_[ref]);
+    return *(protein_reference_map_.find(ref)->second);
   }
 
   bool TargetedExperiment::hasProtein(const String & ref) const
@@ -334,6 +334,7 @@ namespace OpenMS
 
   void TargetedExperiment::setCompounds(const std::vector<Compound> & compounds)
   {
+    compound_reference_map_dirty_ = true;
     compounds_ = compounds;
   }
 
@@ -344,6 +345,7 @@ namespace OpenMS
 
   void TargetedExperiment::addCompound(const Compound & rhs)
   {
+    compound_reference_map_dirty_ = true;
     compounds_.push_back(rhs);
   }
 
@@ -365,7 +367,7 @@ namespace OpenMS
       createPeptideReferenceMap_();
     }
     OPENMS_PRECONDITION(hasPeptide(ref), "Cannot return peptide that does not exist, check with hasPeptide() first")
-    return *(peptide_reference_map_[ref]);
+    return *(peptide_reference_map_.find(ref)->second);
   }
 
   const TargetedExperiment::Compound & TargetedExperiment::getCompoundByRef(const String & ref) const
@@ -375,7 +377,7 @@ namespace OpenMS
       createCompoundReferenceMap_();
     }
     OPENMS_PRECONDITION(hasCompound(ref), "Cannot return compound that does not exist, check with hasCompound() first")
-    return *(compound_reference_map_[ref]);
+    return *(compound_reference_map_.find(ref)->second);
   }
 
   bool TargetedExperiment::hasPeptide(const String & ref) const
@@ -571,6 +573,8 @@ namespace OpenMS
 
   void TargetedExperiment::createProteinReferenceMap_() const
   {
+    protein_reference_map_.clear();
+    protein_reference_map_.reserve(getProteins().size());
     for (Size i = 0; i < getProteins().size(); i++)
     {
       protein_reference_map_[getProteins()[i].id] = &getProteins()[i];
@@ -580,6 +584,8 @@ namespace OpenMS
 
   void TargetedExperiment::createPeptideReferenceMap_() const
   {
+    peptide_reference_map_.clear();
+    peptide_reference_map_.reserve(getPeptides().size());
     for (Size i = 0; i < getPeptides().size(); i++)
     {
       peptide_reference_map_[getPeptides()[i].id] = &getPeptides()[i];
@@ -589,6 +595,8 @@ namespace OpenMS
 
   void TargetedExperiment::createCompoundReferenceMap_() const
   {
+    compound_reference_map_.clear();
+    compound_reference_map_.reserve(getCompounds().size());
     for (Size i = 0; i < getCompounds().size(); i++)
     {
       compound_reference_map_[getCompounds()[i].id] = &getCompounds()[i];
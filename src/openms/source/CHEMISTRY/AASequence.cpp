@@ -42,12 +42,95 @@
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/CONCEPT/PrecisionWrapper.h>
 
+#include <atomic>
 #include <cmath>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      @brief Process-wide cache of parsed sequences used by AASequence::fromString
+
+      The cache is split into shards (selected by the hash of the input
+      string) which are locked independently, so that parallel parsing does
+      not serialize on a single lock.
+    */
+    class AASequenceParseCache
+    {
+    public:
+      static AASequenceParseCache& getInstance()
+      {
+        static AASequenceParseCache cache;
+        return cache;
+      }
+
+      bool isEnabled() const
+      {
+        return enabled_.load(std::memory_order_relaxed);
+      }
+
+      void setEnabled(bool enabled, Size max_size)
+      {
+        max_shard_size_.store(std::max(Size(1), max_size / SHARD_COUNT));
+        enabled_.store(enabled);
+        if (!enabled) clear();
+      }
+
+      void clear()
+      {
+        for (Shard& shard : shards_)
+        {
+          std::lock_guard<std::mutex> lock(shard.mutex);
+          shard.sequences[0].clear();
+          shard.sequences[1].clear();
+        }
+      }
+
+      /// Looks up @p s; returns true and sets @p aas if the sequence was parsed before
+      bool find(const String& s, bool permissive, AASequence& aas)
+      {
+        Shard& shard = getShard_(s);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto& sequences = shard.sequences[permissive];
+        auto it = sequences.find(s);
+        if (it == sequences.end()) return false;
+        aas = it->second;
+        return true;
+      }
+
+      void insert(const String& s, bool permissive, const AASequence& aas)
+      {
+        Shard& shard = getShard_(s);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto& sequences = shard.sequences[permissive];
+        if (sequences.size() >= max_shard_size_.load(std::memory_order_relaxed)) sequences.clear(); // keep memory bounded
+        sequences.emplace(s, aas);
+      }
+
+    private:
+      static const Size SHARD_COUNT = 64;
+
+      struct Shard
+      {
+        std::mutex mutex;
+        std::unordered_map<String, AASequence> sequences[2]; // by value of 'permissive'
+      };
+
+      Shard& getShard_(const String& s)
+      {
+        return shards_[std::hash<String>()(s) % SHARD_COUNT];
+      }
+
+      std::atomic<bool> enabled_{false};
+      std::atomic<Size> max_shard_size_{1};
+      Shard shards_[SHARD_COUNT];
+    };
+  }
 
   const ResidueModification* proteinTerminalResidueHelper( ModificationsDB* mod_db,
       const char term,
@@ -1470,15 +1553,37 @@ namespace OpenMS
   AASequence AASequence::fromString(const String& s, bool permissive)
   {
     AASequence aas;
-    parseString_(s, aas, permissive);
+    AASequenceParseCache& cache = AASequenceParseCache::getInstance();
+    if (!cache.isEnabled())
+    {
+      parseString_(s, aas, permissive);
+    }
+    else if (!cache.find(s, permissive, aas))
+    {
+      parseString_(s, aas, permissive); // may throw, so invalid sequences are never cached
+      cache.insert(s, permissive, aas);
+    }
     return aas;
   }
 
   AASequence AASequence::fromString(const char* s, bool permissive)
   {
-    AASequence aas;
-    parseString_(String(s), aas, permissive);
-    return aas;
+    return fromString(String(s), permissive);
+  }
+
+  void AASequence::setParseCacheEnabled(bool enabled, Size max_size)
+  {
+    AASequenceParseCache::getInstance().setEnabled(enabled, max_size);
+  }
+
+  bool AASequence::isParseCacheEnabled()
+  {
+    return AASequenceParseCache::getInstance().isEnabled();
+  }
+
+  void AASequence::clearParseCache()
+  {
+    AASequenceParseCache::getInstance().clear();
   }
 
 }
@@ -356,6 +356,7 @@ namespace OpenMS
         }
       }
     }
+    publishLookupTables_();
   }
 
   void CrossLinksDB::getAllSearchModifications(vector<String>& modifications) const
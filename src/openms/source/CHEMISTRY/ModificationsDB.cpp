@@ -111,6 +111,7 @@ namespace OpenMS
     {
       readFromOBOFile(xlmod_file);
     }
+    publishLookupTables_();
     is_instantiated_ = true;
   }
 
@@ -128,14 +129,17 @@ namespace OpenMS
     return is_instantiated_;
   }
 
+  void ModificationsDB::publishLookupTables_()
+  {
+    auto tables = std::make_shared<LookupTables>();
+    tables->mods.assign(mods_.begin(), mods_.end());
+    tables->modification_names = modification_names_;
+    lookup_.publish(std::move(tables));
+  }
+
   Size ModificationsDB::getNumberOfModifications() const
   {
-    Size s;
-    #pragma omp critical (OpenMS_ModificationsDB)
-    {
-      s = mods_.size();
-    }
-    return s;
+    return lookup_.get().mods.size();
   }
 
   const ResidueModification* ModificationsDB::searchModificationsFast(const String& mod_name_,
@@ -152,49 +156,44 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
+    const auto& modification_names = lookup_.get().modification_names;
+    auto modifications = modification_names.find(mod_name);
+    if (modifications == modification_names.end())
     {
-      bool found = true;
-      auto modifications = modification_names_.find(mod_name);
-      if (modifications == modification_names_.end())
+      // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
+      if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
       {
-        // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
-        if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
-        {
-          mod_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
-        }
+        mod_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
+      }
 
-        modifications = modification_names_.find(mod_name);
-        if (modifications == modification_names_.end())
-        {
-          OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << mod_name << endl;
-          found = false; 
-        }
+      modifications = modification_names.find(mod_name);
+      if (modifications == modification_names.end())
+      {
+        OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << mod_name << endl;
+        return mod;
       }
+    }
 
-      int nr_mods = 0;
-      if (found)
+    int nr_mods = 0;
+    for (const auto& it : modifications->second)
+    {
+      if ( residuesMatch_(res, it) &&
+           (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
+           (term_spec == it->getTermSpecificity())))
       {
-        for (const auto& it : modifications->second)
-        {
-          if ( residuesMatch_(res, it) &&
-               (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
-               (term_spec == it->getTermSpecificity())))
-          {
-            mod = it;
-            nr_mods++;
-          }
-        }
+        mod = it;
+        nr_mods++;
       }
-      if (nr_mods > 1) multiple_matches = true;
     }
+    if (nr_mods > 1) multiple_matches = true;
     return mod;
   }
 
   const ResidueModification* ModificationsDB::getModification(Size index) const
   {
-    OPENMS_PRECONDITION(index < mods_.size(), "Index out of bounds in ModificationsDB::getModification(Size index)." );
-    return mods_[index];
+    const auto& mods = lookup_.get().mods;
+    OPENMS_PRECONDITION(index < mods.size(), "Index out of bounds in ModificationsDB::getModification(Size index)." );
+    return mods[index];
   }
 
   void ModificationsDB::searchModifications(set<const ResidueModification*>& mods,
@@ -209,39 +208,33 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
+    const auto& modification_names = lookup_.get().modification_names;
+    auto modifications = modification_names.find(mod_name);
+    if (modifications == modification_names.end())
     {
-      bool found = true;
-      auto modifications = modification_names_.find(mod_name);
-      if (modifications == modification_names_.end())
+      // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
+      if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
       {
-        // Try to fix things, Skyline for example uses unimod:10 and not UniMod:10 syntax
-        if (mod_name.size() > 6 && mod_name.prefix(6).toLower() == "unimod")
-        {
-          mod_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
-        }
+        mod_name = "UniMod" + mod_name.substr(6, mod_name.size() - 6);
+      }
 
-        modifications = modification_names_.find(mod_name);
-        if (modifications == modification_names_.end())
-        {
-          OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << mod_name << endl;
-          found = false; 
-        }
+      modifications = modification_names.find(mod_name);
+      if (modifications == modification_names.end())
+      {
+        OPENMS_LOG_WARN << OPENMS_PRETTY_FUNCTION << "Modification not found: " << mod_name << endl;
+        return;
       }
+    }
 
-      if (found)
+    for (const auto& it : modifications->second)
+    {
+      if ( residuesMatch_(res, it) &&
+           (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
+           (term_spec == it->getTermSpecificity())))
       {
-        for (const auto& it : modifications->second)
-        {
-          if ( residuesMatch_(res, it) &&
-               (term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY ||
-               (term_spec == it->getTermSpecificity())))
-          {
-            mods.insert(it);
-          }
-        }
+        mods.insert(it);
       }
-    } 
+    }
   }
 
   const ResidueModification* ModificationsDB::getModification(const String& mod_name, const String& residue, ResidueModification::TermSpecificity term_spec) const
@@ -278,53 +271,34 @@ namespace OpenMS
 
   bool ModificationsDB::has(const String & modification) const
   {
-    bool has_mod;
-    #pragma omp critical(OpenMS_ModificationsDB)
-    {
-      has_mod = (modification_names_.find(modification) != modification_names_.end());
-    }
-    return has_mod;
+    const auto& modification_names = lookup_.get().modification_names;
+    return modification_names.find(modification) != modification_names.end();
   }
 
   Size ModificationsDB::findModificationIndex(const String & mod_name) const
   {
-    if (!has(mod_name))
+    const LookupTables& lookup = lookup_.get();
+    auto modifications = lookup.modification_names.find(mod_name);
+    if (modifications == lookup.modification_names.end())
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: " + mod_name);
     }
 
-    bool one_mod(true);
-    #pragma omp critical(OpenMS_ModificationsDB)
-    {
-      if (modification_names_.find(mod_name)->second.size() > 1)
-      {
-        one_mod = false;
-      }
-    }
-    if (!one_mod) 
+    if (modifications->second.size() > 1)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "More than one modification with name: " + mod_name);
     }
 
-    Size index(numeric_limits<Size>::max());
-    #pragma omp critical(OpenMS_ModificationsDB)
+    const ResidueModification* mod = *(modifications->second.begin());
+    for (Size i = 0; i != lookup.mods.size(); ++i)
     {
-      const ResidueModification* mod = *(modification_names_.find(mod_name)->second.begin());
-      for (Size i = 0; i != mods_.size(); ++i)
+      if (lookup.mods[i] == mod)
       {
-        if (mods_[i] == mod)
-        {
-          index = i;
-          break;
-        }
+        return i;
       }
     }
 
-    if (index == numeric_limits<Size>::max())
-    {
-      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification name found but modification not found: " + mod_name);
-    }
-    return index;
+    throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification name found but modification not found: " + mod_name);
   }
 
 
@@ -333,17 +307,14 @@ namespace OpenMS
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
+    for (auto const & m : lookup_.get().mods)
     {
-      for (auto const & m : mods_)
+      if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
+          residuesMatch_(res, m) &&
+          ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
+           (term_spec == m->getTermSpecificity())))
       {
-        if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          mods.push_back(m->getFullId());
-        }
+        mods.push_back(m->getFullId());
       }
     }
   }
@@ -353,17 +324,14 @@ namespace OpenMS
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
+    for (auto const & m : lookup_.get().mods)
     {
-      for (auto const & m : mods_)
+      if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
+          residuesMatch_(res, m) &&
+          ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
+           (term_spec == m->getTermSpecificity())))
       {
-        if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          mods.push_back(m);
-        }
+        mods.push_back(m);
       }
     }
   }
@@ -375,22 +343,19 @@ namespace OpenMS
     const ResidueModification* mod = nullptr;
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
+    for (auto const & m : lookup_.get().mods)
     {
-      for (auto const & m : mods_)
+      // using less instead of less-or-equal will pick the first matching
+      // modification of equally heavy modifications (in our case this is the
+      // first matching UniMod entry)
+      double mass_error = fabs(m->getDiffMonoMass() - mass);
+      if ((mass_error < min_error) &&
+          residuesMatch_(res, m) &&
+          ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
+           (term_spec == m->getTermSpecificity())))
       {
-        // using less instead of less-or-equal will pick the first matching
-        // modification of equally heavy modifications (in our case this is the
-        // first matching UniMod entry)
-        double mass_error = fabs(m->getDiffMonoMass() - mass);
-        if ((mass_error < min_error) &&
-            residuesMatch_(res, m) &&
-            ((term_spec == ResidueModification::NUMBER_OF_TERM_SPECIFICITY) ||
-             (term_spec == m->getTermSpecificity())))
-        {
-          min_error = mass_error;
-          mod = m;
-        }
+        min_error = mass_error;
+        mod = m;
       }
     }
     return mod;
@@ -441,6 +406,8 @@ namespace OpenMS
         mods_.push_back(new_mod.get());
         new_mod.release(); // do not delete the object; 
         ret = mods_.back();
+        // copy-on-write: readers keep using the previous tables until the new ones are published
+        publishLookupTables_();
       }
     }
     return ret;
@@ -752,14 +719,11 @@ namespace OpenMS
   {
     modifications.clear();
 
-    #pragma omp critical(OpenMS_ModificationsDB)
+    for (auto const & m : lookup_.get().mods)
     {
-      for (auto const & m : mods_)
+      if (m->getUniModRecordId() > 0)
       {
-        if (m->getUniModRecordId() > 0)
-        {
-          modifications.push_back(m->getFullId());
-        }
+        modifications.push_back(m->getFullId());
       }
     }
 
@@ -55,6 +55,7 @@ namespace OpenMS
   {
     readResiduesFromFile_("CHEMISTRY/Residues.xml");
     buildResidueNames_();
+    publishLookupTables_();
   }
 
   ResidueDB* ResidueDB::getInstance()
@@ -76,11 +77,9 @@ namespace OpenMS
     }
 
     Residue* r(nullptr);
-    #pragma omp critical (ResidueDB)
-    {   
-      auto it = residue_names_.find(name);
-      if (it != residue_names_.end()) r = it->second;
-    }
+    const auto& residue_names = lookup_.get().residues->residue_names;
+    auto it = residue_names.find(name);
+    if (it != residue_names.end()) r = it->second;
     if (r == nullptr)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", name);
@@ -97,34 +96,23 @@ namespace OpenMS
 
   Size ResidueDB::getNumberOfResidues() const
   {
-    Size s;
-    #pragma omp critical (ResidueDB)
-    {
-      s = residues_.size();
-    } 
-    return s;
+    return lookup_.get().residues->const_residues.size();
   }
 
   Size ResidueDB::getNumberOfModifiedResidues() const
   {
-    Size s;
-    #pragma omp critical (ResidueDB)
-    {
-      s = modified_residues_.size();
-    } 
-    return s;
+    return lookup_.get().const_modified_residues.size();
   }
 
   const set<const Residue*> ResidueDB::getResidues(const String& residue_set) const
   {
     set<const Residue*> s;
-    #pragma omp critical (ResidueDB)
+    const auto& residues_by_set = lookup_.get().residues->residues_by_set;
+    auto it = residues_by_set.find(residue_set);
+    if (it != residues_by_set.end())
     {
-      if (residues_by_set_.has(residue_set))
-      {
-        s = residues_by_set_[residue_set];
-      }
-    } 
+      s = it->second;
+    }
 
     if (s.empty()) 
     {
@@ -139,9 +127,31 @@ namespace OpenMS
     {
       readResiduesFromFile_(file_name);
       buildResidueNames_();
+      publishLookupTables_();
     }     
   }
 
+  void ResidueDB::publishLookupTables_(bool residues_changed)
+  {
+    auto tables = std::make_shared<LookupTables>();
+    if (residues_changed)
+    {
+      auto residues = std::make_shared<ResidueTables>();
+      residues->residue_names = residue_names_;
+      residues->const_residues = const_residues_;
+      residues->residues_by_set = residues_by_set_;
+      residues->residue_sets = residue_sets_;
+      tables->residues = std::move(residues);
+    }
+    else
+    {
+      tables->residues = lookup_.get().residues;
+    }
+    tables->residue_mod_names = residue_mod_names_;
+    tables->const_modified_residues = const_modified_residues_;
+    lookup_.publish(std::move(tables));
+  }
+
   void ResidueDB::addResidue_(Residue* r)
   {
     vector<String> names;
@@ -202,23 +212,15 @@ namespace OpenMS
 
   bool ResidueDB::hasResidue(const String& res_name) const
   {
-    bool found = false;
-    #pragma omp critical (ResidueDB)
-    {
-      found = residue_names_.find(res_name) != residue_names_.end();
-    }  
-    return found;
+    const auto& residue_names = lookup_.get().residues->residue_names;
+    return residue_names.find(res_name) != residue_names.end();
   }
 
   bool ResidueDB::hasResidue(const Residue* residue) const
   {
-    bool found = false;
-    #pragma omp critical (ResidueDB)
-    {
-      found = (const_residues_.find(residue) != const_residues_.end() ||
-          const_modified_residues_.find(residue) != const_modified_residues_.end());
-    } 
-    return found;
+    const LookupTables& lookup = lookup_.get();
+    return (lookup.residues->const_residues.find(residue) != lookup.residues->const_residues.end() ||
+        lookup.const_modified_residues.find(residue) != lookup.const_modified_residues.end());
   }
 
   void ResidueDB::readResiduesFromFile_(const String& file_name)
@@ -460,12 +462,7 @@ namespace OpenMS
 
   const set<String> ResidueDB::getResidueSets() const
   {
-    set<String> rs;
-    #pragma omp critical (ResidueDB)
-    {
-      rs = residue_sets_; 
-    }
-    return rs;
+    return lookup_.get().residues->residue_sets;
   }
 
   void ResidueDB::buildResidueNames_()
@@ -511,76 +508,66 @@ namespace OpenMS
     OPENMS_PRECONDITION(!modification.empty(), "Modification cannot be empty")
     // search if the mod already exists
     const String & res_name = residue->getName();
+
+    // Perform a single lookup of the residue name in our database, we assume
+    // that if it is present in residue_mod_names then we have seen it
+    // before and can directly grab it. If its not present, we may have as
+    // unmodified residue in residue_names but need to create a new entry as
+    // modified residue. If the residue itself is unknow, we will throw.
+    const LookupTables& lookup = lookup_.get();
+    const auto& rm_entry = lookup.residue_mod_names.find(res_name);
+    if (rm_entry == lookup.residue_mod_names.end() &&
+        lookup.residues->residue_names.find(res_name) == lookup.residues->residue_names.end())
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+    }
+
+    const ResidueModification* mod;
+    try
+    {
+      // terminal modifications don't apply to residues (side chain), so only consider internal ones
+      static const ModificationsDB* mdb = ModificationsDB::getInstance();
+      mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
+    }
+    catch (...)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: ", modification);
+    }
+
+    // check if modified residue is already present in ResidueDB (no locking required)
+    const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
+    if (rm_entry != lookup.residue_mod_names.end())
+    {
+      const auto& inner = rm_entry->second.find(id);
+      if (inner != rm_entry->second.end())
+      {
+        return inner->second;
+      }
+    }
+
     Residue* res(nullptr);
-    bool residue_found(true), mod_found(true);
     #pragma omp critical (ResidueDB)
     {
-      // Perform a single lookup of the residue name in our database, we assume
-      // that if it is present in residue_mod_names_ then we have seen it
-      // before and can directly grab it. If its not present, we may have as
-      // unmodified residue in residue_names_ but need to create a new entry as
-      // modified residue. If the residue itself is unknow, we will throw (see
-      // below).
-      const auto& rm_entry = residue_mod_names_.find(res_name);
-      if (rm_entry == residue_mod_names_.end())
+      // another thread may have added it since our snapshot was taken
+      const auto& master_entry = residue_mod_names_.find(res_name);
+      if (master_entry != residue_mod_names_.end())
       {
-        if (residue_names_.find(res_name) == residue_names_.end())
+        const auto& inner = master_entry->second.find(id);
+        if (inner != master_entry->second.end())
         {
-          residue_found = false;
+          res = inner->second;
         }
       }
-
-      if (residue_found)
+      if (res == nullptr)
       {
-        const ResidueModification* mod;
-        try
-        {
-          // terminal modifications don't apply to residues (side chain), so only consider internal ones
-          static const ModificationsDB* mdb = ModificationsDB::getInstance();
-          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
-        }
-        catch (...)
-        {
-          mod_found = false;
-        }
-
-        // check if modification in ResidueDB
-        if (mod_found)
-        {
-          const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
-
-          // check if modified residue is already present in ResidueDB
-          bool found = false;
-          if (rm_entry != residue_mod_names_.end())
-          {
-            const auto& inner = rm_entry->second.find(id);
-            if (inner != rm_entry->second.end())
-            {
-              res = inner->second;
-              found = true;
-            }
-          }
-          if (!found)
-          {
-            // create and register this modified residue
-            res = new Residue(*residue_names_[res_name]);
-            res->setModification(mod);
-            addResidue_(res);
-          }
-        }
+        // create and register this modified residue
+        res = new Residue(*residue_names_[res_name]);
+        res->setModification(mod);
+        addResidue_(res);
+        publishLookupTables_(false);
       }
     }
 
-    // throwing (uncaught) exceptions needs to happen outside of critical section (see OpenMP reference manual)
-    if (!residue_found)
-    {
-      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
-    }
-    else if (!mod_found)
-    {
-      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: ", modification);
-    }
-    
     return res;
   }
 
@@ -39,7 +39,12 @@
 
 #include <QtCore/QString>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
 using namespace std;
 
@@ -48,10 +53,186 @@ namespace OpenMS
 
   const DataValue DataValue::EMPTY;
 
+  struct DataValue::SharedString_
+  {
+    SharedString_(const char* s, Size length, size_t h, bool p) :
+      ref_count(1),
+      hash(h),
+      pooled(p),
+      value(s, length)
+    {
+    }
+
+    std::atomic<UInt> ref_count;
+    /// hash of @p value (only set for pooled strings)
+    const size_t hash;
+    /// true if the string is registered in the pool of interned strings
+    const bool pooled;
+    const String value;
+  };
+
+  namespace
+  {
+    /**
+      @brief The pool of interned strings
+
+      Split into shards (each with its own mutex) to reduce contention when
+      many threads create or release interned strings at the same time.
+      The pool does not hold a reference itself, entries are removed when
+      the last DataValue using them is released.
+    */
+    template <typename SharedString>
+    struct StringPool
+    {
+      static const size_t SHARDS = 64;
+
+      struct Shard
+      {
+        std::mutex mutex;
+        // key is the hash of the string, the string itself is only stored once (in the shared buffer)
+        std::unordered_multimap<size_t, SharedString*> strings;
+      };
+
+      Shard shards[SHARDS];
+
+      Shard& shard(size_t hash)
+      {
+        return shards[hash % SHARDS];
+      }
+
+      static StringPool& instance()
+      {
+        // intentionally leaked: static DataValues may release interned strings during static destruction
+        static StringPool* pool = new StringPool();
+        return *pool;
+      }
+    };
+  }
+
+  void DataValue::setString_(const char* s, Size length)
+  {
+    value_type_ = STRING_VALUE;
+    str_inline_ = length < sizeof(data_.chars_) && std::memchr(s, '\0', length) == nullptr;
+    if (str_inline_)
+    {
+      std::memcpy(data_.chars_, s, length);
+      data_.chars_[length] = '\0';
+    }
+    else
+    {
+      data_.str_ = new SharedString_(s, length, 0, false);
+    }
+  }
+
+  const char* DataValue::stringData_() const
+  {
+    return str_inline_ ? data_.chars_ : data_.str_->value.c_str();
+  }
+
+  Size DataValue::stringSize_() const
+  {
+    return str_inline_ ? std::strlen(data_.chars_) : data_.str_->value.size();
+  }
+
+  int DataValue::compareStrings_(const DataValue& a, const DataValue& b)
+  {
+    if (!a.str_inline_ && !b.str_inline_ && a.data_.str_ == b.data_.str_)
+    {
+      return 0; // same (e.g. interned) buffer
+    }
+    Size size_a = a.stringSize_(), size_b = b.stringSize_();
+    int result = std::char_traits<char>::compare(a.stringData_(), b.stringData_(), std::min(size_a, size_b));
+    if (result != 0)
+    {
+      return result;
+    }
+    return size_a < size_b ? -1 : (size_a > size_b ? 1 : 0);
+  }
+
+  void DataValue::releaseString_(SharedString_* str) noexcept
+  {
+    if (!str->pooled)
+    {
+      if (--str->ref_count == 0)
+      {
+        delete str;
+      }
+      return;
+    }
+
+    // pooled strings are only released with the lock held, so that a concurrent
+    // lookup cannot pick up a string which is about to be deleted
+    auto& shard = StringPool<SharedString_>::instance().shard(str->hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (--str->ref_count == 0)
+    {
+      auto range = shard.strings.equal_range(str->hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second == str)
+        {
+          shard.strings.erase(it);
+          break;
+        }
+      }
+      delete str;
+    }
+  }
+
+  DataValue DataValue::interned(const String& value)
+  {
+    DataValue result;
+    if (value.size() < sizeof(result.data_.chars_))
+    {
+      // short strings are stored inline anyway
+      result.setString_(value.c_str(), value.size());
+      return result;
+    }
+
+    const size_t hash = std::hash<std::string>()(value);
+    auto& shard = StringPool<SharedString_>::instance().shard(hash);
+    SharedString_* str = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto range = shard.strings.equal_range(hash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second->value == value)
+        {
+          str = it->second;
+          ++str->ref_count;
+          break;
+        }
+      }
+      if (str == nullptr)
+      {
+        str = new SharedString_(value.c_str(), value.size(), hash, true);
+        shard.strings.emplace(hash, str);
+      }
+    }
+    result.value_type_ = STRING_VALUE;
+    result.str_inline_ = false;
+    result.data_.str_ = str;
+    return result;
+  }
+
+  Size DataValue::internedCount()
+  {
+    auto& pool = StringPool<SharedString_>::instance();
+    Size count = 0;
+    for (auto& shard : pool.shards)
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      count += shard.strings.size();
+    }
+    return count;
+  }
+
   // default ctor
   DataValue::DataValue() :
     value_type_(EMPTY_VALUE),
     unit_type_(OTHER),
+    str_inline_(false),
     unit_(-1)
   {
   }
@@ -66,109 +247,110 @@ namespace OpenMS
   //    ctor for all supported types a DataValue object can hold
   //--------------------------------------------------------------------
   DataValue::DataValue(long double p) :
-    value_type_(DOUBLE_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(DOUBLE_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.dou_ = p;
   }
 
   DataValue::DataValue(double p) :
-    value_type_(DOUBLE_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(DOUBLE_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.dou_ = p;
   }
 
   DataValue::DataValue(float p) :
-    value_type_(DOUBLE_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(DOUBLE_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.dou_ = p;
   }
 
   DataValue::DataValue(short int p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(unsigned short int p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(int p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(unsigned int p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(long int p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(unsigned long int p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(long long p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(unsigned long long p) :
-    value_type_(INT_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.ssize_ = p;
   }
 
   DataValue::DataValue(const char* p) :
-    value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(EMPTY_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
-    data_.str_ = new String(p);
+    setString_(p, std::strlen(p));
   }
 
   DataValue::DataValue(const string& p) :
-    value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(EMPTY_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
-    data_.str_ = new String(p);
+    setString_(p.c_str(), p.size());
   }
 
   DataValue::DataValue(const QString& p) :
-    value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(EMPTY_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
-    data_.str_ = new String(p);
+    String s(p);
+    setString_(s.c_str(), s.size());
   }
 
   DataValue::DataValue(const String& p) :
-    value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
+    value_type_(EMPTY_VALUE), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
-    data_.str_ = new String(p);
+    setString_(p.c_str(), p.size());
   }
 
   DataValue::DataValue(const StringList& p) :
-    value_type_(STRING_LIST), unit_type_(OTHER), unit_(-1)
+    value_type_(STRING_LIST), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.str_list_ = new StringList(p);
   }
 
   DataValue::DataValue(const IntList& p) :
-    value_type_(INT_LIST), unit_type_(OTHER), unit_(-1)
+    value_type_(INT_LIST), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.int_list_ = new IntList(p);
   }
 
   DataValue::DataValue(const DoubleList& p) :
-    value_type_(DOUBLE_LIST), unit_type_(OTHER), unit_(-1)
+    value_type_(DOUBLE_LIST), unit_type_(OTHER), str_inline_(false), unit_(-1)
   {
     data_.dou_list_ = new DoubleList(p);
   }
@@ -179,12 +361,14 @@ namespace OpenMS
   DataValue::DataValue(const DataValue& p) :
     value_type_(p.value_type_),
     unit_type_(p.unit_type_),
+    str_inline_(p.str_inline_),
     unit_(p.unit_),
     data_(p.data_)
   {
     if (value_type_ == STRING_VALUE)
     {
-      data_.str_ = new String(*(p.data_.str_));
+      // strings are immutable, copies share the buffer
+      if (!str_inline_) ++data_.str_->ref_count;
     }
     else if (value_type_ == STRING_LIST)
     {
@@ -203,6 +387,7 @@ namespace OpenMS
   DataValue::DataValue(DataValue&& rhs) noexcept :
     value_type_(std::move(rhs.value_type_)),
     unit_type_(std::move(rhs.unit_type_)),
+    str_inline_(rhs.str_inline_),
     unit_(std::move(rhs.unit_)),
     data_(std::move(rhs.data_))
   {
@@ -221,7 +406,7 @@ namespace OpenMS
     }
     else if (value_type_ == STRING_VALUE)
     {
-      delete(data_.str_);
+      if (!str_inline_) releaseString_(data_.str_);
     }
     else if (value_type_ == INT_LIST)
     {
@@ -258,7 +443,8 @@ namespace OpenMS
     }
     else if (p.value_type_ == STRING_VALUE)
     {
-      data_.str_ = new String(*(p.data_.str_));
+      data_ = p.data_;
+      if (!p.str_inline_) ++data_.str_->ref_count;
     }
     else if (p.value_type_ == INT_LIST)
     {
@@ -276,6 +462,7 @@ namespace OpenMS
     // copy type
     value_type_ = p.value_type_;
     unit_type_ = p.unit_type_;
+    str_inline_ = p.str_inline_;
     unit_ = p.unit_;
 
     return *this;
@@ -297,6 +484,7 @@ namespace OpenMS
     data_ = rhs.data_;
     value_type_ = rhs.value_type_;
     unit_type_ = rhs.unit_type_;
+    str_inline_ = rhs.str_inline_;
     unit_ = rhs.unit_;
 
     // clean up rhs 
@@ -314,32 +502,29 @@ namespace OpenMS
   DataValue& DataValue::operator=(const char* arg)
   {
     clear_();
-    data_.str_ = new String(arg);
-    value_type_ = STRING_VALUE;
+    setString_(arg, std::strlen(arg));
     return *this;
   }
 
   DataValue& DataValue::operator=(const std::string& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
-    value_type_ = STRING_VALUE;
+    setString_(arg.c_str(), arg.size());
     return *this;
   }
 
   DataValue& DataValue::operator=(const String& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
-    value_type_ = STRING_VALUE;
+    setString_(arg.c_str(), arg.size());
     return *this;
   }
 
   DataValue& DataValue::operator=(const QString& arg)
   {
+    String s(arg);
     clear_();
-    data_.str_ = new String(arg);
-    value_type_ = STRING_VALUE;
+    setString_(s.c_str(), s.size());
     return *this;
   }
 
@@ -591,7 +776,7 @@ namespace OpenMS
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Could not convert non-string DataValue to string");
     }
-    return *(data_.str_);
+    return std::string(stringData_(), stringSize_());
   }
 
   DataValue::operator StringList() const
@@ -614,7 +799,7 @@ namespace OpenMS
   {
     switch (value_type_)
     {
-    case DataValue::STRING_VALUE: return const_cast<const char*>(data_.str_->c_str());
+    case DataValue::STRING_VALUE: return stringData_();
 
     case DataValue::EMPTY_VALUE: return nullptr;
 
@@ -657,7 +842,7 @@ namespace OpenMS
     {
       case DataValue::EMPTY_VALUE: break;
 
-      case DataValue::STRING_VALUE: return *(data_.str_);
+      case DataValue::STRING_VALUE: return String(stringData_(), stringSize_());
 
       case DataValue::STRING_LIST: ss << *(data_.str_list_); break;
 
@@ -684,7 +869,7 @@ namespace OpenMS
     {
     case DataValue::EMPTY_VALUE: break;
 
-    case DataValue::STRING_VALUE: result = QString::fromStdString(*(data_.str_)); break;
+    case DataValue::STRING_VALUE: result = QString::fromUtf8(stringData_(), int(stringSize_())); break;
 
     case DataValue::STRING_LIST: result = QString::fromStdString(this->toString()); break;
 
@@ -707,12 +892,12 @@ namespace OpenMS
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Could not convert non-string DataValue to bool.");
     }
-    else if (*(data_.str_) != "true" &&  *(data_.str_) != "false")
+    else if (std::strcmp(stringData_(), "true") != 0 && std::strcmp(stringData_(), "false") != 0)
     {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert '") + *(data_.str_) + "' to bool. Valid stings are 'true' and 'false'.");
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert '") + toString() + "' to bool. Valid stings are 'true' and 'false'.");
     }
 
-    return *(data_.str_) == "true";
+    return std::strcmp(stringData_(), "true") == 0;
   }
 
   // ----------------- Comparator ----------------------
@@ -725,7 +910,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return b.value_type_ == DataValue::EMPTY_VALUE;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) == *(b.data_.str_);
+      case DataValue::STRING_VALUE: return DataValue::compareStrings_(a, b) == 0;
 
       case DataValue::STRING_LIST: return *(a.data_.str_list_) == *(b.data_.str_list_);
 
@@ -749,7 +934,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return false;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) < *(b.data_.str_);
+      case DataValue::STRING_VALUE: return DataValue::compareStrings_(a, b) < 0;
 
       case DataValue::STRING_LIST: return a.data_.str_list_->size() < b.data_.str_list_->size();
 
@@ -773,7 +958,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return false;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) > *(b.data_.str_);
+      case DataValue::STRING_VALUE: return DataValue::compareStrings_(a, b) > 0;
 
       case DataValue::STRING_LIST: return a.data_.str_list_->size() > b.data_.str_list_->size();
 
@@ -801,7 +986,7 @@ namespace OpenMS
   {
     switch (p.value_type_)
     {
-    case DataValue::STRING_VALUE: os << *(p.data_.str_); break;
+    case DataValue::STRING_VALUE: os.write(p.stringData_(), p.stringSize_()); break;
 
     case DataValue::STRING_LIST: os << *(p.data_.str_list_); break;
 
@@ -31,9 +31,34 @@
 // $Maintainer: Timo Sachsenberg $
 // $Authors: $
 // --------------------------------------------------------------------------
-//
+
+#include <OpenMS/FILTERING/BASELINE/MorphologicalFilter.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMS
 {
 
+  void MorphologicalFilter::filterExperiment(PeakMap & exp)
+  {
+    Size progress = 0;
+    startProgress(0, exp.size(), "filtering baseline");
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+    {
+      filter(exp[i]);
+
+      IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+    }
+    endProgress();
+  }
+
 }
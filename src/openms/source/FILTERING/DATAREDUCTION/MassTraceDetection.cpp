@@ -34,9 +34,10 @@
 
 #include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
 
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 
-#include <boost/dynamic_bitset.hpp>
+#include <algorithm>
 
 namespace OpenMS
 {
@@ -187,6 +188,34 @@ namespace OpenMS
     }
 
 
+    void MassTraceDetection::filterSpectrum_(MSSpectrum& spec) const
+    {
+      std::vector<Size> indices_passing;
+      for (Size peak_idx = 0; peak_idx < spec.size(); ++peak_idx)
+      {
+        if (spec[peak_idx].getIntensity() > noise_threshold_int_)
+        {
+          indices_passing.push_back(peak_idx);
+        }
+      }
+      spec.select(indices_passing);
+    }
+
+    void MassTraceDetection::addApexCandidates_(const MSSpectrum& spec, const Size scan_idx, MapIdxSortedByInt& chrom_apices) const
+    {
+      for (Size peak_idx = 0; peak_idx < spec.size(); ++peak_idx)
+      {
+        double tmp_peak_int(spec[peak_idx].getIntensity());
+        // Assume that noise_threshold_int_ contains the noise level of the
+        // data and we want to be chrom_peak_snr times above the noise level
+        // --> add this peak as possible chromatographic apex
+        if (tmp_peak_int > chrom_peak_snr_ * noise_threshold_int_)
+        {
+          chrom_apices.insert(std::make_pair(tmp_peak_int, std::make_pair(scan_idx, peak_idx)));
+        }
+      }
+    }
+
     void MassTraceDetection::run(const PeakMap& input_exp, std::vector<MassTrace>& found_masstraces, const Size max_traces)
     {
       // make sure the output vector is empty
@@ -212,27 +241,12 @@ namespace OpenMS
         // check if this is a MS1 survey scan
         if (it->getMSLevel() != 1) continue;
 
-        std::vector<Size> indices_passing;
-        for (Size peak_idx = 0; peak_idx < it->size(); ++peak_idx)
-        {
-          double tmp_peak_int((*it)[peak_idx].getIntensity());
-          if (tmp_peak_int > noise_threshold_int_)
-          {
-            // Assume that noise_threshold_int_ contains the noise level of the
-            // data and we want to be chrom_peak_snr times above the noise level
-            // --> add this peak as possible chromatographic apex
-            if (tmp_peak_int > chrom_peak_snr_ * noise_threshold_int_)
-            {
-              chrom_apices.insert(std::make_pair(tmp_peak_int, std::make_pair(spectra_count, indices_passing.size())));
-            }
-            indices_passing.push_back(peak_idx);
-            ++total_peak_count;
-          }
-        }
         PeakMap::SpectrumType tmp_spec(*it);
-        tmp_spec.select(indices_passing);
-        work_exp.addSpectrum(tmp_spec);
+        filterSpectrum_(tmp_spec);
+        addApexCandidates_(tmp_spec, spectra_count, chrom_apices);
+        total_peak_count += tmp_spec.size();
         spec_offsets.push_back(spec_offsets.back() + tmp_spec.size());
+        work_exp.addSpectrum(std::move(tmp_spec));
         ++spectra_count;
       }
 
@@ -254,6 +268,182 @@ namespace OpenMS
       return;
     } // end of MassTraceDetection::run
 
+    void MassTraceDetection::run(OnDiscMSExperiment& input_exp, std::vector<MassTrace>& found_masstraces,
+                                 const Size block_size, const Size block_overlap, const Size max_traces)
+    {
+      found_masstraces.clear();
+
+      if (block_size == 0)
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                      "The block size must be positive.", String(block_size));
+      }
+
+      // sliding window of filtered MS1 spectra: work_exp[i] is the MS1 spectrum
+      // first_scan + i of the run, its peaks start at peak_visited[spec_offsets[i]]
+      PeakMap work_exp;
+      Size first_scan(0);
+      std::vector<Size> spec_offsets;
+      std::vector<bool> peak_visited;
+
+      // traces which were still extending at the end of the previous window
+      std::vector<TraceState_> open_traces;
+
+      Size trace_number(1);
+      int fwhm_meta_idx(-1);
+      Size next_spectrum(0);
+      Size block_begin(0);
+      bool max_traces_reached(false);
+
+      this->startProgress(0, input_exp.size(), "mass trace detection (block-wise)");
+
+      while (true)
+      {
+        // *********************************************************** //
+        //  Step 1: Read the next block and the following block_overlap
+        //  spectra (lookahead)
+        // *********************************************************** //
+        while (first_scan + work_exp.size() < block_begin + block_size + block_overlap && next_spectrum < input_exp.size())
+        {
+          MSSpectrum spec = input_exp.getSpectrum(next_spectrum++);
+          if (spec.getMSLevel() != 1) continue;
+
+          if (!spec.isSorted()) spec.sortByPosition();
+
+          // FWHM meta data has to be present for all spectra or for none (see run_)
+          const bool has_fwhm = !spec.getFloatDataArrays().empty() &&
+                                spec.getFloatDataArrays()[0].getName() == "FWHM_ppm";
+          if (first_scan + work_exp.size() == 0)
+          {
+            fwhm_meta_idx = has_fwhm ? 0 : -1;
+          }
+          else if (has_fwhm != (fwhm_meta_idx != -1))
+          {
+            throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                          "FWHM meta arrays are expected to be missing or present for all MS spectra.");
+          }
+          if (has_fwhm && spec.getFloatDataArrays()[0].size() != spec.size())
+          {
+            throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, spec.size());
+          }
+
+          filterSpectrum_(spec);
+          spec_offsets.push_back(peak_visited.size());
+          peak_visited.resize(peak_visited.size() + spec.size(), false);
+          work_exp.addSpectrum(std::move(spec));
+        }
+        this->setProgress(next_spectrum);
+
+        const Size window_end(first_scan + work_exp.size());
+        const bool at_end(next_spectrum == input_exp.size());
+        if (at_end && window_end < 3)
+        {
+          throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                                        "Input map consists of too few MS1 spectra (less than 3!). Aborting...", String(window_end));
+        }
+        const Size block_end(at_end ? window_end : block_begin + block_size);
+
+        // *********************************************************** //
+        //  Step 2: Continue the open traces of the previous window, then
+        //  go through the apices of the block and the lookahead in order
+        //  of decreasing intensity. Traces starting in the lookahead only
+        //  reserve their peaks (as they would in the in-memory version)
+        //  and are detected again as part of the next block.
+        // *********************************************************** //
+        MapIdxSortedByInt chrom_apices;
+        for (Size scan_idx = block_begin; scan_idx < window_end; ++scan_idx)
+        {
+          addApexCandidates_(work_exp[scan_idx - first_scan], scan_idx, chrom_apices);
+        }
+
+        std::vector<TraceState_> still_open;
+        std::vector<TraceState_> lookahead_traces;
+        auto reservePeaks = [&](const TraceState_& trace, bool reserve)
+        {
+          for (const std::pair<Size, Size>& idx : trace.gathered_idx)
+          {
+            if (idx.first >= first_scan) peak_visited[spec_offsets[idx.first - first_scan] + idx.second] = reserve;
+          }
+        };
+        auto finishTrace = [&](TraceState_& trace, bool in_lookahead)
+        {
+          if (in_lookahead)
+          {
+            reservePeaks(trace, true);
+            lookahead_traces.push_back(std::move(trace));
+          }
+          else if (!at_end && trace.toggle_up && trace.up_idx + 1 == window_end)
+          {
+            // trace reached the end of the window: reserve its peaks and
+            // continue it (upwards only) in the next window
+            trace.toggle_down = false;
+            reservePeaks(trace, true);
+            still_open.push_back(std::move(trace));
+          }
+          else if (storeTrace_(trace, first_scan, spec_offsets, peak_visited, trace_number, found_masstraces))
+          {
+            max_traces_reached = (max_traces > 0 && found_masstraces.size() == max_traces);
+          }
+          else
+          {
+            // release peaks reserved in the previous window
+            reservePeaks(trace, false);
+          }
+        };
+
+        std::sort(open_traces.begin(), open_traces.end(),
+                  [](const TraceState_& a, const TraceState_& b) { return a.apex_intensity > b.apex_intensity; });
+        for (Size i = 0; i < open_traces.size() && !max_traces_reached; ++i)
+        {
+          extendTrace_(open_traces[i], work_exp, first_scan, spec_offsets, peak_visited, fwhm_meta_idx);
+          finishTrace(open_traces[i], false);
+        }
+
+        for (MapIdxSortedByInt::const_reverse_iterator m_it = chrom_apices.rbegin(); m_it != chrom_apices.rend() && !max_traces_reached; ++m_it)
+        {
+          const Size apex_scan_idx(m_it->second.first);
+          const Size apex_peak_idx(m_it->second.second);
+          if (peak_visited[spec_offsets[apex_scan_idx - first_scan] + apex_peak_idx]) continue;
+
+          TraceState_ trace;
+          initTrace_(trace, work_exp, first_scan, apex_scan_idx, apex_peak_idx, fwhm_meta_idx);
+          extendTrace_(trace, work_exp, first_scan, spec_offsets, peak_visited, fwhm_meta_idx);
+          finishTrace(trace, apex_scan_idx >= block_end);
+        }
+
+        for (const TraceState_& trace : lookahead_traces)
+        {
+          reservePeaks(trace, false);
+        }
+        open_traces.swap(still_open);
+
+        if (at_end || max_traces_reached) break;
+
+        // *********************************************************** //
+        //  Step 3: Slide the window, keeping the last block_overlap
+        //  spectra of the block for the downward extension of the
+        //  traces of the next block
+        // *********************************************************** //
+        block_begin = block_end;
+        const Size keep_from(std::max(first_scan, block_end - std::min(block_end, block_overlap)));
+        const Size n_drop(keep_from - first_scan);
+        if (n_drop > 0)
+        {
+          const Size peak_shift(n_drop < spec_offsets.size() ? spec_offsets[n_drop] : peak_visited.size());
+          work_exp.getSpectra().erase(work_exp.getSpectra().begin(), work_exp.getSpectra().begin() + n_drop);
+          peak_visited.erase(peak_visited.begin(), peak_visited.begin() + peak_shift);
+          spec_offsets.erase(spec_offsets.begin(), spec_offsets.begin() + n_drop);
+          for (Size& offset : spec_offsets)
+          {
+            offset -= peak_shift;
+          }
+          first_scan = keep_from;
+        }
+      }
+
+      this->endProgress();
+    }
+
     void MassTraceDetection::run_(const MapIdxSortedByInt& chrom_apices,
                                   const Size total_peak_count,
                                   const PeakMap& work_exp,
@@ -261,7 +451,7 @@ namespace OpenMS
                                   std::vector<MassTrace>& found_masstraces,
                                   const Size max_traces)
     {
-      boost::dynamic_bitset<> peak_visited(total_peak_count);
+      std::vector<bool> peak_visited(total_peak_count);
       Size trace_number(1);
 
       // check presence of FWHM meta data
@@ -300,255 +490,276 @@ namespace OpenMS
           continue;
         }
 
-        Peak2D apex_peak;
-        apex_peak.setRT(work_exp[apex_scan_idx].getRT());
-        apex_peak.setMZ(work_exp[apex_scan_idx][apex_peak_idx].getMZ());
-        apex_peak.setIntensity(work_exp[apex_scan_idx][apex_peak_idx].getIntensity());
+        TraceState_ trace;
+        initTrace_(trace, work_exp, 0, apex_scan_idx, apex_peak_idx, fwhm_meta_idx);
+        extendTrace_(trace, work_exp, 0, spec_offsets, peak_visited, fwhm_meta_idx);
 
-        Size trace_up_idx(apex_scan_idx);
-        Size trace_down_idx(apex_scan_idx);
+        if (storeTrace_(trace, 0, spec_offsets, peak_visited, trace_number, found_masstraces))
+        {
+          peaks_detected += found_masstraces.back().getSize();
+          this->setProgress(peaks_detected);
 
-        std::list<PeakType> current_trace;
-        current_trace.push_back(apex_peak);
-        std::vector<double> fwhms_mz; // peak-FWHM meta values of collected peaks
+          // check if we already reached the (optional) maximum number of traces
+          if (max_traces > 0 && found_masstraces.size() == max_traces) break;
+        }
+      }
+
+      this->endProgress();
 
-        // Initialization for the iterative version of weighted m/z mean calculation
-        double centroid_mz(apex_peak.getMZ());
-        double prev_counter(apex_peak.getIntensity() * apex_peak.getMZ());
-        double prev_denom(apex_peak.getIntensity());
+    }
 
-        updateIterativeWeightedMeanMZ(apex_peak.getMZ(), apex_peak.getIntensity(), centroid_mz, prev_counter, prev_denom);
+    void MassTraceDetection::initTrace_(TraceState_& trace, const PeakMap& work_exp, const Size first_scan,
+                                        const Size scan_idx, const Size peak_idx, const int fwhm_meta_idx)
+    {
+      const MSSpectrum& apex_spec = work_exp[scan_idx - first_scan];
 
-        std::vector<std::pair<Size, Size> > gathered_idx;
-        gathered_idx.push_back(std::make_pair(apex_scan_idx, apex_peak_idx));
-        if (fwhm_meta_idx != -1)
-        {
-          fwhms_mz.push_back(work_exp[apex_scan_idx].getFloatDataArrays()[fwhm_meta_idx][apex_peak_idx]);
-        }
+      Peak2D apex_peak;
+      apex_peak.setRT(apex_spec.getRT());
+      apex_peak.setMZ(apex_spec[peak_idx].getMZ());
+      apex_peak.setIntensity(apex_spec[peak_idx].getIntensity());
+
+      trace.peaks.push_back(apex_peak);
+      trace.apex_intensity = apex_peak.getIntensity();
+      trace.down_idx = scan_idx;
+      trace.up_idx = scan_idx;
 
-        Size up_hitting_peak(0), down_hitting_peak(0);
-        Size up_scan_counter(0), down_scan_counter(0);
+      // Initialization for the iterative version of weighted m/z mean calculation
+      trace.centroid_mz = apex_peak.getMZ();
+      trace.prev_counter = apex_peak.getIntensity() * apex_peak.getMZ();
+      trace.prev_denom = apex_peak.getIntensity();
 
-        bool toggle_up = true, toggle_down = true;
+      updateIterativeWeightedMeanMZ(apex_peak.getMZ(), apex_peak.getIntensity(), trace.centroid_mz, trace.prev_counter, trace.prev_denom);
 
-        Size conseq_missed_peak_up(0), conseq_missed_peak_down(0);
-        Size max_consecutive_missing(trace_termination_outliers_);
+      trace.gathered_idx.push_back(std::make_pair(scan_idx, peak_idx));
+      if (fwhm_meta_idx != -1)
+      {
+        trace.fwhms_mz.push_back(apex_spec.getFloatDataArrays()[fwhm_meta_idx][peak_idx]);
+      }
 
-        double current_sample_rate(1.0);
-        // Size min_scans_to_consider(std::floor((min_sample_rate_ /2)*10));
-        Size min_scans_to_consider(5);
+      // double ftl_mean(centroid_mz);
+      trace.ftl_sd = (trace.centroid_mz / 1e6) * mass_error_ppm_;
+      trace.intensity_so_far = apex_peak.getIntensity();
+    }
 
-        // double outlier_ratio(0.3);
+    void MassTraceDetection::extendTrace_(TraceState_& trace, const PeakMap& work_exp, const Size first_scan,
+                                          const std::vector<Size>& spec_offsets, const std::vector<bool>& peak_visited,
+                                          const int fwhm_meta_idx)
+    {
+      const Size end_scan(first_scan + work_exp.size());
+      const Size max_consecutive_missing(trace_termination_outliers_);
 
-        // double ftl_mean(centroid_mz);
-        double ftl_sd((centroid_mz / 1e6) * mass_error_ppm_);
-        double intensity_so_far(apex_peak.getIntensity());
+      // Size min_scans_to_consider(std::floor((min_sample_rate_ /2)*10));
+      const Size min_scans_to_consider(5);
 
-        while (((trace_down_idx > 0) && toggle_down) ||
-               ((trace_up_idx < work_exp.size() - 1) && toggle_up)
-                )
+      while (((trace.down_idx > first_scan) && trace.toggle_down) ||
+             ((trace.up_idx + 1 < end_scan) && trace.toggle_up)
+              )
+      {
+        // *********************************************************** //
+        // Step 2.1 MOVE DOWN in RT dim
+        // *********************************************************** //
+        if ((trace.down_idx > first_scan) && trace.toggle_down)
         {
-          // *********************************************************** //
-          // Step 2.1 MOVE DOWN in RT dim
-          // *********************************************************** //
-          if ((trace_down_idx > 0) && toggle_down)
+          const Size scan_down(trace.down_idx - 1);
+          const MSSpectrum& spec_trace_down = work_exp[scan_down - first_scan];
+          if (!spec_trace_down.empty())
           {
-            const MSSpectrum& spec_trace_down = work_exp[trace_down_idx - 1];
-            if (!spec_trace_down.empty())
-            {
-              Size next_down_peak_idx = spec_trace_down.findNearest(centroid_mz);
-              double next_down_peak_mz = spec_trace_down[next_down_peak_idx].getMZ();
-              double next_down_peak_int = spec_trace_down[next_down_peak_idx].getIntensity();
+            Size next_down_peak_idx = spec_trace_down.findNearest(trace.centroid_mz);
+            double next_down_peak_mz = spec_trace_down[next_down_peak_idx].getMZ();
+            double next_down_peak_int = spec_trace_down[next_down_peak_idx].getIntensity();
 
-              double right_bound = centroid_mz + 3 * ftl_sd;
-              double left_bound = centroid_mz - 3 * ftl_sd;
+            double right_bound = trace.centroid_mz + 3 * trace.ftl_sd;
+            double left_bound = trace.centroid_mz - 3 * trace.ftl_sd;
 
-              if ((next_down_peak_mz <= right_bound) &&
-                  (next_down_peak_mz >= left_bound) &&
-                  !peak_visited[spec_offsets[trace_down_idx - 1] + next_down_peak_idx]
-                      )
+            if ((next_down_peak_mz <= right_bound) &&
+                (next_down_peak_mz >= left_bound) &&
+                !peak_visited[spec_offsets[scan_down - first_scan] + next_down_peak_idx]
+                    )
+            {
+              Peak2D next_peak;
+              next_peak.setRT(spec_trace_down.getRT());
+              next_peak.setMZ(next_down_peak_mz);
+              next_peak.setIntensity(next_down_peak_int);
+
+              trace.peaks.push_front(next_peak);
+              // FWHM average
+              if (fwhm_meta_idx != -1)
               {
-                Peak2D next_peak;
-                next_peak.setRT(spec_trace_down.getRT());
-                next_peak.setMZ(next_down_peak_mz);
-                next_peak.setIntensity(next_down_peak_int);
-
-                current_trace.push_front(next_peak);
-                // FWHM average
-                if (fwhm_meta_idx != -1)
-                {
-                  fwhms_mz.push_back(spec_trace_down.getFloatDataArrays()[fwhm_meta_idx][next_down_peak_idx]);
-                }
-                // Update the m/z mean of the current trace as we added a new peak
-                updateIterativeWeightedMeanMZ(next_down_peak_mz, next_down_peak_int, centroid_mz, prev_counter, prev_denom);
-                gathered_idx.push_back(std::make_pair(trace_down_idx - 1, next_down_peak_idx));
+                trace.fwhms_mz.push_back(spec_trace_down.getFloatDataArrays()[fwhm_meta_idx][next_down_peak_idx]);
+              }
+              // Update the m/z mean of the current trace as we added a new peak
+              updateIterativeWeightedMeanMZ(next_down_peak_mz, next_down_peak_int, trace.centroid_mz, trace.prev_counter, trace.prev_denom);
+              trace.gathered_idx.push_back(std::make_pair(scan_down, next_down_peak_idx));
 
-                // Update the m/z variance dynamically
-                if (reestimate_mt_sd_)           //  && (down_hitting_peak+1 > min_flank_scans))
+              // Update the m/z variance dynamically
+              if (reestimate_mt_sd_)           //  && (down_hitting_peak+1 > min_flank_scans))
+              {
+                // if (ftl_t > min_fwhm_scans)
                 {
-                  // if (ftl_t > min_fwhm_scans)
-                  {
-                    updateWeightedSDEstimateRobust(next_peak, centroid_mz, ftl_sd, intensity_so_far);
-                  }
+                  updateWeightedSDEstimateRobust(next_peak, trace.centroid_mz, trace.ftl_sd, trace.intensity_so_far);
                 }
-
-                ++down_hitting_peak;
-                conseq_missed_peak_down = 0;
-              }
-              else
-              {
-                ++conseq_missed_peak_down;
               }
 
+              ++trace.down_hitting_peak;
+              trace.conseq_missed_peak_down = 0;
             }
-            --trace_down_idx;
-            ++down_scan_counter;
+            else
+            {
+              ++trace.conseq_missed_peak_down;
+            }
+
+          }
+          --trace.down_idx;
+          ++trace.down_scan_counter;
 
-            // trace termination criterion: max allowed number of
-            // consecutive outliers reached OR cancel extension if
-            // sampling_rate falls below min_sample_rate_
-            if (trace_termination_criterion_ == "outlier")
+          // trace termination criterion: max allowed number of
+          // consecutive outliers reached OR cancel extension if
+          // sampling_rate falls below min_sample_rate_
+          if (trace_termination_criterion_ == "outlier")
+          {
+            if (trace.conseq_missed_peak_down > max_consecutive_missing)
             {
-              if (conseq_missed_peak_down > max_consecutive_missing)
-              {
-                toggle_down = false;
-              }
+              trace.toggle_down = false;
             }
-            else if (trace_termination_criterion_ == "sample_rate")
+          }
+          else if (trace_termination_criterion_ == "sample_rate")
+          {
+            trace.current_sample_rate = (double)(trace.down_hitting_peak + trace.up_hitting_peak + 1) /
+                                        (double)(trace.down_scan_counter + trace.up_scan_counter + 1);
+            if (trace.down_scan_counter > min_scans_to_consider && trace.current_sample_rate < min_sample_rate_)
             {
-              current_sample_rate = (double)(down_hitting_peak + up_hitting_peak + 1) /
-                                    (double)(down_scan_counter + up_scan_counter + 1);
-              if (down_scan_counter > min_scans_to_consider && current_sample_rate < min_sample_rate_)
-              {
-                // std::cout << "stopping down..." << std::endl;
-                toggle_down = false;
-              }
+              // std::cout << "stopping down..." << std::endl;
+              trace.toggle_down = false;
             }
           }
+        }
 
-          // *********************************************************** //
-          // Step 2.2 MOVE UP in RT dim
-          // *********************************************************** //
-          if ((trace_up_idx < work_exp.size() - 1) && toggle_up)
+        // *********************************************************** //
+        // Step 2.2 MOVE UP in RT dim
+        // *********************************************************** //
+        if ((trace.up_idx + 1 < end_scan) && trace.toggle_up)
+        {
+          const Size scan_up(trace.up_idx + 1);
+          const MSSpectrum& spec_trace_up = work_exp[scan_up - first_scan];
+          if (!spec_trace_up.empty())
           {
-            const MSSpectrum& spec_trace_up = work_exp[trace_up_idx + 1];
-            if (!spec_trace_up.empty())
-            {
-              Size next_up_peak_idx = spec_trace_up.findNearest(centroid_mz);
-              double next_up_peak_mz = spec_trace_up[next_up_peak_idx].getMZ();
-              double next_up_peak_int = spec_trace_up[next_up_peak_idx].getIntensity();
+            Size next_up_peak_idx = spec_trace_up.findNearest(trace.centroid_mz);
+            double next_up_peak_mz = spec_trace_up[next_up_peak_idx].getMZ();
+            double next_up_peak_int = spec_trace_up[next_up_peak_idx].getIntensity();
 
-              double right_bound = centroid_mz + 3 * ftl_sd;
-              double left_bound = centroid_mz - 3 * ftl_sd;
+            double right_bound = trace.centroid_mz + 3 * trace.ftl_sd;
+            double left_bound = trace.centroid_mz - 3 * trace.ftl_sd;
 
-              if ((next_up_peak_mz <= right_bound) &&
-                  (next_up_peak_mz >= left_bound) &&
-                  !peak_visited[spec_offsets[trace_up_idx + 1] + next_up_peak_idx])
-              {
-                Peak2D next_peak;
-                next_peak.setRT(spec_trace_up.getRT());
-                next_peak.setMZ(next_up_peak_mz);
-                next_peak.setIntensity(next_up_peak_int);
+            if ((next_up_peak_mz <= right_bound) &&
+                (next_up_peak_mz >= left_bound) &&
+                !peak_visited[spec_offsets[scan_up - first_scan] + next_up_peak_idx])
+            {
+              Peak2D next_peak;
+              next_peak.setRT(spec_trace_up.getRT());
+              next_peak.setMZ(next_up_peak_mz);
+              next_peak.setIntensity(next_up_peak_int);
 
-                current_trace.push_back(next_peak);
-                if (fwhm_meta_idx != -1)
-                {
-                  fwhms_mz.push_back(spec_trace_up.getFloatDataArrays()[fwhm_meta_idx][next_up_peak_idx]);
-                }
-                // Update the m/z mean of the current trace as we added a new peak
-                updateIterativeWeightedMeanMZ(next_up_peak_mz, next_up_peak_int, centroid_mz, prev_counter, prev_denom);
-                gathered_idx.push_back(std::make_pair(trace_up_idx + 1, next_up_peak_idx));
+              trace.peaks.push_back(next_peak);
+              if (fwhm_meta_idx != -1)
+              {
+                trace.fwhms_mz.push_back(spec_trace_up.getFloatDataArrays()[fwhm_meta_idx][next_up_peak_idx]);
+              }
+              // Update the m/z mean of the current trace as we added a new peak
+              updateIterativeWeightedMeanMZ(next_up_peak_mz, next_up_peak_int, trace.centroid_mz, trace.prev_counter, trace.prev_denom);
+              trace.gathered_idx.push_back(std::make_pair(scan_up, next_up_peak_idx));
 
-                // Update the m/z variance dynamically
-                if (reestimate_mt_sd_)           //  && (up_hitting_peak+1 > min_flank_scans))
+              // Update the m/z variance dynamically
+              if (reestimate_mt_sd_)           //  && (up_hitting_peak+1 > min_flank_scans))
+              {
+                // if (ftl_t > min_fwhm_scans)
                 {
-                  // if (ftl_t > min_fwhm_scans)
-                  {
-                    updateWeightedSDEstimateRobust(next_peak, centroid_mz, ftl_sd, intensity_so_far);
-                  }
+                  updateWeightedSDEstimateRobust(next_peak, trace.centroid_mz, trace.ftl_sd, trace.intensity_so_far);
                 }
-
-                ++up_hitting_peak;
-                conseq_missed_peak_up = 0;
-
-              }
-              else
-              {
-                ++conseq_missed_peak_up;
               }
 
-            }
-
-            ++trace_up_idx;
-            ++up_scan_counter;
+              ++trace.up_hitting_peak;
+              trace.conseq_missed_peak_up = 0;
 
-            if (trace_termination_criterion_ == "outlier")
-            {
-              if (conseq_missed_peak_up > max_consecutive_missing)
-              {
-                toggle_up = false;
-              }
             }
-            else if (trace_termination_criterion_ == "sample_rate")
+            else
             {
-              current_sample_rate = (double)(down_hitting_peak + up_hitting_peak + 1) / (double)(down_scan_counter + up_scan_counter + 1);
-
-              if (up_scan_counter > min_scans_to_consider && current_sample_rate < min_sample_rate_)
-              {
-                // std::cout << "stopping up" << std::endl;
-                toggle_up = false;
-              }
+              ++trace.conseq_missed_peak_up;
             }
 
-
           }
 
-        }
+          ++trace.up_idx;
+          ++trace.up_scan_counter;
 
-        // std::cout << "current sr: " << current_sample_rate << std::endl;
-        double num_scans(down_scan_counter + up_scan_counter + 1 - conseq_missed_peak_down - conseq_missed_peak_up);
+          if (trace_termination_criterion_ == "outlier")
+          {
+            if (trace.conseq_missed_peak_up > max_consecutive_missing)
+            {
+              trace.toggle_up = false;
+            }
+          }
+          else if (trace_termination_criterion_ == "sample_rate")
+          {
+            trace.current_sample_rate = (double)(trace.down_hitting_peak + trace.up_hitting_peak + 1) /
+                                        (double)(trace.down_scan_counter + trace.up_scan_counter + 1);
 
-        double mt_quality((double)current_trace.size() / (double)num_scans);
-        // std::cout << "mt quality: " << mt_quality << std::endl;
-        double rt_range(std::fabs(current_trace.rbegin()->getRT() - current_trace.begin()->getRT()));
+            if (trace.up_scan_counter > min_scans_to_consider && trace.current_sample_rate < min_sample_rate_)
+            {
+              // std::cout << "stopping up" << std::endl;
+              trace.toggle_up = false;
+            }
+          }
 
-        // *********************************************************** //
-        // Step 2.3 check if minimum length and quality of mass trace criteria are met
-        // *********************************************************** //
-        bool max_trace_criteria = (max_trace_length_ < 0.0 || rt_range < max_trace_length_);
-        if (rt_range >= min_trace_length_ && max_trace_criteria && mt_quality >= min_sample_rate_)
-        {
-          // std::cout << "T" << trace_number << "\t" << mt_quality << std::endl;
 
-          // mark all peaks as visited
-          for (Size i = 0; i < gathered_idx.size(); ++i)
-          {
-            peak_visited[spec_offsets[gathered_idx[i].first] +  gathered_idx[i].second] = true;
-          }
+        }
 
-          // create new MassTrace object and store collected peaks from list current_trace
-          MassTrace new_trace(current_trace);
-          new_trace.updateWeightedMeanRT();
-          new_trace.updateWeightedMeanMZ();
-          if (!fwhms_mz.empty()) new_trace.fwhm_mz_avg = Math::median(fwhms_mz.begin(), fwhms_mz.end());
-          new_trace.setQuantMethod(quant_method_);
-          //new_trace.setCentroidSD(ftl_sd);
-          new_trace.updateWeightedMZsd();
-          new_trace.setLabel("T" + String(trace_number));
-          ++trace_number;
+      }
+    }
 
-          found_masstraces.push_back(new_trace);
+    bool MassTraceDetection::storeTrace_(const TraceState_& trace, const Size first_scan, const std::vector<Size>& spec_offsets,
+                                         std::vector<bool>& peak_visited, Size& trace_number, std::vector<MassTrace>& found_masstraces)
+    {
+      // std::cout << "current sr: " << current_sample_rate << std::endl;
+      double num_scans(trace.down_scan_counter + trace.up_scan_counter + 1 - trace.conseq_missed_peak_down - trace.conseq_missed_peak_up);
 
-          peaks_detected += new_trace.getSize();
-          this->setProgress(peaks_detected);
+      double mt_quality((double)trace.peaks.size() / (double)num_scans);
+      // std::cout << "mt quality: " << mt_quality << std::endl;
+      double rt_range(std::fabs(trace.peaks.rbegin()->getRT() - trace.peaks.begin()->getRT()));
 
-          // check if we already reached the (optional) maximum number of traces
-          if (max_traces > 0 && found_masstraces.size() == max_traces) break;
-        }
+      // *********************************************************** //
+      // Step 2.3 check if minimum length and quality of mass trace criteria are met
+      // *********************************************************** //
+      bool max_trace_criteria = (max_trace_length_ < 0.0 || rt_range < max_trace_length_);
+      if (!(rt_range >= min_trace_length_ && max_trace_criteria && mt_quality >= min_sample_rate_))
+      {
+        return false;
       }
+      // std::cout << "T" << trace_number << "\t" << mt_quality << std::endl;
 
-      this->endProgress();
+      // mark all peaks as visited
+      for (Size i = 0; i < trace.gathered_idx.size(); ++i)
+      {
+        if (trace.gathered_idx[i].first < first_scan) continue; // no longer in memory
+        peak_visited[spec_offsets[trace.gathered_idx[i].first - first_scan] + trace.gathered_idx[i].second] = true;
+      }
 
+      // create new MassTrace object and store collected peaks from list current_trace
+      MassTrace new_trace(trace.peaks);
+      new_trace.updateWeightedMeanRT();
+      new_trace.updateWeightedMeanMZ();
+      if (!trace.fwhms_mz.empty())
+      {
+        std::vector<double> fwhms_mz(trace.fwhms_mz);
+        new_trace.fwhm_mz_avg = Math::median(fwhms_mz.begin(), fwhms_mz.end());
+      }
+      new_trace.setQuantMethod(quant_method_);
+      //new_trace.setCentroidSD(ftl_sd);
+      new_trace.updateWeightedMZsd();
+      new_trace.setLabel("T" + String(trace_number));
+      ++trace_number;
+
+      found_masstraces.push_back(new_trace);
+      return true;
     }
 
     void MassTraceDetection::updateMembers_()
@@ -34,6 +34,10 @@
 
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilter.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
 
@@ -60,4 +64,141 @@ namespace OpenMS
             (double)param_.getValue("ppm_tolerance"), param_.getValue("use_ppm_tolerance").toBool());
   }
 
+  void GaussFilter::filterExperiment(PeakMap & map)
+  {
+    if (param_.getValue("use_ppm_tolerance").toBool() && !map.getChromatograms().empty())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+        "GaussFilter: Cannot use ppm tolerance on chromatograms");
+    }
+
+    Size progress = 0;
+    startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // per-thread algorithm (its kernel changes for every data point in ppm mode) and scratch space
+      GaussFilterAlgorithm algo = gauss_algo_;
+      FilterBuffers_ buffers;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
+      {
+        filterSpectrum_(map[i], algo, buffers);
+
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
+      {
+        filterChromatogram_(map.getChromatogram(i), algo, buffers);
+
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+      }
+    }
+    endProgress();
+  }
+
+  void GaussFilter::filterSpectrum_(MSSpectrum & spectrum, GaussFilterAlgorithm & algo, FilterBuffers_ & buffers) const
+  {
+    // make sure the right data type is set
+    spectrum.setType(SpectrumSettings::PROFILE);
+    const Size data_size = spectrum.size();
+    buffers.pos_in.resize(data_size);
+    buffers.int_in.resize(data_size);
+    buffers.pos_out.resize(data_size);
+    buffers.int_out.resize(data_size);
+
+    // copy spectrum to container
+    for (Size p = 0; p < data_size; ++p)
+    {
+      buffers.pos_in[p] = spectrum[p].getMZ();
+      buffers.int_in[p] = static_cast<double>(spectrum[p].getIntensity());
+    }
+
+    // apply filter
+    bool found_signal = algo.filter(buffers.pos_in.cbegin(), buffers.pos_in.cend(), buffers.int_in.cbegin(), buffers.pos_out.begin(), buffers.int_out.begin());
+
+    // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
+    // This is the case if the Gaussian filter is smaller than the spacing of raw data
+    if (!found_signal && data_size >= 3)
+    {
+      String error_message = "Found no signal. The Gaussian width is probably smaller than the spacing in your profile data. Try to use a bigger width.";
+      if (spectrum.getRT() > 0.0)
+      {
+        error_message += String(" The error occurred in the spectrum with retention time ") + spectrum.getRT() + ".";
+      }
+#ifdef _OPENMP
+#pragma omp critical (GaussFilter_log)
+#endif
+      OPENMS_LOG_ERROR << error_message << std::endl;
+    }
+    else
+    {
+      // copy the new data into the spectrum
+      for (Size p = 0; p < data_size; ++p)
+      {
+        spectrum[p].setIntensity(buffers.int_out[p]);
+        spectrum[p].setMZ(buffers.pos_out[p]);
+      }
+    }
+  }
+
+  void GaussFilter::filterChromatogram_(MSChromatogram & chromatogram, GaussFilterAlgorithm & algo, FilterBuffers_ & buffers) const
+  {
+    const Size data_size = chromatogram.size();
+    buffers.pos_in.resize(data_size);
+    buffers.int_in.resize(data_size);
+    buffers.pos_out.resize(data_size);
+    buffers.int_out.resize(data_size);
+
+    // copy chromatogram to container
+    for (Size p = 0; p < data_size; ++p)
+    {
+      buffers.pos_in[p] = chromatogram[p].getRT();
+      buffers.int_in[p] = chromatogram[p].getIntensity();
+    }
+
+    // apply filter
+    bool found_signal = algo.filter(buffers.pos_in.cbegin(), buffers.pos_in.cend(), buffers.int_in.cbegin(), buffers.pos_out.begin(), buffers.int_out.begin());
+
+    // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
+    // This is the case if the Gaussian filter is smaller than the spacing of raw data
+    if (!found_signal && data_size >= 3)
+    {
+      String error_message = "Found no signal. The Gaussian width is probably smaller than the spacing in your chromatogram data. Try to use a bigger width.";
+      if (chromatogram.getMZ() > 0.0)
+      {
+        error_message += String(" The error occurred in the chromatogram with m/z time ") + chromatogram.getMZ() + ".";
+      }
+#ifdef _OPENMP
+#pragma omp critical (GaussFilter_log)
+#endif
+      OPENMS_LOG_ERROR << error_message << std::endl;
+    }
+    else
+    {
+      // copy the new data into the chromatogram
+      for (Size p = 0; p < data_size; ++p)
+      {
+        chromatogram[p].setIntensity(buffers.int_out[p]);
+        chromatogram[p].setMZ(buffers.pos_out[p]);
+      }
+    }
+  }
+
 }
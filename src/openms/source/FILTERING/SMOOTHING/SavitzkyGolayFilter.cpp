@@ -38,6 +38,10 @@
 #include <Eigen/Core>
 #include <Eigen/SVD>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   SavitzkyGolayFilter::SavitzkyGolayFilter() :
@@ -55,6 +59,100 @@ namespace OpenMS
   {
   }
 
+  void SavitzkyGolayFilter::filterExperiment(PeakMap & map)
+  {
+    Size progress = 0;
+    startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // per-thread scratch space, reused for all spectra and chromatograms of this thread
+      std::vector<double> int_in, int_out;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
+      {
+        filterIntensities_(map[i], int_in, int_out);
+
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
+      {
+        filterIntensities_(map.getChromatogram(i), int_in, int_out);
+
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+      }
+    }
+    endProgress();
+  }
+
+  void SavitzkyGolayFilter::smoothIntensities_(const std::vector<double> & in, std::vector<double> & out) const
+  {
+    const Size n = in.size();
+    const Size mid = frame_size_ / 2;
+    out.assign(n, 0.0);
+
+    // transient on: the first mid + 1 points use the asymmetric coefficient sets
+    for (Size i = 0; i <= mid; ++i)
+    {
+      double help = 0;
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        help += in[j] * coeffs_[(i + 1) * frame_size_ - 1 - j];
+      }
+      out[i] = help;
+    }
+
+    // steady state: points [mid + 1, n - mid) share the symmetric coefficient set. Instead of one dot
+    // product per point, add one coefficient times the shifted input to all outputs at once. The
+    // summation order per point is the same as in filter(), but the inner loop is contiguous.
+    if (n > 2 * mid + 1)
+    {
+      const Size count = n - 2 * mid - 1;
+      double* dst = &out[mid + 1];
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        const double coeff = coeffs_[mid * frame_size_ + j];
+        const double* src = &in[j + 1];
+        for (Size k = 0; k < count; ++k)
+        {
+          dst[k] += src[k] * coeff;
+        }
+      }
+    }
+
+    // transient off: the last mid points
+    for (Size i = 0; i < mid; ++i)
+    {
+      double help = 0;
+      for (Size j = 0; j < frame_size_; ++j)
+      {
+        help += in[n - frame_size_ + j] * coeffs_[i * frame_size_ + j];
+      }
+      out[n - 1 - i] = help;
+    }
+
+    for (Size p = 0; p < n; ++p)
+    {
+      out[p] = std::max(0.0, out[p]);
+    }
+  }
+
   void SavitzkyGolayFilter::updateMembers_()
   {
     frame_size_ = (UInt)param_.getValue("frame_length");
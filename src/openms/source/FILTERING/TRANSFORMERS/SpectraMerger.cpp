@@ -34,6 +34,7 @@
 //
 
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
+#include <OpenMS/COMPARISON/CLUSTERING/FlatHashGrid.h>
 
 using namespace std;
 namespace OpenMS
@@ -90,6 +91,8 @@ namespace OpenMS
     defaults_.setMinFloat("precursor_method:mz_tolerance", 0);
     defaults_.setValue("precursor_method:rt_tolerance", 5.0, "Max RT distance of the precursor entries of two spectra to be merged in [s].");
     defaults_.setMinFloat("precursor_method:rt_tolerance", 0);
+    defaults_.setValue("precursor_method:clustering", "grid", "How to find spectra with similar precursors. 'grid' only compares precursors in neighbouring cells of an RT/m/z grid and scales to large numbers of spectra, 'single_linkage' computes all pairwise distances (quadratic runtime and memory). Both yield the same result.", ListUtils::create<String>("advanced"));
+    defaults_.setValidStrings("precursor_method:clustering", ListUtils::create<String>("grid,single_linkage"));
 
     defaultsToParam_();
   }
@@ -112,4 +115,100 @@ namespace OpenMS
     return *this;
   }
 
+  void SpectraMerger::clusterPrecursors_(const vector<BaseFeature>& data, const SpectraDistance_& distance, vector<vector<Size> >& clusters) const
+  {
+    clusters.clear();
+    const double rt_tolerance = param_.getValue("precursor_method:rt_tolerance");
+    const double mz_tolerance = param_.getValue("precursor_method:mz_tolerance");
+    // with a tolerance of zero the similarity is undefined (0/0), nothing is linked
+    if (data.size() < 2 || !(rt_tolerance > 0) || !(mz_tolerance > 0))
+    {
+      return;
+    }
+
+    // any cell size >= tolerance finds all partners in the 3x3 neighbourhood; very small cells would
+    // only produce (possibly unrepresentable) huge cell indices
+    typedef FlatHashGrid<Size> Grid;
+    Grid::ClusterCenter cell_dimension(max(rt_tolerance, 1e-6), max(mz_tolerance, 1e-6));
+    vector<Grid::value_type> elements;
+    elements.reserve(data.size());
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      elements.push_back(make_pair(Grid::ClusterCenter(data[i].getRT(), data[i].getMZ()), i));
+    }
+    const Grid grid(cell_dimension, elements);
+
+    // linked partners with a higher index for every precursor
+    vector<vector<Size> > partners(data.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)data.size(); ++i)
+    {
+      Grid::Range ranges[Grid::NEIGHBOURHOOD_SIZE];
+      const Size range_count = grid.neighbourhood(grid.cellIndexAt(elements[i].first), ranges);
+      for (Size r = 0; r < range_count; ++r)
+      {
+        for (const Grid::value_type& element : ranges[r])
+        {
+          const Size j = element.second;
+          if (j <= (Size)i) continue;
+          // same criterion as for the (float) distance matrix used by single linkage clustering
+          const float dist = 1 - distance(data[i], data[j]);
+          if (dist < 1)
+          {
+            partners[i].push_back(j);
+          }
+        }
+      }
+    }
+
+    // connected components (union-find, the smallest index is the root)
+    vector<Size> parent(data.size());
+    for (Size i = 0; i < parent.size(); ++i)
+    {
+      parent[i] = i;
+    }
+    auto find_root = [&parent](Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    };
+    for (Size i = 0; i < partners.size(); ++i)
+    {
+      for (Size j : partners[i])
+      {
+        Size root_i = find_root(i), root_j = find_root(j);
+        if (root_i == root_j) continue;
+        if (root_j < root_i) swap(root_i, root_j);
+        parent[root_j] = root_i;
+      }
+    }
+
+    // collect groups; indices are visited in increasing order, so groups are sorted and ordered by their root
+    vector<Size> cluster_of(data.size(), numeric_limits<Size>::max());
+    vector<vector<Size> > components;
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      const Size root = find_root(i);
+      if (cluster_of[root] == numeric_limits<Size>::max())
+      {
+        cluster_of[root] = components.size();
+        components.push_back(vector<Size>());
+      }
+      components[cluster_of[root]].push_back(i);
+    }
+    for (Size c = 0; c < components.size(); ++c)
+    {
+      if (components[c].size() > 1)
+      {
+        clusters.push_back(move(components[c]));
+      }
+    }
+  }
+
 }
@@ -37,6 +37,17 @@
 #include <QtCore/QList>
 #include <QtCore/QString>
 
+#include <cstring>
+
+#if defined(__GNUC__) || defined(__clang__)
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
 using namespace std;
 
 namespace OpenMS
@@ -81,48 +92,380 @@ namespace OpenMS
      +   = 43       ->       62
      /   = 47       ->       63
 
+  The scalar decoder uses a direct mapping lookup[char] over all 256 byte
+  values where every character outside of the alphabet maps to 0xFF, which
+  allows us to detect invalid input.
 
-  this can be done by first subtracting 43 from each value
-  and then looking up a value in a table as found in the code,
-  e.g. lookup[char - 43] - 62
+  The vectorized kernels (SSE4.1 and AVX2) are based on the approach by
+  Wojciech Mula and Daniel Lemire ("Faster Base64 Encoding and Decoding
+  using AVX2 Instructions", ACM TOW 2018): the character ranges of the
+  alphabet are identified using nibble lookups (pshufb) and the 6 bit values
+  are packed into bytes using multiply-add instructions. They produce
+  exactly the same output as the scalar code, which is always used for the
+  remaining bytes at the end of the input. Which kernel is used is decided
+  at runtime based on the capabilities of the CPU.
 
-  The following string can be produced by this Python snippet:
+  */
 
-offset = 62
-s = ""
-s += chr(62 + offset)
-s += '$' * 3
-s += "".join([ chr(52 + i + offset) for i in range(10) ])
-s += '$' * 7
-s += "".join([ chr(i + offset) for i in range(26) ])
-s += '$' * 6
-s += "".join([ chr(26 + i + offset) for i in range(26) ])
-print s
+  const char Base64::encoder_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-"|$$$rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\]^_`abcdefghijklmnopq"
+  namespace
+  {
+    const Byte INVALID_CHAR = 0xFF;
 
-  however, this is basically just convenience to produce printable characters.
-  We could also go for a direct mapping:
+    struct DecoderTable
+    {
+      Byte value[256];
 
-s = '$' * 42
-s += hex(62)
-s += '$' * 3
-s += "".join([ hex(52 + i) for i in range(10) ])
-s += '$' * 7
-s += "".join([ hex(i) for i in range(26) ])
-s += '$' * 6
-s += "".join([ hex(26 + i) for i in range(26) ])
-print s
+      DecoderTable()
+      {
+        std::fill(value, value + 256, INVALID_CHAR);
+        const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (Size i = 0; i < alphabet.size(); ++i)
+        {
+          value[(Byte)alphabet[i]] = (Byte)i;
+        }
+      }
+    };
 
-"$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$0x3e$$$0x340x350x360x370x380x390x3a0x3b0x3c0x3d$$$$$$$0x00x10x20x30x40x50x60x70x80x90xa0xb0xc0xd0xe0xf0x100x110x120x130x140x150x160x170x180x19$$$$$$0x1a0x1b0x1c0x1d0x1e0x1f0x200x210x220x230x240x250x260x270x280x290x2a0x2b0x2c0x2d0x2e0x2f0x300x310x320x33"
+    const DecoderTable& decoderTable()
+    {
+      static const DecoderTable table;
+      return table;
+    }
 
-  which would allow lookup[char] without any adding or subtraction step (but
-  needs a 42 byte extra memory in the local cache).
+    /// Encodes 3 bytes into 4 characters
+    inline void encodeTriplet(const Byte* in, char* out, const char* encoder)
+    {
+      const UInt32 int_24bit = (UInt32(in[0]) << 16) | (UInt32(in[1]) << 8) | UInt32(in[2]);
+      out[0] = encoder[(int_24bit >> 18) & 0x3F];
+      out[1] = encoder[(int_24bit >> 12) & 0x3F];
+      out[2] = encoder[(int_24bit >> 6) & 0x3F];
+      out[3] = encoder[int_24bit & 0x3F];
+    }
 
-  */
+    /// Decodes 4 characters into 3 bytes, returns false if any character is invalid
+    inline bool decodeQuad(const char* in, Byte* out, const Byte* table)
+    {
+      const Byte a = table[(Byte)in[0]];
+      const Byte b = table[(Byte)in[1]];
+      const Byte c = table[(Byte)in[2]];
+      const Byte d = table[(Byte)in[3]];
+      if ((a | b | c | d) & 0xC0) return false;
+      out[0] = (Byte)((a << 2) | (b >> 4));
+      out[1] = (Byte)(((b & 15) << 4) | (c >> 2));
+      out[2] = (Byte)(((c & 3) << 6) | d);
+      return true;
+    }
 
-  const char Base64::encoder_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  const char Base64::decoder_[] = "|$$$}rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
+    enum SimdLevel
+    {
+      SIMD_NONE,
+      SIMD_SSE41,
+      SIMD_AVX2
+    };
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define OPENMS_BASE64_SIMD 1
+#define OPENMS_BASE64_TARGET(x) __attribute__((target(x)))
+
+    SimdLevel detectSimdLevel()
+    {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+      if (__builtin_cpu_supports("sse4.1")) return SIMD_SSE41;
+      return SIMD_NONE;
+    }
+
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define OPENMS_BASE64_SIMD 1
+#define OPENMS_BASE64_TARGET(x)
+
+    SimdLevel detectSimdLevel()
+    {
+      int info[4];
+      __cpuid(info, 0);
+      const int max_leaf = info[0];
+      if (max_leaf < 1) return SIMD_NONE;
+      __cpuid(info, 1);
+      const bool sse41 = (info[2] & (1 << 19)) != 0;
+      const bool osxsave = (info[2] & (1 << 27)) != 0;
+      const bool avx = (info[2] & (1 << 28)) != 0;
+      if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+      {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) return SIMD_AVX2;
+      }
+      return sse41 ? SIMD_SSE41 : SIMD_NONE;
+    }
+
+#else
+
+    SimdLevel detectSimdLevel()
+    {
+      return SIMD_NONE;
+    }
+
+#endif
+
+    SimdLevel simdLevel()
+    {
+      static const SimdLevel level = detectSimdLevel();
+      return level;
+    }
+
+#ifdef OPENMS_BASE64_SIMD
+
+    OPENMS_BASE64_TARGET("sse4.1")
+    inline __m128i encodeReshuffle128(__m128i in)
+    {
+      in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+      const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+      const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+      const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+      const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+      return _mm_or_si128(t1, t3);
+    }
+
+    OPENMS_BASE64_TARGET("sse4.1")
+    inline __m128i encodeTranslate128(__m128i in)
+    {
+      // offsets for the ranges A-Z, a-z, 0-9 (10 entries), '+' and '/'
+      const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+      __m128i indices = _mm_subs_epu8(in, _mm_set1_epi8(51));
+      const __m128i mask = _mm_cmpgt_epi8(in, _mm_set1_epi8(25));
+      indices = _mm_sub_epi8(indices, mask);
+      return _mm_add_epi8(in, _mm_shuffle_epi8(lut, indices));
+    }
+
+    // Encodes blocks of 12 bytes into 16 characters (reads 16 bytes per block)
+    OPENMS_BASE64_TARGET("sse4.1")
+    Size encodeSSE41(const Byte* in, Size length, char* out)
+    {
+      Size processed = 0;
+      while (length - processed >= 16)
+      {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + processed));
+        v = encodeTranslate128(encodeReshuffle128(v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+        out += 16;
+        processed += 12;
+      }
+      return processed;
+    }
+
+    OPENMS_BASE64_TARGET("avx2")
+    Size encodeAVX2(const Byte* in, Size length, char* out)
+    {
+      const __m256i shuffle = _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                              10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+      const __m256i lut = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                           65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+      Size processed = 0;
+      while (length - processed >= 28)
+      {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + processed));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + processed + 12));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+        v = _mm256_shuffle_epi8(v, shuffle);
+        const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        v = _mm256_or_si256(t1, t3);
+
+        __m256i indices = _mm256_subs_epu8(v, _mm256_set1_epi8(51));
+        const __m256i mask = _mm256_cmpgt_epi8(v, _mm256_set1_epi8(25));
+        indices = _mm256_sub_epi8(indices, mask);
+        v = _mm256_add_epi8(v, _mm256_shuffle_epi8(lut, indices));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+        out += 32;
+        processed += 24;
+      }
+      return processed;
+    }
+
+    // Decodes blocks of 16 characters into 12 bytes, stops at the first block with invalid characters
+    OPENMS_BASE64_TARGET("sse4.1")
+    Size decodeSSE41(const char* in, Size length, Byte* out)
+    {
+      const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+      const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                           0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+      const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m128i mask_2F = _mm_set1_epi8(0x2F);
+
+      Size processed = 0;
+      while (length - processed >= 16)
+      {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + processed));
+        const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), mask_2F);
+        const __m128i lo_nibbles = _mm_and_si128(v, mask_2F);
+        const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        const __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+        // invalid characters: leave them to the scalar code
+        if (!_mm_testz_si128(lo, hi)) break;
+
+        const __m128i eq_2F = _mm_cmpeq_epi8(v, mask_2F);
+        const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2F, hi_nibbles));
+        v = _mm_add_epi8(v, roll);
+
+        const __m128i merge_ab_and_bc = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+        v = _mm_madd_epi16(merge_ab_and_bc, _mm_set1_epi32(0x00011000));
+        v = _mm_shuffle_epi8(v, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), v);
+        const Int32 last = _mm_extract_epi32(v, 2);
+        std::memcpy(out + 8, &last, 4);
+        out += 12;
+        processed += 16;
+      }
+      return processed;
+    }
+
+    OPENMS_BASE64_TARGET("avx2")
+    Size decodeAVX2(const char* in, Size length, Byte* out)
+    {
+      const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                              0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                              0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                              0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+      const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                              0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                              0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                              0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+      const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+      const __m256i mask_2F = _mm256_set1_epi8(0x2F);
+      const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+      Size processed = 0;
+      while (length - processed >= 32)
+      {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + processed));
+        const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask_2F);
+        const __m256i lo_nibbles = _mm256_and_si256(v, mask_2F);
+        const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        const __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        // invalid characters: leave them to the scalar code
+        if (!_mm256_testz_si256(lo, hi)) break;
+
+        const __m256i eq_2F = _mm256_cmpeq_epi8(v, mask_2F);
+        const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2F, hi_nibbles));
+        v = _mm256_add_epi8(v, roll);
+
+        const __m256i merge_ab_and_bc = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        v = _mm256_madd_epi16(merge_ab_and_bc, _mm256_set1_epi32(0x00011000));
+        v = _mm256_shuffle_epi8(v, pack);
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(v));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(v, 1));
+        out += 24;
+        processed += 32;
+      }
+      return processed;
+    }
+
+#endif
+  }
+
+  void Base64::encodeBytes_(const Byte* in, Size length, String& out)
+  {
+    out.resize((length + 2) / 3 * 4);
+    if (length == 0) return;
+
+    char* to = &out[0];
+    Size processed = 0;
+#ifdef OPENMS_BASE64_SIMD
+    switch (simdLevel())
+    {
+      case SIMD_AVX2:
+        processed = encodeAVX2(in, length, to);
+        break;
+      case SIMD_SSE41:
+        processed = encodeSSE41(in, length, to);
+        break;
+      default:
+        break;
+    }
+    to += processed / 3 * 4;
+#endif
+
+    for (; length - processed >= 3; processed += 3, to += 4)
+    {
+      encodeTriplet(in + processed, to, encoder_);
+    }
+
+    // last incomplete triplet, fill up with zero bits and add padding
+    const Size remaining = length - processed;
+    if (remaining > 0)
+    {
+      Byte tail[3] = {0, 0, 0};
+      std::copy(in + processed, in + length, tail);
+      encodeTriplet(tail, to, encoder_);
+      to[3] = '=';
+      if (remaining == 1) to[2] = '=';
+    }
+  }
+
+  bool Base64::decodeBytes_(const char* in, Size length, std::string& out)
+  {
+    // skip trailing padding characters
+    while (length > 0 && in[length - 1] == '=') --length;
+
+    out.resize((length + 3) / 4 * 3);
+    if (out.empty()) return true;
+
+    Byte* to = reinterpret_cast<Byte*>(&out[0]);
+    const Size full_length = length / 4 * 4;
+    Size processed = 0;
+#ifdef OPENMS_BASE64_SIMD
+    switch (simdLevel())
+    {
+      case SIMD_AVX2:
+        processed = decodeAVX2(in, full_length, to);
+        break;
+      case SIMD_SSE41:
+        processed = decodeSSE41(in, full_length, to);
+        break;
+      default:
+        break;
+    }
+    to += processed / 4 * 3;
+#endif
+
+    const Byte* table = decoderTable().value;
+    for (; processed < full_length; processed += 4, to += 3)
+    {
+      if (!decodeQuad(in + processed, to, table)) return false;
+    }
+
+    // last incomplete group of characters, fill up with zero bits
+    if (length > processed)
+    {
+      char tail[4] = {'A', 'A', 'A', 'A'};
+      std::copy(in + processed, in + length, tail);
+      if (!decodeQuad(tail, to, table)) return false;
+    }
+    return true;
+  }
+
+  void Base64::decodeCompressedBytes_(const String& in, std::string& out)
+  {
+    QByteArray base64_uncompressed;
+    decodeSingleString(in, base64_uncompressed, true);
+    if (base64_uncompressed.isEmpty())
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+    }
+
+    out.assign(base64_uncompressed.constData(), base64_uncompressed.size());
+  }
 
   void Base64::encodeStrings(const std::vector<String>& in, String& out, bool zlib_compression, bool append_null_byte)
   {
@@ -132,8 +475,6 @@ print s
 
     std::string str;
     std::string compressed;
-    Byte* it;
-    Byte* end;
     for (Size i = 0; i < in.size(); ++i)
     {
       str = str.append(in[i]);
@@ -167,57 +508,12 @@ print s
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Compression error?");
       }
 
-      it = reinterpret_cast<Byte*>(&compressed[0]);
-      end = it + compressed_length;
-      // TODO check integer overflow
-      out.resize((Size)ceil(compressed_length / 3.) * 4); //resize output array in order to have enough space for all characters
+      encodeBytes_(reinterpret_cast<const Byte*>(compressed.data()), compressed_length, out);
     }
     else
     {
-      // TODO check integer overflow
-      out.resize((Size)ceil(str.size() / 3.) * 4); //resize output array in order to have enough space for all characters
-      it = reinterpret_cast<Byte*>(&str[0]);
-      end = it + str.size();
-    }
-    Byte* to = reinterpret_cast<Byte*>(&out[0]);
-    Size written = 0;
-
-    while (it != end)
-    {
-      Int int_24bit = 0;
-      Int padding_count = 0;
-
-      // construct 24-bit integer from 3 bytes
-      for (Size i = 0; i < 3; i++)
-      {
-        if (it != end)
-        {
-          int_24bit |= *it++ << ((2 - i) * 8);
-        }
-        else
-        {
-          padding_count++;
-        }
-      }
-
-      // write out 4 characters
-      for (Int i = 3; i >= 0; i--)
-      {
-        to[i] = encoder_[int_24bit & 0x3F];
-        int_24bit >>= 6;
-      }
-
-      // fixup for padding
-      if (padding_count > 0)
-        to[3] = '=';
-      if (padding_count > 1)
-        to[2] = '=';
-
-      to += 4;
-      written += 4;
+      encodeBytes_(reinterpret_cast<const Byte*>(str.data()), str.size(), out);
     }
-
-    out.resize(written); //no more space is needed
   }
 
   void Base64::decodeStrings(const String& in, std::vector<String>& out, bool zlib_compression)
@@ -252,23 +548,42 @@ print s
       return;
     }
 
-    QByteArray herewego = QByteArray::fromRawData(in.c_str(), (int) in.size());
-    base64_uncompressed = QByteArray::fromBase64(herewego);
-    if (zlib_compression)
+    std::string decoded;
+    if (decodeBytes_(in.c_str(), in.size(), decoded))
+    {
+      // remove the zero bits of an incomplete last group of characters
+      Size length = in.size();
+      while (length > 0 && in[length - 1] == '=') --length;
+      decoded.resize(length * 3 / 4);
+    }
+    else
     {
-      QByteArray czip;
-      czip.resize(4);
-      czip[0] = (base64_uncompressed.size() & 0xff000000) >> 24;
-      czip[1] = (base64_uncompressed.size() & 0x00ff0000) >> 16;
-      czip[2] = (base64_uncompressed.size() & 0x0000ff00) >> 8;
-      czip[3] = (base64_uncompressed.size() & 0x000000ff);
-      czip += base64_uncompressed;
-      base64_uncompressed = qUncompress(czip);
+      // Qt silently skips characters outside of the Base64 alphabet
+      QByteArray herewego = QByteArray::fromRawData(in.c_str(), (int) in.size());
+      QByteArray qt_decoded = QByteArray::fromBase64(herewego);
+      decoded.assign(qt_decoded.constData(), qt_decoded.size());
+    }
 
-      if (base64_uncompressed.isEmpty())
-      {
-        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-      }
+    if (!zlib_compression)
+    {
+      base64_uncompressed = QByteArray(decoded.data(), (int) decoded.size());
+      return;
+    }
+
+    // qUncompress expects the (expected) length of the data as 4 byte prefix
+    const int decoded_size = (int) decoded.size();
+    QByteArray czip;
+    czip.resize(4 + decoded_size);
+    czip[0] = (decoded_size & 0xff000000) >> 24;
+    czip[1] = (decoded_size & 0x00ff0000) >> 16;
+    czip[2] = (decoded_size & 0x0000ff00) >> 8;
+    czip[3] = (decoded_size & 0x000000ff);
+    std::copy(decoded.begin(), decoded.end(), czip.begin() + 4);
+    base64_uncompressed = qUncompress(czip);
+
+    if (base64_uncompressed.isEmpty())
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
     }
   }
 
@@ -44,6 +44,8 @@
 
 #include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 namespace OpenMS
 {
 
@@ -63,11 +65,16 @@ namespace OpenMS
 
   CachedmzML::CachedmzML(const CachedmzML & rhs) :
     meta_ms_experiment_(rhs.meta_ms_experiment_),
-    ifs_(rhs.filename_cached_.c_str(), std::ios::binary),
+    // the (read-only) memory mapping can safely be shared between copies
+    mapped_file_(rhs.mapped_file_),
+    use_mmap_(rhs.use_mmap_),
     filename_(rhs.filename_),
+    filename_cached_(rhs.filename_cached_),
     spectra_index_(rhs.spectra_index_),
     chrom_index_(rhs.chrom_index_)
   {
+    // open a new filestream, this is critical for parallel access to the same file
+    if (!use_mmap_) ifs_.open(filename_cached_.c_str(), std::ios::binary);
   }
 
   void CachedmzML::load_(const String& filename)
@@ -81,17 +88,113 @@ namespace OpenMS
     spectra_index_ = cache.getSpectraIndex();
     chrom_index_ = cache.getChromatogramIndex();;
 
-    // open the filestream
-    ifs_.open(filename_cached_.c_str(), std::ios::binary);
+    // open the filestream (or map the file)
+    if (use_mmap_) mapFile_();
+    else ifs_.open(filename_cached_.c_str(), std::ios::binary);
 
     // load the meta data from disk
     MzMLFile().load(filename, meta_ms_experiment_);
   }
 
+  void CachedmzML::mapFile_()
+  {
+    mapped_file_.reset();
+    try
+    {
+      mapped_file_ = std::make_shared<boost::iostreams::mapped_file_source>(filename_cached_);
+    }
+    catch (std::exception& /* e */)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_cached_);
+    }
+  }
+
+  void CachedmzML::setMemoryMapping(bool use_mmap)
+  {
+    if (use_mmap == use_mmap_) return;
+
+    use_mmap_ = use_mmap;
+    if (use_mmap_)
+    {
+      if (ifs_.is_open()) ifs_.close();
+      if (!filename_cached_.empty()) mapFile_();
+    }
+    else
+    {
+      mapped_file_.reset();
+      if (!filename_cached_.empty()) ifs_.open(filename_cached_.c_str(), std::ios::binary);
+    }
+  }
+
+  bool CachedmzML::getMemoryMapping() const
+  {
+    return use_mmap_;
+  }
+
+  std::pair<const char*, const char*> CachedmzML::mappedRange_(std::streampos offset) const
+  {
+    if (!use_mmap_ || !mapped_file_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Memory mapping is not enabled for " + filename_cached_);
+    }
+    const char* begin = mapped_file_->data();
+    const char* end = begin + mapped_file_->size();
+    if (offset < 0 || static_cast<size_t>(offset) >= mapped_file_->size())
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Offset lies outside of the mapped file", filename_cached_);
+    }
+    return std::make_pair(begin + static_cast<std::streamoff>(offset), end);
+  }
+
+  void CachedmzML::getSpectrumView(Size id, Internal::CachedMzMLHandler::DataView& view) const
+  {
+    OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
+
+    std::pair<const char*, const char*> range = mappedRange_(spectra_index_[id]);
+    Internal::CachedMzMLHandler::readSpectrumView(range.first, range.second, view);
+  }
+
+  void CachedmzML::getChromatogramView(Size id, Internal::CachedMzMLHandler::DataView& view) const
+  {
+    OPENMS_PRECONDITION(id < getNrChromatograms(), "Id cannot be larger than number of chromatograms");
+
+    std::pair<const char*, const char*> range = mappedRange_(chrom_index_[id]);
+    Internal::CachedMzMLHandler::readChromatogramView(range.first, range.second, view);
+  }
+
   MSSpectrum CachedmzML::getSpectrum(Size id)
   {
     OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
 
+    if (use_mmap_)
+    {
+      Internal::CachedMzMLHandler::DataView view;
+      getSpectrumView(id, view);
+
+      MSSpectrum s = meta_ms_experiment_.getSpectrum(id);
+      s.setMSLevel(view.ms_level);
+      s.setRT(view.rt);
+      s.reserve(view.first.size);
+      for (Size j = 0; j < view.first.size; j++)
+      {
+        Peak1D p;
+        p.setMZ(view.first[j]);
+        p.setIntensity(view.second[j]);
+        s.push_back(p);
+      }
+      for (const auto& arr : view.additional)
+      {
+        s.getFloatDataArrays().push_back(MSSpectrum::FloatDataArray());
+        MSSpectrum::FloatDataArray& fda = s.getFloatDataArrays().back();
+        fda.setName(String(std::string(arr.name, arr.name_size)));
+        fda.reserve(arr.size);
+        for (Size j = 0; j < arr.size; j++) fda.push_back(arr[j]);
+      }
+      return s;
+    }
+
     if ( !ifs_.seekg(spectra_index_[id]) )
     {
       std::cerr << "Error while reading spectrum " << id << " - seekg created an error when trying to change position to " << spectra_index_[id] << "." << std::endl;
@@ -109,6 +212,31 @@ namespace OpenMS
   {
     OPENMS_PRECONDITION(id < getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
+    if (use_mmap_)
+    {
+      Internal::CachedMzMLHandler::DataView view;
+      getChromatogramView(id, view);
+
+      MSChromatogram c = meta_ms_experiment_.getChromatogram(id);
+      c.reserve(view.first.size);
+      for (Size j = 0; j < view.first.size; j++)
+      {
+        ChromatogramPeak p;
+        p.setRT(view.first[j]);
+        p.setIntensity(view.second[j]);
+        c.push_back(p);
+      }
+      for (const auto& arr : view.additional)
+      {
+        c.getFloatDataArrays().push_back(MSChromatogram::FloatDataArray());
+        MSChromatogram::FloatDataArray& fda = c.getFloatDataArrays().back();
+        fda.setName(String(std::string(arr.name, arr.name_size)));
+        fda.reserve(arr.size);
+        for (Size j = 0; j < arr.size; j++) fda.push_back(arr[j]);
+      }
+      return c;
+    }
+
     if ( !ifs_.seekg(chrom_index_[id]) )
     {
       std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
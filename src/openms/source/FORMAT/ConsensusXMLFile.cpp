@@ -331,7 +331,8 @@ namespace OpenMS
       }
       else if (type == "string")
       {
-        last_meta_->setMetaValue(name, (String) attributeAsString_(attributes, "value"));
+        // short string values are often repeated across features (labels, file origins), share their storage
+        last_meta_->setMetaValue(name, stringUserParamValue_(attributeAsString_(attributes, "value")));
       }
       else
       {
@@ -0,0 +1,1237 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/FeatureBinFile.h>
+
+#include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+using namespace std;
+
+namespace OpenMS
+{
+  const UInt32 FeatureBinFile::VERSION = 1;
+
+  namespace
+  {
+    // magic numbers (first 8 bytes of a file) for the two kinds of maps
+    const char FEATURE_MAGIC[8] = {'O', 'M', 'S', 'F', 'E', 'A', 'T', 'B'};
+    const char CONSENSUS_MAGIC[8] = {'O', 'M', 'S', 'C', 'O', 'N', 'S', 'B'};
+
+    // written in native byte order, reads back differently on machines with another byte order
+    const UInt32 BYTE_ORDER_MARK = 0x01020304;
+
+    /// Writes values, strings and arrays in native byte order to a (seekable) stream
+    class BinaryWriter
+    {
+public:
+      explicit BinaryWriter(std::ostream& os) :
+        os_(os)
+      {
+      }
+
+      template <typename T>
+      void write(const T& value)
+      {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be written directly");
+        os_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void writeBool(bool value)
+      {
+        write<unsigned char>(value ? 1 : 0);
+      }
+
+      void writeBytes(const char* data, UInt64 size)
+      {
+        os_.write(data, size);
+      }
+
+      void writeString(const String& s)
+      {
+        write<UInt64>(s.size());
+        writeBytes(s.c_str(), s.size());
+      }
+
+      void writeStrings(const std::vector<String>& strings)
+      {
+        write<UInt64>(strings.size());
+        for (const String& s : strings) writeString(s);
+      }
+
+      template <typename T>
+      void writeArray(const std::vector<T>& values)
+      {
+        static_assert(std::is_arithmetic<T>::value, "only arrays of arithmetic types can be written directly");
+        write<UInt64>(values.size());
+        if (!values.empty()) os_.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+      }
+
+      /// Starts a section; its size is filled in by endSection()
+      std::streampos beginSection()
+      {
+        write<UInt64>(0);
+        return os_.tellp();
+      }
+
+      /// Ends the section started at @p start
+      void endSection(std::streampos start)
+      {
+        std::streampos end = os_.tellp();
+        os_.seekp(start - std::streamoff(sizeof(UInt64)));
+        write<UInt64>(UInt64(end - start));
+        os_.seekp(end);
+      }
+
+private:
+      std::ostream& os_;
+    };
+
+    /// Reads what BinaryWriter wrote, throws Exception::ParseError on truncated or corrupt input
+    class BinaryReader
+    {
+public:
+      BinaryReader(std::istream& is, const String& filename) :
+        is_(is),
+        filename_(filename)
+      {
+        is_.seekg(0, std::ios::end);
+        file_size_ = is_.tellg();
+        is_.seekg(0, std::ios::beg);
+      }
+
+      template <typename T>
+      T read()
+      {
+        static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be read directly");
+        T value;
+        readBytes(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+      }
+
+      bool readBool()
+      {
+        return read<unsigned char>() != 0;
+      }
+
+      String readString()
+      {
+        UInt64 size = readSize(1);
+        String s(size, '\0');
+        if (size > 0) readBytes(&s[0], size);
+        return s;
+      }
+
+      void readStrings(std::vector<String>& strings)
+      {
+        strings.resize(readSize(sizeof(UInt64)));
+        for (String& s : strings) s = readString();
+      }
+
+      template <typename T>
+      void readArray(std::vector<T>& values)
+      {
+        static_assert(std::is_arithmetic<T>::value, "only arrays of arithmetic types can be read directly");
+        values.resize(readSize(sizeof(T)));
+        if (!values.empty()) readBytes(reinterpret_cast<char*>(&values[0]), values.size() * sizeof(T));
+      }
+
+      /// Reads an element count (each element taking at least @p min_element_size bytes) and checks it against the remaining file size
+      UInt64 readSize(UInt64 min_element_size)
+      {
+        UInt64 size = read<UInt64>();
+        if (min_element_size > 0 && size > remaining_() / min_element_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Element count exceeds file size (corrupt file?)", filename_);
+        }
+        return size;
+      }
+
+      void readBytes(char* target, UInt64 size)
+      {
+        is_.read(target, size);
+        if (!is_)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unexpected end of file", filename_);
+        }
+      }
+
+      /// Starts reading a section; returns the position where the section ends
+      std::streampos beginSection()
+      {
+        UInt64 size = readSize(1);
+        return is_.tellg() + std::streamoff(size);
+      }
+
+      /// Checks that exactly the content of the section ending at @p end was read
+      void endSection(std::streampos end)
+      {
+        if (is_.tellg() != end)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Section size mismatch (corrupt file?)", filename_);
+        }
+      }
+
+      /// Skips a complete section without reading its content
+      void skipSection()
+      {
+        is_.seekg(beginSection());
+      }
+
+private:
+      UInt64 remaining_()
+      {
+        return UInt64(file_size_ - is_.tellg());
+      }
+
+      std::istream& is_;
+      const String& filename_;
+      std::streampos file_size_;
+    };
+
+    //
+    // metadata
+    //
+
+    void writeDataValue(BinaryWriter& w, const DataValue& value)
+    {
+      w.write<unsigned char>(value.valueType());
+      w.write<unsigned char>(value.getUnitType());
+      w.write<Int32>(value.getUnit());
+      switch (value.valueType())
+      {
+      case DataValue::STRING_VALUE:
+        w.writeString(value.toString());
+        break;
+      case DataValue::INT_VALUE:
+        w.write<Int64>((long long)value);
+        break;
+      case DataValue::DOUBLE_VALUE:
+        w.write<double>((double)value);
+        break;
+      case DataValue::STRING_LIST:
+      {
+        StringList list = value.toStringList();
+        w.writeStrings(std::vector<String>(list.begin(), list.end()));
+        break;
+      }
+      case DataValue::INT_LIST:
+        w.writeArray(value.toIntList());
+        break;
+      case DataValue::DOUBLE_LIST:
+        w.writeArray(value.toDoubleList());
+        break;
+      case DataValue::EMPTY_VALUE:
+        break;
+      }
+    }
+
+    DataValue readDataValue(BinaryReader& r)
+    {
+      unsigned char type = r.read<unsigned char>();
+      unsigned char unit_type = r.read<unsigned char>();
+      Int32 unit = r.read<Int32>();
+      DataValue value;
+      switch (type)
+      {
+      case DataValue::STRING_VALUE:
+        value = DataValue(r.readString());
+        break;
+      case DataValue::INT_VALUE:
+        value = DataValue((long long)r.read<Int64>());
+        break;
+      case DataValue::DOUBLE_VALUE:
+        value = DataValue(r.read<double>());
+        break;
+      case DataValue::STRING_LIST:
+      {
+        std::vector<String> strings;
+        r.readStrings(strings);
+        value = DataValue(StringList(strings.begin(), strings.end()));
+        break;
+      }
+      case DataValue::INT_LIST:
+      {
+        IntList list;
+        r.readArray(list);
+        value = DataValue(list);
+        break;
+      }
+      case DataValue::DOUBLE_LIST:
+      {
+        DoubleList list;
+        r.readArray(list);
+        value = DataValue(list);
+        break;
+      }
+      case DataValue::EMPTY_VALUE:
+        break;
+      default:
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid meta value type", String(UInt(type)));
+      }
+      value.setUnitType(DataValue::UnitType(unit_type));
+      value.setUnit(unit);
+      return value;
+    }
+
+    void writeMetaInfo(BinaryWriter& w, const MetaInfoInterface& meta)
+    {
+      std::vector<String> keys;
+      meta.getKeys(keys);
+      w.write<UInt64>(keys.size());
+      for (const String& key : keys)
+      {
+        w.writeString(key);
+        writeDataValue(w, meta.getMetaValue(key));
+      }
+    }
+
+    void readMetaInfo(BinaryReader& r, MetaInfoInterface& meta)
+    {
+      UInt64 count = r.readSize(1);
+      for (UInt64 i = 0; i < count; ++i)
+      {
+        String key = r.readString();
+        meta.setMetaValue(key, readDataValue(r));
+      }
+    }
+
+    void writeDateTime(BinaryWriter& w, const DateTime& date)
+    {
+      // an invalid date is written as "0000-00-00 00:00:00"
+      w.writeString(date.get());
+    }
+
+    DateTime readDateTime(BinaryReader& r)
+    {
+      DateTime date;
+      String s = r.readString();
+      if (s != "0000-00-00 00:00:00") date.set(s);
+      return date;
+    }
+
+    void writeDataProcessing(BinaryWriter& w, const std::vector<DataProcessing>& processing)
+    {
+      w.write<UInt64>(processing.size());
+      for (const DataProcessing& dp : processing)
+      {
+        w.writeString(dp.getSoftware().getName());
+        w.writeString(dp.getSoftware().getVersion());
+        writeMetaInfo(w, dp.getSoftware());
+        w.write<UInt64>(dp.getProcessingActions().size());
+        for (DataProcessing::ProcessingAction action : dp.getProcessingActions())
+        {
+          w.write<UInt32>(action);
+        }
+        writeDateTime(w, dp.getCompletionTime());
+        writeMetaInfo(w, dp);
+      }
+    }
+
+    void readDataProcessing(BinaryReader& r, std::vector<DataProcessing>& processing)
+    {
+      processing.resize(r.readSize(1));
+      for (DataProcessing& dp : processing)
+      {
+        dp.getSoftware().setName(r.readString());
+        dp.getSoftware().setVersion(r.readString());
+        readMetaInfo(r, dp.getSoftware());
+        UInt64 action_count = r.readSize(sizeof(UInt32));
+        for (UInt64 i = 0; i < action_count; ++i)
+        {
+          UInt32 action = r.read<UInt32>();
+          if (action >= DataProcessing::SIZE_OF_PROCESSINGACTION)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid processing action", String(action));
+          }
+          dp.getProcessingActions().insert(DataProcessing::ProcessingAction(action));
+        }
+        dp.setCompletionTime(readDateTime(r));
+        readMetaInfo(r, dp);
+      }
+    }
+
+    void writeProteinGroups(BinaryWriter& w, const std::vector<ProteinIdentification::ProteinGroup>& groups)
+    {
+      w.write<UInt64>(groups.size());
+      for (const ProteinIdentification::ProteinGroup& group : groups)
+      {
+        w.write<double>(group.probability);
+        w.writeStrings(group.accessions);
+      }
+    }
+
+    void readProteinGroups(BinaryReader& r, std::vector<ProteinIdentification::ProteinGroup>& groups)
+    {
+      groups.resize(r.readSize(sizeof(double)));
+      for (ProteinIdentification::ProteinGroup& group : groups)
+      {
+        group.probability = r.read<double>();
+        r.readStrings(group.accessions);
+      }
+    }
+
+    void writeProteinIdentifications(BinaryWriter& w, const std::vector<ProteinIdentification>& ids)
+    {
+      w.write<UInt64>(ids.size());
+      for (const ProteinIdentification& id : ids)
+      {
+        w.writeString(id.getIdentifier());
+        w.writeString(id.getSearchEngine());
+        w.writeString(id.getSearchEngineVersion());
+        writeDateTime(w, id.getDateTime());
+        w.writeString(id.getScoreType());
+        w.writeBool(id.isHigherScoreBetter());
+        w.write<double>(id.getSignificanceThreshold());
+
+        const ProteinIdentification::SearchParameters& params = id.getSearchParameters();
+        w.writeString(params.db);
+        w.writeString(params.db_version);
+        w.writeString(params.taxonomy);
+        w.writeString(params.charges);
+        w.write<Int32>(params.mass_type);
+        w.writeStrings(params.fixed_modifications);
+        w.writeStrings(params.variable_modifications);
+        w.write<UInt32>(params.missed_cleavages);
+        w.write<double>(params.fragment_mass_tolerance);
+        w.writeBool(params.fragment_mass_tolerance_ppm);
+        w.write<double>(params.precursor_mass_tolerance);
+        w.writeBool(params.precursor_mass_tolerance_ppm);
+        w.writeString(params.digestion_enzyme.getName());
+        w.write<Int32>(params.enzyme_term_specificity);
+        writeMetaInfo(w, params);
+
+        w.write<UInt64>(id.getHits().size());
+        for (const ProteinHit& hit : id.getHits())
+        {
+          w.writeString(hit.getAccession());
+          w.writeString(hit.getSequence());
+          w.write<double>(hit.getScore());
+          w.write<UInt32>(hit.getRank());
+          w.write<double>(hit.getCoverage());
+          writeMetaInfo(w, hit);
+        }
+        writeProteinGroups(w, id.getProteinGroups());
+        writeProteinGroups(w, id.getIndistinguishableProteins());
+        writeMetaInfo(w, id);
+      }
+    }
+
+    void readProteinIdentifications(BinaryReader& r, std::vector<ProteinIdentification>& ids)
+    {
+      ids.resize(r.readSize(1));
+      for (ProteinIdentification& id : ids)
+      {
+        id.setIdentifier(r.readString());
+        id.setSearchEngine(r.readString());
+        id.setSearchEngineVersion(r.readString());
+        id.setDateTime(readDateTime(r));
+        id.setScoreType(r.readString());
+        id.setHigherScoreBetter(r.readBool());
+        id.setSignificanceThreshold(r.read<double>());
+
+        ProteinIdentification::SearchParameters& params = id.getSearchParameters();
+        params.db = r.readString();
+        params.db_version = r.readString();
+        params.taxonomy = r.readString();
+        params.charges = r.readString();
+        params.mass_type = ProteinIdentification::PeakMassType(r.read<Int32>());
+        r.readStrings(params.fixed_modifications);
+        r.readStrings(params.variable_modifications);
+        params.missed_cleavages = r.read<UInt32>();
+        params.fragment_mass_tolerance = r.read<double>();
+        params.fragment_mass_tolerance_ppm = r.readBool();
+        params.precursor_mass_tolerance = r.read<double>();
+        params.precursor_mass_tolerance_ppm = r.readBool();
+        String enzyme = r.readString();
+        if (ProteaseDB::getInstance()->hasEnzyme(enzyme))
+        {
+          params.digestion_enzyme = *(ProteaseDB::getInstance()->getEnzyme(enzyme));
+        }
+        params.enzyme_term_specificity = EnzymaticDigestion::Specificity(r.read<Int32>());
+        readMetaInfo(r, params);
+
+        std::vector<ProteinHit>& hits = id.getHits();
+        hits.resize(r.readSize(1));
+        for (ProteinHit& hit : hits)
+        {
+          hit.setAccession(r.readString());
+          hit.setSequence(r.readString());
+          hit.setScore(r.read<double>());
+          hit.setRank(r.read<UInt32>());
+          hit.setCoverage(r.read<double>());
+          readMetaInfo(r, hit);
+        }
+        readProteinGroups(r, id.getProteinGroups());
+        readProteinGroups(r, id.getIndistinguishableProteins());
+        readMetaInfo(r, id);
+      }
+    }
+
+    void writePeptideIdentifications(BinaryWriter& w, const std::vector<PeptideIdentification>& ids)
+    {
+      w.write<UInt64>(ids.size());
+      for (const PeptideIdentification& id : ids)
+      {
+        w.writeString(id.getIdentifier());
+        w.writeString(id.getScoreType());
+        w.writeBool(id.isHigherScoreBetter());
+        w.write<double>(id.getSignificanceThreshold());
+        w.write<double>(id.getRT());
+        w.write<double>(id.getMZ());
+        w.writeString(id.getBaseName());
+
+        w.write<UInt64>(id.getHits().size());
+        for (const PeptideHit& hit : id.getHits())
+        {
+          w.writeString(hit.getSequence().toString());
+          w.write<double>(hit.getScore());
+          w.write<UInt32>(hit.getRank());
+          w.write<Int32>(hit.getCharge());
+
+          const std::vector<PeptideEvidence>& evidences = hit.getPeptideEvidences();
+          w.write<UInt64>(evidences.size());
+          for (const PeptideEvidence& pe : evidences)
+          {
+            w.writeString(pe.getProteinAccession());
+            w.write<Int32>(pe.getStart());
+            w.write<Int32>(pe.getEnd());
+            w.write<char>(pe.getAABefore());
+            w.write<char>(pe.getAAAfter());
+          }
+
+          const std::vector<PeptideHit::PeakAnnotation> annotations = hit.getPeakAnnotations();
+          w.write<UInt64>(annotations.size());
+          for (const PeptideHit::PeakAnnotation& annotation : annotations)
+          {
+            w.writeString(annotation.annotation);
+            w.write<Int32>(annotation.charge);
+            w.write<double>(annotation.mz);
+            w.write<double>(annotation.intensity);
+          }
+          writeMetaInfo(w, hit);
+        }
+        writeMetaInfo(w, id);
+      }
+    }
+
+    void readPeptideIdentifications(BinaryReader& r, std::vector<PeptideIdentification>& ids)
+    {
+      ids.resize(r.readSize(1));
+      for (PeptideIdentification& id : ids)
+      {
+        id.setIdentifier(r.readString());
+        id.setScoreType(r.readString());
+        id.setHigherScoreBetter(r.readBool());
+        id.setSignificanceThreshold(r.read<double>());
+        id.setRT(r.read<double>());
+        id.setMZ(r.read<double>());
+        id.setBaseName(r.readString());
+
+        std::vector<PeptideHit>& hits = id.getHits();
+        hits.resize(r.readSize(1));
+        for (PeptideHit& hit : hits)
+        {
+          hit.setSequence(AASequence::fromString(r.readString()));
+          hit.setScore(r.read<double>());
+          hit.setRank(r.read<UInt32>());
+          hit.setCharge(r.read<Int32>());
+
+          std::vector<PeptideEvidence> evidences(r.readSize(1));
+          for (PeptideEvidence& pe : evidences)
+          {
+            pe.setProteinAccession(r.readString());
+            pe.setStart(r.read<Int32>());
+            pe.setEnd(r.read<Int32>());
+            pe.setAABefore(r.read<char>());
+            pe.setAAAfter(r.read<char>());
+          }
+          hit.setPeptideEvidences(std::move(evidences));
+
+          std::vector<PeptideHit::PeakAnnotation> annotations(r.readSize(1));
+          for (PeptideHit::PeakAnnotation& annotation : annotations)
+          {
+            annotation.annotation = r.readString();
+            annotation.charge = r.read<Int32>();
+            annotation.mz = r.read<double>();
+            annotation.intensity = r.read<double>();
+          }
+          if (!annotations.empty()) hit.setPeakAnnotations(annotations);
+          readMetaInfo(r, hit);
+        }
+        readMetaInfo(r, id);
+      }
+    }
+
+    /// Writes the metadata common to feature and consensus maps
+    template <typename MapType>
+    void writeMapMetadata(BinaryWriter& w, const MapType& map)
+    {
+      w.writeString(map.getIdentifier());
+      w.write<UInt64>(map.getUniqueId());
+      writeMetaInfo(w, map);
+      writeDataProcessing(w, map.getDataProcessing());
+      writeProteinIdentifications(w, map.getProteinIdentifications());
+      writePeptideIdentifications(w, map.getUnassignedPeptideIdentifications());
+    }
+
+    /// Reads the metadata common to feature and consensus maps
+    template <typename MapType>
+    void readMapMetadata(BinaryReader& r, MapType& map)
+    {
+      map.setIdentifier(r.readString());
+      map.setUniqueId(r.read<UInt64>());
+      readMetaInfo(r, map);
+      readDataProcessing(r, map.getDataProcessing());
+      readProteinIdentifications(r, map.getProteinIdentifications());
+      readPeptideIdentifications(r, map.getUnassignedPeptideIdentifications());
+    }
+
+    //
+    // features
+    //
+
+    void writeHulls(BinaryWriter& w, const std::vector<ConvexHull2D>& hulls)
+    {
+      w.write<UInt64>(hulls.size());
+      std::vector<double> coordinates;
+      for (const ConvexHull2D& hull : hulls)
+      {
+        const ConvexHull2D::PointArrayType& points = hull.getHullPoints();
+        coordinates.clear();
+        coordinates.reserve(2 * points.size());
+        for (const ConvexHull2D::PointType& p : points)
+        {
+          coordinates.push_back(p[0]);
+          coordinates.push_back(p[1]);
+        }
+        w.writeArray(coordinates);
+      }
+    }
+
+    void readHulls(BinaryReader& r, std::vector<ConvexHull2D>& hulls)
+    {
+      hulls.resize(r.readSize(sizeof(UInt64)));
+      std::vector<double> coordinates;
+      ConvexHull2D::PointArrayType points;
+      for (ConvexHull2D& hull : hulls)
+      {
+        r.readArray(coordinates);
+        points.resize(coordinates.size() / 2);
+        for (Size i = 0; i < points.size(); ++i)
+        {
+          points[i] = ConvexHull2D::PointType(coordinates[2 * i], coordinates[2 * i + 1]);
+        }
+        hull.setHullPoints(points);
+      }
+    }
+
+    /// Writes a complete (subordinate) feature including its own subordinates
+    void writeFeatureRecord(BinaryWriter& w, const Feature& feature)
+    {
+      w.write<double>(feature.getRT());
+      w.write<double>(feature.getMZ());
+      w.write<float>(feature.getIntensity());
+      w.write<Int32>(feature.getCharge());
+      w.write<float>(feature.getOverallQuality());
+      w.write<float>(feature.getQuality(0));
+      w.write<float>(feature.getQuality(1));
+      w.write<float>(feature.getWidth());
+      w.write<UInt64>(feature.getUniqueId());
+      writeMetaInfo(w, feature);
+      writePeptideIdentifications(w, feature.getPeptideIdentifications());
+      writeHulls(w, feature.getConvexHulls());
+      w.write<UInt64>(feature.getSubordinates().size());
+      for (const Feature& sub : feature.getSubordinates())
+      {
+        writeFeatureRecord(w, sub);
+      }
+    }
+
+    void readFeatureRecord(BinaryReader& r, Feature& feature, bool load_hulls)
+    {
+      feature.setRT(r.read<double>());
+      feature.setMZ(r.read<double>());
+      feature.setIntensity(r.read<float>());
+      feature.setCharge(r.read<Int32>());
+      feature.setOverallQuality(r.read<float>());
+      feature.setQuality(0, r.read<float>());
+      feature.setQuality(1, r.read<float>());
+      feature.setWidth(r.read<float>());
+      feature.setUniqueId(r.read<UInt64>());
+      readMetaInfo(r, feature);
+      readPeptideIdentifications(r, feature.getPeptideIdentifications());
+      readHulls(r, feature.getConvexHulls());
+      if (!load_hulls) feature.getConvexHulls().clear();
+      feature.getSubordinates().resize(r.readSize(1));
+      for (Feature& sub : feature.getSubordinates())
+      {
+        readFeatureRecord(r, sub, load_hulls);
+      }
+    }
+
+    /// Checks magic number, version and byte order at the start of a file
+    void readHeader(BinaryReader& r, const String& filename, const char (&magic)[8], const String& kind)
+    {
+      char file_magic[8];
+      r.readBytes(file_magic, sizeof(file_magic));
+      if (std::memcmp(file_magic, magic, sizeof(file_magic)) != 0)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "File is not a binary " + kind + " (wrong file magic number)", filename);
+      }
+      UInt32 version = r.read<UInt32>();
+      if (version > FeatureBinFile::VERSION)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "File was written by a newer version of OpenMS (format version " + String(version) + ")", filename);
+      }
+      if (r.read<UInt32>() != BYTE_ORDER_MARK)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "File was written on a machine with different byte order", filename);
+      }
+    }
+
+    void writeHeader(BinaryWriter& w, const char (&magic)[8], UInt64 size)
+    {
+      w.writeBytes(magic, sizeof(magic));
+      w.write<UInt32>(FeatureBinFile::VERSION);
+      w.write<UInt32>(BYTE_ORDER_MARK);
+      w.write<UInt64>(size);
+    }
+
+    /// Erases all features with @p keep == false
+    template <typename MapType>
+    void eraseFiltered(MapType& map, const std::vector<bool>& keep)
+    {
+      Size n = 0;
+      for (Size i = 0; i < map.size(); ++i)
+      {
+        if (!keep[i]) continue;
+        if (n != i) map[n] = std::move(map[i]);
+        ++n;
+      }
+      map.resize(n);
+    }
+  } // anonymous namespace
+
+  FeatureBinFile::FeatureBinFile() :
+    ProgressLogger(),
+    options_()
+  {
+  }
+
+  FeatureBinFile::~FeatureBinFile()
+  {
+  }
+
+  FeatureFileOptions& FeatureBinFile::getOptions()
+  {
+    return options_;
+  }
+
+  const FeatureFileOptions& FeatureBinFile::getOptions() const
+  {
+    return options_;
+  }
+
+  void FeatureBinFile::setOptions(const FeatureFileOptions& options)
+  {
+    options_ = options;
+  }
+
+  bool FeatureBinFile::isInRange_(double rt, double mz, double intensity) const
+  {
+    return (!options_.hasRTRange() || options_.getRTRange().encloses(rt))
+        && (!options_.hasMZRange() || options_.getMZRange().encloses(mz))
+        && (!options_.hasIntensityRange() || options_.getIntensityRange().encloses(intensity));
+  }
+
+  void FeatureBinFile::store(const String& filename, const FeatureMap& feature_map)
+  {
+    if (!FileHandler::hasValidExtension(filename, FileTypes::FEATUREBIN))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "invalid file extension, expected '" + FileTypes::typeToName(FileTypes::FEATUREBIN) + "'");
+    }
+    std::ofstream os(filename.c_str(), std::ios::binary);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const Size n = feature_map.size();
+    startProgress(0, 4, "Storing binary feature map");
+    BinaryWriter w(os);
+    writeHeader(w, FEATURE_MAGIC, n);
+
+    std::streampos section = w.beginSection();
+    writeMapMetadata(w, feature_map);
+    w.endSection(section);
+
+    // columns
+    section = w.beginSection();
+    {
+      std::vector<double> rt(n), mz(n);
+      std::vector<float> intensity(n), overall_quality(n), quality_rt(n), quality_mz(n), width(n);
+      std::vector<Int32> charge(n);
+      std::vector<UInt64> unique_id(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        const Feature& f = feature_map[i];
+        rt[i] = f.getRT();
+        mz[i] = f.getMZ();
+        intensity[i] = f.getIntensity();
+        charge[i] = f.getCharge();
+        overall_quality[i] = f.getOverallQuality();
+        quality_rt[i] = f.getQuality(0);
+        quality_mz[i] = f.getQuality(1);
+        width[i] = f.getWidth();
+        unique_id[i] = f.getUniqueId();
+      }
+      w.writeArray(rt);
+      w.writeArray(mz);
+      w.writeArray(intensity);
+      w.writeArray(charge);
+      w.writeArray(overall_quality);
+      w.writeArray(quality_rt);
+      w.writeArray(quality_mz);
+      w.writeArray(width);
+      w.writeArray(unique_id);
+    }
+    w.endSection(section);
+    setProgress(1);
+
+    // annotations
+    section = w.beginSection();
+    for (const Feature& f : feature_map)
+    {
+      writeMetaInfo(w, f);
+      writePeptideIdentifications(w, f.getPeptideIdentifications());
+    }
+    w.endSection(section);
+    setProgress(2);
+
+    // convex hulls
+    section = w.beginSection();
+    for (const Feature& f : feature_map)
+    {
+      writeHulls(w, f.getConvexHulls());
+    }
+    w.endSection(section);
+    setProgress(3);
+
+    // subordinates
+    section = w.beginSection();
+    for (const Feature& f : feature_map)
+    {
+      w.write<UInt64>(f.getSubordinates().size());
+      for (const Feature& sub : f.getSubordinates())
+      {
+        writeFeatureRecord(w, sub);
+      }
+    }
+    w.endSection(section);
+
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "error while writing");
+    }
+    endProgress();
+  }
+
+  Size FeatureBinFile::loadSize(const String& filename)
+  {
+    std::ifstream is(filename.c_str(), std::ios::binary);
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    BinaryReader r(is, filename);
+    readHeader(r, filename, FEATURE_MAGIC, "feature map");
+    return r.read<UInt64>();
+  }
+
+  void FeatureBinFile::load(const String& filename, FeatureMap& feature_map)
+  {
+    std::ifstream is(filename.c_str(), std::ios::binary);
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    feature_map.clear(true);
+    feature_map.setLoadedFileType(filename);
+    feature_map.setLoadedFilePath(filename);
+
+    BinaryReader r(is, filename);
+    readHeader(r, filename, FEATURE_MAGIC, "feature map");
+    const UInt64 n = r.read<UInt64>();
+
+    std::streampos end = r.beginSection();
+    readMapMetadata(r, feature_map);
+    r.endSection(end);
+
+    if (options_.getMetadataOnly())
+    {
+      return;
+    }
+
+    startProgress(0, 4, "Loading binary feature map");
+
+    // columns
+    end = r.beginSection();
+    {
+      std::vector<double> rt, mz;
+      std::vector<float> intensity, overall_quality, quality_rt, quality_mz, width;
+      std::vector<Int32> charge;
+      std::vector<UInt64> unique_id;
+      r.readArray(rt);
+      r.readArray(mz);
+      r.readArray(intensity);
+      r.readArray(charge);
+      r.readArray(overall_quality);
+      r.readArray(quality_rt);
+      r.readArray(quality_mz);
+      r.readArray(width);
+      r.readArray(unique_id);
+      for (const Size size : {mz.size(), intensity.size(), charge.size(), overall_quality.size(), quality_rt.size(), quality_mz.size(), width.size(), unique_id.size(), rt.size()})
+      {
+        if (size != n)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Column size does not match number of features (corrupt file?)", filename);
+        }
+      }
+
+      feature_map.resize(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        Feature& f = feature_map[i];
+        f.setRT(rt[i]);
+        f.setMZ(mz[i]);
+        f.setIntensity(intensity[i]);
+        f.setCharge(charge[i]);
+        f.setOverallQuality(overall_quality[i]);
+        f.setQuality(0, quality_rt[i]);
+        f.setQuality(1, quality_mz[i]);
+        f.setWidth(width[i]);
+        f.setUniqueId(unique_id[i]);
+      }
+    }
+    r.endSection(end);
+    setProgress(1);
+
+    // annotations
+    end = r.beginSection();
+    for (Feature& f : feature_map)
+    {
+      readMetaInfo(r, f);
+      readPeptideIdentifications(r, f.getPeptideIdentifications());
+    }
+    r.endSection(end);
+    setProgress(2);
+
+    // convex hulls
+    if (options_.getLoadConvexHull())
+    {
+      end = r.beginSection();
+      for (Feature& f : feature_map)
+      {
+        readHulls(r, f.getConvexHulls());
+      }
+      r.endSection(end);
+    }
+    else
+    {
+      r.skipSection();
+    }
+    setProgress(3);
+
+    // subordinates
+    if (options_.getLoadSubordinates())
+    {
+      end = r.beginSection();
+      for (Feature& f : feature_map)
+      {
+        f.getSubordinates().resize(r.readSize(1));
+        for (Feature& sub : f.getSubordinates())
+        {
+          readFeatureRecord(r, sub, options_.getLoadConvexHull());
+        }
+      }
+      r.endSection(end);
+    }
+    else
+    {
+      r.skipSection();
+    }
+
+    if (options_.hasRTRange() || options_.hasMZRange() || options_.hasIntensityRange())
+    {
+      std::vector<bool> keep(feature_map.size());
+      for (Size i = 0; i < feature_map.size(); ++i)
+      {
+        keep[i] = isInRange_(feature_map[i].getRT(), feature_map[i].getMZ(), feature_map[i].getIntensity());
+      }
+      eraseFiltered(feature_map, keep);
+    }
+
+    feature_map.updateRanges();
+    endProgress();
+  }
+
+  void FeatureBinFile::store(const String& filename, const ConsensusMap& consensus_map)
+  {
+    if (!FileHandler::hasValidExtension(filename, FileTypes::CONSENSUSBIN))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "invalid file extension, expected '" + FileTypes::typeToName(FileTypes::CONSENSUSBIN) + "'");
+    }
+    std::ofstream os(filename.c_str(), std::ios::binary);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const Size n = consensus_map.size();
+    startProgress(0, 3, "Storing binary consensus map");
+    BinaryWriter w(os);
+    writeHeader(w, CONSENSUS_MAGIC, n);
+
+    std::streampos section = w.beginSection();
+    writeMapMetadata(w, consensus_map);
+    w.writeString(consensus_map.getExperimentType());
+    const ConsensusMap::ColumnHeaders& headers = consensus_map.getColumnHeaders();
+    w.write<UInt64>(headers.size());
+    for (const auto& header : headers)
+    {
+      w.write<UInt64>(header.first);
+      w.writeString(header.second.filename);
+      w.writeString(header.second.label);
+      w.write<UInt64>(header.second.size);
+      w.write<UInt64>(header.second.unique_id);
+      writeMetaInfo(w, header.second);
+    }
+    w.endSection(section);
+
+    // columns
+    section = w.beginSection();
+    {
+      std::vector<double> rt(n), mz(n);
+      std::vector<float> intensity(n), quality(n), width(n);
+      std::vector<Int32> charge(n);
+      std::vector<UInt64> unique_id(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        const ConsensusFeature& f = consensus_map[i];
+        rt[i] = f.getRT();
+        mz[i] = f.getMZ();
+        intensity[i] = f.getIntensity();
+        charge[i] = f.getCharge();
+        quality[i] = f.getQuality();
+        width[i] = f.getWidth();
+        unique_id[i] = f.getUniqueId();
+      }
+      w.writeArray(rt);
+      w.writeArray(mz);
+      w.writeArray(intensity);
+      w.writeArray(charge);
+      w.writeArray(quality);
+      w.writeArray(width);
+      w.writeArray(unique_id);
+    }
+    w.endSection(section);
+    setProgress(1);
+
+    // annotations
+    section = w.beginSection();
+    for (const ConsensusFeature& f : consensus_map)
+    {
+      writeMetaInfo(w, f);
+      writePeptideIdentifications(w, f.getPeptideIdentifications());
+    }
+    w.endSection(section);
+    setProgress(2);
+
+    // feature handles
+    section = w.beginSection();
+    for (const ConsensusFeature& f : consensus_map)
+    {
+      w.write<UInt64>(f.size());
+      for (const FeatureHandle& h : f)
+      {
+        w.write<UInt64>(h.getMapIndex());
+        w.write<UInt64>(h.getUniqueId());
+        w.write<double>(h.getRT());
+        w.write<double>(h.getMZ());
+        w.write<float>(h.getIntensity());
+        w.write<Int32>(h.getCharge());
+        w.write<float>(h.getWidth());
+      }
+    }
+    w.endSection(section);
+
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "error while writing");
+    }
+    endProgress();
+  }
+
+  void FeatureBinFile::load(const String& filename, ConsensusMap& consensus_map)
+  {
+    std::ifstream is(filename.c_str(), std::ios::binary);
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    consensus_map.clear(true);
+    consensus_map.setLoadedFileType(filename);
+    consensus_map.setLoadedFilePath(filename);
+
+    BinaryReader r(is, filename);
+    readHeader(r, filename, CONSENSUS_MAGIC, "consensus map");
+    const UInt64 n = r.read<UInt64>();
+
+    std::streampos end = r.beginSection();
+    readMapMetadata(r, consensus_map);
+    consensus_map.setExperimentType(r.readString());
+    UInt64 header_count = r.readSize(1);
+    ConsensusMap::ColumnHeaders& headers = consensus_map.getColumnHeaders();
+    for (UInt64 i = 0; i < header_count; ++i)
+    {
+      ConsensusMap::ColumnHeader& header = headers[r.read<UInt64>()];
+      header.filename = r.readString();
+      header.label = r.readString();
+      header.size = r.read<UInt64>();
+      header.unique_id = r.read<UInt64>();
+      readMetaInfo(r, header);
+    }
+    r.endSection(end);
+
+    if (options_.getMetadataOnly())
+    {
+      return;
+    }
+
+    startProgress(0, 3, "Loading binary consensus map");
+
+    // columns
+    end = r.beginSection();
+    {
+      std::vector<double> rt, mz;
+      std::vector<float> intensity, quality, width;
+      std::vector<Int32> charge;
+      std::vector<UInt64> unique_id;
+      r.readArray(rt);
+      r.readArray(mz);
+      r.readArray(intensity);
+      r.readArray(charge);
+      r.readArray(quality);
+      r.readArray(width);
+      r.readArray(unique_id);
+      for (const Size size : {mz.size(), intensity.size(), charge.size(), quality.size(), width.size(), unique_id.size(), rt.size()})
+      {
+        if (size != n)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Column size does not match number of features (corrupt file?)", filename);
+        }
+      }
+
+      consensus_map.resize(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        ConsensusFeature& f = consensus_map[i];
+        f.setRT(rt[i]);
+        f.setMZ(mz[i]);
+        f.setIntensity(intensity[i]);
+        f.setCharge(charge[i]);
+        f.setQuality(quality[i]);
+        f.setWidth(width[i]);
+        f.setUniqueId(unique_id[i]);
+      }
+    }
+    r.endSection(end);
+    setProgress(1);
+
+    // annotations
+    end = r.beginSection();
+    for (ConsensusFeature& f : consensus_map)
+    {
+      readMetaInfo(r, f);
+      readPeptideIdentifications(r, f.getPeptideIdentifications());
+    }
+    r.endSection(end);
+    setProgress(2);
+
+    // feature handles
+    end = r.beginSection();
+    for (ConsensusFeature& f : consensus_map)
+    {
+      UInt64 handle_count = r.readSize(1);
+      for (UInt64 i = 0; i < handle_count; ++i)
+      {
+        FeatureHandle h;
+        h.setMapIndex(r.read<UInt64>());
+        h.setUniqueId(r.read<UInt64>());
+        h.setRT(r.read<double>());
+        h.setMZ(r.read<double>());
+        h.setIntensity(r.read<float>());
+        h.setCharge(r.read<Int32>());
+        h.setWidth(r.read<float>());
+        f.insert(h);
+      }
+    }
+    r.endSection(end);
+
+    if (options_.hasRTRange() || options_.hasMZRange() || options_.hasIntensityRange())
+    {
+      std::vector<bool> keep(consensus_map.size());
+      for (Size i = 0; i < consensus_map.size(); ++i)
+      {
+        keep[i] = isInRange_(consensus_map[i].getRT(), consensus_map[i].getMZ(), consensus_map[i].getIntensity());
+      }
+      eraseFiltered(consensus_map, keep);
+    }
+
+    consensus_map.updateRanges();
+    endProgress();
+  }
+
+} // namespace OpenMS
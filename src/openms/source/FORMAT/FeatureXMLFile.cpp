@@ -447,7 +447,8 @@ namespace OpenMS
       }
       else if (type == "string")
       {
-        last_meta_->setMetaValue(name, (String)attributeAsString_(attributes, s_value));
+        // short string values are often repeated across features (labels, file origins), share their storage
+        last_meta_->setMetaValue(name, stringUserParamValue_(attributeAsString_(attributes, s_value)));
       }
       else if (type == "intList")
       {
@@ -941,19 +942,19 @@ namespace OpenMS
     String& current_tag = open_tags_.back();
     if (current_tag == "intensity")
     {
-      current_feature_->setIntensity(asDouble_(sm_.convert(chars)));
+      current_feature_->setIntensity(asDouble_(chars));
     }
     else if (current_tag == "position")
     {
-      current_feature_->getPosition()[dim_] = asDouble_(sm_.convert(chars));
+      current_feature_->getPosition()[dim_] = asDouble_(chars);
     }
     else if (current_tag == "quality")
     {
-      current_feature_->setQuality(dim_, asDouble_(sm_.convert(chars)));
+      current_feature_->setQuality(dim_, asDouble_(chars));
     }
     else if (current_tag == "overallquality")
     {
-      current_feature_->setOverallQuality(asDouble_(sm_.convert(chars)));
+      current_feature_->setOverallQuality(asDouble_(chars));
     }
     else if (current_tag == "charge")
     {
@@ -961,7 +962,7 @@ namespace OpenMS
     }
     else if (current_tag == "hposition")
     {
-      hull_position_[dim_] = asDouble_(sm_.convert(chars));
+      hull_position_[dim_] = asDouble_(chars);
     }
   }
 
@@ -39,6 +39,8 @@
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureBinFile.h>
 #include <OpenMS/FORMAT/MzDataFile.h>
 #include <OpenMS/FORMAT/MascotGenericFile.h>
 #include <OpenMS/FORMAT/MS2File.h>
@@ -165,9 +167,9 @@ namespace OpenMS
     vector<String> complete_file;
 
     // test whether the file is compressed (bzip2 or gzip)
-    ifstream compressed_file(filename.c_str());
-    char bz[2];
-    compressed_file.read(bz, 2);
+    ifstream compressed_file(filename.c_str(), ios::binary);
+    char bz[8] = {0};
+    compressed_file.read(bz, 8);
     char g1 = 0x1f;
     char g2 = 0;
     g2 |= 1 << 7;
@@ -175,6 +177,20 @@ namespace OpenMS
     g2 |= 1 << 1;
     g2 |= 1 << 0;
     compressed_file.close();
+    // binary feature and consensus maps (see FeatureBinFile)
+    if (String(bz, 8) == "OMSFEATB")
+    {
+      return FileTypes::FEATUREBIN;
+    }
+    if (String(bz, 8) == "OMSCONSB")
+    {
+      return FileTypes::CONSENSUSBIN;
+    }
+    // binary transition library (see TransitionBinFile)
+    if (String(bz, 8) == "OMSTRLIB")
+    {
+      return FileTypes::TRANSITIONBIN;
+    }
     if (bz[0] == 'B' && bz[1] == 'Z') // bzip2
     {
       Bzip2Ifstream bzip2_file(filename.c_str());
@@ -505,6 +521,21 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     options_ = options;
   }
 
+  FeatureFileOptions& FileHandler::getFeatOptions()
+  {
+    return f_options_;
+  }
+
+  const FeatureFileOptions& FileHandler::getFeatOptions() const
+  {
+    return f_options_;
+  }
+
+  void FileHandler::setFeatOptions(const FeatureFileOptions& options)
+  {
+    f_options_ = options;
+  }
+
   String FileHandler::computeFileHash(const String& filename)
   {
     QCryptographicHash crypto(QCryptographicHash::Sha1);
@@ -540,7 +571,15 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     //load right file
     if (type == FileTypes::FEATUREXML)
     {
-      FeatureXMLFile().load(filename, map);
+      FeatureXMLFile f;
+      f.setOptions(f_options_);
+      f.load(filename, map);
+    }
+    else if (type == FileTypes::FEATUREBIN)
+    {
+      FeatureBinFile f;
+      f.setOptions(f_options_);
+      f.load(filename, map);
     }
     else if (type == FileTypes::TSV)
     {
@@ -562,6 +601,69 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     return true;
   }
 
+  void FileHandler::storeFeatures(const String& filename, const FeatureMap& map)
+  {
+    if (getTypeByFileName(filename) == FileTypes::FEATUREBIN)
+    {
+      FeatureBinFile().store(filename, map);
+    }
+    else
+    {
+      FeatureXMLFile().store(filename, map);
+    }
+  }
+
+  bool FileHandler::loadConsensusFeatures(const String& filename, ConsensusMap& map, FileTypes::Type force_type)
+  {
+    //determine file type
+    FileTypes::Type type;
+    if (force_type != FileTypes::UNKNOWN)
+    {
+      type = force_type;
+    }
+    else
+    {
+      try
+      {
+        type = getType(filename);
+      }
+      catch ( Exception::FileNotFound& )
+      {
+        return false;
+      }
+    }
+
+    //load right file
+    if (type == FileTypes::CONSENSUSXML)
+    {
+      ConsensusXMLFile().load(filename, map);
+    }
+    else if (type == FileTypes::CONSENSUSBIN)
+    {
+      FeatureBinFile f;
+      f.setOptions(f_options_);
+      f.load(filename, map);
+    }
+    else
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  void FileHandler::storeConsensusFeatures(const String& filename, const ConsensusMap& map)
+  {
+    if (getTypeByFileName(filename) == FileTypes::CONSENSUSBIN)
+    {
+      FeatureBinFile().store(filename, map);
+    }
+    else
+    {
+      ConsensusXMLFile().store(filename, map);
+    }
+  }
+
   bool FileHandler::loadExperiment(const String& filename, PeakMap& exp, FileTypes::Type force_type, ProgressLogger::LogType log, const bool rewrite_source_file, const bool compute_hash)
   {
     // setting the flag for hash recomputation only works if source file entries are rewritten
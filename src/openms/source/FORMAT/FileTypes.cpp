@@ -117,6 +117,9 @@ namespace OpenMS
     TypeNameBinding(FileTypes::EXE, "exe", "Windows executable"),
     TypeNameBinding(FileTypes::BZ2, "bz2", "bzip2 compressed file"),
     TypeNameBinding(FileTypes::GZ, "gz", "gzip compressed file"),
+    TypeNameBinding(FileTypes::FEATUREBIN, "featureBin", "OpenMS binary feature map"),
+    TypeNameBinding(FileTypes::CONSENSUSBIN, "consensusBin", "OpenMS binary consensus feature map"),
+    TypeNameBinding(FileTypes::TRANSITIONBIN, "trBin", "OpenSWATH binary transition library"),
     TypeNameBinding(FileTypes::XML, "xml", "any XML file")  // make sure this comes last, since the name is a suffix of other formats and should only be matched last
   };
 
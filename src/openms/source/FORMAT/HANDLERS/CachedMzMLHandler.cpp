@@ -399,6 +399,112 @@ namespace Internal
     return data;
   }
 
+  namespace
+  {
+    /// reads a single value from an unaligned position and advances @p pos
+    template <typename T>
+    inline void readValue(const char*& pos, const char* end, T& value)
+    {
+      if (end - pos < static_cast<std::ptrdiff_t>(sizeof(T)))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Read past the end of the cached data, something is wrong here. Aborting.", "memory map");
+      }
+      std::memcpy(&value, pos, sizeof(T));
+      pos += sizeof(T);
+    }
+
+    /// points @p view to @p len elements at @p pos and advances @p pos
+    inline void viewArray(const char*& pos, const char* end, Size len, CachedMzMLHandler::DataArrayView& view)
+    {
+      Size nbytes = len * sizeof(CachedMzMLHandler::DatumSingleton);
+      if (len > static_cast<Size>(end - pos) / sizeof(CachedMzMLHandler::DatumSingleton))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Data array extends past the end of the cached data, something is wrong here. Aborting.", "memory map");
+      }
+      view.data = pos;
+      view.size = len;
+      pos += nbytes;
+    }
+  }
+
+  void CachedMzMLHandler::readSpectrumView(const char* pos, const char* end, DataView& view)
+  {
+    Size spec_size = 0;
+    Size nr_float_arrays = 0;
+    readValue(pos, end, spec_size);
+    readValue(pos, end, nr_float_arrays);
+    readValue(pos, end, view.ms_level);
+    readValue(pos, end, view.rt);
+    readDataView_(pos, end, view, spec_size, nr_float_arrays);
+  }
+
+  void CachedMzMLHandler::readChromatogramView(const char* pos, const char* end, DataView& view)
+  {
+    Size chrom_size = 0;
+    Size nr_float_arrays = 0;
+    readValue(pos, end, chrom_size);
+    readValue(pos, end, nr_float_arrays);
+    view.ms_level = -1;
+    view.rt = -1.0;
+    readDataView_(pos, end, view, chrom_size, nr_float_arrays);
+  }
+
+  void CachedMzMLHandler::readDataView_(const char* pos, const char* end, DataView& view,
+                                        Size data_size, Size nr_float_arrays)
+  {
+    // keep the capacity of the additional arrays to avoid re-allocation
+    view.additional.clear();
+    viewArray(pos, end, data_size, view.first);
+    viewArray(pos, end, data_size, view.second);
+    for (Size k = 0; k < nr_float_arrays; k++)
+    {
+      DataArrayView arr;
+      Size len, len_name;
+      readValue(pos, end, len);
+      readValue(pos, end, len_name);
+      if (len_name > static_cast<Size>(end - pos))
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Data array name extends past the end of the cached data, something is wrong here. Aborting.", "memory map");
+      }
+      arr.name = pos;
+      arr.name_size = len_name;
+      pos += len_name;
+      viewArray(pos, end, len, arr);
+      view.additional.push_back(arr);
+    }
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::copyDataView(const DataView& view)
+  {
+    auto copy_array = [](const DataArrayView& arr)
+    {
+      OpenSwath::BinaryDataArrayPtr ptr(new OpenSwath::BinaryDataArray);
+      ptr->data.resize(arr.size);
+      if (arr.size > 0)
+      {
+        std::memcpy(&ptr->data[0], arr.data, arr.size * sizeof(DatumSingleton));
+      }
+      if (arr.name != nullptr)
+      {
+        ptr->description = std::string(arr.name, arr.name_size);
+      }
+      return ptr;
+    };
+
+    std::vector<OpenSwath::BinaryDataArrayPtr> data;
+    data.reserve(2 + view.additional.size());
+    data.push_back(copy_array(view.first));
+    data.push_back(copy_array(view.second));
+    for (const auto& arr : view.additional)
+    {
+      data.push_back(copy_array(arr));
+    }
+    return data;
+  }
+
   void CachedMzMLHandler::readSpectrum(SpectrumType& spectrum, std::ifstream& ifs)
   {
     int ms_level;
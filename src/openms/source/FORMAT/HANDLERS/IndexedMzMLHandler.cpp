@@ -37,6 +37,7 @@
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLDecoder.h>
 #include <OpenMS/FORMAT/HANDLERS/MzMLSpectrumDecoder.h>
 
+#include <boost/iostreams/device/mapped_file.hpp>
 
 // #define DEBUG_READER
 
@@ -84,7 +85,23 @@ namespace Internal
     else parsing_success_ = false;
   }
 
+  void IndexedMzMLHandler::mapFile_()
+  {
+    mapped_file_.reset();
+    if (!parsing_success_) return;
+
+    try
+    {
+      mapped_file_ = std::make_shared<boost::iostreams::mapped_file_source>(filename_);
+    }
+    catch (std::exception& /* e */)
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_);
+    }
+  }
+
   IndexedMzMLHandler::IndexedMzMLHandler(const String& filename) :
+    use_mmap_(false),
     parsing_success_(false),
     skip_xml_checks_(false) 
   {
@@ -92,6 +109,7 @@ namespace Internal
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler() :
+    use_mmap_(false),
     parsing_success_(false),
     skip_xml_checks_(false) 
   {}
@@ -99,15 +117,20 @@ namespace Internal
   IndexedMzMLHandler::IndexedMzMLHandler(const IndexedMzMLHandler& source) :
     filename_(source.filename_),
     spectra_offsets_(source.spectra_offsets_),
+    spectra_native_ids_(source.spectra_native_ids_),
     chromatograms_offsets_(source.chromatograms_offsets_),
+    chromatograms_native_ids_(source.chromatograms_native_ids_),
     index_offset_(source.index_offset_),
     spectra_before_chroms_(source.spectra_before_chroms_),
-    // do not copy the filestream itself but open a new filestream using the same file
-    // this is critical for parallel access to the same file!
-    filestream_(source.filename_.c_str()),
+    // the (read-only) memory mapping can safely be shared between copies
+    mapped_file_(source.mapped_file_),
+    use_mmap_(source.use_mmap_),
     parsing_success_(source.parsing_success_),
     skip_xml_checks_(source.skip_xml_checks_)
   {
+    // do not copy the filestream itself but open a new filestream using the same file
+    // this is critical for parallel access to the same file!
+    if (!use_mmap_) filestream_.open(source.filename_.c_str());
   }
 
   IndexedMzMLHandler::~IndexedMzMLHandler()
@@ -121,8 +144,60 @@ namespace Internal
       filestream_.close();
     }
     filename_ = filename;
-    filestream_.open(filename.c_str());
+    spectra_offsets_.clear();
+    spectra_native_ids_.clear();
+    chromatograms_offsets_.clear();
+    chromatograms_native_ids_.clear();
+    mapped_file_.reset();
+    if (!use_mmap_) filestream_.open(filename.c_str());
     parseFooter_(filename);
+    if (use_mmap_) mapFile_();
+  }
+
+  void IndexedMzMLHandler::setMemoryMapping(bool use_mmap)
+  {
+    if (use_mmap == use_mmap_) return;
+
+    use_mmap_ = use_mmap;
+    if (use_mmap_)
+    {
+      if (filestream_.is_open()) filestream_.close();
+      mapFile_();
+    }
+    else
+    {
+      mapped_file_.reset();
+      if (!filename_.empty()) filestream_.open(filename_.c_str());
+    }
+  }
+
+  bool IndexedMzMLHandler::getMemoryMapping() const
+  {
+    return use_mmap_;
+  }
+
+  std::string IndexedMzMLHandler::readChunk_(std::streampos startidx, std::streampos endidx)
+  {
+    std::streampos readl = endidx - startidx;
+
+    if (use_mmap_)
+    {
+      // no shared state is modified here, this is safe to call from multiple threads
+      if (!mapped_file_ || (size_t)endidx > mapped_file_->size())
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Offset lies outside of the mapped file", filename_);
+      }
+      return std::string(mapped_file_->data() + (std::streamoff)startidx, (size_t)readl);
+    }
+
+    char* buffer = new char[readl + std::streampos(1)];
+    filestream_.seekg(startidx, filestream_.beg);
+    filestream_.read(buffer, readl);
+    buffer[readl] = '\0';
+    std::string text(buffer);
+    delete[] buffer;
+    return text;
   }
 
   bool IndexedMzMLHandler::getParsingSuccess() const
@@ -184,13 +259,7 @@ namespace Internal
       endidx = chromatograms_offsets_[chromToGet + 1];
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+    std::string text = readChunk_(startidx, endidx);
 
 #ifdef DEBUG_READER
     // print the full text we just read
@@ -244,13 +313,7 @@ namespace Internal
       endidx = spectra_offsets_[spectrumToGet + 1];
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+    std::string text = readChunk_(startidx, endidx);
 
 #ifdef DEBUG_READER
     // print the full text we just read
@@ -277,12 +340,13 @@ namespace Internal
 
   void IndexedMzMLHandler::getMSSpectrumByNativeId(std::string id, MSSpectrum& s)
   {
-    if (spectra_native_ids_.find(id) == spectra_native_ids_.end())
+    const auto it = spectra_native_ids_.find(id);
+    if (it == spectra_native_ids_.end())
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
           String( "Could not find spectrum id " + String(id) ));
     }
-    getMSSpectrumById(spectra_native_ids_[id], s);
+    getMSSpectrumById(int(it->second), s);
   }
 
   void IndexedMzMLHandler::getMSSpectrumById(int id, MSSpectrum& s)
@@ -308,12 +372,13 @@ namespace Internal
 
   void IndexedMzMLHandler::getMSChromatogramByNativeId(std::string id, OpenMS::MSChromatogram& c)
   {
-    if (chromatograms_native_ids_.find(id) == chromatograms_native_ids_.end())
+    const auto it = chromatograms_native_ids_.find(id);
+    if (it == chromatograms_native_ids_.end())
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
           String( "Could not find chromatogram id " + String(id) ));
     }
-    getMSChromatogramById(chromatograms_native_ids_[id], c);
+    getMSChromatogramById(int(it->second), c);
   }
   // const OpenMS::MSChromatogram IndexedMzMLHandler::getMSChromatogramById(int id)
 
@@ -44,6 +44,8 @@
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <type_traits>
+
 namespace OpenMS
 {
   namespace Internal
@@ -4002,12 +4004,21 @@ namespace OpenMS
           warning(STORE, String("Invalid native IDs detected. Using spectrum identifier nativeID format (spectrum=xsd:nonNegativeInteger) for all spectra."));
         }
 
-        // write actual data
-        for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+        // write actual data: the binary data of a batch of spectra is
+        // encoded in parallel, then the XML is written in order (which also
+        // keeps the offsets for the index correct)
+        const Size batch_size = std::max(Size(1), options_.getMaxDataPoolSize());
+        std::vector<std::vector<EncodedArray> > encoded;
+        for (Size batch_start = 0; batch_start < exp.size(); batch_start += batch_size)
         {
-          logger_.setProgress(progress++);
-          const SpectrumType& spec = exp[s_idx];
-          writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
+          const Size batch_end = std::min(exp.size(), batch_start + batch_size);
+          encodeBinaryDataBatch_(exp.getSpectra(), batch_start, batch_end, encoded);
+          for (Size s_idx = batch_start; s_idx < batch_end; ++s_idx)
+          {
+            logger_.setProgress(progress++);
+            const SpectrumType& spec = exp[s_idx];
+            writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps, &encoded[s_idx - batch_start]);
+          }
         }
         os << "\t\t</spectrumList>\n";
       }
@@ -4022,11 +4033,18 @@ namespace OpenMS
         // meta information needs to be stored here but the actual data is
         // stored somewhere else).
         os << "\t\t<chromatogramList count=\"" << exp.getChromatograms().size() << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
-        for (Size c_idx = 0; c_idx != exp.getChromatograms().size(); ++c_idx)
+        const Size batch_size = std::max(Size(1), options_.getMaxDataPoolSize());
+        std::vector<std::vector<EncodedArray> > encoded;
+        for (Size batch_start = 0; batch_start < exp.getChromatograms().size(); batch_start += batch_size)
         {
-          logger_.setProgress(progress++);
-          const ChromatogramType& chromatogram = exp.getChromatograms()[c_idx];
-          writeChromatogram_(os, chromatogram, c_idx, validator);
+          const Size batch_end = std::min(exp.getChromatograms().size(), batch_start + batch_size);
+          encodeBinaryDataBatch_(exp.getChromatograms(), batch_start, batch_end, encoded);
+          for (Size c_idx = batch_start; c_idx < batch_end; ++c_idx)
+          {
+            logger_.setProgress(progress++);
+            const ChromatogramType& chromatogram = exp.getChromatograms()[c_idx];
+            writeChromatogram_(os, chromatogram, c_idx, validator, &encoded[c_idx - batch_start]);
+          }
         }
         os << "\t\t</chromatogramList>" << "\n";
       }
@@ -4973,7 +4991,8 @@ namespace OpenMS
                                      Size s,
                                      const Internal::MzMLValidator& validator,
                                      bool renew_native_ids,
-                                     std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+                                     std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                                     const std::vector<EncodedArray>* encoded_arrays)
     {
       //native id
       String native_id = spec.getNativeID();
@@ -5237,29 +5256,30 @@ namespace OpenMS
       //--------------------------------------------------------------------------------------------
       if (spec.size() != 0)
       {
-        String encoded_string;
+        std::vector<EncodedArray> local_encoded;
+        if (encoded_arrays == nullptr)
+        {
+          encodeBinaryData_(spec, local_encoded);
+          encoded_arrays = &local_encoded;
+        }
+        Size array_idx = 0;
         os << "\t\t\t\t<binaryDataArrayList count=\"" << (2 + spec.getFloatDataArrays().size() + spec.getStringDataArrays().size() + spec.getIntegerDataArrays().size()) << "\">\n";
 
-        writeContainerData_<SpectrumType>(os, options_, spec, "mz");
-        writeContainerData_<SpectrumType>(os, options_, spec, "intensity");
+        writeBinaryDataArray_(os, options_, (*encoded_arrays)[array_idx++], "mz");
+        writeBinaryDataArray_(os, options_, (*encoded_arrays)[array_idx++], "intensity");
 
         String compression_term = MzMLHandlerHelper::getCompressionTerm_(options_, options_.getNumpressConfigurationIntensity(), "\t\t\t\t\t\t", false);
         // write float data array
         for (Size m = 0; m < spec.getFloatDataArrays().size(); ++m)
         {
           const SpectrumType::FloatDataArray& array = spec.getFloatDataArrays()[m];
-          writeBinaryFloatDataArray_(os, options_, array, s, m, true, validator);
+          writeBinaryFloatDataArray_(os, options_, array, (*encoded_arrays)[array_idx++], s, m, true, validator);
         }
         // write integer data array
         for (Size m = 0; m < spec.getIntegerDataArrays().size(); ++m)
         {
           const SpectrumType::IntegerDataArray& array = spec.getIntegerDataArrays()[m];
-          std::vector<Int64> data64_to_encode(array.size());
-          for (Size p = 0; p < array.size(); ++p)
-          {
-            data64_to_encode[p] = array[p];
-          }
-          Base64::encodeIntegers(data64_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded_string, options_.getCompression());
+          const String& encoded_string = (*encoded_arrays)[array_idx++].data;
 
           String data_processing_ref_string = "";
           if (array.getDataProcessing().size() != 0)
@@ -5286,11 +5306,7 @@ namespace OpenMS
         for (Size m = 0; m < spec.getStringDataArrays().size(); ++m)
         {
           const SpectrumType::StringDataArray& array = spec.getStringDataArrays()[m];
-          std::vector<String> data_to_encode;
-          data_to_encode.resize(array.size());
-          for (Size p = 0; p < array.size(); ++p)
-            data_to_encode[p] = array[p];
-          Base64::encodeStrings(data_to_encode, encoded_string, options_.getCompression());
+          const String& encoded_string = (*encoded_arrays)[array_idx++].data;
           String data_processing_ref_string = "";
           if (array.getDataProcessing().size() != 0)
           {
@@ -5311,12 +5327,82 @@ namespace OpenMS
     }
 
     template <typename ContainerT>
-    void MzMLHandler::writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, String array_type)
+    void MzMLHandler::encodeBinaryData_(const ContainerT& container, std::vector<EncodedArray>& encoded) const
+    {
+      encoded.clear();
+      encoded.resize(2 + container.getFloatDataArrays().size() + container.getIntegerDataArrays().size() + container.getStringDataArrays().size());
+      Size array_idx = 0;
+
+      encodeContainerData_(options_, container, std::is_same<ContainerT, SpectrumType>::value ? "mz" : "time", encoded[array_idx++]);
+      encodeContainerData_(options_, container, "intensity", encoded[array_idx++]);
+
+      for (const auto& array : container.getFloatDataArrays())
+      {
+        std::vector<float> data_to_encode = array;
+        encodeDataArray_(options_, options_.getNumpressConfigurationFloatDataArray(), data_to_encode, true, encoded[array_idx++]);
+      }
+      for (const auto& array : container.getIntegerDataArrays())
+      {
+        std::vector<Int64> data64_to_encode(array.begin(), array.end());
+        Base64::encodeIntegers(data64_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded[array_idx++].data, options_.getCompression());
+      }
+      for (const auto& array : container.getStringDataArrays())
+      {
+        Base64::encodeStrings(array, encoded[array_idx++].data, options_.getCompression());
+      }
+    }
+
+    template <typename ContainerT>
+    void MzMLHandler::encodeBinaryDataBatch_(const std::vector<ContainerT>& data,
+                                             Size begin,
+                                             Size end,
+                                             std::vector<std::vector<EncodedArray> >& encoded) const
+    {
+      encoded.resize(end - begin);
+      size_t errCount = 0;
+      String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = (SignedSize)begin; i < (SignedSize)end; i++)
+      {
+        // parallel exception catching and re-throwing business
+        if (!errCount) // no need to encode further if already an error was encountered
+        {
+          try
+          {
+            encodeBinaryData_(data[i], encoded[i - begin]);
+          }
+          catch (OpenMS::Exception::BaseException& e)
+          {
+#pragma omp critical
+            {
+              ++errCount;
+              error_message = e.what();
+            }
+          }
+          catch (...)
+          {
+#pragma omp atomic
+            ++errCount;
+          }
+        }
+      }
+      if (errCount != 0)
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Error during encoding of binary data: '" + error_message + "'");
+      }
+    }
+
+    template <typename ContainerT>
+    void MzMLHandler::encodeContainerData_(const PeakFileOptions& pf_options_, const ContainerT& container, const String& array_type, EncodedArray& encoded)
     {
       // Intensity is the same for chromatograms and spectra, the second
       // dimension is either "time" or "mz" (both of these are controlled by
       // getMz32Bit)
       bool is32Bit = ((array_type == "intensity" && pf_options_.getIntensity32Bit()) || pf_options_.getMz32Bit());
+      MSNumpressCoder::NumpressConfig np_config = (array_type == "intensity") ?
+        pf_options_.getNumpressConfigurationIntensity() : pf_options_.getNumpressConfigurationMassTime();
       if (!is32Bit || pf_options_.getNumpressConfigurationMassTime().np_compression != MSNumpressCoder::NONE)
       {
         std::vector<double> data_to_encode(container.size());
@@ -5334,7 +5420,7 @@ namespace OpenMS
             data_to_encode[p] = container[p].getMZ();
           }
         }
-        writeBinaryDataArray_(os, pf_options_, data_to_encode, false, array_type);
+        encodeDataArray_(pf_options_, np_config, data_to_encode, false, encoded);
       }
       else
       {
@@ -5354,100 +5440,89 @@ namespace OpenMS
             data_to_encode[p] = container[p].getMZ();
           }
         }
-        writeBinaryDataArray_(os, pf_options_, data_to_encode, true, array_type);
+        encodeDataArray_(pf_options_, np_config, data_to_encode, true, encoded);
       }
 
     }
 
     template <typename DataType>
+    void MzMLHandler::encodeDataArray_(const PeakFileOptions& options,
+                                       const MSNumpressCoder::NumpressConfig& np_config,
+                                       std::vector<DataType>& data_to_encode,
+                                       bool is32bit,
+                                       EncodedArray& encoded)
+    {
+      encoded.is32bit = is32bit;
+      encoded.numpress = false;
+
+      // Try numpress encoding (if it is enabled) and fall back to regular encoding if it fails
+      if (np_config.np_compression != MSNumpressCoder::NONE)
+      {
+        MSNumpressCoder().encodeNP(data_to_encode, encoded.data, options.getCompression(), np_config);
+        encoded.numpress = !encoded.data.empty();
+      }
+
+      // Regular DataArray without numpress (either 32 or 64 bit encoded)
+      if (!encoded.numpress)
+      {
+        Base64::encode(data_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded.data, options.getCompression());
+      }
+    }
+
     void MzMLHandler::writeBinaryDataArray_(std::ostream& os,
                                             const PeakFileOptions& pf_options_,
-                                            std::vector<DataType>& data_to_encode,
-                                            bool is32bit,
-                                            String array_type)
+                                            const EncodedArray& encoded,
+                                            const String& array_type)
     {
-      String encoded_string;
-      bool no_numpress = true;
-
       // Compute the array-type and the compression CV term
       String cv_term_type;
-      String compression_term;
-      String compression_term_no_np;
       MSNumpressCoder::NumpressConfig np_config;
       if (array_type == "mz")
       {
         cv_term_type = "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000514\" name=\"m/z array\" unitAccession=\"MS:1000040\" unitName=\"m/z\" unitCvRef=\"MS\" />\n";
-        compression_term = MzMLHandlerHelper::getCompressionTerm_(pf_options_, pf_options_.getNumpressConfigurationMassTime(), "\t\t\t\t\t\t", true);
-        compression_term_no_np = MzMLHandlerHelper::getCompressionTerm_(pf_options_, pf_options_.getNumpressConfigurationMassTime(), "\t\t\t\t\t\t", false);
         np_config = pf_options_.getNumpressConfigurationMassTime();
       }
       else if (array_type == "time")
       {
         cv_term_type = "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000595\" name=\"time array\" unitAccession=\"UO:0000010\" unitName=\"second\" unitCvRef=\"MS\" />\n";
-        compression_term = MzMLHandlerHelper::getCompressionTerm_(pf_options_, pf_options_.getNumpressConfigurationMassTime(), "\t\t\t\t\t\t", true);
-        compression_term_no_np = MzMLHandlerHelper::getCompressionTerm_(pf_options_, pf_options_.getNumpressConfigurationMassTime(), "\t\t\t\t\t\t", false);
         np_config = pf_options_.getNumpressConfigurationMassTime();
       }
       else if (array_type == "intensity")
       {
         cv_term_type = "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000515\" name=\"intensity array\" unitAccession=\"MS:1000131\" unitName=\"number of detector counts\" unitCvRef=\"MS\"/>\n";
-        compression_term = MzMLHandlerHelper::getCompressionTerm_(pf_options_, pf_options_.getNumpressConfigurationIntensity(), "\t\t\t\t\t\t", true);
-        compression_term_no_np = MzMLHandlerHelper::getCompressionTerm_(pf_options_, pf_options_.getNumpressConfigurationIntensity(), "\t\t\t\t\t\t", false);
         np_config = pf_options_.getNumpressConfigurationIntensity();
       }
       else
       {
         throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown array type", array_type);
       }
+      String compression_term = MzMLHandlerHelper::getCompressionTerm_(pf_options_, np_config, "\t\t\t\t\t\t", encoded.numpress);
 
-      // Try numpress encoding (if it is enabled) and fall back to regular encoding if it fails
-      if (np_config.np_compression != MSNumpressCoder::NONE)
+      os << "\t\t\t\t\t<binaryDataArray encodedLength=\"" << encoded.data.size() << "\">\n";
+      os << cv_term_type;
+      if (encoded.is32bit && !encoded.numpress)
       {
-        MSNumpressCoder().encodeNP(data_to_encode, encoded_string, pf_options_.getCompression(), np_config);
-        if (!encoded_string.empty())
-        {
-          // numpress succeeded
-          no_numpress = false;
-          os << "\t\t\t\t\t<binaryDataArray encodedLength=\"" << encoded_string.size() << "\">\n";
-          os << cv_term_type;
-          os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000523\" name=\"64-bit float\" />\n";
-        }
-      }
-
-      // Regular DataArray without numpress (either 32 or 64 bit encoded)
-      if (is32bit && no_numpress)
-      {
-        compression_term = compression_term_no_np; // select the no-numpress term
-        Base64::encode(data_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded_string, pf_options_.getCompression());
-        os << "\t\t\t\t\t<binaryDataArray encodedLength=\"" << encoded_string.size() << "\">\n";
-        os << cv_term_type;
         os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000521\" name=\"32-bit float\" />\n";
       }
-      else if (!is32bit && no_numpress)
+      else
       {
-        compression_term = compression_term_no_np; // select the no-numpress term
-        Base64::encode(data_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded_string, pf_options_.getCompression());
-        os << "\t\t\t\t\t<binaryDataArray encodedLength=\"" << encoded_string.size() << "\">\n";
-        os << cv_term_type;
         os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000523\" name=\"64-bit float\" />\n";
       }
 
       os << compression_term << "\n";
-      os << "\t\t\t\t\t\t<binary>" << encoded_string << "</binary>\n";
+      os << "\t\t\t\t\t\t<binary>" << encoded.data << "</binary>\n";
       os << "\t\t\t\t\t</binaryDataArray>\n";
     }
 
     void MzMLHandler::writeBinaryFloatDataArray_(std::ostream& os,
                                                  const PeakFileOptions& pf_options_,
                                                  const OpenMS::DataArrays::FloatDataArray& array,
+                                                 const EncodedArray& encoded,
                                                  const Size spec_chrom_idx,
                                                  const Size array_idx,
                                                  bool isSpectrum,
                                                  const Internal::MzMLValidator& validator)
     {
-      String encoded_string;
-      bool no_numpress = true;
-      std::vector<float> data_to_encode = array;
       MetaInfoDescription array_metadata = array;
       // bool is32bit = true;
 
@@ -5490,27 +5565,16 @@ namespace OpenMS
         data_processing_ref_string = String("dataProcessingRef=\"dp_sp_") + spec_chrom_idx + "_bi_" + array_idx + "\"";
       }
 
-      // Try numpress encoding (if it is enabled) and fall back to regular encoding if it fails
-      if (np_config.np_compression != MSNumpressCoder::NONE)
+      os << "\t\t\t\t\t<binaryDataArray arrayLength=\"" << array.size() << "\" encodedLength=\"" << encoded.data.size() << "\" " << data_processing_ref_string << ">\n";
+      os << cv_term_type;
+      if (encoded.numpress)
       {
-        MSNumpressCoder().encodeNP(data_to_encode, encoded_string, pf_options_.getCompression(), np_config);
-        if (!encoded_string.empty())
-        {
-          // numpress succeeded
-          no_numpress = false;
-          os << "\t\t\t\t\t<binaryDataArray arrayLength=\"" << array.size() << "\" encodedLength=\"" << encoded_string.size() << "\" " << data_processing_ref_string << ">\n";
-          os << cv_term_type;
-          os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000523\" name=\"64-bit float\" />\n";
-        }
+        os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000523\" name=\"64-bit float\" />\n";
       }
-
-      // Regular DataArray without numpress (here: only 32 bit encoded)
-      if (no_numpress)
+      else
       {
+        // Regular DataArray without numpress (here: only 32 bit encoded)
         compression_term = compression_term_no_np; // select the no-numpress term
-        Base64::encode(data_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded_string, pf_options_.getCompression());
-        os << "\t\t\t\t\t<binaryDataArray arrayLength=\"" << array.size() << "\" encodedLength=\"" << encoded_string.size() << "\" " << data_processing_ref_string << ">\n";
-        os << cv_term_type;
         os << "\t\t\t\t\t\t<cvParam cvRef=\"MS\" accession=\"MS:1000521\" name=\"32-bit float\" />\n";
       }
 
@@ -5523,37 +5587,38 @@ namespace OpenMS
       {
         writeUserParam_(os, array_metadata, 6, "/mzML/run/chromatogramList/chromatogram/binaryDataArrayList/binaryDataArray/cvParam/@accession", validator);
       }
-      os << "\t\t\t\t\t\t<binary>" << encoded_string << "</binary>\n";
+      os << "\t\t\t\t\t\t<binary>" << encoded.data << "</binary>\n";
       os << "\t\t\t\t\t</binaryDataArray>\n";
     }
 
     // We only ever need 2 instances for the following functions: one for Spectra / Chromatograms and one for floats / doubles
-    template void MzMLHandler::writeContainerData_<SpectrumType>(std::ostream& os,
-                                                                 const PeakFileOptions& pf_options_,
-                                                                 const SpectrumType& container,
-                                                                 String array_type);
-
-    template void MzMLHandler::writeContainerData_<ChromatogramType>(std::ostream& os,
-                                                                     const PeakFileOptions& pf_options_,
-                                                                     const ChromatogramType& container,
-                                                                     String array_type);
-
-    template void MzMLHandler::writeBinaryDataArray_<float>(std::ostream& os,
-                                                            const PeakFileOptions& pf_options_,
-                                                            std::vector<float>& data_to_encode,
-                                                            bool is32bit,
-                                                            String array_type);
-
-    template void MzMLHandler::writeBinaryDataArray_<double>(std::ostream& os,
-                                                             const PeakFileOptions& pf_options_,
-                                                             std::vector<double>& data_to_encode,
-                                                             bool is32bit,
-                                                             String array_type);
+    template void MzMLHandler::encodeContainerData_<SpectrumType>(const PeakFileOptions& pf_options_,
+                                                                  const SpectrumType& container,
+                                                                  const String& array_type,
+                                                                  EncodedArray& encoded);
+
+    template void MzMLHandler::encodeContainerData_<ChromatogramType>(const PeakFileOptions& pf_options_,
+                                                                      const ChromatogramType& container,
+                                                                      const String& array_type,
+                                                                      EncodedArray& encoded);
+
+    template void MzMLHandler::encodeDataArray_<float>(const PeakFileOptions& options,
+                                                       const MSNumpressCoder::NumpressConfig& np_config,
+                                                       std::vector<float>& data_to_encode,
+                                                       bool is32bit,
+                                                       EncodedArray& encoded);
+
+    template void MzMLHandler::encodeDataArray_<double>(const PeakFileOptions& options,
+                                                        const MSNumpressCoder::NumpressConfig& np_config,
+                                                        std::vector<double>& data_to_encode,
+                                                        bool is32bit,
+                                                        EncodedArray& encoded);
 
     void MzMLHandler::writeChromatogram_(std::ostream& os,
                                          const ChromatogramType& chromatogram,
                                          Size c,
-                                         const Internal::MzMLValidator& validator)
+                                         const Internal::MzMLValidator& validator,
+                                         const std::vector<EncodedArray>* encoded_arrays)
     {
       Int64 offset = os.tellp();
       chromatograms_offsets_.push_back(make_pair(chromatogram.getNativeID(), offset + 3));
@@ -5609,30 +5674,31 @@ namespace OpenMS
       //--------------------------------------------------------------------------------------------
       //binary data array list
       //--------------------------------------------------------------------------------------------
+      std::vector<EncodedArray> local_encoded;
+      if (encoded_arrays == nullptr)
+      {
+        encodeBinaryData_(chromatogram, local_encoded);
+        encoded_arrays = &local_encoded;
+      }
+      Size array_idx = 0;
       String compression_term;
-      String encoded_string;
       os << "\t\t\t\t<binaryDataArrayList count=\"" << (2 + chromatogram.getFloatDataArrays().size() + chromatogram.getStringDataArrays().size() + chromatogram.getIntegerDataArrays().size()) << "\">\n";
 
-      writeContainerData_<ChromatogramType>(os, options_, chromatogram, "time");
-      writeContainerData_<ChromatogramType>(os, options_, chromatogram, "intensity");
+      writeBinaryDataArray_(os, options_, (*encoded_arrays)[array_idx++], "time");
+      writeBinaryDataArray_(os, options_, (*encoded_arrays)[array_idx++], "intensity");
 
       compression_term = MzMLHandlerHelper::getCompressionTerm_(options_, options_.getNumpressConfigurationIntensity(), "\t\t\t\t\t\t", false);
       // write float data array
       for (Size m = 0; m < chromatogram.getFloatDataArrays().size(); ++m)
       {
         const ChromatogramType::FloatDataArray& array = chromatogram.getFloatDataArrays()[m];
-        writeBinaryFloatDataArray_(os, options_, array, c, m, false, validator);
+        writeBinaryFloatDataArray_(os, options_, array, (*encoded_arrays)[array_idx++], c, m, false, validator);
       }
       //write integer data array
       for (Size m = 0; m < chromatogram.getIntegerDataArrays().size(); ++m)
       {
         const ChromatogramType::IntegerDataArray& array = chromatogram.getIntegerDataArrays()[m];
-        std::vector<Int64> data64_to_encode(array.size());
-        for (Size p = 0; p < array.size(); ++p)
-        {
-          data64_to_encode[p] = array[p];
-        }
-        Base64::encodeIntegers(data64_to_encode, Base64::BYTEORDER_LITTLEENDIAN, encoded_string, options_.getCompression());
+        const String& encoded_string = (*encoded_arrays)[array_idx++].data;
         String data_processing_ref_string = "";
         if (array.getDataProcessing().size() != 0)
         {
@@ -5658,13 +5724,7 @@ namespace OpenMS
       for (Size m = 0; m < chromatogram.getStringDataArrays().size(); ++m)
       {
         const ChromatogramType::StringDataArray& array = chromatogram.getStringDataArrays()[m];
-        std::vector<String> data_to_encode;
-        data_to_encode.resize(array.size());
-        for (Size p = 0; p < array.size(); ++p)
-        {
-          data_to_encode[p] = array[p];
-        }
-        Base64::encodeStrings(data_to_encode, encoded_string, options_.getCompression());
+        const String& encoded_string = (*encoded_arrays)[array_idx++].data;
         String data_processing_ref_string = "";
         if (array.getDataProcessing().size() != 0)
         {
@@ -37,6 +37,7 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/StringUtils.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 
 #include <set>
@@ -198,6 +199,15 @@ namespace OpenMS
       }
     }
 
+    DataValue XMLHandler::stringUserParamValue_(const String& value)
+    {
+      if (value.size() <= MAX_INTERNED_USERPARAM_LENGTH)
+      {
+        return DataValue::interned(value);
+      }
+      return DataValue(value);
+    }
+
     void XMLHandler::writeUserParam_(const String& tag_name, std::ostream& os, const MetaInfoInterface& meta, UInt indent) const
     {
       std::vector<String> keys;
@@ -291,6 +301,28 @@ namespace OpenMS
 
     }
 
+    bool StringManager::parseDouble(const XMLCh * str, double & value)
+    {
+      if (str == nullptr) return false;
+
+      // Numbers are plain ASCII and short, so we narrow them into a buffer on
+      // the stack (no transcoder, no heap allocation). Anything else is left
+      // to the caller.
+      char buffer[64];
+      Size length = 0;
+      for (const XMLCh* it = str; *it != 0; ++it)
+      {
+        if (*it >= 128 || length == sizeof(buffer)) return false;
+        buffer[length++] = (char)*it;
+      }
+
+      const char* begin = buffer;
+      const char* end = buffer + length;
+      while (begin != end && (*begin == ' ' || (*begin >= '\t' && *begin <= '\r'))) ++begin;
+      while (begin != end && (*(end - 1) == ' ' || (*(end - 1) >= '\t' && *(end - 1) <= '\r'))) --end;
+      return StringUtils::extractDouble(begin, end, value) && begin == end;
+    }
+
   }   // namespace Internal
 
 } // namespace OpenMS
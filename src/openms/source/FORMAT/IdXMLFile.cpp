@@ -56,7 +56,9 @@ namespace OpenMS
     XMLFile("/SCHEMAS/IdXML_1_5.xsd", "1.5"),
     last_meta_(nullptr),
     document_id_(),
-    prot_id_in_run_(false)
+    prot_id_in_run_(false),
+    consumer_(nullptr),
+    batch_size_(0)
   {
   }
 
@@ -82,9 +84,55 @@ namespace OpenMS
 
     parse_(filename, this);
 
-    //reset members
+    resetLoadMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, Size batch_size)
+  {
+    if (batch_size == 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Batch size must be positive");
+    }
+
+    startProgress(0, 0, "Loading idXML");
+    //Filename for error messages in XMLHandler
+    file_ = filename;
+
+    // the vectors only buffer identifications until they are passed to the consumer
+    std::vector<ProteinIdentification> protein_ids;
+    std::vector<PeptideIdentification> peptide_ids;
+    String document_id;
+
+    prot_ids_ = &protein_ids;
+    pep_ids_ = &peptide_ids;
+    document_id_ = &document_id;
+    consumer_ = consumer;
+    batch_size_ = batch_size;
+
+    try
+    {
+      parse_(filename, this);
+      flushPeptideIdentifications_();
+    }
+    catch (...)
+    {
+      resetLoadMembers_();
+      throw;
+    }
+
+    resetLoadMembers_();
+
+    endProgress();
+  }
+
+  void IdXMLFile::resetLoadMembers_()
+  {
     prot_ids_ = nullptr;
     pep_ids_ = nullptr;
+    consumer_ = nullptr;
+    batch_size_ = 0;
     last_meta_ = nullptr;
     parameters_.clear();
     param_ = ProteinIdentification::SearchParameters();
@@ -94,8 +142,37 @@ namespace OpenMS
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
     proteinid_to_accession_.clear();
+  }
 
-    endProgress();
+  void IdXMLFile::proteinIdentificationAdded_()
+  {
+    if (consumer_ == nullptr) return;
+
+    // peptides of the previous run go first
+    flushPeptideIdentifications_();
+
+    // only the identifier is needed for the rest of the run (peptide identifications refer to it)
+    String identifier = prot_ids_->back().getIdentifier();
+    consumer_->consumeProteinIdentification(prot_ids_->back());
+    prot_ids_->clear();
+    prot_ids_->resize(1);
+    prot_ids_->back().setIdentifier(identifier);
+  }
+
+  void IdXMLFile::peptideIdentificationAdded_()
+  {
+    if (consumer_ != nullptr && pep_ids_->size() >= batch_size_)
+    {
+      flushPeptideIdentifications_();
+    }
+  }
+
+  void IdXMLFile::flushPeptideIdentifications_()
+  {
+    if (consumer_ == nullptr || pep_ids_->empty()) return;
+
+    consumer_->consumePeptideIdentifications(*pep_ids_);
+    pep_ids_->clear();
   }
 
   void IdXMLFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids, const String& document_id)
@@ -445,18 +522,7 @@ namespace OpenMS
 
     endProgress();
 
-    //reset members
-    prot_ids_ = nullptr;
-    pep_ids_ = nullptr;
-    last_meta_ = nullptr;
-    parameters_.clear();
-    param_ = ProteinIdentification::SearchParameters();
-    id_ = "";
-    prot_id_ = ProteinIdentification();
-    pep_id_ = PeptideIdentification();
-    prot_hit_ = ProteinHit();
-    pep_hit_ = PeptideHit();
-    proteinid_to_accession_.clear();
+    resetLoadMembers_();
   }
 
   void IdXMLFile::startElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname, const xercesc::Attributes& attributes)
@@ -615,6 +681,7 @@ namespace OpenMS
       if (!prot_id_in_run_)
       {
         prot_ids_->push_back(prot_id_);
+        proteinIdentificationAdded_();
         prot_id_in_run_ = true; // set to true, cause we have created one; will be reset for next run
       }
 
@@ -828,7 +895,8 @@ namespace OpenMS
           pep_hit_.setPeakAnnotations(annotations);
           return;
       }
-        last_meta_->setMetaValue(name, value);
+        // short string values are often repeated across hits (e.g. target_decoy), share their storage
+        last_meta_->setMetaValue(name, stringUserParamValue_(value));
       }
       else if (type == "intList")
       {
@@ -887,6 +955,7 @@ namespace OpenMS
                         "indistinguishable_proteins");
 
       prot_ids_->push_back(prot_id_);
+      proteinIdentificationAdded_();
       prot_id_ = ProteinIdentification();
       last_meta_  = nullptr;
       prot_id_in_run_ = true;
@@ -897,6 +966,7 @@ namespace OpenMS
       {
         // add empty <ProteinIdentification> if there was none so far (that's where the IdentificationRun parameters are stored)
         prot_ids_->emplace_back(std::move(prot_id_));
+        proteinIdentificationAdded_();
       }
       prot_id_ = ProteinIdentification();
       last_meta_ = nullptr;
@@ -913,6 +983,7 @@ namespace OpenMS
       pep_ids_->emplace_back(std::move(pep_id_));
       pep_id_ = PeptideIdentification();
       last_meta_ = nullptr;
+      peptideIdentificationAdded_();
     }
     else if (tag == "PeptideHit")
     {
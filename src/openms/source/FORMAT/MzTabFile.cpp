@@ -2895,7 +2895,10 @@ namespace OpenMS
       }
     }
   }
-    // stream IDs to file
+  /// number of rows that the streaming store() methods collect before formatting them in parallel and writing them out
+  static const Size STREAM_CHUNK_SIZE = 10000;
+
+  // stream IDs to file
   void MzTabFile::store(
         const String& filename,
         const std::vector<ProteinIdentification>& protein_identifications,
@@ -2942,6 +2945,7 @@ namespace OpenMS
       MzTabProteinSectionRow row;
       bool first = true;
       size_t n_header_columns = 0;
+      std::vector<MzTabProteinSectionRow> chunk;
       while (s.nextPRTRow(row))
       {
         if (first)
@@ -2954,10 +2958,13 @@ namespace OpenMS
             n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
+        chunk.push_back(std::move(row));
+        if (chunk.size() >= STREAM_CHUNK_SIZE)
+        {
+          writeMzTabSectionRows_(tab_file, chunk, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
+        }
       }
+      writeMzTabSectionRows_(tab_file, chunk, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     Size n_search_engine_scores = meta_data.psm_search_engine_score.size();
@@ -2971,6 +2978,7 @@ namespace OpenMS
       MzTabPSMSectionRow row;
       bool first = true;
       size_t n_header_columns = 0;
+      std::vector<MzTabPSMSectionRow> chunk;
       while (s.nextPSMRow(row))
       {
         if (first)
@@ -2978,10 +2986,13 @@ namespace OpenMS
           tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
+        chunk.push_back(std::move(row));
+        if (chunk.size() >= STREAM_CHUNK_SIZE)
+        {
+          writeMzTabSectionRows_(tab_file, chunk, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
+        }
       }
+      writeMzTabSectionRows_(tab_file, chunk, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     tab_file.close();
@@ -3032,6 +3043,7 @@ namespace OpenMS
       MzTabProteinSectionRow row;
       bool first = true;
       size_t n_header_columns = 0;
+      std::vector<MzTabProteinSectionRow> chunk;
       while (s.nextPRTRow(row))
       {
         if (first)
@@ -3044,10 +3056,13 @@ namespace OpenMS
             n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
+        chunk.push_back(std::move(row));
+        if (chunk.size() >= STREAM_CHUNK_SIZE)
+        {
+          writeMzTabSectionRows_(tab_file, chunk, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
+        }
       }
+      writeMzTabSectionRows_(tab_file, chunk, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     Size assays(0);
@@ -3056,6 +3071,7 @@ namespace OpenMS
       MzTabPeptideSectionRow row;
       bool first = true;
       size_t n_header_columns = 0;
+      std::vector<MzTabPeptideSectionRow> chunk;
       while (s.nextPEPRow(row))
       {
         if (first)
@@ -3071,14 +3087,13 @@ namespace OpenMS
           tab_file << "\n" << generateMzTabPeptideHeader_(search_ms_runs, n_best_search_engine_score, n_search_engine_score, assays, study_variables, s.getPeptideOptionalColumnNames(), n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPeptideOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)
+        chunk.push_back(std::move(row));
+        if (chunk.size() >= STREAM_CHUNK_SIZE)
         {
-          OPENMS_LOG_ERROR << "Number of columns in header/section: " << n_header_columns << "/" << n_section_columns << endl;
-          throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Peptide header and content differs in columns. Please report this bug to the OpenMS developers.");
+          writeMzTabSectionRows_(tab_file, chunk, s.getPeptideOptionalColumnNames(), meta_data, n_header_columns);
         }
       }
+      writeMzTabSectionRows_(tab_file, chunk, s.getPeptideOptionalColumnNames(), meta_data, n_header_columns);
     } 
 
     Size n_search_engine_scores = meta_data.psm_search_engine_score.size();
@@ -3095,6 +3110,7 @@ namespace OpenMS
       // TODO: we currently only store one search engine score per PSM so we need to limit the number to the main score      
       n_search_engine_scores = 1;
       size_t n_header_columns = 0;
+      std::vector<MzTabPSMSectionRow> chunk;
       while (s.nextPSMRow(row))
       {
         if (first)
@@ -3102,10 +3118,13 @@ namespace OpenMS
           tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
+        chunk.push_back(std::move(row));
+        if (chunk.size() >= STREAM_CHUNK_SIZE)
+        {
+          writeMzTabSectionRows_(tab_file, chunk, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
+        }
       }
+      writeMzTabSectionRows_(tab_file, chunk, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     tab_file.close();
@@ -3293,44 +3312,54 @@ namespace OpenMS
       generateMzTabSection_(mz_tab.getOSMSectionRows(), mz_tab.getOSMOptionalColumnNames(), mz_tab.getMetaData(), out, n_columns);
   }
 
-    // insert comments (might provide critical cues for human reader) and empty lines
-  Size line = 0;
-  vector<Size> empty_rows = mz_tab.getEmptyRows();
-  map<Size, String> comment_rows = mz_tab.getCommentRows();
-
-  if (empty_rows.empty() && comment_rows.empty())
-  {
-    TextFile tmp_out;
-    for (TextFile::ConstIterator it = out.begin(); it != out.end(); ++it)
+    // stream not opened in binary mode, thus "\n" will be evaluated platform dependent (same line handling as TextFile::store)
+    ofstream tab_file(filename.c_str(), ios::out | ios::trunc);
+    if (!tab_file)
     {
-      tmp_out.addLine(*it);
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
     }
-    tmp_out.store(filename);
-  }
-  else
-  {
-    TextFile tmp_out;
-    for (TextFile::ConstIterator it = out.begin(); it != out.end(); )
+
+    auto writeLine = [&tab_file](const String& l)
     {
+      if (l.hasSuffix("\r\n"))
+      {
+        tab_file.write(l.c_str(), l.size() - 2);
+        tab_file << "\n";
+      }
+      else if (l.hasSuffix("\n"))
+      {
+        tab_file << l;
+      }
+      else
+      {
+        tab_file << l << "\n";
+      }
+    };
+
+    // insert comments (might provide critical cues for human reader) and empty lines
+    Size line = 0;
+    const vector<Size>& empty_rows = mz_tab.getEmptyRows();
+    const map<Size, String>& comment_rows = mz_tab.getCommentRows();
+
+    for (StringList::const_iterator it = out.begin(); it != out.end(); )
+    {
+      map<Size, String>::const_iterator comment_it;
       if (std::binary_search(empty_rows.begin(), empty_rows.end(), line))  // check if current line was originally an empty line
       {
-        tmp_out.addLine("\n");
-        ++line;
+        writeLine("\n");
       }
-      else if (comment_rows.find(line) != comment_rows.end()) // check if current line was originally a comment line
+      else if ((comment_it = comment_rows.find(line)) != comment_rows.end()) // check if current line was originally a comment line
       {
-        tmp_out.addLine(comment_rows[line]);
-        ++line;
+        writeLine(comment_it->second);
       }
       else   // no empty line, no comment => add row
       {
-        tmp_out.addLine(*it);
-        ++line;
+        writeLine(*it);
         ++it;
       }
+      ++line;
     }
-    tmp_out.store(filename);
-  }
+    tab_file.close();
   }
 
 }
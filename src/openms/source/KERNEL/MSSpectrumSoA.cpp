@@ -0,0 +1,208 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace OpenMS
+{
+  MSSpectrumSoA::MSSpectrumSoA(const MSSpectrum& spectrum)
+  {
+    assign(spectrum);
+  }
+
+  bool MSSpectrumSoA::operator==(const MSSpectrumSoA& rhs) const
+  {
+    return mz_ == rhs.mz_ && intensity_ == rhs.intensity_;
+  }
+
+  bool MSSpectrumSoA::operator!=(const MSSpectrumSoA& rhs) const
+  {
+    return !(operator==(rhs));
+  }
+
+  void MSSpectrumSoA::assign(const MSSpectrum& spectrum)
+  {
+    mz_.resize(spectrum.size());
+    intensity_.resize(spectrum.size());
+    for (Size i = 0; i < spectrum.size(); ++i)
+    {
+      mz_[i] = spectrum[i].getMZ();
+      intensity_[i] = spectrum[i].getIntensity();
+    }
+  }
+
+  void MSSpectrumSoA::toMSSpectrum(MSSpectrum& spectrum) const
+  {
+    spectrum.resize(mz_.size());
+    for (Size i = 0; i < mz_.size(); ++i)
+    {
+      spectrum[i].setMZ(mz_[i]);
+      spectrum[i].setIntensity(intensity_[i]);
+    }
+  }
+
+  void MSSpectrumSoA::clear()
+  {
+    mz_.clear();
+    intensity_.clear();
+  }
+
+  void MSSpectrumSoA::reserve(Size n)
+  {
+    mz_.reserve(n);
+    intensity_.reserve(n);
+  }
+
+  bool MSSpectrumSoA::isSorted() const
+  {
+    return std::is_sorted(mz_.begin(), mz_.end());
+  }
+
+  void MSSpectrumSoA::sortByPosition()
+  {
+    if (isSorted()) return;
+
+    std::vector<Size> order(mz_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](Size a, Size b) { return mz_[a] < mz_[b]; });
+
+    std::vector<CoordinateType> mz(mz_.size());
+    std::vector<IntensityType> intensity(intensity_.size());
+    for (Size i = 0; i < order.size(); ++i)
+    {
+      mz[i] = mz_[order[i]];
+      intensity[i] = intensity_[order[i]];
+    }
+    mz_.swap(mz);
+    intensity_.swap(intensity);
+  }
+
+  Size MSSpectrumSoA::MZBegin(CoordinateType mz) const
+  {
+    return std::lower_bound(mz_.begin(), mz_.end(), mz) - mz_.begin();
+  }
+
+  Size MSSpectrumSoA::MZEnd(CoordinateType mz) const
+  {
+    return std::upper_bound(mz_.begin(), mz_.end(), mz) - mz_.begin();
+  }
+
+  Size MSSpectrumSoA::findNearest(CoordinateType mz) const
+  {
+    // no peak => no search
+    if (mz_.empty()) throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "There must be at least one peak to determine the nearest peak!");
+
+    // search for position for inserting
+    Size i = MZBegin(mz);
+    // border cases
+    if (i == 0) return 0;
+    if (i == mz_.size()) return mz_.size() - 1;
+
+    // the peak before or the current peak are closest
+    if (std::fabs(mz_[i] - mz) < std::fabs(mz_[i - 1] - mz))
+    {
+      return i;
+    }
+    return i - 1;
+  }
+
+  Int MSSpectrumSoA::findNearest(CoordinateType mz, CoordinateType tolerance) const
+  {
+    if (mz_.empty()) return -1;
+    Size i = findNearest(mz);
+    if (mz_[i] >= mz - tolerance && mz_[i] <= mz + tolerance)
+    {
+      return static_cast<Int>(i);
+    }
+    return -1;
+  }
+
+  Int MSSpectrumSoA::findNearest(CoordinateType mz, CoordinateType tolerance_left, CoordinateType tolerance_right) const
+  {
+    if (mz_.empty()) return -1;
+
+    // do a binary search for nearest peak first
+    Size i = findNearest(mz);
+    const double nearest_mz = mz_[i];
+
+    if (nearest_mz < mz)
+    {
+      if (nearest_mz >= mz - tolerance_left) return i; // nearest peak is in left tolerance window
+      if (i == mz_.size() - 1) return -1; // last peak, too far left
+      // there still might be a peak to the right of mz that falls in the right window
+      ++i;
+      if (mz_[i] <= mz + tolerance_right) return i;
+    }
+    else
+    {
+      if (nearest_mz <= mz + tolerance_right) return i; // nearest peak is in right tolerance window
+      if (i == 0) return -1; // first peak, too far right
+      --i;
+      if (mz_[i] >= mz - tolerance_left) return i;
+    }
+    return -1;
+  }
+
+  void MSSpectrumSoA::findNearest(const std::vector<CoordinateType>& mz, CoordinateType tolerance, std::vector<Int>& indices) const
+  {
+    indices.assign(mz.size(), -1);
+    if (mz_.empty()) return;
+
+    // both arrays are sorted: advance the peak index monotonically
+    Size i = 0;
+    const Size n = mz_.size();
+    for (Size q = 0; q < mz.size(); ++q)
+    {
+      const CoordinateType query = mz[q];
+      // move to the first peak not less than the query (as MZBegin does)
+      while (i < n && mz_[i] < query) ++i;
+
+      // the peak before or the current peak are closest (ties go to the left peak, as in findNearest)
+      Size nearest;
+      if (i == 0) nearest = 0;
+      else if (i == n) nearest = n - 1;
+      else nearest = std::fabs(mz_[i] - query) < std::fabs(mz_[i - 1] - query) ? i : i - 1;
+
+      if (mz_[nearest] >= query - tolerance && mz_[nearest] <= query + tolerance)
+      {
+        indices[q] = static_cast<Int>(nearest);
+      }
+    }
+  }
+
+} // namespace OpenMS
@@ -48,6 +48,19 @@ namespace OpenMS
     options.setFillData(false);
     f.setOptions(options);
     f.load(filename, *meta_ms_experiment_.get());
+
+    // build the native id lookup tables right away, so that native id access
+    // does not modify any state afterwards (required for concurrent access)
+    chromatograms_native_ids_.clear();
+    for (Size k = 0; k < meta_ms_experiment_->getChromatograms().size(); k++)
+    {
+      chromatograms_native_ids_.emplace(meta_ms_experiment_->getChromatograms()[k].getNativeID(), k);
+    }
+    spectra_native_ids_.clear();
+    for (Size k = 0; k < meta_ms_experiment_->getSpectra().size(); k++)
+    {
+      spectra_native_ids_.emplace(meta_ms_experiment_->getSpectra()[k].getNativeID(), k);
+    }
   }
 
   MSChromatogram OnDiscMSExperiment::getMetaChromatogramById_(const std::string& id)
@@ -65,7 +78,7 @@ namespace OpenMS
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
           String("Could not find chromatogram with id '") + id + "'.");
     }
-    return meta_ms_experiment_->getChromatogram(chromatograms_native_ids_[id]);
+    return meta_ms_experiment_->getChromatogram(chromatograms_native_ids_.at(id));
   }
 
   MSChromatogram OnDiscMSExperiment::getChromatogramByNativeId(const std::string& id)
@@ -97,7 +110,7 @@ namespace OpenMS
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
           String("Could not find spectrum with id '") + id + "'.");
     }
-    return meta_ms_experiment_->getSpectrum(spectra_native_ids_[id]);
+    return meta_ms_experiment_->getSpectrum(spectra_native_ids_.at(id));
   }
 
   MSSpectrum OnDiscMSExperiment::getSpectrumByNativeId(const std::string& id)
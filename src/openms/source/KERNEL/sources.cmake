@@ -17,6 +17,7 @@ MRMFeature.cpp
 MRMTransitionGroup.cpp
 MSExperiment.cpp
 MSSpectrum.cpp
+MSSpectrumSoA.cpp
 OnDiscMSExperiment.cpp
 Peak1D.cpp
 Peak2D.cpp
@@ -38,9 +38,16 @@
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/MATH/MISC/SplineBisection.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 
+#include <atomic>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -408,6 +415,122 @@ namespace OpenMS
     uint32_t total{0};  ///< overall number of spectra
   };
 
+  namespace
+  {
+    /*
+      Reads and picks @p n items (spectra or chromatograms) in chunks of
+      @p chunk_size. While the threads process chunk k, a single thread hands
+      the items of chunk k-1 to @p consume_item in input order (double
+      buffering), so reading, picking and writing overlap.
+    */
+    template <typename ContainerType, typename PickFunction, typename ConsumeFunction>
+    void pickChunked(Size n, Size chunk_size, PickFunction pick_item, ConsumeFunction consume_item,
+                     const ProgressLogger& logger, Size& progress)
+    {
+      std::vector<ContainerType> current, previous;
+      // exceptions must not leave the parallel region, the first one is rethrown afterwards
+      std::exception_ptr error;
+      std::atomic<bool> failed(false);
+
+      // one more round than there are chunks to pass on the last one
+      Size chunk_start = 0;
+      while (chunk_start < n || !previous.empty())
+      {
+        Size chunk_end = std::min(chunk_start + chunk_size, n);
+        current.clear();
+        current.resize(chunk_end - chunk_start);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+          // one thread passes on the previous chunk, then joins the others in picking
+#ifdef _OPENMP
+#pragma omp single nowait
+#endif
+          {
+            try
+            {
+              for (ContainerType& item : previous)
+              {
+                consume_item(item);
+              }
+            }
+            catch (...)
+            {
+#ifdef _OPENMP
+#pragma omp critical (PeakPickerHiRes_error)
+#endif
+              if (!error) error = std::current_exception();
+              failed = true;
+            }
+          }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+          for (SignedSize i = 0; i < (SignedSize)current.size(); ++i)
+          {
+            if (failed) continue;
+            try
+            {
+              pick_item(chunk_start + i, current[i]);
+            }
+            catch (...)
+            {
+#ifdef _OPENMP
+#pragma omp critical (PeakPickerHiRes_error)
+#endif
+              if (!error) error = std::current_exception();
+              failed = true;
+            }
+          }
+        }
+
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+
+        progress += current.size();
+        logger.setProgress(progress);
+        previous.swap(current);
+        chunk_start = chunk_end;
+      }
+    }
+  }
+
+  bool PeakPickerHiRes::pickSpectrumOfMap_(const MSSpectrum& input, MSSpectrum& output, std::vector<PeakBoundary>& boundaries, const bool check_spectrum_type) const
+  {
+    // auto mode
+    if (ms_levels_.empty())
+    {
+      SpectrumSettings::SpectrumType spectrum_type = input.getType(true); // uses meta-info and inspects data if needed
+      if (spectrum_type == SpectrumSettings::CENTROID)
+      {
+        output = input;
+        return false;
+      }
+    }
+    // manual mode
+    else if (!ListUtils::contains(ms_levels_, input.getMSLevel()))
+    {
+      output = input;
+      return false;
+    }
+    else if (check_spectrum_type)
+    {
+      SpectrumSettings::SpectrumType spectrum_type = input.getType(true); // uses meta-info and inspects data if needed
+      if (spectrum_type == SpectrumSettings::CENTROID)
+      {
+        throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+      }
+    }
+
+    pick(input, output, boundaries);
+    return true;
+  }
+
   void PeakPickerHiRes::pickExperiment(const PeakMap& input,
                                        PeakMap& output, 
                                        std::vector<std::vector<PeakBoundary> >& boundaries_spec, 
@@ -422,70 +545,97 @@ namespace OpenMS
 
     // resize output with respect to input
     output.resize(input.size());
+    output.getChromatograms().resize(input.getChromatograms().size());
 
     Size progress = 0;
     startProgress(0, input.size() + input.getChromatograms().size(), "picking peaks");
 
-    // MSLevel -> stats
-    map<int, SpectraPickInfo> pick_info;
-
-    if (input.getNrSpectra() > 0)
+    // results are stored at the index of their input, which keeps the output
+    // independent of the order in which the threads finish
+    std::vector<std::vector<PeakBoundary> > spectrum_boundaries(input.size());
+    std::vector<char> was_picked(input.size(), false); // not vector<bool>, which is unsafe for concurrent writes
+    std::vector<std::vector<PeakBoundary> > chromatogram_boundaries(input.getChromatograms().size());
+
+    Size error_count = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize scan_idx = 0; scan_idx < (SignedSize)input.size(); ++scan_idx)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      // parallel exception catching and re-throwing business
+      if (error_count) continue;
+      try
       {
-        bool was_picked{false};
-        // auto mode
-        if (ms_levels_.empty()) 
-        {
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
-          if (spectrum_type == SpectrumSettings::CENTROID)
-          {
-            output[scan_idx] = input[scan_idx];
-          }
-          else
-          {
-            std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-            pick(input[scan_idx], output[scan_idx], boundaries_s);
-            was_picked = true;
-            boundaries_spec.push_back(std::move(boundaries_s));
-          }
-        }
-        // manual mode
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) 
+        was_picked[scan_idx] = pickSpectrumOfMap_(input[scan_idx], output[scan_idx], spectrum_boundaries[scan_idx], check_spectrum_type);
+      }
+      catch (Exception::BaseException& e)
+      {
+#pragma omp critical (PeakPickerHiRes_error)
         {
-          output[scan_idx] = input[scan_idx];
+          ++error_count;
+          error_message = e.what();
         }
-        else
-        {
-          std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-          SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
-
-          pick(input[scan_idx], output[scan_idx], boundaries_s);
-          was_picked = true;
-          boundaries_spec.push_back(std::move(boundaries_s));
-        }
-        pick_info[input[scan_idx].getMSLevel()].picked += was_picked;
-        ++pick_info[input[scan_idx].getMSLevel()].total;
-        setProgress(++progress);
       }
+
+      IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+    }
+    if (error_count != 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error_message);
     }
 
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)input.getChromatograms().size(); ++i)
+    {
+      // parallel exception catching and re-throwing business
+      if (error_count) continue;
+      try
+      {
+        pick(input.getChromatograms()[i], output.getChromatograms()[i], chromatogram_boundaries[i]);
+      }
+      catch (Exception::BaseException& e)
+      {
+#pragma omp critical (PeakPickerHiRes_error)
+        {
+          ++error_count;
+          error_message = e.what();
+        }
+      }
 
-    for (Size i = 0; i < input.getChromatograms().size(); ++i)
+      IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+    }
+    if (error_count != 0)
     {
-      MSChromatogram chromatogram;
-      std::vector<PeakBoundary> boundaries_c; // peak boundaries of a single chromatogram
-      pick(input.getChromatograms()[i], chromatogram, boundaries_c);
-      output.addChromatogram(chromatogram);
-      boundaries_chrom.push_back(boundaries_c);
-      setProgress(++progress);
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error_message);
     }
     endProgress();
 
+    // MSLevel -> stats
+    map<int, SpectraPickInfo> pick_info;
+    for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+    {
+      if (was_picked[scan_idx])
+      {
+        boundaries_spec.push_back(std::move(spectrum_boundaries[scan_idx]));
+      }
+      pick_info[input[scan_idx].getMSLevel()].picked += was_picked[scan_idx];
+      ++pick_info[input[scan_idx].getMSLevel()].total;
+    }
+    boundaries_chrom.insert(boundaries_chrom.end(),
+                            std::make_move_iterator(chromatogram_boundaries.begin()),
+                            std::make_move_iterator(chromatogram_boundaries.end()));
+
     OPENMS_LOG_INFO << "Picked spectra by MS-level:\n";
     for (const auto& info : pick_info)
     {
@@ -508,62 +658,155 @@ namespace OpenMS
 
     // resize output with respect to input
     output.resize(input.size());
-
-    if (input.getNrSpectra() > 0)
+    output.getChromatograms().resize(input.getNrChromatograms());
+
+    // reading through a shared file stream has to be serialized, memory mapped
+    // files can be read concurrently
+    const bool concurrent_read = input.getMemoryMapping();
+
+    Size error_count = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize scan_idx = 0; scan_idx < (SignedSize)input.size(); ++scan_idx)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      // parallel exception catching and re-throwing business
+      if (error_count) continue;
+      try
       {
-        if (ms_levels_.empty()) //auto mode
-        {
-          MSSpectrum s = input[scan_idx];
-          s.sortByPosition();
-
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrumType = s.getType();
-          if (spectrumType == SpectrumSettings::CENTROID)
-          {
-            output[scan_idx] = input[scan_idx];
-          }
-          else
-          {
-            pick(s, output[scan_idx]);
-          }
-        }
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) // manual mode
+        MSSpectrum s;
+        if (concurrent_read)
         {
-          output[scan_idx] = input[scan_idx];
+          s = input.getSpectrum(scan_idx);
         }
         else
         {
-          MSSpectrum s = input[scan_idx];
-          s.sortByPosition();
+#pragma omp critical (PeakPickerHiRes_read)
+          s = input.getSpectrum(scan_idx);
+        }
+        s.sortByPosition();
 
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrum_type = s.getType();
+        std::vector<PeakBoundary> boundaries;
+        pickSpectrumOfMap_(s, output[scan_idx], boundaries, check_spectrum_type);
+      }
+      catch (Exception::BaseException& e)
+      {
+#pragma omp critical (PeakPickerHiRes_error)
+        {
+          ++error_count;
+          error_message = e.what();
+        }
+      }
 
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
-          {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
-          }
+      IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+    }
+    if (error_count != 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error_message);
+    }
 
-          pick(s, output[scan_idx]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)input.getNrChromatograms(); ++i)
+    {
+      if (error_count) continue;
+      try
+      {
+        MSChromatogram chromatogram;
+        if (concurrent_read)
+        {
+          chromatogram = input.getChromatogram(i);
+        }
+        else
+        {
+#pragma omp critical (PeakPickerHiRes_read)
+          chromatogram = input.getChromatogram(i);
+        }
+        pick(chromatogram, output.getChromatograms()[i]);
+      }
+      catch (Exception::BaseException& e)
+      {
+#pragma omp critical (PeakPickerHiRes_error)
+        {
+          ++error_count;
+          error_message = e.what();
         }
-        setProgress(++progress);
       }
-    }
 
-    for (Size i = 0; i < input.getNrChromatograms(); ++i)
+      IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+    }
+    if (error_count != 0)
     {
-      MSChromatogram chromatogram;
-      pick(input.getChromatogram(i), chromatogram);
-      output.addChromatogram(chromatogram);
-      setProgress(++progress);
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, error_message);
     }
     endProgress();
 
     return;
   }
 
+  void PeakPickerHiRes::pickExperiment(/* const */ OnDiscMSExperiment& input, Interfaces::IMSDataConsumer& output, const bool check_spectrum_type, Size chunk_size) const
+  {
+    output.setExperimentalSettings(*input.getExperimentalSettings());
+    output.setExpectedSize(input.getNrSpectra(), input.getNrChromatograms());
+
+    chunk_size = std::max(chunk_size, Size(1));
+    const bool concurrent_read = input.getMemoryMapping();
+
+    Size progress = 0;
+    startProgress(0, input.size() + input.getNrChromatograms(), "picking peaks");
+
+    pickChunked<MSSpectrum>(input.getNrSpectra(), chunk_size,
+      [&](Size scan_idx, MSSpectrum& picked)
+      {
+        MSSpectrum s;
+        if (concurrent_read)
+        {
+          s = input.getSpectrum(scan_idx);
+        }
+        else
+        {
+#pragma omp critical (PeakPickerHiRes_read)
+          s = input.getSpectrum(scan_idx);
+        }
+        s.sortByPosition();
+
+        std::vector<PeakBoundary> boundaries;
+        pickSpectrumOfMap_(s, picked, boundaries, check_spectrum_type);
+      },
+      [&](MSSpectrum& picked) { output.consumeSpectrum(picked); },
+      *this, progress);
+
+    pickChunked<MSChromatogram>(input.getNrChromatograms(), chunk_size,
+      [&](Size i, MSChromatogram& picked)
+      {
+        MSChromatogram chromatogram;
+        if (concurrent_read)
+        {
+          chromatogram = input.getChromatogram(i);
+        }
+        else
+        {
+#pragma omp critical (PeakPickerHiRes_read)
+          chromatogram = input.getChromatogram(i);
+        }
+        pick(chromatogram, picked);
+      },
+      [&](MSChromatogram& picked) { output.consumeChromatogram(picked); },
+      *this, progress);
+
+    endProgress();
+  }
+
   void PeakPickerHiRes::updateMembers_()
   {
     signal_to_noise_ = param_.getValue("signal_to_noise");
@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <boost/math/special_functions/fpclassify.hpp> // for isnan
 #include <boost/numeric/conversion/cast.hpp>
@@ -92,7 +93,11 @@ public:
     typedef boost::shared_ptr<OpenSwath::IFeature> FeatureType;
     //@}
 
-    /** @name Accessors */
+    /** @name Accessors
+
+      The full cross-correlation matrices are not needed for scoring and are only computed on first access.
+      This is thread-safe, concurrent calls wait for the first one to finish.
+    */
     //@{
     /// non-mutable access to the cross-correlation matrix
     const XCorrMatrixType& getXCorrMatrix() const;
@@ -250,6 +255,15 @@ public:
     /// Initialize the mutual information vector with the MS1 trace
     void initializeMIPrecursorCombinedMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids);
 
+    /**
+      @brief Initialize the MI matrix and the MI precursor, precursor contrast and precursor combined matrices
+
+      Gives the same matrices as initializeMIMatrix(), initializeMIPrecursorMatrix(),
+      initializeMIPrecursorContrastMatrix() and initializeMIPrecursorCombinedMatrix(), but ranks every
+      chromatogram only once and assembles the combined matrix from the other three.
+    */
+    void initializeMIMatrices(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& native_ids, const std::vector<String>& precursor_ids);
+
     double calcMIScore();
     double calcMIWeightedScore(const std::vector<double>& normalized_library_intensity);
     double calcMIPrecursorScore();
@@ -261,24 +275,71 @@ public:
 
 private:
 
+    /**
+      @brief Cross-correlation peaks between two sets of chromatograms
+
+      The xcorr scores only use the highest peak (lag and correlation) of each cross-correlation,
+      so only these are stored. The standardized chromatograms are kept to compute the full
+      per-lag cross-correlation matrix on demand (see getXCorrMatrix()). Computing it is
+      guarded by a mutex, so the const accessors can be called from several threads.
+    */
+    struct XCorrPeakMatrix_
+    {
+      XCorrPeakMatrix_() :
+        full_square(false),
+        full_valid(false)
+      {
+      }
+
+      /// Copies the data (the mutex is not copied)
+      XCorrPeakMatrix_(const XCorrPeakMatrix_& rhs);
+
+      /// Copies the data (the mutex is not copied)
+      XCorrPeakMatrix_& operator=(const XCorrPeakMatrix_& rhs);
+
+      /// standardized intensities of the row chromatograms
+      std::vector<std::vector<double> > rows;
+      /// standardized intensities of the column chromatograms (empty if rows and columns are the same chromatograms)
+      std::vector<std::vector<double> > cols;
+      /// highest cross-correlation peak of each pair (row-major), only the upper triangle is computed if @p cols is empty
+      std::vector<Scoring::XCorrEntry> peaks;
+      /// whether the full matrix contains all pairs or only the upper triangle
+      bool full_square;
+      /// full per-lag cross-correlation matrix, computed on first access
+      mutable XCorrMatrixType full;
+      mutable bool full_valid;
+      /// guards @p full and @p full_valid in const access
+      mutable std::mutex full_mutex;
+
+      std::size_t size() const {return rows.size();}
+      std::size_t columns() const {return cols.empty() ? rows.size() : cols.size();}
+      const Scoring::XCorrEntry& peak(std::size_t i, std::size_t j) const {return peaks[i * columns() + j];}
+    };
+
+    /// Standardize the chromatograms of @p m (rows and cols need to be filled) and compute the cross-correlation peaks
+    static void initializeXCorrPeaks_(XCorrPeakMatrix_& m, bool full_square);
+
+    /// Compute (if necessary) and return the full per-lag cross-correlation matrix of @p m
+    static const XCorrMatrixType& getFullXCorrMatrix_(const XCorrPeakMatrix_& m);
+
     /** @name Members */
     //@{
     /// the precomputed cross correlation matrix
-    XCorrMatrixType xcorr_matrix_;
+    XCorrPeakMatrix_ xcorr_matrix_;
 
     /// the precomputed contrast cross correlation
-    XCorrMatrixType xcorr_contrast_matrix_;
+    XCorrPeakMatrix_ xcorr_contrast_matrix_;
     //@}
 
     /// the precomputed cross correlation matrix of the MS1 trace
-    XCorrMatrixType xcorr_precursor_matrix_;
+    XCorrPeakMatrix_ xcorr_precursor_matrix_;
 
     /// the precomputed cross correlation against the MS1 trace
-    XCorrMatrixType xcorr_precursor_contrast_matrix_;
+    XCorrPeakMatrix_ xcorr_precursor_contrast_matrix_;
     //@}
 
     /// the precomputed cross correlation with the MS1 trace
-    XCorrMatrixType xcorr_precursor_combined_matrix_;
+    XCorrPeakMatrix_ xcorr_precursor_combined_matrix_;
     //@}
 
     /// the precomputed mutual information matrix
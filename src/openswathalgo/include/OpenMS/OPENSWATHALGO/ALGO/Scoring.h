@@ -126,6 +126,16 @@ public:
     /// Find best peak in an cross-correlation (highest apex)
     OPENSWATHALGO_DLLAPI XCorrArrayType::const_iterator xcorrArrayGetMaxPeak(const XCorrArrayType & array);
 
+    /**
+      @brief Find the highest peak of the normalized cross-correlation of two standardized vectors
+
+      Evaluates all lags in [-size, size] in one pass and returns the (lag, correlation) pair that
+      xcorrArrayGetMaxPeak() would find in the result of normalizedCrossCorrelation() with maxdelay = size and lag = 1.
+      The input is expected to be standardized already (see standardize_data()), no per-lag array is allocated.
+    */
+    OPENSWATHALGO_DLLAPI XCorrEntry standardizedCrossCorrelationMaxPeak(const std::vector<double>& data1,
+                                                                        const std::vector<double>& data2);
+
     /// Standardize a vector (subtract mean, divide by standard deviation)
     OPENSWATHALGO_DLLAPI void standardize_data(std::vector<double>& data);
 
@@ -138,6 +148,24 @@ public:
     // Estimate rank-transformed mutual information between two vectors of data points
     OPENSWATHALGO_DLLAPI double rankedMutualInformation(std::vector<double>& data1, std::vector<double>& data2);
 
+    /// Ranks of a vector (as computed by computeRank) and the number of elements sharing each rank
+    struct RankedData
+    {
+      std::vector<unsigned int> ranks;
+      std::vector<unsigned int> rank_counts;
+    };
+
+    /// Rank a vector once for repeated mutual information calculations
+    OPENSWATHALGO_DLLAPI RankedData computeRankedData(const std::vector<double>& data);
+
+    /**
+      @brief Estimate rank-transformed mutual information between two ranked vectors
+
+      Gives the same result as rankedMutualInformation() on the original data, but the ranks are
+      computed only once per vector and the joint histogram only has as many entries as data points.
+    */
+    OPENSWATHALGO_DLLAPI double rankedMutualInformation(const RankedData& data1, const RankedData& data2);
+
     //@}
 
   }
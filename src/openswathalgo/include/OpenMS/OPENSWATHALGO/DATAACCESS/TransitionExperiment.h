@@ -37,6 +37,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 #include <OpenMS/OPENSWATHALGO/OpenSwathAlgoConfig.h>
 
@@ -273,7 +274,7 @@ public:
 
     // Map of compounds (peptides or metabolites)
     bool compound_reference_map_dirty_;
-    std::map<std::string, LightCompound*> compound_reference_map_;
+    std::unordered_map<std::string, LightCompound*> compound_reference_map_;
 
   };
 
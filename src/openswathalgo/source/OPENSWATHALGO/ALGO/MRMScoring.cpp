@@ -44,187 +44,210 @@
 namespace OpenSwath
 {
 
-  const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrMatrix() const
+  namespace
+  {
+    /// Append the intensities of @p feature to @p data
+    void appendIntensities(const MRMScoring::FeatureType& feature, std::vector<std::vector<double> >& data)
+    {
+      data.push_back(std::vector<double>());
+      feature->getIntensity(data.back());
+    }
+
+    /// Append the ranked intensities of @p feature to @p data
+    void appendRankedIntensities(const MRMScoring::FeatureType& feature, std::vector<Scoring::RankedData>& data)
+    {
+      std::vector<double> intensity;
+      feature->getIntensity(intensity);
+      data.push_back(Scoring::computeRankedData(intensity));
+    }
+
+    /// Compute the mutual information of all pairs of @p rows and @p cols (only the upper triangle if @p upper_triangle is set)
+    void fillMIMatrix(const std::vector<Scoring::RankedData>& rows, const std::vector<Scoring::RankedData>& cols,
+                      bool upper_triangle, std::vector<std::vector<double> >& mi_matrix)
+    {
+      mi_matrix.assign(rows.size(), std::vector<double>(cols.size(), 0.0));
+      for (std::size_t i = 0; i < rows.size(); i++)
+      {
+        for (std::size_t j = (upper_triangle ? i : 0); j < cols.size(); j++)
+        {
+          mi_matrix[i][j] = Scoring::rankedMutualInformation(rows[i], cols[j]);
+        }
+      }
+    }
+  }
+
+  MRMScoring::XCorrPeakMatrix_::XCorrPeakMatrix_(const XCorrPeakMatrix_& rhs) :
+    rows(rhs.rows),
+    cols(rhs.cols),
+    peaks(rhs.peaks),
+    full_square(rhs.full_square),
+    full_valid(false)
   {
-    return xcorr_matrix_;
+    std::lock_guard<std::mutex> lock(rhs.full_mutex);
+    full = rhs.full;
+    full_valid = rhs.full_valid;
   }
 
-  void MRMScoring::initializeXCorrMatrix(const std::vector< std::vector< double > >& data)
+  MRMScoring::XCorrPeakMatrix_& MRMScoring::XCorrPeakMatrix_::operator=(const XCorrPeakMatrix_& rhs)
   {
-    xcorr_matrix_.resize(data.size());
-    for (std::size_t i = 0; i < data.size(); i++)
+    if (&rhs == this) return *this;
+    rows = rhs.rows;
+    cols = rhs.cols;
+    peaks = rhs.peaks;
+    full_square = rhs.full_square;
+    std::lock_guard<std::mutex> lock(rhs.full_mutex);
+    full = rhs.full;
+    full_valid = rhs.full_valid;
+    return *this;
+  }
+
+  void MRMScoring::initializeXCorrPeaks_(XCorrPeakMatrix_& m, bool full_square)
+  {
+    for (std::vector<double>& d : m.rows) Scoring::standardize_data(d);
+    for (std::vector<double>& d : m.cols) Scoring::standardize_data(d);
+
+    const bool same_sets = m.cols.empty();
+    const std::vector<std::vector<double> >& cols = same_sets ? m.rows : m.cols;
+    m.peaks.assign(m.size() * m.columns(), Scoring::XCorrEntry(0, 0.0));
+    for (std::size_t i = 0; i < m.rows.size(); i++)
     {
-      xcorr_matrix_[i].resize(data.size());
-      for (std::size_t j = i; j < data.size(); j++)
+      // the scores only use the upper triangle if rows and columns are the same chromatograms
+      for (std::size_t j = (same_sets ? i : 0); j < cols.size(); j++)
       {
-        // compute normalized cross correlation
-        std::vector< double > tmp1(data[i]);
-        std::vector< double > tmp2(data[j]);
-        xcorr_matrix_[i][j] = Scoring::normalizedCrossCorrelation(tmp1, tmp2, boost::numeric_cast<int>(data[i].size()), 1);
+        m.peaks[i * cols.size() + j] = Scoring::standardizedCrossCorrelationMaxPeak(m.rows[i], cols[j]);
       }
     }
+    m.full_square = full_square;
+    m.full.clear();
+    m.full_valid = false;
+  }
+
+  const MRMScoring::XCorrMatrixType& MRMScoring::getFullXCorrMatrix_(const XCorrPeakMatrix_& m)
+  {
+    // several threads may score the same object, only one of them fills the matrix
+    std::lock_guard<std::mutex> lock(m.full_mutex);
+    if (m.full_valid) return m.full;
+
+    const std::vector<std::vector<double> >& cols = m.cols.empty() ? m.rows : m.cols;
+    m.full.clear();
+    m.full.resize(m.rows.size());
+    for (std::size_t i = 0; i < m.rows.size(); i++)
+    {
+      m.full[i].resize(cols.size());
+      for (std::size_t j = (m.full_square ? 0 : i); j < cols.size(); j++)
+      {
+        // data is already standardized, only normalize by the length
+        m.full[i][j] = Scoring::calculateCrossCorrelation(m.rows[i], cols[j], boost::numeric_cast<int>(m.rows[i].size()), 1);
+        for (Scoring::XCorrEntry& e : m.full[i][j].data)
+        {
+          e.second /= m.rows[i].size();
+        }
+      }
+    }
+    m.full_valid = true;
+    return m.full;
+  }
+
+  const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrMatrix() const
+  {
+    return getFullXCorrMatrix_(xcorr_matrix_);
+  }
+
+  void MRMScoring::initializeXCorrMatrix(const std::vector< std::vector< double > >& data)
+  {
+    xcorr_matrix_.rows = data;
+    xcorr_matrix_.cols.clear();
+    initializeXCorrPeaks_(xcorr_matrix_, false);
   }
 
   const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrContrastMatrix() const
   {
-    return xcorr_contrast_matrix_;
+    return getFullXCorrMatrix_(xcorr_contrast_matrix_);
   }
 
   const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrPrecursorContrastMatrix() const
   {
-    return xcorr_precursor_contrast_matrix_;
+    return getFullXCorrMatrix_(xcorr_precursor_contrast_matrix_);
   }
 
   const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrPrecursorCombinedMatrix() const
   {
-    return xcorr_precursor_combined_matrix_;
+    return getFullXCorrMatrix_(xcorr_precursor_combined_matrix_);
   }
 
   void MRMScoring::initializeXCorrMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_matrix_.resize(native_ids.size());
+    xcorr_matrix_.rows.clear();
+    xcorr_matrix_.cols.clear();
     for (std::size_t i = 0; i < native_ids.size(); i++)
     {
-      String native_id = native_ids[i];
-      FeatureType fi = mrmfeature->getFeature(native_id);
-      xcorr_matrix_[i].resize(native_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = i; j < native_ids.size(); j++)
-      {
-        String native_id2 = native_ids[j];
-        FeatureType fj = mrmfeature->getFeature(native_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
+      appendIntensities(mrmfeature->getFeature(native_ids[i]), xcorr_matrix_.rows);
     }
+    initializeXCorrPeaks_(xcorr_matrix_, false);
   }
 
   void MRMScoring::initializeXCorrContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& native_ids_set1, const std::vector<String>& native_ids_set2)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_contrast_matrix_.resize(native_ids_set1.size());
+    xcorr_contrast_matrix_.rows.clear();
+    xcorr_contrast_matrix_.cols.clear();
     for (std::size_t i = 0; i < native_ids_set1.size(); i++)
-    { 
-      String native_id = native_ids_set1[i];
-      FeatureType fi = mrmfeature->getFeature(native_id);
-      xcorr_contrast_matrix_[i].resize(native_ids_set2.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < native_ids_set2.size(); j++)
-      {
-        String native_id2 = native_ids_set2[j];
-        FeatureType fj = mrmfeature->getFeature(native_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_contrast_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
+    {
+      appendIntensities(mrmfeature->getFeature(native_ids_set1[i]), xcorr_contrast_matrix_.rows);
     }
+    for (std::size_t j = 0; j < native_ids_set2.size(); j++)
+    {
+      appendIntensities(mrmfeature->getFeature(native_ids_set2[j]), xcorr_contrast_matrix_.cols);
+    }
+    initializeXCorrPeaks_(xcorr_contrast_matrix_, true);
   }
 
   void MRMScoring::initializeXCorrPrecursorMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_precursor_matrix_.resize(precursor_ids.size());
+    xcorr_precursor_matrix_.rows.clear();
+    xcorr_precursor_matrix_.cols.clear();
     for (std::size_t i = 0; i < precursor_ids.size(); i++)
     {
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      xcorr_precursor_matrix_[i].resize(precursor_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = i; j < precursor_ids.size(); j++)
-      {
-        String precursor_id2 = precursor_ids[j];
-        FeatureType fj = mrmfeature->getPrecursorFeature(precursor_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_precursor_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
+      appendIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), xcorr_precursor_matrix_.rows);
     }
+    initializeXCorrPeaks_(xcorr_precursor_matrix_, false);
   }
 
   void MRMScoring::initializeXCorrPrecursorContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    xcorr_precursor_contrast_matrix_.resize(precursor_ids.size());
+    xcorr_precursor_contrast_matrix_.rows.clear();
+    xcorr_precursor_contrast_matrix_.cols.clear();
     for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    { 
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      xcorr_precursor_contrast_matrix_[i].resize(native_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < native_ids.size(); j++)
-      {
-        String native_id = native_ids[j];
-        FeatureType fj = mrmfeature->getFeature(native_id);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_precursor_contrast_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
+    {
+      appendIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), xcorr_precursor_contrast_matrix_.rows);
     }
+    for (std::size_t j = 0; j < native_ids.size(); j++)
+    {
+      appendIntensities(mrmfeature->getFeature(native_ids[j]), xcorr_precursor_contrast_matrix_.cols);
+    }
+    initializeXCorrPeaks_(xcorr_precursor_contrast_matrix_, true);
   }
 
   void MRMScoring::initializeXCorrPrecursorContrastMatrix(const std::vector< std::vector< double > >& data_precursor, const std::vector< std::vector< double > >& data_fragments)
   {
-    xcorr_precursor_contrast_matrix_.resize(data_precursor.size());
-    for (std::size_t i = 0; i < data_precursor.size(); i++)
-    { 
-      xcorr_precursor_contrast_matrix_[i].resize(data_fragments.size());
-      for (std::size_t j = 0; j < data_fragments.size(); j++)
-      {
-        // compute normalized cross correlation
-        std::vector< double > tmp1(data_precursor[i]);
-        std::vector< double > tmp2(data_fragments[j]);
-        xcorr_precursor_contrast_matrix_[i][j] = Scoring::normalizedCrossCorrelation(tmp1, tmp2, boost::numeric_cast<int>(tmp1.size()), 1);
-#ifdef MRMSCORING_TESTING
-        std::cout << " fill xcorr_precursor_contrast_matrix_ "<< tmp1.size() << " / " << tmp2.size() << " : " << xcorr_precursor_contrast_matrix_[i][j].data.size() << std::endl;
-#endif
-      }
-    }
+    xcorr_precursor_contrast_matrix_.rows = data_precursor;
+    xcorr_precursor_contrast_matrix_.cols = data_fragments;
+    initializeXCorrPeaks_(xcorr_precursor_contrast_matrix_, true);
   }
 
   void MRMScoring::initializeXCorrPrecursorCombinedMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    std::vector<FeatureType> features;
-
+    // precursor and fragment traces form one set, the scores only use the upper triangle
+    xcorr_precursor_combined_matrix_.rows.clear();
+    xcorr_precursor_combined_matrix_.cols.clear();
     for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    { 
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      features.push_back(fi);
+    {
+      appendIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), xcorr_precursor_combined_matrix_.rows);
     }
     for (std::size_t j = 0; j < native_ids.size(); j++)
     {
-      String native_id = native_ids[j];
-      FeatureType fj = mrmfeature->getFeature(native_id);
-      features.push_back(fj);
-    }
-
-    xcorr_precursor_combined_matrix_.resize(features.size());
-    for (std::size_t i = 0; i < features.size(); i++)
-    { 
-      FeatureType fi = features[i];
-      xcorr_precursor_combined_matrix_[i].resize(features.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < features.size(); j++)
-      {
-        FeatureType fj = features[j];
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute normalized cross correlation
-        xcorr_precursor_combined_matrix_[i][j] = Scoring::normalizedCrossCorrelation(intensityi, intensityj, boost::numeric_cast<int>(intensityi.size()), 1);
-      }
+      appendIntensities(mrmfeature->getFeature(native_ids[j]), xcorr_precursor_combined_matrix_.rows);
     }
+    initializeXCorrPeaks_(xcorr_precursor_combined_matrix_, true);
   }
 
   // see /IMSB/users/reiterl/bin/code/biognosys/trunk/libs/mrm_libs/MRM_pgroup.pm
@@ -243,9 +266,9 @@ namespace OpenSwath
       for (std::size_t  j = i; j < xcorr_matrix_.size(); j++)
       {
         // first is the X value (RT), should be an int
-        deltas.push_back(std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->first));
+        deltas.push_back(std::abs(xcorr_matrix_.peak(i, j).first));
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << std::abs(xcorr_matrix_.peak(i, j).first) << std::endl;
 #endif
       }
     }
@@ -271,11 +294,11 @@ namespace OpenSwath
     for (std::size_t i = 0; i < xcorr_matrix_.size(); i++)
     {
       deltas.push_back(
-        std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][i])->first)
+        std::abs(xcorr_matrix_.peak(i, i).first)
         * normalized_library_intensity[i]
         * normalized_library_intensity[i]);
 #ifdef MRMSCORING_TESTING
-      std::cout << "_xcoel_weighted " << i << " " << i << " " << Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][i])->first << " weight " <<
+      std::cout << "_xcoel_weighted " << i << " " << i << " " << xcorr_matrix_.peak(i, i).first << " weight " <<
         normalized_library_intensity[i] * normalized_library_intensity[i] << std::endl;
       weights += normalized_library_intensity[i] * normalized_library_intensity[i];
 #endif
@@ -283,11 +306,11 @@ namespace OpenSwath
       {
         // first is the X value (RT), should be an int
         deltas.push_back(
-          std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->first)
+          std::abs(xcorr_matrix_.peak(i, j).first)
           * normalized_library_intensity[i]
           * normalized_library_intensity[j] * 2);
 #ifdef MRMSCORING_TESTING
-        std::cout << "_xcoel_weighted " << i << " " << j << " " << Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->first << " weight " <<
+        std::cout << "_xcoel_weighted " << i << " " << j << " " << xcorr_matrix_.peak(i, j).first << " weight " <<
           normalized_library_intensity[i] * normalized_library_intensity[j] * 2 << std::endl;
         weights += normalized_library_intensity[i] * normalized_library_intensity[j];
 #endif
@@ -304,17 +327,17 @@ namespace OpenSwath
 
   double MRMScoring::calcXcorrContrastCoelutionScore()
   {
-    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_[0].size() > 1, "Expect cross-correlation matrix of at least 1x2");
+    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_.columns() > 1, "Expect cross-correlation matrix of at least 1x2");
 
     std::vector<int> deltas;
     for (std::size_t i = 0; i < xcorr_contrast_matrix_.size(); i++)
     {
-      for (std::size_t  j = 0; j < xcorr_contrast_matrix_[0].size(); j++)
+      for (std::size_t  j = 0; j < xcorr_contrast_matrix_.columns(); j++)
       {
         // first is the X value (RT), should be an int
-        deltas.push_back(std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_[i][j])->first));
+        deltas.push_back(std::abs(xcorr_contrast_matrix_.peak(i, j).first));
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << std::abs(xcorr_contrast_matrix_.peak(i, j).first) << std::endl;
 #endif
       }
     }
@@ -330,21 +353,21 @@ namespace OpenSwath
 
   std::vector<double> MRMScoring::calcSeparateXcorrContrastCoelutionScore()
   {
-    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_[0].size() > 1, "Expect cross-correlation matrix of at least 1x2");
+    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_.columns() > 1, "Expect cross-correlation matrix of at least 1x2");
 
     std::vector<double> deltas;
     for (std::size_t i = 0; i < xcorr_contrast_matrix_.size(); i++)
     {
       double deltas_id = 0;
-      for (std::size_t  j = 0; j < xcorr_contrast_matrix_[0].size(); j++)
+      for (std::size_t  j = 0; j < xcorr_contrast_matrix_.columns(); j++)
       {
         // first is the X value (RT), should be an int
-        deltas_id += std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_[i][j])->first);
+        deltas_id += std::abs(xcorr_contrast_matrix_.peak(i, j).first);
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << std::abs(xcorr_contrast_matrix_.peak(i, j).first) << std::endl;
 #endif
       }
-      deltas.push_back(deltas_id / xcorr_contrast_matrix_[0].size());
+      deltas.push_back(deltas_id / xcorr_contrast_matrix_.columns());
     }
 
     return deltas;
@@ -360,9 +383,9 @@ namespace OpenSwath
       for (std::size_t  j = i; j < xcorr_precursor_matrix_.size(); j++)
       {
         // first is the X value (RT), should be an int
-        deltas.push_back(std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_matrix_[i][j])->first));
+        deltas.push_back(std::abs(xcorr_precursor_matrix_.peak(i, j).first));
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << std::abs(xcorr_precursor_matrix_.peak(i, j).first) << std::endl;
 #endif
       }
     }
@@ -378,17 +401,17 @@ namespace OpenSwath
 
   double MRMScoring::calcXcorrPrecursorContrastCoelutionScore()
   {
-    OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.size() > 0 && xcorr_precursor_contrast_matrix_[0].size() > 1, "Expect cross-correlation matrix of at least 1x2");
+    OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.size() > 0 && xcorr_precursor_contrast_matrix_.columns() > 1, "Expect cross-correlation matrix of at least 1x2");
 
     std::vector<int> deltas;
     for (std::size_t i = 0; i < xcorr_precursor_contrast_matrix_.size(); i++)
     {
-      for (std::size_t  j = 0; j < xcorr_precursor_contrast_matrix_[0].size(); j++)
+      for (std::size_t  j = 0; j < xcorr_precursor_contrast_matrix_.columns(); j++)
       {
         // first is the X value (RT), should be an int
-        deltas.push_back(std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_contrast_matrix_[i][j])->first));
+        deltas.push_back(std::abs(xcorr_precursor_contrast_matrix_.peak(i, j).first));
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_contrast_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << std::abs(xcorr_precursor_contrast_matrix_.peak(i, j).first) << std::endl;
 #endif
       }
     }
@@ -412,9 +435,9 @@ namespace OpenSwath
       for (std::size_t  j = i; j < xcorr_precursor_combined_matrix_.size(); j++)
       {
         // first is the X value (RT), should be an int
-        deltas.push_back(std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_combined_matrix_[i][j])->first));
+        deltas.push_back(std::abs(xcorr_precursor_combined_matrix_.peak(i, j).first));
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_combined_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << std::abs(xcorr_precursor_combined_matrix_.peak(i, j).first) << std::endl;
 #endif
       }
     }
@@ -444,7 +467,7 @@ namespace OpenSwath
       for (std::size_t j = i; j < xcorr_matrix_.size(); j++)
       {
         // second is the Y value (intensity)
-        intensities.push_back(Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->second);
+        intensities.push_back(xcorr_matrix_.peak(i, j).second);
       }
     }
     OpenSwath::mean_and_stddev msc;
@@ -464,21 +487,21 @@ namespace OpenSwath
     for (std::size_t i = 0; i < xcorr_matrix_.size(); i++)
     {
       intensities.push_back(
-        Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][i])->second
+        xcorr_matrix_.peak(i, i).second
         * normalized_library_intensity[i]
         * normalized_library_intensity[i]);
 #ifdef MRMSCORING_TESTING
-      std::cout << "_xcorr_weighted " << i << " " << i << " " << Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][i])->second << " weight " <<
+      std::cout << "_xcorr_weighted " << i << " " << i << " " << xcorr_matrix_.peak(i, i).second << " weight " <<
         normalized_library_intensity[i] * normalized_library_intensity[i] << std::endl;
 #endif
       for (std::size_t j = i + 1; j < xcorr_matrix_.size(); j++)
       {
         intensities.push_back(
-          Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->second
+          xcorr_matrix_.peak(i, j).second
           * normalized_library_intensity[i]
           * normalized_library_intensity[j] * 2);
 #ifdef MRMSCORING_TESTING
-        std::cout << "_xcorr_weighted " << i << " " << j << " " << Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_[i][j])->second << " weight " <<
+        std::cout << "_xcorr_weighted " << i << " " << j << " " << xcorr_matrix_.peak(i, j).second << " weight " <<
           normalized_library_intensity[i] * normalized_library_intensity[j] * 2 << std::endl;
 #endif
       }
@@ -488,15 +511,15 @@ namespace OpenSwath
 
   double MRMScoring::calcXcorrContrastShapeScore()
   {
-    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_[0].size() > 1, "Expect cross-correlation matrix of at least 1x2");
+    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_.columns() > 1, "Expect cross-correlation matrix of at least 1x2");
 
     std::vector<double> intensities;
     for (std::size_t i = 0; i < xcorr_contrast_matrix_.size(); i++)
     {
-      for (std::size_t j = 0; j < xcorr_contrast_matrix_[0].size(); j++)
+      for (std::size_t j = 0; j < xcorr_contrast_matrix_.columns(); j++)
       {
         // second is the Y value (intensity)
-        intensities.push_back(Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_[i][j])->second);
+        intensities.push_back(xcorr_contrast_matrix_.peak(i, j).second);
       }
     }
     OpenSwath::mean_and_stddev msc;
@@ -506,18 +529,18 @@ namespace OpenSwath
 
   std::vector<double> MRMScoring::calcSeparateXcorrContrastShapeScore()
   {
-    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_[0].size() > 1, "Expect cross-correlation matrix of at least 1x2");
+    OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.size() > 0 && xcorr_contrast_matrix_.columns() > 1, "Expect cross-correlation matrix of at least 1x2");
 
     std::vector<double> intensities;
     for (std::size_t i = 0; i < xcorr_contrast_matrix_.size(); i++)
     {
       double intensities_id = 0;
-      for (std::size_t j = 0; j < xcorr_contrast_matrix_[0].size(); j++)
+      for (std::size_t j = 0; j < xcorr_contrast_matrix_.columns(); j++)
       {
         // second is the Y value (intensity)
-        intensities_id += Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_[i][j])->second;
+        intensities_id += xcorr_contrast_matrix_.peak(i, j).second;
       }
-      intensities.push_back(intensities_id / xcorr_contrast_matrix_[0].size());
+      intensities.push_back(intensities_id / xcorr_contrast_matrix_.columns());
     }
 
     return intensities;
@@ -533,7 +556,7 @@ namespace OpenSwath
       for (std::size_t j = i; j < xcorr_precursor_matrix_.size(); j++)
       {
         // second is the Y value (intensity)
-        intensities.push_back(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_matrix_[i][j])->second);
+        intensities.push_back(xcorr_precursor_matrix_.peak(i, j).second);
       }
     }
     OpenSwath::mean_and_stddev msc;
@@ -543,15 +566,15 @@ namespace OpenSwath
 
   double MRMScoring::calcXcorrPrecursorContrastShapeScore()
   {
-    OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.size() > 0 && xcorr_precursor_contrast_matrix_[0].size() > 1, "Expect cross-correlation matrix of at least 1x2");
+    OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.size() > 0 && xcorr_precursor_contrast_matrix_.columns() > 1, "Expect cross-correlation matrix of at least 1x2");
 
     std::vector<double> intensities;
     for (std::size_t i = 0; i < xcorr_precursor_contrast_matrix_.size(); i++)
     {
-      for (std::size_t j = 0; j < xcorr_precursor_contrast_matrix_[0].size(); j++)
+      for (std::size_t j = 0; j < xcorr_precursor_contrast_matrix_.columns(); j++)
       {
         // second is the Y value (intensity)
-        intensities.push_back(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_contrast_matrix_[i][j])->second);
+        intensities.push_back(xcorr_precursor_contrast_matrix_.peak(i, j).second);
       }
     }
     OpenSwath::mean_and_stddev msc;
@@ -569,7 +592,7 @@ namespace OpenSwath
       for (std::size_t j = i; j < xcorr_precursor_combined_matrix_.size(); j++)
       {
         // second is the Y value (intensity)
-        intensities.push_back(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_combined_matrix_[i][j])->second);
+        intensities.push_back(xcorr_precursor_combined_matrix_.peak(i, j).second);
       }
     }
     OpenSwath::mean_and_stddev msc;
@@ -710,128 +733,105 @@ namespace OpenSwath
 
   void MRMScoring::initializeMIMatrix(OpenSwath::IMRMFeature* mrmfeature, std::vector<String> native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    mi_matrix_.resize(native_ids.size());
+    std::vector<Scoring::RankedData> ranked;
     for (std::size_t i = 0; i < native_ids.size(); i++)
     {
-      String native_id = native_ids[i];
-      FeatureType fi = mrmfeature->getFeature(native_id);
-      mi_matrix_[i].resize(native_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = i; j < native_ids.size(); j++)
-      {
-        String native_id2 = native_ids[j];
-        FeatureType fj = mrmfeature->getFeature(native_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute ranked mutual information
-        mi_matrix_[i][j] = Scoring::rankedMutualInformation(intensityi, intensityj);
-      }
+      appendRankedIntensities(mrmfeature->getFeature(native_ids[i]), ranked);
     }
+    fillMIMatrix(ranked, ranked, true, mi_matrix_);
   }
 
   void MRMScoring::initializeMIContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, std::vector<String> native_ids_set1, std::vector<String> native_ids_set2)
   { 
-    std::vector<double> intensityi, intensityj;
-    mi_contrast_matrix_.resize(native_ids_set1.size());
+    std::vector<Scoring::RankedData> ranked1, ranked2;
     for (std::size_t i = 0; i < native_ids_set1.size(); i++)
-    { 
-      String native_id = native_ids_set1[i];
-      FeatureType fi = mrmfeature->getFeature(native_id);
-      mi_contrast_matrix_[i].resize(native_ids_set2.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < native_ids_set2.size(); j++)
-      {
-        String native_id2 = native_ids_set2[j];
-        FeatureType fj = mrmfeature->getFeature(native_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute ranked mutual information
-        mi_contrast_matrix_[i][j] = Scoring::rankedMutualInformation(intensityi, intensityj);
-      }
+    {
+      appendRankedIntensities(mrmfeature->getFeature(native_ids_set1[i]), ranked1);
+    }
+    for (std::size_t j = 0; j < native_ids_set2.size(); j++)
+    {
+      appendRankedIntensities(mrmfeature->getFeature(native_ids_set2[j]), ranked2);
     }
+    fillMIMatrix(ranked1, ranked2, false, mi_contrast_matrix_);
   }
 
   void MRMScoring::initializeMIPrecursorMatrix(OpenSwath::IMRMFeature* mrmfeature, std::vector<String> precursor_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    mi_precursor_matrix_.resize(precursor_ids.size());
+    std::vector<Scoring::RankedData> ranked;
     for (std::size_t i = 0; i < precursor_ids.size(); i++)
     {
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      mi_precursor_matrix_[i].resize(precursor_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = i; j < precursor_ids.size(); j++)
-      {
-        String precursor_id2 = precursor_ids[j];
-        FeatureType fj = mrmfeature->getPrecursorFeature(precursor_id2);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute ranked mutual information
-        mi_precursor_matrix_[i][j] = Scoring::rankedMutualInformation(intensityi, intensityj);
-      }
+      appendRankedIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), ranked);
     }
+    fillMIMatrix(ranked, ranked, true, mi_precursor_matrix_);
   }
 
   void MRMScoring::initializeMIPrecursorContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    mi_precursor_contrast_matrix_.resize(precursor_ids.size());
+    std::vector<Scoring::RankedData> ranked_precursors, ranked_fragments;
     for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    { 
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      mi_precursor_contrast_matrix_[i].resize(native_ids.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < native_ids.size(); j++)
-      {
-        String native_id = native_ids[j];
-        FeatureType fj = mrmfeature->getFeature(native_id);
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute ranked mutual information
-        mi_precursor_contrast_matrix_[i][j] = Scoring::rankedMutualInformation(intensityi, intensityj);
-      }
+    {
+      appendRankedIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), ranked_precursors);
+    }
+    for (std::size_t j = 0; j < native_ids.size(); j++)
+    {
+      appendRankedIntensities(mrmfeature->getFeature(native_ids[j]), ranked_fragments);
     }
+    fillMIMatrix(ranked_precursors, ranked_fragments, false, mi_precursor_contrast_matrix_);
   }
 
   void MRMScoring::initializeMIPrecursorCombinedMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& precursor_ids, const std::vector<String>& native_ids)
   {
-    std::vector<double> intensityi, intensityj;
-    std::vector<FeatureType> features;
-
+    std::vector<Scoring::RankedData> ranked;
     for (std::size_t i = 0; i < precursor_ids.size(); i++)
-    { 
-      String precursor_id = precursor_ids[i];
-      FeatureType fi = mrmfeature->getPrecursorFeature(precursor_id);
-      features.push_back(fi);
+    {
+      appendRankedIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), ranked);
     }
     for (std::size_t j = 0; j < native_ids.size(); j++)
     {
-      String native_id = native_ids[j];
-      FeatureType fj = mrmfeature->getFeature(native_id);
-      features.push_back(fj);
+      appendRankedIntensities(mrmfeature->getFeature(native_ids[j]), ranked);
     }
+    fillMIMatrix(ranked, ranked, false, mi_precursor_combined_matrix_);
+  }
 
-    mi_precursor_combined_matrix_.resize(features.size());
-    for (std::size_t i = 0; i < features.size(); i++)
-    { 
-      FeatureType fi = features[i];
-      mi_precursor_combined_matrix_[i].resize(features.size());
-      intensityi.clear();
-      fi->getIntensity(intensityi);
-      for (std::size_t j = 0; j < features.size(); j++)
-      {
-        FeatureType fj = features[j];
-        intensityj.clear();
-        fj->getIntensity(intensityj);
-        // compute ranked mutual information
-        mi_precursor_combined_matrix_[i][j] = Scoring::rankedMutualInformation(intensityi, intensityj);
+  void MRMScoring::initializeMIMatrices(OpenSwath::IMRMFeature* mrmfeature, const std::vector<String>& native_ids, const std::vector<String>& precursor_ids)
+  {
+    std::vector<Scoring::RankedData> ranked_precursors, ranked_fragments;
+    for (std::size_t i = 0; i < precursor_ids.size(); i++)
+    {
+      appendRankedIntensities(mrmfeature->getPrecursorFeature(precursor_ids[i]), ranked_precursors);
+    }
+    for (std::size_t j = 0; j < native_ids.size(); j++)
+    {
+      appendRankedIntensities(mrmfeature->getFeature(native_ids[j]), ranked_fragments);
+    }
+
+    fillMIMatrix(ranked_fragments, ranked_fragments, true, mi_matrix_);
+    fillMIMatrix(ranked_precursors, ranked_precursors, true, mi_precursor_matrix_);
+    fillMIMatrix(ranked_precursors, ranked_fragments, false, mi_precursor_contrast_matrix_);
+
+    // the combined matrix consists of the three matrices above, the lower triangle is mirrored
+    const std::size_t n_precursors = ranked_precursors.size();
+    const std::size_t n_combined = n_precursors + ranked_fragments.size();
+    mi_precursor_combined_matrix_.assign(n_combined, std::vector<double>(n_combined, 0.0));
+    for (std::size_t i = 0; i < n_combined; i++)
+    {
+      for (std::size_t j = i; j < n_combined; j++)
+      {
+        double mi;
+        if (j < n_precursors)
+        {
+          mi = mi_precursor_matrix_[i][j];
+        }
+        else if (i < n_precursors)
+        {
+          mi = mi_precursor_contrast_matrix_[i][j - n_precursors];
+        }
+        else
+        {
+          mi = mi_matrix_[i - n_precursors][j - n_precursors];
+        }
+        mi_precursor_combined_matrix_[i][j] = mi;
+        mi_precursor_combined_matrix_[j][i] = mi;
       }
     }
   }
@@ -134,6 +134,38 @@ namespace OpenSwath
       return max_it;
     }
 
+    XCorrEntry standardizedCrossCorrelationMaxPeak(const std::vector<double>& data1,
+                                                   const std::vector<double>& data2)
+    {
+      OPENSWATH_PRECONDITION(data1.size() != 0 && data1.size() == data2.size(), "Both data vectors need to have the same length");
+
+      const int datasize = boost::numeric_cast<int>(data1.size());
+      const double* x = data1.data();
+      const double* y = data2.data();
+
+      // the lag -datasize has no overlap (correlation zero) and is the first entry xcorrArrayGetMaxPeak looks at,
+      // the lag +datasize can never be strictly higher
+      XCorrEntry max_peak(-datasize, 0.0);
+      for (int delay = -datasize + 1; delay < datasize; ++delay)
+      {
+        // only sum over the overlapping part instead of testing every index
+        const int begin = std::max(0, -delay);
+        const int end = std::min(datasize, datasize - delay);
+        double sxy = 0;
+        for (int i = begin; i < end; ++i)
+        {
+          sxy += x[i] * y[i + delay];
+        }
+        sxy /= datasize;
+        if (sxy > max_peak.second)
+        {
+          max_peak.first = delay;
+          max_peak.second = sxy;
+        }
+      }
+      return max_peak;
+    }
+
     void standardize_data(std::vector<double>& data)
     {
       OPENSWATH_PRECONDITION(data.size() > 0, "Need non-empty array.");
@@ -304,5 +336,47 @@ namespace OpenSwath
       return result;
     }
 
+    RankedData computeRankedData(const std::vector<double>& data)
+    {
+      RankedData result;
+      result.ranks = computeRank(data);
+      result.rank_counts.assign(data.size(), 0);
+      for (unsigned int rank : result.ranks)
+      {
+        ++result.rank_counts[rank];
+      }
+      return result;
+    }
+
+    double rankedMutualInformation(const RankedData& data1, const RankedData& data2)
+    {
+      OPENSWATH_PRECONDITION(data1.ranks.size() != 0 && data1.ranks.size() == data2.ranks.size(), "Both data vectors need to have the same length");
+
+      // Encode the joint states as MIToolbox does (second * n + first). After sorting, equal states
+      // are adjacent and appear in the order in which calcMutualInformation sums them up.
+      const std::size_t n = data1.ranks.size();
+      std::vector<std::size_t> joint_states(n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        joint_states[i] = data2.ranks[i] * n + data1.ranks[i];
+      }
+      std::sort(joint_states.begin(), joint_states.end());
+
+      const double length = n;
+      double result = 0.0;
+      for (std::size_t k = 0; k < n; )
+      {
+        std::size_t l = k + 1;
+        while (l < n && joint_states[l] == joint_states[k]) ++l;
+
+        const double p_joint = (l - k) / length;
+        const double p_first = data1.rank_counts[joint_states[k] % n] / length;
+        const double p_second = data2.rank_counts[joint_states[k] / n] / length;
+        result += p_joint * log(p_joint / p_first / p_second);
+        k = l;
+      }
+      return result / log(LOG_BASE);
+    }
+
   } //end namespace Scoring
 }
@@ -6,6 +6,7 @@ from libcpp.string cimport string as libcpp_string
 from FileTypes cimport *
 from Types cimport *
 from PeakFileOptions cimport *
+from FeatureFileOptions cimport *
 
 cdef extern from "<OpenMS/FORMAT/FileHandler.h>" namespace "OpenMS":
 
@@ -19,6 +20,8 @@ cdef extern from "<OpenMS/FORMAT/FileHandler.h>" namespace "OpenMS":
 
         PeakFileOptions  getOptions() nogil except +
         void setOptions(PeakFileOptions) nogil except +
+        FeatureFileOptions getFeatOptions() nogil except +
+        void setFeatOptions(FeatureFileOptions) nogil except +
 
 #
 # wrap static method:
@@ -65,5 +65,8 @@ cdef extern from "<OpenMS/FORMAT/FileTypes.h>" namespace "OpenMS::FileTypes":
           OSW,                # < OpenSWATH OpenSWATH report (OSW) SQLite DB
           PSMS,               # < Percolator tab-delimited output (PSM level)
           PARAMXML,           # < internal format for writing and reading parameters (also used as part of CTD)
+          FEATUREBIN,         # < OpenMS binary feature map (.featureBin)
+          CONSENSUSBIN,       # < OpenMS binary consensus feature map (.consensusBin)
+          TRANSITIONBIN,      # < OpenSWATH binary transition library (.trBin)
           SIZE_OF_TYPE        # < No file type. Simply stores the number of types
 
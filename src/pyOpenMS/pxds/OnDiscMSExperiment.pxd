@@ -32,4 +32,6 @@ cdef extern from "<OpenMS/KERNEL/OnDiscMSExperiment.h>" namespace "OpenMS":
         shared_ptr[Chromatogram] getChromatogramById(int id_) nogil except +
 
         void setSkipXMLChecks(bool skip) nogil except +
+        void setMemoryMapping(bool use_mmap) nogil except +
+        bool getMemoryMapping() nogil except +
 
@@ -0,0 +1,13 @@
+### list all benchmark sources here (one file per benchmarked class)
+set(BENCHMARK_sources
+  Base64_benchmark
+  ChromatogramExtractorAlgorithm_benchmark
+  FeatureGroupingAlgorithmKD_benchmark
+  HyperScore_benchmark
+  MassTraceDetection_benchmark
+  MSNumpressCoder_benchmark
+  MSSpectrum_benchmark
+  MzMLFile_benchmark
+  PeakPickerHiRes_benchmark
+  TheoreticalSpectrumGenerator_benchmark
+)
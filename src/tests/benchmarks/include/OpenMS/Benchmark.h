@@ -0,0 +1,219 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+  @brief Minimal micro-benchmark harness
+
+  Benchmarks are plain functions taking a State which are registered using
+  the OPENMS_BENCHMARK macro. The function prepares its input and then runs
+  the code to be measured in a range-based for loop over the State:
+
+  @code
+  void BM_MSSpectrum_findNearest(Benchmark::State& state)
+  {
+    MSSpectrum spec = ...; // not measured
+    for (auto _ : state)
+    {
+      Benchmark::doNotOptimize(spec.findNearest(500.0));
+    }
+  }
+  OPENMS_BENCHMARK(BM_MSSpectrum_findNearest);
+  @endcode
+
+  The runner repeats the loop with increasing iteration counts until the
+  minimal run time is reached and reports the time per iteration. The
+  command line interface and the JSON output follow Google Benchmark
+  (--benchmark_filter, --benchmark_min_time, --benchmark_out), so results
+  of two commits can be compared with its tools/compare.py script.
+*/
+namespace OpenMS
+{
+namespace Benchmark
+{
+  class State
+  {
+public:
+    /// Iterator for the measurement loop
+    class Iterator
+    {
+public:
+      Iterator(State* state, Size remaining) :
+        state_(state),
+        remaining_(remaining)
+      {
+      }
+
+      /// dummy value of the loop variable
+      int operator*() const
+      {
+        return 0;
+      }
+
+      Iterator& operator++()
+      {
+        --remaining_;
+        return *this;
+      }
+
+      bool operator!=(const Iterator& /* end */)
+      {
+        if (remaining_ != 0) return true;
+        state_->stopTiming_();
+        return false;
+      }
+
+private:
+      State* state_;
+      Size remaining_;
+    };
+
+    explicit State(Size iterations) :
+      iterations_(iterations)
+    {
+    }
+
+    /// Starts the timer and returns the iterator to the first iteration
+    Iterator begin()
+    {
+      resumeTiming();
+      return Iterator(this, iterations_);
+    }
+
+    Iterator end()
+    {
+      return Iterator(this, 0);
+    }
+
+    /// Number of iterations of the measurement loop
+    Size iterations() const
+    {
+      return iterations_;
+    }
+
+    /// Stops the timer (e.g. to re-create input which is consumed by an iteration)
+    void pauseTiming()
+    {
+      if (!running_) return;
+      real_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - real_start_).count();
+      cpu_seconds_ += double(std::clock() - cpu_start_) / CLOCKS_PER_SEC;
+      running_ = false;
+    }
+
+    /// Restarts the timer after pauseTiming
+    void resumeTiming()
+    {
+      if (running_) return;
+      real_start_ = std::chrono::steady_clock::now();
+      cpu_start_ = std::clock();
+      running_ = true;
+    }
+
+    /// Number of items (e.g. spectra or peaks) processed in total, reported as items per second
+    void setItemsProcessed(Size items)
+    {
+      items_processed_ = items;
+    }
+
+    /// Number of bytes processed in total, reported as bytes per second
+    void setBytesProcessed(Size bytes)
+    {
+      bytes_processed_ = bytes;
+    }
+
+    /// Free text shown next to the result
+    void setLabel(const std::string& label)
+    {
+      label_ = label;
+    }
+
+    double getRealSeconds() const { return real_seconds_; }
+    double getCPUSeconds() const { return cpu_seconds_; }
+    Size getItemsProcessed() const { return items_processed_; }
+    Size getBytesProcessed() const { return bytes_processed_; }
+    const std::string& getLabel() const { return label_; }
+
+private:
+    void stopTiming_()
+    {
+      pauseTiming();
+    }
+
+    Size iterations_;
+    bool running_ = false;
+    std::chrono::steady_clock::time_point real_start_;
+    std::clock_t cpu_start_ = 0;
+    double real_seconds_ = 0.0;
+    double cpu_seconds_ = 0.0;
+    Size items_processed_ = 0;
+    Size bytes_processed_ = 0;
+    std::string label_;
+  };
+
+  /// Signature of a benchmark function
+  typedef void (*Function)(State&);
+
+  /// Registers a benchmark (use OPENMS_BENCHMARK instead)
+  int registerBenchmark(const char* name, Function function);
+
+  /// Prevents the compiler from optimizing away the computation of @p value
+  template <typename T>
+  inline void doNotOptimize(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+  }
+}
+}
+
+#define OPENMS_BENCHMARK_CONCAT_IMPL_(a, b) a ## b
+#define OPENMS_BENCHMARK_CONCAT_(a, b) OPENMS_BENCHMARK_CONCAT_IMPL_(a, b)
+
+/// Registers the benchmark function @p function
+#define OPENMS_BENCHMARK(function) \
+  static int OPENMS_BENCHMARK_CONCAT_(openms_benchmark_registered_, __LINE__) = \
+    OpenMS::Benchmark::registerBenchmark(#function, function)
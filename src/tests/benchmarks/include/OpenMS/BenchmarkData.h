@@ -0,0 +1,234 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+  @brief Deterministic synthetic input data for the benchmarks
+
+  All data is generated from a fixed seed using a small xorshift generator
+  instead of the std::*_distribution classes (whose output differs between
+  standard library implementations). Thus every platform and every commit
+  benchmarks exactly the same input.
+*/
+namespace OpenMS
+{
+namespace BenchmarkData
+{
+  /// Deterministic random number generator
+  class Random
+  {
+public:
+    explicit Random(std::uint32_t seed = 42) :
+      state_(seed == 0 ? 0x9E3779B9u : seed)
+    {
+    }
+
+    /// uniform random number in [a, b)
+    double uniform(double a, double b)
+    {
+      return a + (b - a) * (next_() / 4294967296.0);
+    }
+
+    /// uniform random index in [0, n)
+    Size index(Size n)
+    {
+      return static_cast<Size>(next_() % n);
+    }
+
+private:
+    /// xorshift32 (fully specified, identical on all platforms)
+    std::uint32_t next_()
+    {
+      state_ ^= state_ << 13;
+      state_ ^= state_ >> 17;
+      state_ ^= state_ << 5;
+      return state_;
+    }
+
+    std::uint32_t state_;
+  };
+
+  /// Centroided spectrum with @p n_peaks peaks at random positions in [200, 2000) (sorted by m/z)
+  inline MSSpectrum centroidSpectrum(Size n_peaks, std::uint32_t seed = 42)
+  {
+    Random rng(seed);
+    MSSpectrum spec;
+    spec.reserve(n_peaks);
+    for (Size i = 0; i < n_peaks; ++i)
+    {
+      spec.push_back(Peak1D(rng.uniform(200.0, 2000.0), static_cast<float>(rng.uniform(10.0, 1e5))));
+    }
+    spec.sortByPosition();
+    spec.setMSLevel(2);
+    spec.setType(SpectrumSettings::CENTROID);
+    return spec;
+  }
+
+  /// A simple isotopic signal: m/z, RT and intensity of the monoisotopic peak
+  struct Signal
+  {
+    double mz;
+    double rt;
+    double intensity;
+    int charge;
+  };
+
+  /// @p n random isotopic signals in the given m/z and RT range
+  inline std::vector<Signal> signals(Size n, double rt_min, double rt_max, std::uint32_t seed = 42)
+  {
+    Random rng(seed);
+    std::vector<Signal> result(n);
+    for (Signal& s : result)
+    {
+      s.mz = rng.uniform(400.0, 1200.0);
+      s.rt = rng.uniform(rt_min, rt_max);
+      s.intensity = rng.uniform(1e4, 1e6);
+      s.charge = 1 + static_cast<int>(rng.index(3));
+    }
+    return result;
+  }
+
+  /**
+    @brief LC-MS map of @p n_spectra MS1 spectra (one per second) containing @p n_signals isotopic signals
+
+    Each signal elutes as a Gaussian (sigma 5 s) and has three isotopic peaks.
+    In profile mode, each peak is sampled as a Gaussian (FWHM 0.01 Th) on a
+    grid of 0.002 Th, otherwise it is stored as a single centroid. Some
+    uniform noise is added to every spectrum.
+  */
+  inline PeakMap lcmsMap(Size n_spectra, Size n_signals, bool profile, std::uint32_t seed = 42)
+  {
+    const double rt_sigma = 5.0;
+    const double mz_sigma = 0.01 / 2.355;
+    const double step = 0.002;
+    std::vector<Signal> sig = signals(n_signals, 0.0, static_cast<double>(n_spectra), seed);
+    Random rng(seed + 1);
+
+    PeakMap exp;
+    for (Size i = 0; i < n_spectra; ++i)
+    {
+      MSSpectrum spec;
+      const double rt = static_cast<double>(i);
+      spec.setRT(rt);
+      spec.setMSLevel(1);
+      spec.setNativeID("scan=" + String(i + 1));
+      spec.setType(profile ? SpectrumSettings::PROFILE : SpectrumSettings::CENTROID);
+      for (const Signal& s : sig)
+      {
+        const double drt = (rt - s.rt) / rt_sigma;
+        if (std::fabs(drt) > 3.0) continue;
+        const double elution = s.intensity * std::exp(-0.5 * drt * drt);
+        for (int iso = 0; iso < 3; ++iso)
+        {
+          const double mz = s.mz + iso * 1.003355 / s.charge;
+          const double height = elution * (iso == 0 ? 1.0 : (iso == 1 ? 0.6 : 0.25));
+          if (!profile)
+          {
+            spec.push_back(Peak1D(mz, static_cast<float>(height)));
+            continue;
+          }
+          for (double x = mz - 4 * mz_sigma; x <= mz + 4 * mz_sigma; x += step)
+          {
+            const double d = (x - mz) / mz_sigma;
+            spec.push_back(Peak1D(x, static_cast<float>(height * std::exp(-0.5 * d * d))));
+          }
+        }
+      }
+      for (Size k = 0; k < 200; ++k)
+      {
+        spec.push_back(Peak1D(rng.uniform(400.0, 1250.0), static_cast<float>(rng.uniform(0.0, 100.0))));
+      }
+      spec.sortByPosition();
+      exp.addSpectrum(spec);
+    }
+    exp.updateRanges();
+    return exp;
+  }
+
+  /// @p n random tryptic peptides of length 7 to 25 without modifications
+  inline std::vector<AASequence> peptides(Size n, std::uint32_t seed = 42)
+  {
+    static const char aa[] = "ACDEFGHILMNPQSTVWY";
+    Random rng(seed);
+    std::vector<AASequence> result;
+    result.reserve(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      String seq;
+      const Size length = 6 + rng.index(19);
+      for (Size k = 0; k < length; ++k)
+      {
+        seq += aa[rng.index(sizeof(aa) - 1)];
+      }
+      seq += (rng.index(2) == 0 ? 'K' : 'R');
+      result.push_back(AASequence::fromString(seq));
+    }
+    return result;
+  }
+
+  /// Feature map with @p n features (each map gets a small systematic RT and m/z shift)
+  inline FeatureMap featureMap(Size n, Size map_index, std::uint32_t seed = 42)
+  {
+    std::vector<Signal> sig = signals(n, 0.0, 3600.0, seed);
+    Random rng(seed + 1 + static_cast<std::uint32_t>(map_index));
+    FeatureMap map;
+    map.reserve(n);
+    for (const Signal& s : sig)
+    {
+      Feature f;
+      f.setRT(s.rt + 2.0 * map_index + rng.uniform(-3.0, 3.0));
+      f.setMZ(s.mz * (1.0 + 1e-6 * rng.uniform(-3.0, 3.0)));
+      f.setIntensity(static_cast<float>(s.intensity * rng.uniform(0.5, 1.5)));
+      f.setCharge(s.charge);
+      f.setOverallQuality(1.0);
+      f.setUniqueId();
+      map.push_back(f);
+    }
+    map.setUniqueId();
+    map.updateRanges();
+    return map;
+  }
+}
+}
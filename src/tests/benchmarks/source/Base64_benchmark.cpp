@@ -0,0 +1,96 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FORMAT/Base64.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  const Size n_values = 100000;
+
+  std::vector<double> values()
+  {
+    MSSpectrum spec = BenchmarkData::centroidSpectrum(n_values);
+    std::vector<double> mz;
+    mz.reserve(spec.size());
+    for (const Peak1D& p : spec) mz.push_back(p.getMZ());
+    return mz;
+  }
+
+  void decode(Benchmark::State& state, bool zlib)
+  {
+    std::vector<double> in = values();
+    String encoded;
+    Base64::encode(in, Base64::BYTEORDER_LITTLEENDIAN, encoded, zlib);
+    std::vector<double> out;
+    for (auto _ : state)
+    {
+      Base64::decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, out, zlib);
+      Benchmark::doNotOptimize(out.data());
+    }
+    state.setItemsProcessed(state.iterations() * n_values);
+    state.setBytesProcessed(state.iterations() * encoded.size());
+  }
+}
+
+void BM_Base64_encode(Benchmark::State& state)
+{
+  std::vector<double> in = values();
+  String out;
+  for (auto _ : state)
+  {
+    Base64::encode(in, Base64::BYTEORDER_LITTLEENDIAN, out, false);
+    Benchmark::doNotOptimize(out.data());
+  }
+  state.setItemsProcessed(state.iterations() * n_values);
+  state.setBytesProcessed(state.iterations() * n_values * sizeof(double));
+}
+OPENMS_BENCHMARK(BM_Base64_encode);
+
+void BM_Base64_decode(Benchmark::State& state)
+{
+  decode(state, false);
+}
+OPENMS_BENCHMARK(BM_Base64_decode);
+
+void BM_Base64_decode_zlib(Benchmark::State& state)
+{
+  decode(state, true);
+}
+OPENMS_BENCHMARK(BM_Base64_decode_zlib);
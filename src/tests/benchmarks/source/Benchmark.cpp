@@ -0,0 +1,244 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/Benchmark.h>
+
+#include <OpenMS/CONCEPT/VersionInfo.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+using namespace OpenMS;
+
+namespace OpenMS
+{
+namespace Benchmark
+{
+  namespace
+  {
+    struct Registered
+    {
+      std::string name;
+      Function function;
+    };
+
+    std::vector<Registered>& registry()
+    {
+      static std::vector<Registered> benchmarks;
+      return benchmarks;
+    }
+
+    struct Result
+    {
+      std::string name;
+      Size iterations;
+      double real_ns; ///< per iteration
+      double cpu_ns; ///< per iteration
+      double items_per_second;
+      double bytes_per_second;
+      std::string label;
+    };
+
+    std::string escapeJSON(const std::string& s)
+    {
+      std::string out;
+      for (char c : s)
+      {
+        if (c == '"' || c == '\\') out += '\\';
+        if (static_cast<unsigned char>(c) < 0x20) continue;
+        out += c;
+      }
+      return out;
+    }
+
+    /*
+      Runs the benchmark with 1, 10, 100, ... iterations (at most 1e9) until
+      the measured time reaches min_time seconds, like Google Benchmark.
+    */
+    Result run(const Registered& benchmark, double min_time)
+    {
+      Size iterations = 1;
+      while (true)
+      {
+        State state(iterations);
+        benchmark.function(state);
+        const double seconds = state.getRealSeconds();
+        if (seconds >= min_time || iterations >= 1000000000)
+        {
+          Result r;
+          r.name = benchmark.name;
+          r.iterations = iterations;
+          r.real_ns = seconds * 1e9 / iterations;
+          r.cpu_ns = state.getCPUSeconds() * 1e9 / iterations;
+          r.items_per_second = seconds > 0 ? state.getItemsProcessed() / seconds : 0.0;
+          r.bytes_per_second = seconds > 0 ? state.getBytesProcessed() / seconds : 0.0;
+          r.label = state.getLabel();
+          return r;
+        }
+        // predict the number of iterations needed, but grow at most 10 fold
+        double factor = seconds > 0 ? 1.4 * min_time / seconds : 10.0;
+        factor = std::min(10.0, std::max(factor, 2.0));
+        iterations = static_cast<Size>(iterations * factor);
+      }
+    }
+
+    void writeJSON(std::ostream& os, const std::vector<Result>& results, const char* executable)
+    {
+      char date[64];
+      std::time_t now = std::time(nullptr);
+      std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+      os << "{\n";
+      os << "  \"context\": {\n";
+      os << "    \"date\": \"" << date << "\",\n";
+      os << "    \"executable\": \"" << escapeJSON(executable) << "\",\n";
+      os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+      os << "    \"openms_version\": \"" << escapeJSON(VersionInfo::getVersion()) << "\",\n";
+      os << "    \"openms_revision\": \"" << escapeJSON(VersionInfo::getRevision()) << "\",\n";
+      os << "    \"openms_branch\": \"" << escapeJSON(VersionInfo::getBranch()) << "\",\n";
+#ifdef NDEBUG
+      os << "    \"library_build_type\": \"release\"\n";
+#else
+      os << "    \"library_build_type\": \"debug\"\n";
+#endif
+      os << "  },\n";
+      os << "  \"benchmarks\": [\n";
+      os << std::setprecision(10);
+      for (Size i = 0; i < results.size(); ++i)
+      {
+        const Result& r = results[i];
+        os << "    {\n";
+        os << "      \"name\": \"" << escapeJSON(r.name) << "\",\n";
+        os << "      \"run_name\": \"" << escapeJSON(r.name) << "\",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"iterations\": " << r.iterations << ",\n";
+        os << "      \"real_time\": " << r.real_ns << ",\n";
+        os << "      \"cpu_time\": " << r.cpu_ns << ",\n";
+        os << "      \"time_unit\": \"ns\"";
+        if (r.items_per_second > 0) os << ",\n      \"items_per_second\": " << r.items_per_second;
+        if (r.bytes_per_second > 0) os << ",\n      \"bytes_per_second\": " << r.bytes_per_second;
+        if (!r.label.empty()) os << ",\n      \"label\": \"" << escapeJSON(r.label) << "\"";
+        os << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+      }
+      os << "  ]\n";
+      os << "}\n";
+    }
+
+    void printUsage(const char* executable)
+    {
+      std::cerr << "Usage: " << executable << " [options]\n"
+                << "  --benchmark_filter=<regex>    only run benchmarks whose name matches (default: all)\n"
+                << "  --benchmark_min_time=<sec>    minimal run time of each benchmark (default: 0.5)\n"
+                << "  --benchmark_out=<file>        write results as JSON to <file>\n"
+                << "  --benchmark_list_tests        list all benchmarks and exit\n";
+    }
+  }
+
+  int registerBenchmark(const char* name, Function function)
+  {
+    registry().push_back(Registered{name, function});
+    return static_cast<int>(registry().size());
+  }
+}
+}
+
+int main(int argc, char** argv)
+{
+  std::string filter = ".*";
+  double min_time = 0.5;
+  std::string out_file;
+  bool list_only = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const String arg(argv[i]);
+    if (arg.hasPrefix("--benchmark_filter=")) filter = arg.suffix('=');
+    else if (arg.hasPrefix("--benchmark_min_time=")) min_time = arg.suffix('=').toDouble();
+    else if (arg.hasPrefix("--benchmark_out=")) out_file = arg.suffix('=');
+    else if (arg == "--benchmark_list_tests") list_only = true;
+    else
+    {
+      Benchmark::printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<Benchmark::Registered> benchmarks = Benchmark::registry();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+    [](const Benchmark::Registered& a, const Benchmark::Registered& b) { return a.name < b.name; });
+  const std::regex re(filter);
+
+  std::vector<Benchmark::Result> results;
+  std::cout << std::left << std::setw(60) << "Benchmark" << std::right << std::setw(16) << "Time [ns]"
+            << std::setw(16) << "CPU [ns]" << std::setw(14) << "Iterations" << "\n"
+            << std::string(106, '-') << std::endl;
+  for (const auto& b : benchmarks)
+  {
+    if (!std::regex_search(b.name, re)) continue;
+    if (list_only)
+    {
+      std::cout << b.name << std::endl;
+      continue;
+    }
+    Benchmark::Result r = Benchmark::run(b, min_time);
+    std::cout << std::left << std::setw(60) << r.name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(16) << r.real_ns << std::setw(16) << r.cpu_ns << std::setw(14) << r.iterations;
+    if (r.items_per_second > 0) std::cout << "  items/s=" << std::scientific << std::setprecision(3) << r.items_per_second;
+    if (r.bytes_per_second > 0) std::cout << "  bytes/s=" << std::scientific << std::setprecision(3) << r.bytes_per_second;
+    if (!r.label.empty()) std::cout << "  " << r.label;
+    std::cout << std::endl;
+    results.push_back(r);
+  }
+
+  if (!out_file.empty())
+  {
+    std::ofstream ofs(out_file.c_str());
+    if (!ofs)
+    {
+      std::cerr << "Could not open " << out_file << " for writing." << std::endl;
+      return 1;
+    }
+    Benchmark::writeJSON(ofs, results, argv[0]);
+  }
+  return 0;
+}
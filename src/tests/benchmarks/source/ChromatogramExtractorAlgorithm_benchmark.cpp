@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+#include <algorithm>
+
+using namespace OpenMS;
+
+void BM_ChromatogramExtractorAlgorithm_extractChromatograms(Benchmark::State& state)
+{
+  const Size n_spectra = 500;
+  const Size n_transitions = 2000;
+  boost::shared_ptr<PeakMap> exp(new PeakMap(BenchmarkData::lcmsMap(n_spectra, 1000, false)));
+  OpenSwath::SpectrumAccessPtr input = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates> coordinates;
+  BenchmarkData::Random rng;
+  for (Size i = 0; i < n_transitions; ++i)
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = rng.uniform(400.0, 1250.0);
+    coord.rt_start = -1; // extract over the whole RT range
+    coord.rt_end = -2;
+    coord.id = String(i);
+    coordinates.push_back(coord);
+  }
+  std::sort(coordinates.begin(), coordinates.end(),
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates::SortExtractionCoordinatesByMZ);
+
+  ChromatogramExtractorAlgorithm extractor;
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    std::vector<OpenSwath::ChromatogramPtr> output;
+    for (Size i = 0; i < n_transitions; ++i)
+    {
+      output.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    state.resumeTiming();
+    extractor.extractChromatograms(input, output, coordinates, 10.0, true, -1, "tophat");
+    Benchmark::doNotOptimize(output.data());
+  }
+  state.setItemsProcessed(state.iterations() * n_spectra);
+}
+OPENMS_BENCHMARK(BM_ChromatogramExtractorAlgorithm_extractChromatograms);
@@ -0,0 +1,70 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmKD.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+using namespace OpenMS;
+
+void BM_FeatureGroupingAlgorithmKD_group(Benchmark::State& state)
+{
+  const Size n_maps = 5;
+  const Size n_features = 10000;
+  std::vector<FeatureMap> maps;
+  for (Size i = 0; i < n_maps; ++i)
+  {
+    maps.push_back(BenchmarkData::featureMap(n_features, i));
+  }
+
+  FeatureGroupingAlgorithmKD grouping;
+  grouping.setLogType(ProgressLogger::NONE);
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    ConsensusMap out;
+    for (Size i = 0; i < n_maps; ++i)
+    {
+      out.getColumnHeaders()[i].size = maps[i].size();
+    }
+    state.resumeTiming();
+    grouping.group(maps, out);
+    Benchmark::doNotOptimize(out.size());
+  }
+  state.setItemsProcessed(state.iterations() * n_maps * n_features);
+}
+OPENMS_BENCHMARK(BM_FeatureGroupingAlgorithmKD_group);
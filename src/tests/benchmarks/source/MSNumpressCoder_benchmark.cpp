@@ -0,0 +1,88 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FORMAT/MSNumpressCoder.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  const Size n_values = 100000;
+
+  void decode(Benchmark::State& state, MSNumpressCoder::NumpressCompression compression, bool mz)
+  {
+    MSSpectrum spec = BenchmarkData::centroidSpectrum(n_values);
+    std::vector<double> in;
+    in.reserve(spec.size());
+    for (const Peak1D& p : spec) in.push_back(mz ? p.getMZ() : p.getIntensity());
+
+    MSNumpressCoder coder;
+    MSNumpressCoder::NumpressConfig config;
+    config.np_compression = compression;
+    String encoded;
+    coder.encodeNP(in, encoded, false, config);
+
+    std::vector<double> out;
+    for (auto _ : state)
+    {
+      out.clear();
+      coder.decodeNP(encoded, out, false, config);
+      Benchmark::doNotOptimize(out.data());
+    }
+    state.setItemsProcessed(state.iterations() * n_values);
+    state.setBytesProcessed(state.iterations() * encoded.size());
+  }
+}
+
+void BM_MSNumpressCoder_decode_linear(Benchmark::State& state)
+{
+  decode(state, MSNumpressCoder::LINEAR, true);
+}
+OPENMS_BENCHMARK(BM_MSNumpressCoder_decode_linear);
+
+void BM_MSNumpressCoder_decode_pic(Benchmark::State& state)
+{
+  decode(state, MSNumpressCoder::PIC, false);
+}
+OPENMS_BENCHMARK(BM_MSNumpressCoder_decode_pic);
+
+void BM_MSNumpressCoder_decode_slof(Benchmark::State& state)
+{
+  decode(state, MSNumpressCoder::SLOF, false);
+}
+OPENMS_BENCHMARK(BM_MSNumpressCoder_decode_slof);
@@ -0,0 +1,82 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  const Size n_peaks = 100000;
+}
+
+void BM_MSSpectrum_sortByPosition(Benchmark::State& state)
+{
+  MSSpectrum sorted = BenchmarkData::centroidSpectrum(n_peaks);
+  BenchmarkData::Random rng;
+  MSSpectrum unsorted = sorted;
+  for (Size i = unsorted.size() - 1; i > 0; --i)
+  {
+    std::swap(unsorted[i], unsorted[rng.index(i + 1)]);
+  }
+  MSSpectrum spec;
+  for (auto _ : state)
+  {
+    state.pauseTiming();
+    spec = unsorted;
+    state.resumeTiming();
+    spec.sortByPosition();
+  }
+  state.setItemsProcessed(state.iterations() * n_peaks);
+}
+OPENMS_BENCHMARK(BM_MSSpectrum_sortByPosition);
+
+void BM_MSSpectrum_findNearest(Benchmark::State& state)
+{
+  const Size n_queries = 10000;
+  MSSpectrum spec = BenchmarkData::centroidSpectrum(n_peaks);
+  BenchmarkData::Random rng;
+  std::vector<double> queries(n_queries);
+  for (double& q : queries) q = rng.uniform(200.0, 2000.0);
+  for (auto _ : state)
+  {
+    Size sum = 0;
+    for (double q : queries) sum += spec.findNearest(q);
+    Benchmark::doNotOptimize(sum);
+  }
+  state.setItemsProcessed(state.iterations() * n_queries);
+}
+OPENMS_BENCHMARK(BM_MSSpectrum_findNearest);
@@ -56,6 +56,7 @@ set(datastructures_executables_list
   GridBasedCluster_test
   GridBasedClustering_test
   GridFeature_test
+  FlatHashGrid_test
   HashGrid_test
   ListUtils_test
   ListUtilsIO_test
@@ -69,6 +70,7 @@ set(datastructures_executables_list
   Param_test
   QTCluster_test
   RangeManager_test
+  SnapshotHolder_test
   StringListUtils_test
   StringUtils_test
   String_test
@@ -156,6 +158,7 @@ set(kernel_executables_list
   MSExperiment_test
   OnDiscMSExperiment_test
   MSSpectrum_test
+  MSSpectrumSoA_test
   Peak1D_test
   Peak2D_test
   PeakIndex_test
@@ -182,6 +185,7 @@ set(format_executables_list
   EDTAFile_test
   ExperimentalDesignFile_test
   FASTAFile_test
+  FeatureBinFile_test
   FeatureFileOptions_test
   FeatureXMLFile_test
   FileHandler_test
@@ -254,6 +258,7 @@ set(format_executables_list
   TransformationXMLFile_test
   UnimodXMLFile_test
   XMassFile_test
+  XMLHandler_test
   XMLFile_test
   XMLValidator_test
   XQuestResultXMLFile_test
@@ -481,6 +486,7 @@ set(analysis_executables_list
   FeatureHandle_test
   FIAMSDataProcessor_test
   FIAMSScheduler_test
+  FragmentIndex_test
   HiddenMarkovModel_test
   IDBoostGraph_test
   IDMapper_test
@@ -655,6 +661,9 @@ if(NOT DISABLE_OPENSWATH)
     MRMRTNormalizer_test
     TransitionTSVFile_test
     TransitionPQPFile_test
+    TransitionBinFile_test
+    MappedTransitionLibrary_test
+    TransitionLibraryIndex_test
     ChromatogramExtractor_test
     ChromatogramExtractorAlgorithm_test
     OpenSwathHelper_test
@@ -1554,6 +1554,68 @@ START_SECTION([EXTRA] multithreaded example)
 }
 END_SECTION
 
+START_SECTION(static void setParseCacheEnabled(bool enabled, Size max_size = 1000000))
+{
+  TEST_EQUAL(AASequence::isParseCacheEnabled(), false)
+  AASequence::setParseCacheEnabled(true, 1000);
+  TEST_EQUAL(AASequence::isParseCacheEnabled(), true)
+
+  // cached and uncached parsing give the same results
+  const StringList sequences = ListUtils::create<String>("PEPTIDE,PEPM(Oxidation)TIDE,.(Acetyl)PEPTIDEK.,TEST[+16.0]PEPTIDE,PEPTIDE");
+  for (const String& seq : sequences)
+  {
+    AASequence first = AASequence::fromString(seq);
+    AASequence second = AASequence::fromString(seq);
+    TEST_EQUAL(first, second)
+    AASequence::setParseCacheEnabled(false);
+    TEST_EQUAL(first, AASequence::fromString(seq))
+    AASequence::setParseCacheEnabled(true, 1000);
+  }
+
+  // 'permissive' is part of the key
+  TEST_EQUAL(AASequence::fromString("PEP*TIDE", true).toString(), "PEPXTIDE")
+  TEST_EXCEPTION(Exception::ParseError, AASequence::fromString("PEP*TIDE", false))
+
+  // invalid sequences are not cached
+  TEST_EXCEPTION(Exception::ParseError, AASequence::fromString("PEPTIDE(Oxidation"))
+  TEST_EXCEPTION(Exception::ParseError, AASequence::fromString("PEPTIDE(Oxidation"))
+
+  // cached copies are independent of each other
+  AASequence modified = AASequence::fromString("PEPTIDE");
+  modified.setModification(3, "Phospho");
+  TEST_EQUAL(AASequence::fromString("PEPTIDE").isModified(), false)
+
+  // parallel parsing with the cache
+  int test = 0;
+#pragma omp parallel for reduction (+: test)
+  for (int k = 0; k < 1000; k++)
+  {
+    auto aa = AASequence::fromString(sequences[k % sequences.size()]);
+    test += aa.size();
+  }
+  TEST_EQUAL(test, 200 * (7 + 8 + 8 + 11 + 7))
+
+  AASequence::setParseCacheEnabled(false);
+  TEST_EQUAL(AASequence::isParseCacheEnabled(), false)
+}
+END_SECTION
+
+START_SECTION(static bool isParseCacheEnabled())
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(static void clearParseCache())
+{
+  AASequence::setParseCacheEnabled(true);
+  AASequence seq = AASequence::fromString("PEPTIDER");
+  AASequence::clearParseCache();
+  TEST_EQUAL(AASequence::fromString("PEPTIDER"), seq)
+  AASequence::setParseCacheEnabled(false);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -43,6 +43,8 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 
+#include <random>
+
 using namespace std;
 
 START_TEST(Base64, "$Id$")
@@ -184,14 +186,8 @@ START_SECTION((template < typename ToType > void decode(const String &in, ByteOr
   src = "whoPutMeHere:somecrazyperson,obviously!WhatifIcontaininvalidcharacterslikethese";
   TEST_EXCEPTION(Exception::ConversionError, b64.decode(src, Base64::BYTEORDER_BIGENDIAN, res) );
 
-  // TODO : some error checking and handling
-  // currently there is no "safe" Base64 decoding that checks that all
-  // characters are actually valid and the string is actually encoding to
-  // floats.
-  // 
-  // src = "Q A..A=="; // spaces and dots are not allowed
-  // b64.decode(src, Base64::BYTEORDER_BIGENDIAN, res);
-  // TEST_EQUAL(res.size(), 0)
+  src = "Q A..A=="; // spaces and dots are not allowed
+  TEST_EXCEPTION(Exception::ConversionError, b64.decode(src, Base64::BYTEORDER_BIGENDIAN, res) );
 }
 END_SECTION
 
@@ -264,6 +260,57 @@ START_SECTION([EXTRA] zlib functionality)
 }
 END_SECTION
 
+START_SECTION([EXTRA] vectorized encoding and decoding)
+{
+  // the vectorized kernels work on blocks of 12/24 bytes and 16/32
+  // characters, test all lengths around these boundaries against Qt
+  Base64 b64;
+  std::mt19937 rng(42);
+  for (Size length = 0; length < 200; ++length)
+  {
+    String data(length, '\0');
+    for (Size i = 0; i < length; ++i)
+    {
+      data[i] = (char)(rng() % 256);
+    }
+
+    String encoded;
+    b64.encodeStrings(std::vector<String>(1, data), encoded, false, false);
+    QByteArray qt_encoded = QByteArray(data.c_str(), (int)data.size()).toBase64();
+    TEST_EQUAL(encoded, String(std::string(qt_encoded.constData(), qt_encoded.size())))
+
+    QByteArray decoded;
+    b64.decodeSingleString(encoded, decoded, false);
+    TEST_EQUAL(String(std::string(decoded.constData(), decoded.size())), data)
+
+    // invalid characters anywhere in the input are detected
+    if (length >= 3)
+    {
+      String invalid = encoded;
+      invalid[rng() % (invalid.size() - 1)] = '.';
+      std::vector<Int32> res;
+      TEST_EXCEPTION(Exception::ConversionError, b64.decodeIntegers(invalid, Base64::BYTEORDER_LITTLEENDIAN, res, false))
+    }
+  }
+
+  std::vector<double> data_double, res_double;
+  for (Size i = 0; i < 1000; ++i)
+  {
+    data_double.push_back(100.0 + i * 0.0123456789);
+  }
+  std::vector<double> data_double_copy = data_double;
+  String encoded;
+  b64.encode(data_double_copy, Base64::BYTEORDER_LITTLEENDIAN, encoded);
+  b64.decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, res_double);
+  TEST_EQUAL(res_double == data_double, true)
+
+  data_double_copy = data_double;
+  b64.encode(data_double_copy, Base64::BYTEORDER_BIGENDIAN, encoded, true);
+  b64.decode(encoded, Base64::BYTEORDER_BIGENDIAN, res_double, true);
+  TEST_EQUAL(res_double == data_double, true)
+}
+END_SECTION
+
 START_SECTION(( void encodeStrings(const std::vector<String> & in, String & out, bool zlib_compression = false, bool append_zero_byte = true)))
 {
   Base64 b64;
@@ -420,10 +467,8 @@ START_SECTION((template < typename ToType > void decodeIntegers(const String &in
   b64.decodeIntegers(src, Base64::BYTEORDER_BIGENDIAN,res,false);
   TEST_EQUAL(res.size(), 0)
 
-  // src = "Q A..A=="; // spaces and dots are not allowed
-  // b64.decodeIntegers(src, Base64::BYTEORDER_BIGENDIAN,res,false);
-  // TODO : some error checking and handling
-  // TEST_EQUAL(res.size(), 0)
+  src = "Q A..A=="; // spaces and dots are not allowed
+  TEST_EXCEPTION(Exception::ConversionError, b64.decodeIntegers(src, Base64::BYTEORDER_BIGENDIAN,res,false) );
 }
 END_SECTION
 
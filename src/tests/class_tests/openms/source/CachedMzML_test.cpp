@@ -220,6 +220,111 @@ START_SECTION(( const MSExperiment& getMetaData() const ))
 }
 END_SECTION
 
+START_SECTION(( void setMemoryMapping(bool use_mmap) ))
+{
+  CachedmzML cache;
+  TEST_EQUAL(cache.getMemoryMapping(), false)
+  cache.setMemoryMapping(true);
+  TEST_EQUAL(cache.getMemoryMapping(), true)
+  CachedmzML::load(tmpf, cache);
+  TEST_EQUAL(cache.getMemoryMapping(), true)
+
+  // spectra and chromatograms read through the mapping are identical
+  for (int i = 0; i < 4; i++)
+  {
+    auto tmp1 = cache.getSpectrum(i);
+    auto tmp2 = cache_example.getSpectrum(i);
+    TEST_EQUAL(tmp1 == tmp2, true)
+  }
+  for (int i = 0; i < 2; i++)
+  {
+    auto tmp1 = cache.getChromatogram(i);
+    auto tmp2 = cache_example.getChromatogram(i);
+    TEST_EQUAL(tmp1 == tmp2, true)
+  }
+
+  // copies share the mapping
+  CachedmzML copy(cache);
+  TEST_EQUAL(copy.getMemoryMapping(), true)
+  TEST_EQUAL(copy.getSpectrum(1) == cache.getSpectrum(1), true)
+
+  // switching back to the file stream
+  cache.setMemoryMapping(false);
+  TEST_EQUAL(cache.getMemoryMapping(), false)
+  TEST_EQUAL(cache.getSpectrum(1) == cache_example.getSpectrum(1), true)
+  Internal::CachedMzMLHandler::DataView view;
+  TEST_EXCEPTION(Exception::IllegalArgument, cache.getSpectrumView(1, view))
+}
+END_SECTION
+
+START_SECTION(( bool getMemoryMapping() const ))
+{
+  NOT_TESTABLE // see above
+}
+END_SECTION
+
+START_SECTION(( void getSpectrumView(Size id, Internal::CachedMzMLHandler::DataView& view) const ))
+{
+  CachedmzML cache;
+  cache.setMemoryMapping(true);
+  CachedmzML::load(tmpf, cache);
+
+  Internal::CachedMzMLHandler::DataView view;
+  for (int i = 0; i < 4; i++)
+  {
+    cache.getSpectrumView(i, view);
+    TEST_EQUAL(view.first.size, exp[i].size())
+    TEST_EQUAL(view.second.size, exp[i].size())
+    TEST_EQUAL(view.ms_level, (int)exp[i].getMSLevel())
+    TEST_REAL_SIMILAR(view.rt, exp[i].getRT())
+    for (Size j = 0; j < exp[i].size(); j++)
+    {
+      TEST_REAL_SIMILAR(view.first[j], exp[i][j].getMZ())
+      TEST_REAL_SIMILAR(view.second[j], exp[i][j].getIntensity())
+    }
+    // iterator access
+    Size count = 0;
+    for (auto it = view.first.begin(); it != view.first.end(); ++it, ++count)
+    {
+      TEST_REAL_SIMILAR(*it, exp[i][count].getMZ())
+    }
+    TEST_EQUAL(count, exp[i].size())
+  }
+
+  // additional data arrays
+  cache.getSpectrumView(1, view);
+  TEST_EQUAL(view.additional.size(), 2)
+  TEST_EQUAL(std::string(view.additional[0].name, view.additional[0].name_size), "signal to noise array")
+  TEST_EQUAL(view.additional[1].nameStartsWith("user-defined"), true)
+  TEST_EQUAL(view.additional[1].nameStartsWith("signal"), false)
+  TEST_EQUAL(view.additional[0].size, exp[1].getFloatDataArrays()[0].size())
+  for (Size k = 0; k < view.additional[0].size; k++)
+  {
+    TEST_REAL_SIMILAR(view.additional[0][k], exp[1].getFloatDataArrays()[0][k])
+  }
+}
+END_SECTION
+
+START_SECTION(( void getChromatogramView(Size id, Internal::CachedMzMLHandler::DataView& view) const ))
+{
+  CachedmzML cache;
+  cache.setMemoryMapping(true);
+  CachedmzML::load(tmpf, cache);
+
+  Internal::CachedMzMLHandler::DataView view;
+  for (int i = 0; i < 2; i++)
+  {
+    cache.getChromatogramView(i, view);
+    TEST_EQUAL(view.first.size, exp.getChromatogram(i).size())
+    for (Size j = 0; j < view.first.size; j++)
+    {
+      TEST_REAL_SIMILAR(view.first[j], exp.getChromatogram(i)[j].getRT())
+      TEST_REAL_SIMILAR(view.second[j], exp.getChromatogram(i)[j].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
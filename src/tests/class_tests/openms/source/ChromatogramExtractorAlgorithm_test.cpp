@@ -38,6 +38,9 @@
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSCached.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessQuadMZTransforming.h>
+#include <OpenMS/FORMAT/CachedMzML.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -136,6 +139,128 @@ START_SECTION(void extractChromatograms(const OpenSwath::SpectrumAccessPtr input
 }
 END_SECTION
 
+START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter) with memory-mapped cached input)
+{
+  double extract_window = 0.05;
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), *exp);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  CachedmzML::store(tmp_filename, *exp);
+  boost::shared_ptr<SpectrumAccessOpenMSCached> cached(new SpectrumAccessOpenMSCached(tmp_filename));
+  cached->setMemoryMapping(true);
+  TEST_EQUAL(cached->getMemoryMapping(), true)
+
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 618.31; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr1";
+    coordinates.push_back(coord);
+    coord.mz = 628.45; coord.rt_start = 3050; coord.rt_end = 3150; coord.id = "tr2";
+    coordinates.push_back(coord);
+    coord.mz = 654.38; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr3";
+    coordinates.push_back(coord);
+  }
+
+  std::vector< OpenSwath::ChromatogramPtr > out_mem, out_mapped;
+  for (int i = 0; i < 3; i++)
+  {
+    out_mem.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_mapped.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  }
+
+  ChromatogramExtractorAlgorithm extractor;
+  extractor.extractChromatograms(expptr, out_mem, coordinates, extract_window, false, -1, "tophat");
+  extractor.extractChromatograms(cached, out_mapped, coordinates, extract_window, false, -1, "tophat");
+
+  // reading in place from the mapped file runs the same kernel on the same
+  // values as the in-memory path, so the result is bit-identical
+  for (Size k = 0; k < 3; k++)
+  {
+    TEST_EQUAL(out_mapped[k]->getTimeArray()->data.size(), out_mem[k]->getTimeArray()->data.size())
+    TEST_EQUAL(out_mapped[k]->getTimeArray()->data == out_mem[k]->getTimeArray()->data, true)
+    TEST_EQUAL(out_mapped[k]->getIntensityArray()->data == out_mem[k]->getIntensityArray()->data, true)
+  }
+  TEST_EQUAL(out_mapped[0]->getTimeArray()->data.size(), 59);
+
+  double max_value = -1; double foundat = -1;
+  find_max_helper(out_mapped[2], max_value, foundat);
+  TEST_REAL_SIMILAR(max_value, 577.33);
+  TEST_REAL_SIMILAR(foundat, 3120.26);
+
+  // there is no ion mobility, so this should not work
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extractChromatograms(cached, out_mapped, coordinates, extract_window, false, 1, "tophat"))
+}
+END_SECTION
+
+START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter) with a wrapped cached input)
+{
+  double extract_window = 0.05;
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), *exp);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  CachedmzML::store(tmp_filename, *exp);
+  boost::shared_ptr<SpectrumAccessOpenMSCached> cached(new SpectrumAccessOpenMSCached(tmp_filename));
+  cached->setMemoryMapping(true);
+
+  // a wrapper is not recognized as cached input and takes the generic path,
+  // so the m/z transformation it applies is part of the extraction
+  OpenSwath::SpectrumAccessPtr wrapped_cached(new SpectrumAccessQuadMZTransforming(cached, 0.1, 1.0, 0.0, false));
+  OpenSwath::SpectrumAccessPtr wrapped_mem(new SpectrumAccessQuadMZTransforming(expptr, 0.1, 1.0, 0.0, false));
+  OpenSwath::SpectrumAccessPtr identity_cached(new SpectrumAccessQuadMZTransforming(cached, 0.0, 1.0, 0.0, false));
+
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 618.31; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr1";
+    coordinates.push_back(coord);
+    coord.mz = 628.45; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr2";
+    coordinates.push_back(coord);
+    coord.mz = 654.38; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr3";
+    coordinates.push_back(coord);
+  }
+
+  std::vector< OpenSwath::ChromatogramPtr > out_mapped, out_wrapped, out_wrapped_mem, out_identity;
+  for (int i = 0; i < 3; i++)
+  {
+    out_mapped.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_wrapped.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_wrapped_mem.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_identity.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  }
+
+  ChromatogramExtractorAlgorithm extractor;
+  extractor.extractChromatograms(cached, out_mapped, coordinates, extract_window, false, -1, "tophat");
+  extractor.extractChromatograms(wrapped_cached, out_wrapped, coordinates, extract_window, false, -1, "tophat");
+  extractor.extractChromatograms(wrapped_mem, out_wrapped_mem, coordinates, extract_window, false, -1, "tophat");
+  extractor.extractChromatograms(identity_cached, out_identity, coordinates, extract_window, false, -1, "tophat");
+
+  bool shift_changes_result = false;
+  for (Size k = 0; k < 3; k++)
+  {
+    // the fallback reads the same spectra as the in-memory accessor
+    TEST_EQUAL(out_wrapped[k]->getTimeArray()->data == out_wrapped_mem[k]->getTimeArray()->data, true)
+    TEST_EQUAL(out_wrapped[k]->getIntensityArray()->data == out_wrapped_mem[k]->getIntensityArray()->data, true)
+
+    // an identity transformation reproduces the in-place result
+    TEST_EQUAL(out_identity[k]->getTimeArray()->data == out_mapped[k]->getTimeArray()->data, true)
+    TEST_EQUAL(out_identity[k]->getIntensityArray()->data == out_mapped[k]->getIntensityArray()->data, true)
+
+    if (out_wrapped[k]->getIntensityArray()->data != out_mapped[k]->getIntensityArray()->data)
+    {
+      shift_changes_result = true;
+    }
+  }
+  // the shift is not lost by bypassing the wrapper
+  TEST_EQUAL(shift_changes_result, true)
+}
+END_SECTION
+
 START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter))
 {
   typedef OpenMS::DataArrays::FloatDataArray FloatDataArray;
@@ -540,6 +665,53 @@ START_SECTION([EXTRA]void extract_value_tophat(const std::vector< double >::cons
 }
 END_SECTION
 
+START_SECTION((void extract_value_tophat(const std::vector<double>& mz_array, const std::vector<double>& int_array, const std::vector<double>& mz_targets, std::vector<double>& integrated_intensities, const double mz_extraction_window, const bool ppm)))
+{
+  std::vector<double> mz (mz_arr, mz_arr + sizeof(mz_arr) / sizeof(mz_arr[0]) );
+  std::vector<double> intensities (int_arr, int_arr + sizeof(int_arr) / sizeof(int_arr[0]) );
+
+  ChromatogramExtractorAlgorithm extractor;
+  std::vector<double> targets = {399.805, 399.91, 400.0, 400.05, 400.1, 400.28, 450.0, 500.0, 500.05};
+  std::vector<double> result;
+
+  // Th and ppm windows give the same result as one call of the scalar function per target,
+  // up to rounding: the batched kernel sums the same peaks, but in a different order
+  for (int ppm = 0; ppm < 2; ppm++)
+  {
+    double extract_window = ppm ? 500 : 0.2;
+    extractor.extract_value_tophat(mz, intensities, targets, result, extract_window, ppm);
+    TEST_EQUAL(result.size(), targets.size())
+
+    std::vector<double>::const_iterator mz_it = mz.begin();
+    std::vector<double>::const_iterator int_it = intensities.begin();
+    for (Size k = 0; k < targets.size(); k++)
+    {
+      double integrated_intensity = 0;
+      extractor.extract_value_tophat(mz.begin(), mz_it, mz.end(), int_it, targets[k], integrated_intensity, extract_window, ppm);
+      TEST_REAL_SIMILAR(result[k], integrated_intensity)
+    }
+  }
+
+  extractor.extract_value_tophat(mz, intensities, targets, result, 0.2, false);
+  TEST_REAL_SIMILAR(result[0], 0.0)
+  TEST_REAL_SIMILAR(result[1], 108.0)
+  TEST_REAL_SIMILAR(result[2], 4508.0)
+  TEST_REAL_SIMILAR(result[3], 8400.0)
+  TEST_REAL_SIMILAR(result[4], 9000.0)
+  TEST_REAL_SIMILAR(result[5], 100.0)
+  TEST_REAL_SIMILAR(result[7], 10.0)
+
+  // empty spectrum
+  std::vector<double> empty;
+  extractor.extract_value_tophat(empty, empty, targets, result, 0.2, false);
+  TEST_EQUAL(result.size(), targets.size())
+  TEST_REAL_SIMILAR(result[4], 0.0)
+
+  intensities.pop_back();
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extract_value_tophat(mz, intensities, targets, result, 0.2, false))
+}
+END_SECTION
+
 START_SECTION( [ChromatogramExtractorAlgorithm::ExtractionCoordinates] static bool SortExtractionCoordinatesByMZ(const ChromatogramExtractorAlgorithm::ExtractionCoordinates &left, const ChromatogramExtractorAlgorithm::ExtractionCoordinates &right))    
 {
   NOT_TESTABLE
@@ -77,6 +77,7 @@ START_SECTION((DataValue()))
   // - 1 byte for the data type
   // - 1 byte for the unit type
   // - 4 bytes for the unit identifier (32bit integer)
+  // - 1 byte storage flag for strings (inline or shared)
   // - 1 byte padding
   // - 8 bytes for the actual data / pointers to data
   std::cout << "\n\n --- Size of DataValue " << sizeof(DataValue) << std::endl;
@@ -1021,6 +1022,83 @@ START_SECTION((DataValue& operator=(const unsigned long long)))
 }
 END_SECTION
 
+START_SECTION((static DataValue interned(const String& value)))
+{
+  Size count = DataValue::internedCount();
+  DataValue a = DataValue::interned("a string that is not stored inline");
+  DataValue b = DataValue::interned(String("a string that is not stored inline"));
+  TEST_EQUAL(a.valueType(), DataValue::STRING_VALUE)
+  TEST_EQUAL(a.toString(), "a string that is not stored inline")
+  TEST_EQUAL(a == b, true)
+  // both share the same storage
+  TEST_EQUAL(a.toChar() == b.toChar(), true)
+  TEST_EQUAL(DataValue::internedCount(), count + 1)
+
+  // a non-interned value compares equal, but has its own storage
+  DataValue c("a string that is not stored inline");
+  TEST_EQUAL(a == c, true)
+  TEST_EQUAL(a.toChar() == c.toChar(), false)
+
+  // short strings are stored inline
+  DataValue d = DataValue::interned("decoy");
+  TEST_EQUAL(d.toString(), "decoy")
+  TEST_EQUAL(DataValue::internedCount(), count + 1)
+
+  // storage is released with the last value
+  a = 1;
+  TEST_EQUAL(DataValue::internedCount(), count + 1)
+  b = DataValue();
+  TEST_EQUAL(DataValue::internedCount(), count)
+}
+END_SECTION
+
+START_SECTION((static Size internedCount()))
+{
+  Size count = DataValue::internedCount();
+  {
+    std::vector<DataValue> values(10, DataValue::interned("first long interned value"));
+    values.push_back(DataValue::interned("second long interned value"));
+    values.push_back(values.back());
+    TEST_EQUAL(DataValue::internedCount(), count + 2)
+  }
+  TEST_EQUAL(DataValue::internedCount(), count)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] string storage))
+{
+  // short (inline) and long (shared) strings behave the same
+  DataValue s1("abc"), s2("abcd"), l1("a long string value"), l2("a long string value, even longer");
+  TEST_EQUAL(s1 < s2, true)
+  TEST_EQUAL(l1 < l2, true)
+  TEST_EQUAL(s1 < l1, false)
+  TEST_EQUAL(l2 > l1, true)
+  TEST_EQUAL(DataValue("") == DataValue(""), true)
+  TEST_EQUAL(DataValue("").isEmpty(), false)
+
+  // strings with embedded zeros are kept completely
+  std::string with_zero("a\0b", 3);
+  DataValue z(with_zero);
+  TEST_EQUAL(std::string(z) == with_zero, true)
+  TEST_EQUAL(z == DataValue(std::string("a\0c", 3)), false)
+
+  // copies share long strings, assignment of a new value does not modify the copy
+  DataValue copy = l1;
+  TEST_EQUAL(copy.toChar() == l1.toChar(), true)
+  l1 = "changed";
+  TEST_EQUAL(copy, "a long string value")
+  TEST_EQUAL(l1, "changed")
+
+  DataValue moved(std::move(copy));
+  TEST_EQUAL(moved, "a long string value")
+  TEST_EQUAL(copy.isEmpty(), true)
+
+  stringstream ss;
+  ss << s1 << l2;
+  TEST_EQUAL(ss.str(), "abca long string value, even longer")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
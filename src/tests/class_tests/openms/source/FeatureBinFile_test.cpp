@@ -0,0 +1,274 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/FeatureBinFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+using namespace OpenMS;
+using namespace std;
+
+DRange<1> makeRange(double a, double b)
+{
+  DPosition<1> pa(a), pb(b);
+  return DRange<1>(pa, pb);
+}
+
+///////////////////////////
+
+START_TEST(FeatureBinFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+FeatureBinFile* ptr = nullptr;
+FeatureBinFile* null_ptr = nullptr;
+START_SECTION((FeatureBinFile()))
+{
+  ptr = new FeatureBinFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION((~FeatureBinFile()))
+{
+  delete ptr;
+}
+END_SECTION
+
+FeatureMap features;
+FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), features);
+String feature_file;
+NEW_TMP_FILE(feature_file)
+
+START_SECTION((void store(const String& filename, const FeatureMap& feature_map)))
+{
+  FeatureBinFile f;
+  f.store(feature_file, features);
+  TEST_EQUAL(FileHandler::getType(feature_file), FileTypes::FEATUREBIN)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, f.store("this_is_not_binary.featureXML", features))
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, FeatureMap& feature_map)))
+{
+  FeatureBinFile f;
+  FeatureMap loaded;
+  TEST_EXCEPTION(Exception::FileNotFound, f.load("dummy/dummy.featureBin", loaded))
+  TEST_EXCEPTION(Exception::ParseError, f.load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), loaded))
+
+  f.load(feature_file, loaded);
+  TEST_STRING_EQUAL(loaded.getLoadedFilePath(), feature_file)
+  // everything stored in featureXML survives the round trip
+  TEST_EQUAL(loaded == features, true)
+  ABORT_IF(loaded.size() != 2)
+  TEST_EQUAL(loaded.getIdentifier(), "lsid")
+  TEST_EQUAL(loaded[0].getSubordinates().size(), 2)
+  TEST_EQUAL(loaded[0].getConvexHulls().size(), features[0].getConvexHulls().size())
+  TEST_EQUAL(loaded[0].getPeptideIdentifications().size(), 2)
+  TEST_EQUAL(loaded[0].getMetaValue("stringparametername"), "stringparametervalue")
+  TEST_EQUAL(loaded[0].getMetaValue("myIntList").toIntList().size(), 3)
+  TEST_EQUAL(loaded.getProteinIdentifications().size(), features.getProteinIdentifications().size())
+  TEST_EQUAL(loaded.getUnassignedPeptideIdentifications().size(), 2)
+
+  // binary consensus maps are rejected
+  ConsensusMap consensus;
+  String consensus_file;
+  NEW_TMP_FILE(consensus_file)
+  FeatureBinFile().store(consensus_file, consensus);
+  TEST_EXCEPTION(Exception::ParseError, f.load(consensus_file, loaded))
+
+  // feature width is stored directly
+  FeatureMap with_width = features;
+  with_width[1].setWidth(12.5);
+  String width_file;
+  NEW_TMP_FILE(width_file)
+  f.store(width_file, with_width);
+  f.load(width_file, loaded);
+  TEST_REAL_SIMILAR(loaded[1].getWidth(), 12.5)
+}
+END_SECTION
+
+START_SECTION((Size loadSize(const String& filename)))
+{
+  FeatureBinFile f;
+  TEST_EQUAL(f.loadSize(feature_file), features.size())
+  TEST_EXCEPTION(Exception::FileNotFound, f.loadSize("dummy/dummy.featureBin"))
+  TEST_EXCEPTION(Exception::ParseError, f.loadSize(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML")))
+}
+END_SECTION
+
+START_SECTION((FeatureFileOptions& getOptions()))
+{
+  FeatureBinFile f;
+  FeatureMap loaded;
+
+  f.getOptions().setLoadConvexHull(false);
+  f.load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 2)
+  TEST_EQUAL(loaded[0].getConvexHulls().size(), 0)
+  TEST_EQUAL(loaded[0].getSubordinates().size(), 2)
+  TEST_EQUAL(loaded[0].getSubordinates()[0].getConvexHulls().size(), 0)
+  TEST_EQUAL(loaded[0].getPeptideIdentifications().size(), 2)
+
+  f.getOptions() = FeatureFileOptions();
+  f.getOptions().setLoadSubordinates(false);
+  f.load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 2)
+  TEST_EQUAL(loaded[0].getSubordinates().size(), 0)
+  TEST_EQUAL(loaded[0].getConvexHulls().size(), features[0].getConvexHulls().size())
+
+  f.getOptions() = FeatureFileOptions();
+  f.getOptions().setMetadataOnly(true);
+  f.load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 0)
+  TEST_EQUAL(loaded.getIdentifier(), "lsid")
+  TEST_EQUAL(loaded.getProteinIdentifications().size(), features.getProteinIdentifications().size())
+
+  f.getOptions() = FeatureFileOptions();
+  f.getOptions().setRTRange(makeRange(20, 30));
+  f.load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 1)
+  TEST_REAL_SIMILAR(loaded[0].getRT(), 25)
+
+  f.getOptions() = FeatureFileOptions();
+  f.getOptions().setMZRange(makeRange(30, 40));
+  f.load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 1)
+  TEST_REAL_SIMILAR(loaded[0].getMZ(), 35)
+
+  f.getOptions() = FeatureFileOptions();
+  f.getOptions().setIntensityRange(makeRange(400, 600));
+  f.load(feature_file, loaded);
+  TEST_EQUAL(loaded.size(), 1)
+  TEST_REAL_SIMILAR(loaded[0].getIntensity(), 500)
+}
+END_SECTION
+
+START_SECTION((const FeatureFileOptions& getOptions() const))
+{
+  FeatureBinFile f;
+  const FeatureBinFile& cf = f;
+  TEST_EQUAL(cf.getOptions().getLoadConvexHull(), true)
+  TEST_EQUAL(cf.getOptions().getLoadSubordinates(), true)
+  TEST_EQUAL(cf.getOptions().getMetadataOnly(), false)
+}
+END_SECTION
+
+START_SECTION((void setOptions(const FeatureFileOptions& options)))
+{
+  FeatureBinFile f;
+  FeatureFileOptions options;
+  options.setLoadSubordinates(false);
+  f.setOptions(options);
+  TEST_EQUAL(f.getOptions().getLoadSubordinates(), false)
+}
+END_SECTION
+
+ConsensusMap consensus;
+ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), consensus);
+String consensus_file;
+NEW_TMP_FILE(consensus_file)
+
+START_SECTION((void store(const String& filename, const ConsensusMap& consensus_map)))
+{
+  FeatureBinFile f;
+  f.store(consensus_file, consensus);
+  TEST_EQUAL(FileHandler::getType(consensus_file), FileTypes::CONSENSUSBIN)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, f.store("this_is_not_binary.consensusXML", consensus))
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, ConsensusMap& consensus_map)))
+{
+  FeatureBinFile f;
+  ConsensusMap loaded;
+  TEST_EXCEPTION(Exception::FileNotFound, f.load("dummy/dummy.consensusBin", loaded))
+  TEST_EXCEPTION(Exception::ParseError, f.load(feature_file, loaded))
+
+  f.load(consensus_file, loaded);
+  TEST_EQUAL(loaded == consensus, true)
+  ABORT_IF(loaded.size() != consensus.size())
+  TEST_EQUAL(loaded.getColumnHeaders().size(), consensus.getColumnHeaders().size())
+  TEST_EQUAL(loaded.getExperimentType(), consensus.getExperimentType())
+  for (Size i = 0; i < loaded.size(); ++i)
+  {
+    TEST_EQUAL(loaded[i].size(), consensus[i].size())
+    TEST_EQUAL(loaded[i].getUniqueId(), consensus[i].getUniqueId())
+  }
+
+  f.getOptions().setMetadataOnly(true);
+  f.load(consensus_file, loaded);
+  TEST_EQUAL(loaded.size(), 0)
+  TEST_EQUAL(loaded.getColumnHeaders().size(), consensus.getColumnHeaders().size())
+}
+END_SECTION
+
+START_SECTION(([EXTRA] FileHandler::loadFeatures / loadConsensusFeatures))
+{
+  FileHandler fh;
+  FeatureMap loaded_features;
+  TEST_EQUAL(fh.loadFeatures(feature_file, loaded_features), true)
+  TEST_EQUAL(loaded_features == features, true)
+
+  ConsensusMap loaded_consensus;
+  TEST_EQUAL(fh.loadConsensusFeatures(consensus_file, loaded_consensus), true)
+  TEST_EQUAL(loaded_consensus == consensus, true)
+
+  // feature options are used for featureXML and featureBin
+  fh.getFeatOptions().setLoadSubordinates(false);
+  TEST_EQUAL(fh.loadFeatures(feature_file, loaded_features), true)
+  TEST_EQUAL(loaded_features[0].getSubordinates().size(), 0)
+  TEST_EQUAL(fh.loadFeatures(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), loaded_features), true)
+  TEST_EQUAL(loaded_features[0].getSubordinates().size(), 0)
+  FeatureFileOptions options;
+  fh.setFeatOptions(options);
+  TEST_EQUAL(fh.getFeatOptions().getLoadSubordinates(), true)
+  TEST_EQUAL(fh.loadFeatures(feature_file, loaded_features), true)
+  TEST_EQUAL(loaded_features[0].getSubordinates().size(), 2)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
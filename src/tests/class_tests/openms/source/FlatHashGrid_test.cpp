@@ -0,0 +1,202 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/COMPARISON/CLUSTERING/FlatHashGrid.h>
+///////////////////////////
+
+#include <limits>
+
+using namespace OpenMS;
+
+typedef OpenMS::HashGrid<int> TestHashGrid;
+typedef OpenMS::FlatHashGrid<int> TestGrid;
+const TestGrid::ClusterCenter cell_dimension(1, 1);
+
+START_TEST(FlatHashGrid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// elements: value = 10 * x + y of the containing cell (plus 100 for the second element in a cell)
+std::vector<TestGrid::value_type> elements;
+elements.push_back(std::make_pair(TestGrid::ClusterCenter(0.5, 0.5), 0));
+elements.push_back(std::make_pair(TestGrid::ClusterCenter(2.5, 1.5), 21));
+elements.push_back(std::make_pair(TestGrid::ClusterCenter(1.5, 1.5), 11));
+elements.push_back(std::make_pair(TestGrid::ClusterCenter(0.2, 0.7), 100));
+elements.push_back(std::make_pair(TestGrid::ClusterCenter(5.5, 5.5), 55));
+elements.push_back(std::make_pair(TestGrid::ClusterCenter(-0.5, 1.5), -9));
+
+START_SECTION((FlatHashGrid(const ClusterCenter& cell_dimension, const std::vector<value_type>& elements)))
+{
+  TestGrid t(cell_dimension, elements);
+  TEST_EQUAL(t.size(), 6)
+  TEST_EQUAL(t.empty(), false)
+  TEST_EQUAL(t.cellCount(), 5)
+  TEST_EQUAL(t.getCellDimension(), cell_dimension)
+
+  // cells are sorted by index
+  TEST_EQUAL(t.cellIndex(0)[0], -1)
+  TEST_EQUAL(t.cellIndex(0)[1], 1)
+  TEST_EQUAL(t.cellIndex(4)[0], 5)
+
+  // contents of a cell are contiguous and keep the input order
+  TestGrid::Range r = t.cell(TestGrid::CellIndex(0, 0));
+  TEST_EQUAL(r.size(), 2)
+  TEST_EQUAL(r.begin()->second, 0)
+  TEST_EQUAL((r.begin() + 1)->second, 100)
+
+  TestGrid empty(cell_dimension, std::vector<TestGrid::value_type>());
+  TEST_EQUAL(empty.size(), 0)
+  TEST_EQUAL(empty.empty(), true)
+  TEST_EQUAL(empty.cellCount(), 0)
+  TEST_EQUAL(empty.cell(TestGrid::CellIndex(0, 0)).empty(), true)
+
+  std::vector<TestGrid::value_type> out_of_range(1, std::make_pair(TestGrid::ClusterCenter(0, (double)std::numeric_limits<Int64>::max() + 1e5), 0));
+  TEST_EXCEPTION(Exception::OutOfRange, TestGrid(cell_dimension, out_of_range))
+}
+END_SECTION
+
+START_SECTION((explicit FlatHashGrid(const HashGrid<Value>& grid)))
+{
+  TestHashGrid hash_grid(cell_dimension);
+  for (Size i = 0; i < elements.size(); ++i)
+  {
+    hash_grid.insert(elements[i]);
+  }
+  TestGrid t(hash_grid);
+  TEST_EQUAL(t.size(), hash_grid.size())
+  TEST_EQUAL(t.cellCount(), 5)
+
+  // same iteration order as the hash grid
+  TestHashGrid::const_iterator hash_it = hash_grid.begin();
+  for (TestGrid::const_iterator it = t.begin(); it != t.end(); ++it, ++hash_it)
+  {
+    TEST_EQUAL(it->second, hash_it->second)
+    TEST_EQUAL(it->first, hash_it->first)
+  }
+  TEST_EQUAL(hash_it == hash_grid.end(), true)
+}
+END_SECTION
+
+TestGrid grid(cell_dimension, elements);
+
+START_SECTION((Size findCell(const CellIndex& index) const))
+{
+  for (Size cell = 0; cell < grid.cellCount(); ++cell)
+  {
+    TEST_EQUAL(grid.findCell(grid.cellIndex(cell)), cell)
+  }
+  TEST_EQUAL(grid.findCell(TestGrid::CellIndex(3, 3)), TestGrid::NPOS)
+  TEST_EQUAL(grid.findCell(TestGrid::CellIndex(1, 0)), TestGrid::NPOS)
+}
+END_SECTION
+
+START_SECTION((Range cellContents(Size cell) const))
+{
+  Size total = 0;
+  for (Size cell = 0; cell < grid.cellCount(); ++cell)
+  {
+    TestGrid::Range r = grid.cellContents(cell);
+    for (TestGrid::const_iterator it = r.begin(); it != r.end(); ++it)
+    {
+      TEST_EQUAL(grid.cellIndexAt(it->first) == grid.cellIndex(cell), true)
+    }
+    total += r.size();
+  }
+  TEST_EQUAL(total, grid.size())
+}
+END_SECTION
+
+START_SECTION((Size neighbourhood(const CellIndex& index, Range* ranges) const))
+{
+  TestGrid::Range ranges[TestGrid::NEIGHBOURHOOD_SIZE];
+
+  // cells (-1, 1), (0, 0), (1, 1) around (0, 1); (2, 1) is too far
+  Size n = grid.neighbourhood(TestGrid::CellIndex(0, 1), ranges);
+  TEST_EQUAL(n, 3)
+  TEST_EQUAL(ranges[0].begin()->second, -9)
+  TEST_EQUAL(ranges[1].size(), 2)
+  TEST_EQUAL(ranges[2].begin()->second, 11)
+
+  n = grid.neighbourhood(TestGrid::CellIndex(5, 5), ranges);
+  TEST_EQUAL(n, 1)
+  TEST_EQUAL(ranges[0].begin()->second, 55)
+
+  n = grid.neighbourhood(TestGrid::CellIndex(10, 10), ranges);
+  TEST_EQUAL(n, 0)
+}
+END_SECTION
+
+START_SECTION((void neighbourhoods(const std::vector<CellIndex>& indices, std::vector<Range>& ranges, std::vector<Size>& offsets) const))
+{
+  std::vector<TestGrid::CellIndex> indices;
+  indices.push_back(TestGrid::CellIndex(0, 1));
+  indices.push_back(TestGrid::CellIndex(10, 10));
+  indices.push_back(TestGrid::CellIndex(2, 2));
+  std::vector<TestGrid::Range> ranges;
+  std::vector<Size> offsets;
+  grid.neighbourhoods(indices, ranges, offsets);
+  TEST_EQUAL(offsets.size(), 4)
+  TEST_EQUAL(offsets[0], 0)
+  TEST_EQUAL(offsets[1], 3)
+  TEST_EQUAL(offsets[2], 3)
+  TEST_EQUAL(offsets[3], 5)
+  TEST_EQUAL(ranges.size(), 5)
+  // neighbourhood of (2, 2): (1, 1) and (2, 1)
+  TEST_EQUAL(ranges[3].begin()->second, 11)
+  TEST_EQUAL(ranges[4].begin()->second, 21)
+}
+END_SECTION
+
+START_SECTION((CellIndex cellIndexAt(const ClusterCenter& center) const))
+{
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter(0.5, 1.5)) == TestGrid::CellIndex(0, 1), true)
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter(-0.5, -1.5)) == TestGrid::CellIndex(-1, -2), true)
+  TEST_EXCEPTION(Exception::OutOfRange, grid.cellIndexAt(TestGrid::ClusterCenter(-1e19, 0)))
+  TEST_EXCEPTION(Exception::OutOfRange, grid.cellIndexAt(TestGrid::ClusterCenter(0, 1e19)))
+  TEST_EXCEPTION(Exception::OutOfRange, grid.cellIndexAt(TestGrid::ClusterCenter(std::numeric_limits<double>::quiet_NaN(), 0)))
+
+  // with unit cells: 2^63 does not fit into Int64 (its maximum is converted to exactly this double), -2^63 does
+  TEST_EXCEPTION(Exception::OutOfRange, grid.cellIndexAt(TestGrid::ClusterCenter((double)std::numeric_limits<Int64>::max(), 0)))
+  TEST_EQUAL(grid.cellIndexAt(TestGrid::ClusterCenter((double)std::numeric_limits<Int64>::min(), 0))[0], std::numeric_limits<Int64>::min())
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,335 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+///////////////////////////
+
+#include <OpenMS/ANALYSIS/RNPXL/HyperScore.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(FragmentIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+FragmentIndex* ptr = nullptr;
+FragmentIndex* null_ptr = nullptr;
+START_SECTION(FragmentIndex(double bin_size = 0.05))
+{
+  ptr = new FragmentIndex();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_REAL_SIMILAR(ptr->getBinSize(), 0.05)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->isFinalized(), false)
+  TEST_EXCEPTION(Exception::InvalidParameter, FragmentIndex(0.0))
+}
+END_SECTION
+
+START_SECTION(~FragmentIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+// theoretical spectra as generated in the SimpleSearchEngineAlgorithm
+TheoreticalSpectrumGenerator tsg;
+Param tsg_param(tsg.getParameters());
+tsg_param.setValue("add_first_prefix_ion", "true");
+tsg_param.setValue("add_metainfo", "true");
+tsg.setParameters(tsg_param);
+
+vector<String> sequences = {"PEPTIDEK", "ELVISLIVESK", "SAMPLER", "PEPTIDER"};
+vector<MSSpectrum> theo_spectra(sequences.size());
+for (Size i = 0; i < sequences.size(); ++i)
+{
+  tsg.getSpectrum(theo_spectra[i], AASequence::fromString(sequences[i]), 1, 1);
+  theo_spectra[i].sortByPosition();
+}
+
+FragmentIndex fi(0.02);
+
+START_SECTION(Size addSequence(const String& sequence))
+{
+  for (Size i = 0; i < sequences.size(); ++i)
+  {
+    TEST_EQUAL(fi.addSequence(sequences[i]), i)
+  }
+  TEST_EQUAL(fi.getSequences().size(), 4)
+  TEST_EQUAL(fi.getSequences()[1], "ELVISLIVESK")
+}
+END_SECTION
+
+START_SECTION(void addPeptide(Size sequence_index, Size modification_index, double mass, const MSSpectrum& theoretical_spectrum))
+{
+  for (Size i = 0; i < sequences.size(); ++i)
+  {
+    fi.addPeptide(i, 0, AASequence::fromString(sequences[i]).getMonoWeight(), theo_spectra[i]);
+  }
+  TEST_EQUAL(fi.size(), 4)
+}
+END_SECTION
+
+START_SECTION(void finalize())
+{
+  fi.finalize();
+  TEST_EQUAL(fi.isFinalized(), true)
+  // sorted by mass
+  const vector<FragmentIndex::Peptide>& peptides = fi.getPeptides();
+  for (Size i = 1; i < peptides.size(); ++i)
+  {
+    TEST_EQUAL(peptides[i - 1].mass <= peptides[i].mass, true)
+  }
+  TEST_EQUAL(fi.getSequences()[peptides[0].sequence_index], "SAMPLER")
+  TEST_EQUAL(fi.getSequences()[peptides[3].sequence_index], "ELVISLIVESK")
+  TEST_EXCEPTION(Exception::IllegalArgument, fi.addPeptide(0, 1, 100.0, theo_spectra[0]))
+}
+END_SECTION
+
+START_SECTION((std::pair<Size, Size> getPeptideRange(double min_mass, double max_mass) const))
+{
+  const vector<FragmentIndex::Peptide>& peptides = fi.getPeptides();
+  pair<Size, Size> r = fi.getPeptideRange(0.0, 1e6);
+  TEST_EQUAL(r.first, 0)
+  TEST_EQUAL(r.second, 4)
+  r = fi.getPeptideRange(peptides[1].mass, peptides[2].mass);
+  TEST_EQUAL(r.first, 1)
+  TEST_EQUAL(r.second, 3)
+  r = fi.getPeptideRange(peptides[3].mass + 1.0, 1e6);
+  TEST_EQUAL(r.first, r.second)
+}
+END_SECTION
+
+START_SECTION(void getTheoreticalSpectrum(Size peptide_index, MSSpectrum& spectrum) const)
+{
+  // the reconstructed spectrum scores like the original one
+  MSSpectrum exp_spectrum = theo_spectra[2];
+  for (Size p = 0; p < fi.size(); ++p)
+  {
+    const FragmentIndex::Peptide& peptide = fi.getPeptides()[p];
+    MSSpectrum theo;
+    fi.getTheoreticalSpectrum(p, theo);
+    TEST_EQUAL(theo.size(), theo_spectra[peptide.sequence_index].size())
+    TEST_EQUAL(theo.getStringDataArrays().size(), 1)
+    TEST_EQUAL(theo.getStringDataArrays()[0].size(), theo.size())
+    TEST_REAL_SIMILAR(HyperScore::compute(10.0, true, exp_spectrum, theo), HyperScore::compute(10.0, true, exp_spectrum, theo_spectra[peptide.sequence_index]))
+  }
+}
+END_SECTION
+
+START_SECTION(void query(const MSSpectrum& spectrum, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, Size peptide_begin, Size peptide_end, Size min_shared_fragments, std::vector<Size>& candidates) const)
+{
+  // query with the fragments of PEPTIDEK
+  MSSpectrum exp_spectrum = theo_spectra[0];
+  Size pepk_index = 0;
+  for (Size p = 0; p < fi.size(); ++p)
+  {
+    if (fi.getPeptides()[p].sequence_index == 0) pepk_index = p;
+  }
+
+  vector<Size> candidates;
+  fi.query(exp_spectrum, 10.0, true, 0, fi.size(), exp_spectrum.size(), candidates);
+  ABORT_IF(candidates.size() != 1)
+  TEST_EQUAL(candidates[0], pepk_index)
+
+  // PEPTIDER shares the b ions
+  candidates.clear();
+  fi.query(exp_spectrum, 10.0, true, 0, fi.size(), 3, candidates);
+  TEST_EQUAL(candidates.size(), 2)
+  for (Size c : candidates)
+  {
+    TEST_EQUAL(fi.getSequences()[fi.getPeptides()[c].sequence_index].hasPrefix("PEPTIDE"), true)
+  }
+
+  // restricted to a peptide range without PEPTIDEK
+  candidates.clear();
+  fi.query(exp_spectrum, 0.02, false, pepk_index + 1, fi.size(), 1, candidates);
+  for (Size c : candidates)
+  {
+    TEST_EQUAL(c > pepk_index, true)
+  }
+
+  // not finalized
+  FragmentIndex empty_index;
+  TEST_EXCEPTION(Exception::IllegalArgument, empty_index.query(exp_spectrum, 10.0, true, 0, 1, 1, candidates))
+}
+END_SECTION
+
+START_SECTION(void setSettings(const String& settings))
+{
+  fi.setSettings("enzyme=Trypsin");
+  TEST_EQUAL(fi.getSettings(), "enzyme=Trypsin")
+}
+END_SECTION
+
+START_SECTION(const String& getSettings() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename) const)
+{
+  FragmentIndex not_finalized;
+  TEST_EXCEPTION(Exception::IllegalArgument, not_finalized.store("dummy"))
+  NOT_TESTABLE // tested with load
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  fi.store(filename);
+
+  FragmentIndex loaded(1.0);
+  loaded.load(filename);
+  TEST_EQUAL(loaded.isFinalized(), true)
+  TEST_REAL_SIMILAR(loaded.getBinSize(), 0.02)
+  TEST_EQUAL(loaded.getSettings(), "enzyme=Trypsin")
+  TEST_EQUAL(loaded.getSequences() == fi.getSequences(), true)
+  ABORT_IF(loaded.size() != fi.size())
+  for (Size p = 0; p < fi.size(); ++p)
+  {
+    TEST_EQUAL(loaded.getPeptides()[p].sequence_index, fi.getPeptides()[p].sequence_index)
+    TEST_REAL_SIMILAR(loaded.getPeptides()[p].mass, fi.getPeptides()[p].mass)
+  }
+
+  vector<Size> candidates, loaded_candidates;
+  fi.query(theo_spectra[1], 10.0, true, 0, fi.size(), 2, candidates);
+  loaded.query(theo_spectra[1], 10.0, true, 0, loaded.size(), 2, loaded_candidates);
+  TEST_EQUAL(loaded_candidates == candidates, true)
+
+  // a failed load drops the previously loaded index
+  TEST_EXCEPTION(Exception::FileNotFound, loaded.load("this_file_does_not_exist.idx"))
+  TEST_EQUAL(loaded.isFinalized(), false)
+  TEST_EQUAL(loaded.size(), 0)
+  loaded.load(filename);
+  TEST_EQUAL(loaded.isFinalized(), true)
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(OPENMS_GET_TEST_DATA_PATH("PeakPickerHiRes_orbitrap.mzML")))
+  TEST_EQUAL(loaded.isFinalized(), false)
+  TEST_EQUAL(loaded.getSequences().empty(), true)
+  loaded.load(filename);
+
+  // modified copies of the stored index
+  String content;
+  {
+    ifstream ifs(filename.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+  String copy_filename;
+  NEW_TMP_FILE(copy_filename)
+  auto writeCopy = [&copy_filename](const String& data)
+  {
+    ofstream ofs(copy_filename.c_str(), std::ios::binary);
+    ofs.write(data.data(), data.size());
+    return copy_filename;
+  };
+
+  // file of another version
+  String wrong_version = content;
+  int version = 0;
+  memcpy(&version, &wrong_version[sizeof(int)], sizeof(int));
+  ++version;
+  memcpy(&wrong_version[sizeof(int)], &version, sizeof(int));
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(writeCopy(wrong_version)))
+  TEST_EQUAL(loaded.isFinalized(), false)
+
+  // truncated file
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(writeCopy(content.substr(0, content.size() / 2))))
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(writeCopy(content.substr(0, content.size() - 1))))
+
+  // corrupt lengths must not be allocated (settings length and number of sequences)
+  const Size huge = std::numeric_limits<Size>::max() / 2;
+  const Size settings_length_pos = 2 * sizeof(int) + sizeof(double);
+  String corrupt_settings = content;
+  memcpy(&corrupt_settings[settings_length_pos], &huge, sizeof(Size));
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(writeCopy(corrupt_settings)))
+
+  const Size n_sequences_pos = settings_length_pos + sizeof(Size) + String("enzyme=Trypsin").size();
+  String corrupt_count = content;
+  memcpy(&corrupt_count[n_sequences_pos], &huge, sizeof(Size));
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(writeCopy(corrupt_count)))
+
+  // the unmodified copy still loads
+  loaded.load(writeCopy(content));
+  TEST_EQUAL(loaded.size(), fi.size())
+}
+END_SECTION
+
+START_SECTION(double getBinSize() const)
+{
+  TEST_REAL_SIMILAR(fi.getBinSize(), 0.02)
+}
+END_SECTION
+
+START_SECTION(bool isFinalized() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  TEST_EQUAL(fi.size(), 4)
+}
+END_SECTION
+
+START_SECTION(const std::vector<String>& getSequences() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<Peptide>& getPeptides() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -41,6 +41,22 @@
 
 ///////////////////////////
 
+#include <cmath>
+
+// exposes the point-wise integration, which is the reference for the convolution of equally spaced data
+class GaussFilterAlgorithmReference :
+  public OpenMS::GaussFilterAlgorithm
+{
+public:
+  using GaussFilterAlgorithm::isEquallySpaced_;
+
+  template <typename InputPeakIterator>
+  double integrate(InputPeakIterator x, InputPeakIterator y, InputPeakIterator first, InputPeakIterator last)
+  {
+    return integrate_(x, y, first, last);
+  }
+};
+
 START_TEST(GaussFilterAlgorithm<D>, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -187,6 +203,47 @@ START_SECTION((bool filter(OpenMS::Interfaces::ChromatogramPtr chromatogram)))
   TEST_REAL_SIMILAR(chromatogram->getIntensityArray()->data[8],0.000881793)
 END_SECTION 
 
+START_SECTION(([EXTRA] filtering equally spaced data agrees with the point-wise integration))
+{
+  // gaussian width, kernel spacing, data start, data spacing
+  const double settings[][4] = { {0.2, 0.01, 400.0, 0.01}, {0.05, 0.001, 1500.0, 0.0007}, {1.0, 0.01, 10.0, 0.1}, {0.3, 0.005, 800.0, 0.05} };
+  TOLERANCE_RELATIVE(1.0 + 1e-9)
+  TOLERANCE_ABSOLUTE(1e-9)
+  for (const auto& setting : settings)
+  {
+    const Size n = 250;
+    std::vector<double> mz(n), intensities(n), mz_out(n), intensities_out(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      mz[i] = setting[2] + setting[3] * i;
+      intensities[i] = (i % 11 == 0) ? 0.0 : 500.0 * (1.0 + std::sin(0.1 * i)) + (i % 7);
+    }
+    TEST_EQUAL(GaussFilterAlgorithmReference::isEquallySpaced_(mz.begin(), mz.end()), true)
+
+    GaussFilterAlgorithmReference gauss;
+    gauss.initialize(setting[0], setting[1], 10.0, false);
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    for (Size i = 0; i < n; ++i)
+    {
+      TEST_EQUAL(mz_out[i], mz[i])
+      TEST_REAL_SIMILAR(intensities_out[i], gauss.integrate(mz.begin() + i, intensities.begin() + i, mz.begin(), mz.end()))
+    }
+
+    // data that is only close to equally spaced is integrated point-wise
+    for (Size i = 1; i < n; i += 2)
+    {
+      mz[i] += setting[3] * 1e-6;
+    }
+    TEST_EQUAL(GaussFilterAlgorithmReference::isEquallySpaced_(mz.begin(), mz.end()), false)
+    gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin());
+    for (Size i = 0; i < n; ++i)
+    {
+      TEST_EQUAL(intensities_out[i], gauss.integrate(mz.begin() + i, intensities.begin() + i, mz.begin(), mz.end()))
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -197,6 +197,81 @@ START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<P
 
 END_SECTION
 
+START_SECTION(([EXTRA] filterExperiment gives the same result as filtering each spectrum and chromatogram))
+{
+  // equally spaced (convolution with a shared kernel) and irregularly spaced (point-wise integration) data
+  PeakMap exp;
+  for (Size s = 0; s < 40; ++s)
+  {
+    MSSpectrum spec;
+    spec.setRT(s + 1.0);
+    for (Size i = 0; i < 200; ++i)
+    {
+      double mz = (s % 2 == 0) ? 400.0 + 0.01 * i : 400.0 + 0.01 * i + 0.0001 * i * i;
+      spec.push_back(Peak1D(mz, (float)(100.0 * std::exp(-0.5 * std::pow((i - 100.0 + s) / 8.0, 2)) + (i % 7))));
+    }
+    exp.addSpectrum(spec);
+  }
+  MSChromatogram chrom;
+  for (Size i = 0; i < 100; ++i)
+  {
+    chrom.push_back(ChromatogramPeak(10.0 + 0.02 * i, (double)(i % 13) * (i < 50 ? 2.0 : 1.0)));
+  }
+  exp.addChromatogram(chrom);
+
+  GaussFilter gauss;
+  Param param;
+  param.setValue("gaussian_width", 0.1);
+  gauss.setParameters(param);
+
+  PeakMap expected = exp;
+  for (Size s = 0; s < expected.size(); ++s)
+  {
+    gauss.filter(expected[s]);
+  }
+  gauss.filter(expected.getChromatogram(0));
+
+  gauss.filterExperiment(exp);
+
+  for (Size s = 0; s < expected.size(); ++s)
+  {
+    ABORT_IF(exp[s].size() != expected[s].size())
+    for (Size i = 0; i < expected[s].size(); ++i)
+    {
+      TEST_EQUAL(exp[s][i].getIntensity(), expected[s][i].getIntensity())
+    }
+  }
+  for (Size i = 0; i < chrom.size(); ++i)
+  {
+    TEST_EQUAL(exp.getChromatogram(0)[i].getIntensity(), expected.getChromatogram(0)[i].getIntensity())
+  }
+}
+END_SECTION
+
+START_SECTION(([EXTRA] smoothing equally spaced data agrees with irregularly spaced data))
+{
+  // a tiny distortion of the spacing disables the shared kernel but should not change the result
+  MSSpectrum regular, irregular;
+  for (Size i = 0; i < 300; ++i)
+  {
+    float intensity = (float)(1000.0 * std::exp(-0.5 * std::pow((i - 150.0) / 10.0, 2)));
+    regular.push_back(Peak1D(600.0 + 0.005 * i, intensity));
+    irregular.push_back(Peak1D(600.0 + 0.005 * i + ((i % 2) ? 1e-6 : 0.0), intensity));
+  }
+  GaussFilter gauss;
+  Param param;
+  param.setValue("gaussian_width", 0.05);
+  gauss.setParameters(param);
+  gauss.filter(regular);
+  gauss.filter(irregular);
+  TOLERANCE_ABSOLUTE(0.05)
+  for (Size i = 0; i < regular.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(regular[i].getIntensity(), irregular[i].getIntensity())
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
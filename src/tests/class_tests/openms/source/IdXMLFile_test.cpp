@@ -42,6 +42,34 @@
 
 ///////////////////////////
 
+using namespace OpenMS;
+
+/// Collects all identifications and the sizes of the peptide batches
+class CollectingConsumer :
+  public Interfaces::IIdentificationConsumer
+{
+public:
+  void consumeProteinIdentification(ProteinIdentification& prot_id) override
+  {
+    // peptides always follow the protein identification of their run
+    peptides_before_protein.push_back(pep_ids.size());
+    prot_ids.push_back(prot_id);
+  }
+
+  void consumePeptideIdentifications(std::vector<PeptideIdentification>& ids) override
+  {
+    batch_sizes.push_back(ids.size());
+    pep_ids.insert(pep_ids.end(), ids.begin(), ids.end());
+  }
+
+  std::vector<ProteinIdentification> prot_ids;
+  std::vector<PeptideIdentification> pep_ids;
+  std::vector<Size> batch_sizes;
+  std::vector<Size> peptides_before_protein;
+};
+
+///////////////////////////
+
 START_TEST(IdXMLFile, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -223,6 +251,40 @@ START_SECTION(void store(String filename, const std::vector<ProteinIdentificatio
   TEST_EQUAL(result, true);
 END_SECTION
 
+START_SECTION(void transform(const String& filename, Interfaces::IIdentificationConsumer* consumer, Size batch_size = 1000))
+{
+  std::vector<ProteinIdentification> protein_ids;
+  std::vector<PeptideIdentification> peptide_ids;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+
+  IdXMLFile f;
+  CollectingConsumer consumer;
+  f.transform(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &consumer, 2);
+  TEST_EQUAL(consumer.prot_ids.size(), protein_ids.size())
+  TEST_EQUAL(consumer.prot_ids == protein_ids, true)
+  TEST_EQUAL(consumer.pep_ids.size(), peptide_ids.size())
+  TEST_EQUAL(consumer.pep_ids == peptide_ids, true)
+  for (Size batch_size : consumer.batch_sizes)
+  {
+    TEST_EQUAL(batch_size > 0 && batch_size <= 2, true)
+  }
+  TEST_EQUAL(consumer.peptides_before_protein.front(), 0)
+
+  // file without protein hits: an empty protein identification is created for the run
+  CollectingConsumer consumer2;
+  f.transform(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_no_proteinhits.idXML"), &consumer2);
+  TEST_EQUAL(consumer2.prot_ids.size(), 1)
+  TEST_EQUAL(consumer2.pep_ids.size(), 10)
+  TEST_EQUAL(consumer2.batch_sizes.size(), 1)
+
+  // loading still works after streaming with the same instance
+  f.load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), protein_ids, peptide_ids);
+  TEST_EQUAL(peptide_ids.size(), consumer.pep_ids.size())
+
+  TEST_EXCEPTION(Exception::IllegalArgument, f.transform(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), &consumer, 0))
+  TEST_EXCEPTION(Exception::FileNotFound, f.transform("dummy/dummy.idXML", &consumer))
+}
+END_SECTION
 
 START_SECTION([EXTRA] static bool isValid(const String& filename))
   std::vector<ProteinIdentification> protein_ids, protein_ids2;
@@ -280,6 +280,51 @@ START_SECTION(( void getMSChromatogramByNativeId(std::string id, OpenMS::MSChrom
 }
 END_SECTION
 
+START_SECTION(( void setMemoryMapping(bool use_mmap) ))
+{
+  IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  IndexedMzMLHandler file_mmap;
+  TEST_EQUAL(file_mmap.getMemoryMapping(), false)
+  file_mmap.setMemoryMapping(true);
+  TEST_EQUAL(file_mmap.getMemoryMapping(), true)
+  file_mmap.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  TEST_EQUAL(file_mmap.getParsingSuccess(), true)
+
+  ABORT_IF(file_mmap.getNrSpectra() != 2)
+  TEST_EQUAL(file.getSpectrumById(0)->getMZArray()->data == file_mmap.getSpectrumById(0)->getMZArray()->data, true)
+  TEST_EQUAL(file.getSpectrumById(1)->getIntensityArray()->data == file_mmap.getSpectrumById(1)->getIntensityArray()->data, true)
+  ABORT_IF(file_mmap.getNrChromatograms() != 1)
+  TEST_EQUAL(file.getChromatogramById(0)->getTimeArray()->data == file_mmap.getChromatogramById(0)->getTimeArray()->data, true)
+  TEST_EQUAL(file.getMSSpectrumById(1) == file_mmap.getMSSpectrumById(1), true)
+
+  // copies share the mapping
+  IndexedMzMLHandler file_mmap2(file_mmap);
+  TEST_EQUAL(file_mmap2.getMemoryMapping(), true)
+  TEST_EQUAL(file_mmap2.getMSChromatogramById(0) == file.getMSChromatogramById(0), true)
+
+  // switch an already opened file to memory-mapped access and back
+  file.setMemoryMapping(true);
+  TEST_EQUAL(file.getMSSpectrumById(0) == file_mmap.getMSSpectrumById(0), true)
+  file.setMemoryMapping(false);
+  TEST_EQUAL(file.getMSSpectrumById(0) == file_mmap.getMSSpectrumById(0), true)
+
+  TEST_EXCEPTION(Exception::IllegalArgument, file_mmap.getSpectrumById(-1));
+  TEST_EXCEPTION(Exception::IllegalArgument, file_mmap.getSpectrumById(file_mmap.getNrSpectra() + 1));
+
+  // concurrent access to the same object
+  std::vector<Size> sizes(20);
+#pragma omp parallel for
+  for (SignedSize k = 0; k < (SignedSize)sizes.size(); ++k)
+  {
+    sizes[k] = file_mmap.getMSSpectrumById(int(k % 2)).size();
+  }
+  for (Size k = 0; k < sizes.size(); ++k)
+  {
+    TEST_EQUAL(sizes[k], file.getMSSpectrumById(int(k % 2)).size())
+  }
+}
+END_SECTION
+
 START_SECTION(([EXTRA] load broken file))
 {
 
@@ -40,6 +40,10 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 ///////////////////////////
 #include <OpenMS/ANALYSIS/OPENSWATH/MRMFeatureFinderScoring.h>
 
@@ -319,6 +323,72 @@ START_SECTION(void pickExperiment(OpenSwath::SpectrumAccessPtr input, FeatureMap
 }
 END_SECTION
 
+START_SECTION([EXTRA] void pickExperiment(...) gives the same output for any number of threads)
+{
+  // Load the chromatograms (mzML) and the meta-information (TraML)
+  boost::shared_ptr<PeakMap> exp (new PeakMap);
+  boost::shared_ptr<PeakMap> swath_map (new PeakMap);
+  OpenSwath::LightTargetedExperiment transitions;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.mzML"), *exp);
+  {
+    TargetedExperiment transition_exp_;
+    TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_identification_input.TraML"), transition_exp_);
+    OpenSwathDataAccessHelper::convertTargetedExp(transition_exp_, transitions);
+  }
+  OpenSwath::SpectrumAccessPtr chromatogram_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+  std::vector< OpenSwath::SwathMap > swath_maps(1);
+  swath_maps[0].sptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_map);
+
+  Param ff_param = MRMFeatureFinderScoring().getDefaults();
+  Param scores_to_use;
+  scores_to_use.setValue("use_uis_scores", "true", "Use UIS scores for peptidoform identification ", ListUtils::create<String>("advanced"));
+  scores_to_use.setValidStrings("use_uis_scores", ListUtils::create<String>("true,false"));
+  ff_param.insert("Scores:", scores_to_use);
+  ff_param.setValue("TransitionGroupPicker:PeakPickerMRM:method", "legacy");
+  ff_param.setValue("TransitionGroupPicker:PeakPickerMRM:peak_width", 40.0);
+
+  auto pick = [&](int threads, FeatureMap& output)
+  {
+#ifdef _OPENMP
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(threads);
+#endif
+    MRMFeatureFinderScoring ff;
+    ff.setParameters(ff_param);
+    TransformationDescription trafo;
+    TransitionGroupMapType transition_group_map;
+    ff.pickExperiment(chromatogram_ptr, output, transitions, trafo, swath_maps, transition_group_map);
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+    (void)threads;
+  };
+
+  FeatureMap serial, parallel;
+  pick(1, serial);
+  pick(4, parallel);
+
+  // features are in the same order with the same values (unique ids are random)
+  TEST_EQUAL(serial.size(), 3)
+  ABORT_IF(serial.size() != parallel.size())
+  for (Size i = 0; i < serial.size(); ++i)
+  {
+    TEST_EQUAL(serial[i].getRT(), parallel[i].getRT())
+    TEST_EQUAL(serial[i].getMZ(), parallel[i].getMZ())
+    TEST_EQUAL(serial[i].getIntensity(), parallel[i].getIntensity())
+    TEST_EQUAL(serial[i].getSubordinates().size(), parallel[i].getSubordinates().size())
+    std::vector<String> keys, parallel_keys;
+    serial[i].getKeys(keys);
+    parallel[i].getKeys(parallel_keys);
+    TEST_EQUAL(keys == parallel_keys, true)
+    for (const String& key : keys)
+    {
+      TEST_STRING_EQUAL(serial[i].getMetaValue(key).toString(), parallel[i].getMetaValue(key).toString())
+    }
+  }
+}
+END_SECTION
+
 START_SECTION(void mapExperimentToTransitionList(OpenSwath::SpectrumAccessPtr input, OpenSwath::LightTargetedExperiment &transition_exp, TransitionGroupMapType &transition_group_map, TransformationDescription trafo, double rt_extraction_window))
 {
   MRMFeatureFinderScoring ff;
@@ -0,0 +1,310 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/MSSpectrumSoA.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MSSpectrumSoA, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MSSpectrum spec;
+for (double mz : {412.0, 412.5, 413.0, 415.0, 419.5, 423.0, 431.25})
+{
+  spec.push_back(Peak1D(mz, static_cast<float>(mz - 400.0)));
+}
+spec.setRT(12.3);
+
+MSSpectrumSoA* ptr = nullptr;
+MSSpectrumSoA* null_ptr = nullptr;
+START_SECTION(MSSpectrumSoA())
+{
+  ptr = new MSSpectrumSoA();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+}
+END_SECTION
+
+START_SECTION(~MSSpectrumSoA())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit MSSpectrumSoA(const MSSpectrum& spectrum))
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.size(), spec.size())
+  TEST_EQUAL(soa.getMZArray().size(), spec.size())
+  TEST_EQUAL(soa.getIntensityArray().size(), spec.size())
+  for (Size i = 0; i < spec.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(soa.getMZ(i), spec[i].getMZ())
+    TEST_REAL_SIMILAR(soa.getIntensity(i), spec[i].getIntensity())
+  }
+}
+END_SECTION
+
+START_SECTION(MSSpectrumSoA(const MSSpectrumSoA& source))
+{
+  MSSpectrumSoA soa(spec);
+  MSSpectrumSoA copy(soa);
+  TEST_EQUAL(copy == soa, true)
+}
+END_SECTION
+
+START_SECTION(MSSpectrumSoA(MSSpectrumSoA&& source))
+{
+  MSSpectrumSoA soa(spec);
+  const double* mz_data = soa.getMZArray().data();
+  MSSpectrumSoA moved(std::move(soa));
+  TEST_EQUAL(moved.size(), spec.size())
+  TEST_EQUAL(moved.getMZArray().data() == mz_data, true)
+}
+END_SECTION
+
+START_SECTION(MSSpectrumSoA& operator=(const MSSpectrumSoA& source))
+{
+  MSSpectrumSoA soa(spec), copy;
+  copy = soa;
+  TEST_EQUAL(copy == soa, true)
+}
+END_SECTION
+
+START_SECTION(MSSpectrumSoA& operator=(MSSpectrumSoA&& source))
+{
+  MSSpectrumSoA soa(spec), moved;
+  moved = std::move(soa);
+  TEST_EQUAL(moved.size(), spec.size())
+}
+END_SECTION
+
+START_SECTION(bool operator==(const MSSpectrumSoA& rhs) const)
+{
+  MSSpectrumSoA a(spec), b(spec);
+  TEST_EQUAL(a == b, true)
+  b.getIntensityArray()[0] = 100.0;
+  TEST_EQUAL(a == b, false)
+}
+END_SECTION
+
+START_SECTION(bool operator!=(const MSSpectrumSoA& rhs) const)
+{
+  MSSpectrumSoA a(spec), b;
+  TEST_EQUAL(a != b, true)
+  b = a;
+  TEST_EQUAL(a != b, false)
+}
+END_SECTION
+
+START_SECTION(void assign(const MSSpectrum& spectrum))
+{
+  MSSpectrumSoA soa;
+  soa.push_back(1.0, 1.0);
+  soa.assign(spec);
+  TEST_EQUAL(soa == MSSpectrumSoA(spec), true)
+}
+END_SECTION
+
+START_SECTION(void toMSSpectrum(MSSpectrum& spectrum) const)
+{
+  MSSpectrumSoA soa(spec);
+  soa.getIntensityArray()[1] = 42.0;
+  MSSpectrum out = spec;
+  out.push_back(Peak1D(500.0, 1.0f));
+  soa.toMSSpectrum(out);
+  TEST_EQUAL(out.size(), spec.size())
+  TEST_REAL_SIMILAR(out[1].getIntensity(), 42.0)
+  TEST_REAL_SIMILAR(out[6].getMZ(), 431.25)
+  TEST_REAL_SIMILAR(out.getRT(), 12.3) // metadata is kept
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  MSSpectrumSoA soa(spec);
+  soa.clear();
+  TEST_EQUAL(soa.empty(), true)
+  TEST_EQUAL(soa.getIntensityArray().empty(), true)
+}
+END_SECTION
+
+START_SECTION(void reserve(Size n))
+{
+  MSSpectrumSoA soa;
+  soa.reserve(100);
+  TEST_EQUAL(soa.getMZArray().capacity() >= 100, true)
+  TEST_EQUAL(soa.getIntensityArray().capacity() >= 100, true)
+}
+END_SECTION
+
+START_SECTION(void push_back(CoordinateType mz, IntensityType intensity))
+{
+  MSSpectrumSoA soa;
+  soa.push_back(100.0, 2.0);
+  TEST_EQUAL(soa.size(), 1)
+  TEST_REAL_SIMILAR(soa.getMZ(0), 100.0)
+  TEST_REAL_SIMILAR(soa.getIntensity(0), 2.0)
+}
+END_SECTION
+
+START_SECTION(bool isSorted() const)
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.isSorted(), true)
+  soa.push_back(100.0, 1.0);
+  TEST_EQUAL(soa.isSorted(), false)
+}
+END_SECTION
+
+START_SECTION(void sortByPosition())
+{
+  MSSpectrumSoA soa;
+  soa.push_back(300.0, 3.0);
+  soa.push_back(100.0, 1.0);
+  soa.push_back(200.0, 2.0);
+  soa.sortByPosition();
+  TEST_EQUAL(soa.isSorted(), true)
+  for (Size i = 0; i < soa.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(soa.getMZ(i), 100.0 * (i + 1))
+    TEST_REAL_SIMILAR(soa.getIntensity(i), i + 1.0)
+  }
+}
+END_SECTION
+
+START_SECTION(Size MZBegin(CoordinateType mz) const)
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.MZBegin(400.0), 0)
+  TEST_EQUAL(soa.MZBegin(413.0), 2)
+  TEST_EQUAL(soa.MZBegin(414.0), 3)
+  TEST_EQUAL(soa.MZBegin(500.0), 7)
+  TEST_EQUAL(soa.MZBegin(414.0), Size(spec.MZBegin(414.0) - spec.begin()))
+}
+END_SECTION
+
+START_SECTION(Size MZEnd(CoordinateType mz) const)
+{
+  MSSpectrumSoA soa(spec);
+  TEST_EQUAL(soa.MZEnd(400.0), 0)
+  TEST_EQUAL(soa.MZEnd(413.0), 3)
+  TEST_EQUAL(soa.MZEnd(500.0), 7)
+  TEST_EQUAL(soa.MZEnd(413.0), Size(spec.MZEnd(413.0) - spec.begin()))
+}
+END_SECTION
+
+START_SECTION(Size findNearest(CoordinateType mz) const)
+{
+  MSSpectrumSoA soa(spec);
+  // same results as MSSpectrum
+  for (double mz : {400.0, 412.0, 412.2, 412.25, 412.3, 414.0, 417.0, 425.0, 431.25, 500.0})
+  {
+    TEST_EQUAL(soa.findNearest(mz), spec.findNearest(mz))
+  }
+  MSSpectrumSoA empty;
+  TEST_PRECONDITION_VIOLATED(empty.findNearest(412.0))
+}
+END_SECTION
+
+START_SECTION(Int findNearest(CoordinateType mz, CoordinateType tolerance) const)
+{
+  MSSpectrumSoA soa(spec);
+  for (double mz : {400.0, 412.0, 412.2, 414.0, 417.0, 419.0, 425.0, 431.5, 500.0})
+  {
+    TEST_EQUAL(soa.findNearest(mz, 0.5), spec.findNearest(mz, 0.5))
+  }
+  TEST_EQUAL(soa.findNearest(414.0, 0.5), -1)
+  TEST_EQUAL(MSSpectrumSoA().findNearest(414.0, 0.5), -1)
+}
+END_SECTION
+
+START_SECTION(Int findNearest(CoordinateType mz, CoordinateType tolerance_left, CoordinateType tolerance_right) const)
+{
+  MSSpectrumSoA soa(spec);
+  for (double mz : {400.0, 412.0, 412.2, 414.0, 417.0, 419.0, 425.0, 431.5, 500.0})
+  {
+    TEST_EQUAL(soa.findNearest(mz, 0.5, 2.0), spec.findNearest(mz, 0.5, 2.0))
+    TEST_EQUAL(soa.findNearest(mz, 2.0, 0.5), spec.findNearest(mz, 2.0, 0.5))
+  }
+  TEST_EQUAL(MSSpectrumSoA().findNearest(414.0, 0.5, 0.5), -1)
+}
+END_SECTION
+
+START_SECTION(void findNearest(const std::vector<CoordinateType>& mz, CoordinateType tolerance, std::vector<Int>& indices) const)
+{
+  MSSpectrumSoA soa(spec);
+  vector<double> queries = {400.0, 412.0, 412.2, 412.25, 414.0, 417.0, 419.0, 419.6, 425.0, 431.5, 500.0};
+  vector<Int> indices;
+  for (double tolerance : {0.0, 0.1, 0.5, 2.0})
+  {
+    soa.findNearest(queries, tolerance, indices);
+    ABORT_IF(indices.size() != queries.size())
+    for (Size q = 0; q < queries.size(); ++q)
+    {
+      TEST_EQUAL(indices[q], soa.findNearest(queries[q], tolerance))
+    }
+  }
+  MSSpectrumSoA().findNearest(queries, 0.5, indices);
+  TEST_EQUAL(indices.size(), queries.size())
+  TEST_EQUAL(indices[1], -1)
+}
+END_SECTION
+
+START_SECTION(const std::vector<CoordinateType>& getMZArray() const)
+{
+  const MSSpectrumSoA soa(spec);
+  TEST_REAL_SIMILAR(soa.getMZArray()[3], 415.0)
+}
+END_SECTION
+
+START_SECTION(const std::vector<IntensityType>& getIntensityArray() const)
+{
+  const MSSpectrumSoA soa(spec);
+  TEST_REAL_SIMILAR(soa.getIntensityArray()[3], 15.0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
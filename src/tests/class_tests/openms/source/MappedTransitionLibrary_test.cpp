@@ -0,0 +1,439 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinFile.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/MappedTransitionLibrary.h>
+///////////////////////////
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MappedTransitionLibrary, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MappedTransitionLibrary* ptr = nullptr;
+MappedTransitionLibrary* nullPointer = nullptr;
+
+START_SECTION(MappedTransitionLibrary())
+{
+  ptr = new MappedTransitionLibrary();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->isOpen(), false)
+  TEST_EQUAL(ptr->getNrTransitions(), 0)
+  TEST_EQUAL(ptr->getNrCompounds(), 0)
+  TEST_EQUAL(ptr->getNrProteins(), 0)
+}
+END_SECTION
+
+START_SECTION(~MappedTransitionLibrary())
+{
+  delete ptr;
+}
+END_SECTION
+
+// three peptides of two proteins in different precursor windows
+OpenSwath::LightTargetedExperiment library;
+{
+  const char* protein_ids[] = {"PROT_1", "PROT_2"};
+  for (Size i = 0; i < 2; ++i)
+  {
+    OpenSwath::LightProtein prot;
+    prot.id = protein_ids[i];
+    prot.sequence = "SEQUENCE";
+    library.proteins.push_back(prot);
+  }
+
+  const char* compound_ids[] = {"PEP_A/2", "PEP_B/2", "PEP_C/3"};
+  const char* compound_proteins[] = {"PROT_1", "PROT_2", "PROT_1"};
+  const double precursors[] = {500.2, 420.7, 612.3};
+  for (Size i = 0; i < 3; ++i)
+  {
+    OpenSwath::LightCompound pep;
+    pep.id = compound_ids[i];
+    pep.sequence = "PEPTIDE";
+    pep.rt = 10.0 * (i + 1);
+    pep.drift_time = 0.5 + i;
+    pep.charge = 2 + (i == 2);
+    pep.protein_refs.push_back(compound_proteins[i]);
+    library.compounds.push_back(pep);
+
+    for (Size j = 0; j < 2; ++j)
+    {
+      OpenSwath::LightTransition tr;
+      tr.transition_name = String(compound_ids[i]) + "_" + String(j);
+      tr.peptide_ref = compound_ids[i];
+      tr.precursor_mz = precursors[i];
+      tr.product_mz = 300.0 + j;
+      tr.library_intensity = 100.0 - j;
+      tr.fragment_charge = 1;
+      tr.decoy = false;
+      tr.detecting_transition = true;
+      tr.quantifying_transition = (j == 0);
+      tr.identifying_transition = false;
+      library.transitions.push_back(tr);
+    }
+  }
+}
+
+String filename;
+NEW_TMP_FILE(filename)
+TransitionBinFile().store(filename, library);
+
+START_SECTION(explicit MappedTransitionLibrary(const String& filename))
+{
+  MappedTransitionLibrary mapped(filename);
+  TEST_EQUAL(mapped.isOpen(), true)
+  TEST_EQUAL(mapped.getFilename(), filename)
+  TEST_EXCEPTION(Exception::FileNotFound, MappedTransitionLibrary("dummy/dummy.trBin"))
+}
+END_SECTION
+
+START_SECTION(void open(const String& filename))
+{
+  MappedTransitionLibrary mapped;
+  mapped.open(filename);
+  TEST_EQUAL(mapped.isOpen(), true)
+  TEST_EXCEPTION(Exception::ParseError, mapped.open(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.TraML")))
+  TEST_EQUAL(mapped.isOpen(), false)
+}
+END_SECTION
+
+START_SECTION(bool isOpen() const)
+{
+  NOT_TESTABLE // see above
+}
+END_SECTION
+
+START_SECTION(const String& getFilename() const)
+{
+  NOT_TESTABLE // see above
+}
+END_SECTION
+
+MappedTransitionLibrary mapped(filename);
+
+START_SECTION(Size getNrTransitions() const)
+{
+  TEST_EQUAL(mapped.getNrTransitions(), 6)
+}
+END_SECTION
+
+START_SECTION(Size getNrCompounds() const)
+{
+  TEST_EQUAL(mapped.getNrCompounds(), 3)
+}
+END_SECTION
+
+START_SECTION(Size getNrProteins() const)
+{
+  TEST_EQUAL(mapped.getNrProteins(), 2)
+}
+END_SECTION
+
+START_SECTION(const double* getPrecursorMZs() const)
+{
+  TEST_REAL_SIMILAR(mapped.getPrecursorMZs()[0], 500.2)
+  TEST_REAL_SIMILAR(mapped.getPrecursorMZs()[2], 420.7)
+  TEST_REAL_SIMILAR(mapped.getPrecursorMZs()[5], 612.3)
+}
+END_SECTION
+
+START_SECTION(const double* getProductMZs() const)
+{
+  TEST_REAL_SIMILAR(mapped.getProductMZs()[0], 300.0)
+  TEST_REAL_SIMILAR(mapped.getProductMZs()[1], 301.0)
+}
+END_SECTION
+
+START_SECTION(const double* getLibraryIntensities() const)
+{
+  TEST_REAL_SIMILAR(mapped.getLibraryIntensities()[0], 100.0)
+  TEST_REAL_SIMILAR(mapped.getLibraryIntensities()[1], 99.0)
+}
+END_SECTION
+
+START_SECTION(const Int32* getFragmentCharges() const)
+{
+  TEST_EQUAL(mapped.getFragmentCharges()[3], 1)
+}
+END_SECTION
+
+START_SECTION(const UInt32* getCompoundIndices() const)
+{
+  TEST_EQUAL(mapped.getCompoundIndices()[0], 0)
+  TEST_EQUAL(mapped.getCompoundIndices()[3], 1)
+  TEST_EQUAL(mapped.getCompoundIndices()[5], 2)
+}
+END_SECTION
+
+START_SECTION(const unsigned char* getFlags() const)
+{
+  TEST_EQUAL(mapped.getFlags()[0], TransitionBinFile::FLAG_DETECTING | TransitionBinFile::FLAG_QUANTIFYING)
+  TEST_EQUAL(mapped.getFlags()[1], TransitionBinFile::FLAG_DETECTING)
+}
+END_SECTION
+
+START_SECTION(const double* getNormalizedRTs() const)
+{
+  TEST_REAL_SIMILAR(mapped.getNormalizedRTs()[0], 10.0)
+  TEST_REAL_SIMILAR(mapped.getNormalizedRTs()[2], 30.0)
+}
+END_SECTION
+
+START_SECTION(const double* getDriftTimes() const)
+{
+  TEST_REAL_SIMILAR(mapped.getDriftTimes()[1], 1.5)
+}
+END_SECTION
+
+START_SECTION(const Int32* getCharges() const)
+{
+  TEST_EQUAL(mapped.getCharges()[0], 2)
+  TEST_EQUAL(mapped.getCharges()[2], 3)
+}
+END_SECTION
+
+START_SECTION(std::string getTransitionName(Size index) const)
+{
+  TEST_EQUAL(mapped.getTransitionName(3), "PEP_B/2_1")
+}
+END_SECTION
+
+START_SECTION(std::string getCompoundId(Size index) const)
+{
+  TEST_EQUAL(mapped.getCompoundId(2), "PEP_C/3")
+}
+END_SECTION
+
+START_SECTION(std::string getProteinId(Size index) const)
+{
+  TEST_EQUAL(mapped.getProteinId(1), "PROT_2")
+}
+END_SECTION
+
+START_SECTION(void getTransition(Size index, OpenSwath::LightTransition& transition) const)
+{
+  OpenSwath::LightTransition tr;
+  mapped.getTransition(4, tr);
+  TEST_EQUAL(tr.transition_name, "PEP_C/3_0")
+  TEST_EQUAL(tr.peptide_ref, "PEP_C/3")
+  TEST_REAL_SIMILAR(tr.precursor_mz, 612.3)
+  TEST_EQUAL(tr.isDetectingTransition(), true)
+  TEST_EQUAL(tr.isQuantifyingTransition(), true)
+  TEST_EQUAL(tr.isIdentifyingTransition(), false)
+  TEST_EQUAL(tr.decoy, false)
+}
+END_SECTION
+
+START_SECTION(void getCompound(Size index, OpenSwath::LightCompound& compound) const)
+{
+  OpenSwath::LightCompound pep;
+  mapped.getCompound(1, pep);
+  TEST_EQUAL(pep.id, "PEP_B/2")
+  TEST_EQUAL(pep.sequence, "PEPTIDE")
+  TEST_REAL_SIMILAR(pep.rt, 20.0)
+  TEST_EQUAL(pep.protein_refs.size(), 1)
+  TEST_EQUAL(pep.protein_refs[0], "PROT_2")
+}
+END_SECTION
+
+START_SECTION(void getProtein(Size index, OpenSwath::LightProtein& protein) const)
+{
+  OpenSwath::LightProtein prot;
+  mapped.getProtein(0, prot);
+  TEST_EQUAL(prot.id, "PROT_1")
+  TEST_EQUAL(prot.sequence, "SEQUENCE")
+}
+END_SECTION
+
+START_SECTION(void selectTransitions(const std::vector<Size>& indices, OpenSwath::LightTargetedExperiment& transition_exp_used) const)
+{
+  OpenSwath::LightTargetedExperiment selected;
+  mapped.selectTransitions({1, 5}, selected);
+  TEST_EQUAL(selected.transitions.size(), 2)
+  TEST_EQUAL(selected.transitions[0].transition_name, "PEP_A/2_1")
+  TEST_EQUAL(selected.transitions[1].transition_name, "PEP_C/3_1")
+  TEST_EQUAL(selected.compounds.size(), 2)
+  TEST_EQUAL(selected.compounds[0].id, "PEP_A/2")
+  TEST_EQUAL(selected.compounds[1].id, "PEP_C/3")
+  TEST_EQUAL(selected.proteins.size(), 1)
+  TEST_EQUAL(selected.proteins[0].id, "PROT_1")
+
+  // proteins are added in library order, not in the order they are referenced
+  OpenSwath::LightTargetedExperiment selected_both;
+  mapped.selectTransitions({2, 4}, selected_both);
+  TEST_EQUAL(selected_both.compounds.size(), 2)
+  TEST_EQUAL(selected_both.proteins.size(), 2)
+  TEST_EQUAL(selected_both.proteins[0].id, "PROT_1")
+  TEST_EQUAL(selected_both.proteins[1].id, "PROT_2")
+}
+END_SECTION
+
+START_SECTION(void selectSwathTransitions(OpenSwath::LightTargetedExperiment& transition_exp_used, double min_upper_edge_dist, double lower, double upper) const)
+{
+  // compare to the selection on the full library for a set of windows
+  const double windows[][3] = { {400.0, 425.0, 0.0}, {400.0, 525.0, 0.0}, {480.0, 500.5, 1.0}, {0.0, 1000.0, 0.0}, {700.0, 800.0, 0.0} };
+  for (Size w = 0; w < 5; ++w)
+  {
+    OpenSwath::LightTargetedExperiment expected, selected;
+    OpenSwathHelper::selectSwathTransitions(library, expected, windows[w][2], windows[w][0], windows[w][1]);
+    mapped.selectSwathTransitions(selected, windows[w][2], windows[w][0], windows[w][1]);
+    TEST_EQUAL(selected.transitions.size(), expected.transitions.size())
+    for (Size i = 0; i < selected.transitions.size() && i < expected.transitions.size(); ++i)
+    {
+      TEST_EQUAL(selected.transitions[i].transition_name, expected.transitions[i].transition_name)
+    }
+    TEST_EQUAL(selected.compounds.size(), expected.compounds.size())
+    for (Size i = 0; i < selected.compounds.size() && i < expected.compounds.size(); ++i)
+    {
+      TEST_EQUAL(selected.compounds[i].id, expected.compounds[i].id)
+    }
+    TEST_EQUAL(selected.proteins.size(), expected.proteins.size())
+    for (Size i = 0; i < selected.proteins.size() && i < expected.proteins.size(); ++i)
+    {
+      TEST_EQUAL(selected.proteins[i].id, expected.proteins[i].id)
+    }
+  }
+
+  // upper edge distance excludes PEP_A (500.2 is only 0.3 away from 500.5)
+  OpenSwath::LightTargetedExperiment selected;
+  mapped.selectSwathTransitions(selected, 1.0, 480.0, 500.5);
+  TEST_EQUAL(selected.transitions.size(), 0)
+}
+END_SECTION
+
+START_SECTION(void getLightTargetedExperiment(OpenSwath::LightTargetedExperiment& transition_exp) const)
+{
+  OpenSwath::LightTargetedExperiment all;
+  mapped.getLightTargetedExperiment(all);
+  TEST_EQUAL(all.transitions.size(), 6)
+  TEST_EQUAL(all.compounds.size(), 3)
+  TEST_EQUAL(all.proteins.size(), 2)
+  TEST_EQUAL(all.transitions[5].transition_name, "PEP_C/3_1")
+  TEST_EQUAL(all.compounds[2].charge, 3)
+}
+END_SECTION
+
+START_SECTION([EXTRA] copies share the mapping)
+{
+  MappedTransitionLibrary copy(mapped);
+  TEST_EQUAL(copy.getPrecursorMZs() == mapped.getPrecursorMZs(), true)
+  TEST_EQUAL(copy.getCompoundId(0), "PEP_A/2")
+}
+END_SECTION
+
+START_SECTION([EXTRA] corrupt files are rejected)
+{
+  std::string content;
+  {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  ABORT_IF(content.size() < sizeof(TransitionBinFile::Header))
+
+  auto writeFile = [](const String& name, const std::string& bytes)
+  {
+    std::ofstream out(name.c_str(), std::ios::binary);
+    out.write(bytes.data(), bytes.size());
+  };
+  auto setUInt64 = [](std::string& bytes, Size offset, UInt64 value)
+  {
+    std::memcpy(&bytes[offset], &value, sizeof(value));
+  };
+
+  String truncated_header, truncated_columns, bad_magic, wrong_version, huge_transitions, huge_compounds, huge_proteins;
+  NEW_TMP_FILE(truncated_header)
+  NEW_TMP_FILE(truncated_columns)
+  NEW_TMP_FILE(bad_magic)
+  NEW_TMP_FILE(wrong_version)
+  NEW_TMP_FILE(huge_transitions)
+  NEW_TMP_FILE(huge_compounds)
+  NEW_TMP_FILE(huge_proteins)
+
+  writeFile(truncated_header, content.substr(0, sizeof(TransitionBinFile::Header) - 1));
+  writeFile(truncated_columns, content.substr(0, content.size() - 8));
+
+  std::string corrupt = content;
+  corrupt[0] = 'X';
+  writeFile(bad_magic, corrupt);
+
+  corrupt = content;
+  UInt32 version = TransitionBinFile::VERSION + 1;
+  std::memcpy(&corrupt[offsetof(TransitionBinFile::Header, version)], &version, sizeof(version));
+  writeFile(wrong_version, corrupt);
+
+  // counts for which n + 1 or n * element size would overflow
+  corrupt = content;
+  setUInt64(corrupt, offsetof(TransitionBinFile::Header, nr_transitions), std::numeric_limits<UInt64>::max());
+  writeFile(huge_transitions, corrupt);
+  corrupt = content;
+  setUInt64(corrupt, offsetof(TransitionBinFile::Header, nr_compounds), std::numeric_limits<UInt64>::max());
+  writeFile(huge_compounds, corrupt);
+  corrupt = content;
+  setUInt64(corrupt, offsetof(TransitionBinFile::Header, nr_proteins), std::numeric_limits<UInt64>::max() / 8 + 1);
+  writeFile(huge_proteins, corrupt);
+
+  MappedTransitionLibrary mapped_corrupt;
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(truncated_header))
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(truncated_columns))
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(bad_magic))
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(wrong_version))
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(huge_transitions))
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(huge_compounds))
+  TEST_EXCEPTION(Exception::ParseError, mapped_corrupt.open(huge_proteins))
+  TEST_EQUAL(mapped_corrupt.isOpen(), false)
+
+  // the unmodified file still opens
+  mapped_corrupt.open(filename);
+  TEST_EQUAL(mapped_corrupt.isOpen(), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
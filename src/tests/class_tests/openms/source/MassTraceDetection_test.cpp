@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 
 ///////////////////////////
 #include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
@@ -175,6 +176,50 @@ START_SECTION((void run(const PeakMap &, std::vector< MassTrace > &)))
 }
 END_SECTION
 
+START_SECTION((void run(OnDiscMSExperiment &input_exp, std::vector< MassTrace > &found_masstraces, const Size block_size = 1000, const Size block_overlap = 100, const Size max_traces = 0)))
+{
+    // block-wise processing requires an indexed mzML file
+    String tmp_file;
+    NEW_TMP_FILE(tmp_file)
+    MzMLFile().store(tmp_file, input);
+    OnDiscMSExperiment ondisc_exp;
+    TEST_EQUAL(ondisc_exp.openFile(tmp_file), true)
+
+    // a single block gives the same result as the in-memory version
+    std::vector<MassTrace> ondisc_mt;
+    test_mtd.run(ondisc_exp, ondisc_mt);
+    TEST_EQUAL(ondisc_mt.size(), 3);
+    for (Size i = 0; i < ondisc_mt.size(); ++i)
+    {
+        TEST_EQUAL(ondisc_mt[i].getSize(), exp_mt_lengths[i]);
+        TEST_REAL_SIMILAR(ondisc_mt[i].getCentroidRT(), exp_mt_rts[i]);
+        TEST_REAL_SIMILAR(ondisc_mt[i].getCentroidMZ(), exp_mt_mzs[i]);
+        TEST_REAL_SIMILAR(ondisc_mt[i].computePeakArea(), exp_mt_ints[i]);
+    }
+
+    // small blocks: the longest trace spans several blocks, but the traces
+    // are the same (possibly in different order), as the traces of this
+    // input do not compete for peaks
+    test_mtd.run(ondisc_exp, ondisc_mt, 20, 40);
+    TEST_EQUAL(ondisc_mt.size(), 3);
+    std::sort(ondisc_mt.begin(), ondisc_mt.end(),
+              [](const MassTrace& a, const MassTrace& b) { return a.getSize() > b.getSize(); });
+    for (Size i = 0; i < ondisc_mt.size(); ++i)
+    {
+        TEST_EQUAL(ondisc_mt[i].getSize(), exp_mt_lengths[i]);
+        TEST_REAL_SIMILAR(ondisc_mt[i].getCentroidRT(), exp_mt_rts[i]);
+        TEST_REAL_SIMILAR(ondisc_mt[i].getCentroidMZ(), exp_mt_mzs[i]);
+        TEST_REAL_SIMILAR(ondisc_mt[i].computePeakArea(), exp_mt_ints[i]);
+    }
+
+    // maximal number of traces
+    test_mtd.run(ondisc_exp, ondisc_mt, 20, 40, 1);
+    TEST_EQUAL(ondisc_mt.size(), 1);
+
+    TEST_EXCEPTION(Exception::InvalidValue, test_mtd.run(ondisc_exp, ondisc_mt, 0))
+}
+END_SECTION
+
 std::vector<MassTrace> filt;
 
 //START_SECTION((void filterByPeakWidth(std::vector< MassTrace > &, std::vector< MassTrace > &)))
@@ -701,6 +701,58 @@ START_SECTION((template <typename PeakType > void filterExperiment(MSExperiment<
 }
 END_SECTION
 
+START_SECTION(([EXTRA] filterExperiment gives the same result as filtering each spectrum))
+{
+  // spectra of different lengths and spacings, so the structuring element size differs between them
+  PeakMap exp;
+  for (Size s = 0; s < 64; ++s)
+  {
+    MSSpectrum spec;
+    spec.setRT(s + 1.0);
+    const double spacing = 0.05 + 0.01 * (s % 5);
+    for (Size i = 0; i < 50 + 7 * s; ++i)
+    {
+      spec.push_back(Peak1D(300.0 + spacing * i, float(data[(i + s) % data_size] + (i % 13))));
+    }
+    exp.addSpectrum(spec);
+  }
+
+  StringList methods = ListUtils::create<String>("erosion,dilation,opening,closing,gradient,tophat,bothat,erosion_simple,dilation_simple");
+  for (const String& method : methods)
+  {
+    for (const String& unit : ListUtils::create<String>("Thomson,DataPoints"))
+    {
+      MorphologicalFilter mf;
+      Param parameters;
+      parameters.setValue("method", method);
+      parameters.setValue("struc_elem_length", unit == "Thomson" ? 0.7 : 5.0);
+      parameters.setValue("struc_elem_unit", unit);
+      mf.setParameters(parameters);
+
+      PeakMap expected = exp;
+      for (Size s = 0; s < expected.size(); ++s)
+      {
+        mf.filter(expected[s]);
+      }
+
+      PeakMap filtered = exp;
+      mf.filterExperiment(filtered);
+
+      STATUS(method << " " << unit);
+      ABORT_IF(filtered.size() != expected.size())
+      for (Size s = 0; s < expected.size(); ++s)
+      {
+        ABORT_IF(filtered[s].size() != expected[s].size())
+        for (Size i = 0; i < expected[s].size(); ++i)
+        {
+          TEST_EQUAL(filtered[s][i].getIntensity(), expected[s][i].getIntensity())
+        }
+      }
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -1071,6 +1071,25 @@ START_SECTION((template <typename MapType> void store(const String& filename, co
     TEST_EQUAL(exp == exp_original,true)
   }
 
+  // binary data is encoded in parallel batches: the output (including the
+  // offsets in the index) must not depend on the batch size
+  {
+    PeakMap exp_original;
+    MzMLFile batch_file;
+    batch_file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_6_uncompressed.mzML"), exp_original);
+    batch_file.getOptions().setCompression(true);
+
+    std::string out_default;
+    batch_file.storeBuffer(out_default, exp_original);
+    for (Size batch_size : {1, 2, 3})
+    {
+      batch_file.getOptions().setMaxDataPoolSize(batch_size);
+      std::string out;
+      batch_file.storeBuffer(out, exp_original);
+      TEST_EQUAL(out == out_default, true)
+    }
+  }
+
 }
 END_SECTION
 
@@ -41,6 +41,12 @@
 #include <OpenMS/FORMAT/TextFile.h>
 ///////////////////////////
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -122,6 +128,46 @@ START_SECTION(void store(const String& filename, MzTab& mzTab) )
 }
 END_SECTION
 
+START_SECTION([EXTRA] void store(const String& filename, MzTab& mzTab) writes the same rows in the same order for any number of threads)
+{
+  std::vector<String> files_to_test;
+  files_to_test.push_back("MzTabFile_SILAC.mzTab"); // > 1000 rows, formatted in several parallel chunks
+  files_to_test.push_back("MzTabFile_SILAC2.mzTab");
+  files_to_test.push_back("MzTabFile_labelfree.mzTab");
+  files_to_test.push_back("MzTabFile_iTRAQ.mzTab");
+  files_to_test.push_back("MzTabFile_Cytidine.mzTab");
+
+  String serial_file, parallel_file;
+  NEW_TMP_FILE(serial_file)
+  NEW_TMP_FILE(parallel_file)
+
+  for (const String& file : files_to_test)
+  {
+    MzTab mzTab;
+    MzTabFile().load(OPENMS_GET_TEST_DATA_PATH(file), mzTab);
+
+#ifdef _OPENMP
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    MzTabFile().store(serial_file, mzTab);
+    omp_set_num_threads(4);
+    MzTabFile().store(parallel_file, mzTab);
+    omp_set_num_threads(max_threads);
+#else
+    MzTabFile().store(serial_file, mzTab);
+    MzTabFile().store(parallel_file, mzTab);
+#endif
+
+    // compare row by row, without sorting
+    TextFile serial, parallel;
+    serial.load(serial_file);
+    parallel.load(parallel_file);
+    TEST_EQUAL(serial.end() - serial.begin(), parallel.end() - parallel.begin())
+    TEST_EQUAL(std::equal(serial.begin(), serial.end(), parallel.begin(), parallel.end()), true)
+  }
+}
+END_SECTION
+
 START_SECTION(~MzTabFile())
 {
   delete ptr;
@@ -334,6 +334,32 @@ START_SECTION(MSMSSpectrum getSpectrumByNativeId(const std::string& id))
 }
 END_SECTION
 
+START_SECTION((void setMemoryMapping(bool use_mmap)))
+{
+  OnDiscPeakMap tmp;
+  TEST_EQUAL(tmp.getMemoryMapping(), false)
+  tmp.setMemoryMapping(true);
+  TEST_EQUAL(tmp.getMemoryMapping(), true)
+  tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  TEST_EQUAL(tmp.getNrSpectra(), 2)
+
+  std::vector<Size> sizes(10);
+#pragma omp parallel for
+  for (SignedSize k = 0; k < (SignedSize)sizes.size(); ++k)
+  {
+    sizes[k] = tmp.getSpectrum(k % 2).size();
+  }
+  TEST_EQUAL(sizes[0], 19914)
+  TEST_EQUAL(sizes[1], 19800)
+  TEST_EQUAL(sizes[8], 19914)
+  TEST_EQUAL(sizes[9], 19800)
+
+  OpenMS::MSSpectrum s = tmp.getSpectrumByNativeId("controllerType=0 controllerNumber=1 scan=2");
+  TEST_EQUAL(s.size(), 19800);
+  TEST_EQUAL(tmp.getChromatogramByNativeId("TIC").size(), 48);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -100,6 +100,25 @@ START_SECTION(OpenSwathDataAccessHelper::convertToSpectrumPtr(sptr))
 }
 END_SECTION
 
+START_SECTION((static OpenSwath::SpectrumPtr convertToSpectrumPtr(OpenMS::MSSpectrumSoA && spectrum)))
+{
+  MSSpectrumSoA soa;
+  soa.push_back(2.0, 1.0);
+  soa.push_back(10.0, 2.0);
+  soa.push_back(30.0, 3.0);
+  const double* mz_data = soa.getMZArray().data();
+
+  OpenSwath::SpectrumPtr p = OpenSwathDataAccessHelper::convertToSpectrumPtr(std::move(soa));
+  TEST_EQUAL(soa.size(), 0)
+  TEST_EQUAL(p->getMZArray()->data.size(), 3)
+  TEST_EQUAL(p->getIntensityArray()->data.size(), 3)
+  // the array was moved, not copied
+  TEST_EQUAL(p->getMZArray()->data.data() == mz_data, true)
+  TEST_REAL_SIMILAR(p->getMZArray()->data[1], 10.0)
+  TEST_REAL_SIMILAR(p->getIntensityArray()->data[2], 3.0)
+}
+END_SECTION
+
 START_SECTION(OpenSwathDataAccessHelper::convertToOpenMSChromatogram(cptr, chromatogram))
 {
   //void OpenSwathDataAccessHelper::convertToOpenMSChromatogram(OpenMS::MSChromatogram & chromatogram,
@@ -35,6 +35,8 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 
 ///////////////////////////
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
@@ -163,6 +165,92 @@ START_SECTION((template <typename PeakType, typename ChromatogramPeakT> void pic
   }
 END_SECTION
 
+// indexed copy of the input for the on-disc tests
+String ondisc_file;
+NEW_TMP_FILE(ondisc_file)
+MzMLFile().store(ondisc_file, input);
+
+START_SECTION((void pickExperiment(OnDiscMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const))
+{
+  PeakMap tmp_exp;
+  OnDiscMSExperiment ondisc_exp;
+  TEST_EQUAL(ondisc_exp.openFile(ondisc_file), true)
+  pp_hires.pickExperiment(ondisc_exp, tmp_exp);
+
+  ABORT_IF(tmp_exp.size() != output.size())
+  for (Size scan_idx = 0; scan_idx < tmp_exp.size(); ++scan_idx)
+  {
+    TEST_EQUAL(tmp_exp[scan_idx].size(), output[scan_idx].size())
+    for (Size peak_idx = 0; peak_idx < tmp_exp[scan_idx].size(); ++peak_idx)
+    {
+      TEST_REAL_SIMILAR(tmp_exp[scan_idx][peak_idx].getMZ(), output[scan_idx][peak_idx].getMZ())
+      TEST_REAL_SIMILAR(tmp_exp[scan_idx][peak_idx].getIntensity(), output[scan_idx][peak_idx].getIntensity())
+    }
+  }
+
+  // concurrent reading from a memory mapped file gives the same result
+  PeakMap tmp_exp_mmap;
+  ondisc_exp.setMemoryMapping(true);
+  pp_hires.pickExperiment(ondisc_exp, tmp_exp_mmap);
+  TEST_EQUAL(tmp_exp_mmap.size(), tmp_exp.size())
+  TEST_EQUAL(tmp_exp_mmap == tmp_exp, true)
+}
+END_SECTION
+
+START_SECTION((void pickExperiment(OnDiscMSExperiment& input, Interfaces::IMSDataConsumer& output, const bool check_spectrum_type = true, Size chunk_size = 1000) const))
+{
+  PeakMap tmp_exp;
+  pp_hires.pickExperiment(input, tmp_exp);
+
+  OnDiscMSExperiment ondisc_exp;
+  TEST_EQUAL(ondisc_exp.openFile(ondisc_file), true)
+
+  // small chunks, so that several chunks are picked and written in turn
+  for (Size chunk_size : {Size(1), Size(2), Size(1000)})
+  {
+    MSDataStoringConsumer consumer;
+    pp_hires.pickExperiment(ondisc_exp, consumer, true, chunk_size);
+    const PeakMap& consumed = consumer.getData();
+
+    ABORT_IF(consumed.size() != tmp_exp.size())
+    for (Size scan_idx = 0; scan_idx < consumed.size(); ++scan_idx)
+    {
+      TEST_EQUAL(consumed[scan_idx].getNativeID(), tmp_exp[scan_idx].getNativeID())
+      TEST_EQUAL(consumed[scan_idx].size(), tmp_exp[scan_idx].size())
+      for (Size peak_idx = 0; peak_idx < consumed[scan_idx].size(); ++peak_idx)
+      {
+        TEST_REAL_SIMILAR(consumed[scan_idx][peak_idx].getMZ(), tmp_exp[scan_idx][peak_idx].getMZ())
+        TEST_REAL_SIMILAR(consumed[scan_idx][peak_idx].getIntensity(), tmp_exp[scan_idx][peak_idx].getIntensity())
+      }
+    }
+  }
+
+  // centroided data is rejected in manual mode
+  PeakPickerHiRes pp_ms1;
+  Param pp_ms1_param;
+  pp_ms1_param.setValue("ms_levels", ListUtils::create<Int>("1"));
+  pp_ms1.setParameters(pp_ms1_param);
+  String centroided_file;
+  NEW_TMP_FILE(centroided_file)
+  MzMLFile().store(centroided_file, tmp_exp);
+  OnDiscMSExperiment centroided_exp;
+  centroided_exp.openFile(centroided_file);
+  MSDataStoringConsumer consumer;
+  TEST_EXCEPTION(Exception::IllegalArgument, pp_ms1.pickExperiment(centroided_exp, consumer))
+
+  // exceptions of the consumer are passed on unchanged
+  struct FailingConsumer : public MSDataStoringConsumer
+  {
+    void consumeSpectrum(SpectrumType&) override
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test.mzML");
+    }
+  };
+  FailingConsumer failing_consumer;
+  TEST_EXCEPTION(Exception::UnableToCreateFile, pp_hires.pickExperiment(ondisc_exp, failing_consumer, true, 2))
+}
+END_SECTION
+
 output.clear(true);
 
 ///////////////////////////////////////////
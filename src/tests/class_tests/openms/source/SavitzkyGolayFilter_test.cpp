@@ -157,6 +157,60 @@ START_SECTION((template <typename PeakType> void filterExperiment(MSExperiment<P
 
 END_SECTION
 
+START_SECTION(([EXTRA] filterExperiment gives the same result as the iterator based filter))
+{
+  Param sg_param;
+  sg_param.setValue("frame_length", 11);
+  sg_param.setValue("polynomial_order", 4);
+  SavitzkyGolayFilter sgolay;
+  sgolay.setParameters(sg_param);
+
+  PeakMap exp;
+  for (Size s = 0; s < 30; ++s)
+  {
+    MSSpectrum spec;
+    // includes spectra shorter than the frame length, which are left untouched
+    for (Size i = 0; i < 5 + 7 * s; ++i)
+    {
+      spec.push_back(Peak1D(100.0 + 0.1 * i, (float)((i * 37 + s * 11) % 101)));
+    }
+    exp.addSpectrum(spec);
+  }
+  MSChromatogram chrom;
+  for (Size i = 0; i < 50; ++i)
+  {
+    chrom.push_back(ChromatogramPeak(1.0 * i, (double)((i * 13) % 29)));
+  }
+  exp.addChromatogram(chrom);
+
+  PeakMap expected = exp;
+  for (Size s = 0; s < expected.size(); ++s)
+  {
+    MSSpectrum output = expected[s];
+    sgolay.filter(expected[s].begin(), expected[s].end(), output.begin());
+    expected[s] = output;
+  }
+  MSChromatogram chrom_output = chrom;
+  sgolay.filter(chrom.begin(), chrom.end(), chrom_output.begin());
+
+  sgolay.filterExperiment(exp);
+
+  for (Size s = 0; s < expected.size(); ++s)
+  {
+    ABORT_IF(exp[s].size() != expected[s].size())
+    for (Size i = 0; i < expected[s].size(); ++i)
+    {
+      TEST_REAL_SIMILAR(exp[s][i].getIntensity(), expected[s][i].getIntensity())
+      TEST_REAL_SIMILAR(exp[s][i].getMZ(), expected[s][i].getMZ())
+    }
+  }
+  for (Size i = 0; i < chrom.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(exp.getChromatogram(0)[i].getIntensity(), chrom_output[i].getIntensity())
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -33,11 +33,17 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
 
 ///////////////////////////
 #include <OpenMS/ANALYSIS/ID/SimpleSearchEngineAlgorithm.h>
 ///////////////////////////
 
+#include <OpenMS/ANALYSIS/ID/FragmentIndex.h>
+#include <OpenMS/FORMAT/FASTAFile.h>
+
+#include <fstream>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -63,8 +69,129 @@ END_SECTION
 
 START_SECTION((ExitCodes search(const String &in_mzML, const String &in_db, std::vector< ProteinIdentification > &prot_ids, std::vector< PeptideIdentification > &pep_ids) const ))
 {
-  // tested via tool
-  NOT_TESTABLE
+  // tested via tool, except for the persisted fragment index
+  SimpleSearchEngineAlgorithm sse;
+  Param p = sse.getParameters();
+  p.setValue("precursor:mass_tolerance", 5.0);
+  p.setValue("fragment:mass_tolerance", 0.3);
+  p.setValue("fragment:mass_tolerance_unit", "Da");
+  p.setValue("modifications:fixed", StringList());
+  p.setValue("modifications:variable_max_per_peptide", 2);
+  p.setValue("fragment_index:enable", "true");
+  p.setValue("fragment_index:min_shared_fragments", 1);
+  String index_file;
+  NEW_TMP_FILE(index_file)
+  p.setValue("fragment_index:file", index_file);
+  sse.setParameters(p);
+
+  const String in_mzML = OPENMS_GET_TEST_DATA_PATH("SimpleSearchEngineAlgorithm_test.mzML");
+  const String in_db = OPENMS_GET_TEST_DATA_PATH("SimpleSearchEngineAlgorithm_test.fasta");
+
+  auto hitSequences = [](const vector<PeptideIdentification>& pep_ids)
+  {
+    vector<String> sequences;
+    for (const PeptideIdentification& pi : pep_ids)
+    {
+      for (const PeptideHit& ph : pi.getHits()) { sequences.push_back(ph.getSequence().toString()); }
+    }
+    return sequences;
+  };
+
+  // builds and stores the index
+  vector<ProteinIdentification> prot_ids;
+  vector<PeptideIdentification> pep_ids;
+  auto search = [&](const String& db)
+  {
+    prot_ids.clear();
+    pep_ids.clear();
+    return sse.search(in_mzML, db, prot_ids, pep_ids) == SimpleSearchEngineAlgorithm::ExitCodes::EXECUTION_OK;
+  };
+  TEST_EQUAL(search(in_db), true)
+  const vector<String> expected = hitSequences(pep_ids);
+  TEST_NOT_EQUAL(expected.size(), 0)
+
+  FragmentIndex stored;
+  stored.load(index_file);
+  const String settings = stored.getSettings();
+  TEST_EQUAL(settings.hasPrefix("database_sha1="), true)
+
+  // reuses the stored index
+  TEST_EQUAL(search(in_db), true)
+  TEST_EQUAL(hitSequences(pep_ids) == expected, true)
+
+  // a file of another version is rebuilt instead of aborting the search
+  {
+    ofstream ofs(index_file.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    const int wrong_version = 9999;
+    ofs.seekp(sizeof(int));
+    ofs.write((const char*)&wrong_version, sizeof(int));
+  }
+  TEST_EXCEPTION(Exception::ParseError, stored.load(index_file))
+  TEST_EQUAL(search(in_db), true)
+  TEST_EQUAL(hitSequences(pep_ids) == expected, true)
+  stored.load(index_file);
+  TEST_EQUAL(stored.getSettings(), settings)
+
+  // a stale index (other database contents, same name and number of entries) is rebuilt
+  String edited_db;
+  NEW_TMP_FILE(edited_db)
+  vector<FASTAFile::FASTAEntry> fasta_db;
+  FASTAFile::load(in_db, fasta_db);
+  fasta_db[0].sequence.reverse();
+  FASTAFile::store(edited_db, fasta_db);
+  TEST_EQUAL(search(edited_db), true)
+  stored.load(index_file);
+  TEST_NOT_EQUAL(stored.getSettings(), settings)
+
+  // as is an index built with other fragment settings
+  p.setValue("fragment_index:bin_size", 0.1);
+  sse.setParameters(p);
+  TEST_EQUAL(search(in_db), true)
+  stored.load(index_file);
+  TEST_REAL_SIMILAR(stored.getBinSize(), 0.1)
+  TEST_NOT_EQUAL(stored.getSettings(), settings)
+}
+END_SECTION
+
+START_SECTION([EXTRA] fragment index with min_shared_fragments = 1 reports the same hits as the peptide-centric search)
+{
+  SimpleSearchEngineAlgorithm sse;
+  Param p = sse.getParameters();
+  p.setValue("precursor:mass_tolerance", 5.0);
+  p.setValue("fragment:mass_tolerance", 0.3);
+  p.setValue("fragment:mass_tolerance_unit", "Da");
+  p.setValue("modifications:fixed", StringList());
+  p.setValue("modifications:variable_max_per_peptide", 2);
+  p.setValue("report:top_hits", 3);
+  sse.setParameters(p);
+
+  const String in_mzML = OPENMS_GET_TEST_DATA_PATH("SimpleSearchEngineAlgorithm_test.mzML");
+  const String in_db = OPENMS_GET_TEST_DATA_PATH("SimpleSearchEngineAlgorithm_test.fasta");
+
+  vector<ProteinIdentification> prot_ids, index_prot_ids;
+  vector<PeptideIdentification> pep_ids, index_pep_ids;
+  TEST_EQUAL(sse.search(in_mzML, in_db, prot_ids, pep_ids) == SimpleSearchEngineAlgorithm::ExitCodes::EXECUTION_OK, true)
+
+  p.setValue("fragment_index:enable", "true");
+  p.setValue("fragment_index:min_shared_fragments", 1);
+  sse.setParameters(p);
+  TEST_EQUAL(sse.search(in_mzML, in_db, index_prot_ids, index_pep_ids) == SimpleSearchEngineAlgorithm::ExitCodes::EXECUTION_OK, true)
+
+  TEST_NOT_EQUAL(pep_ids.size(), 0)
+  ABORT_IF(index_pep_ids.size() != pep_ids.size())
+  for (Size i = 0; i < pep_ids.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(index_pep_ids[i].getRT(), pep_ids[i].getRT())
+    TEST_REAL_SIMILAR(index_pep_ids[i].getMZ(), pep_ids[i].getMZ())
+    const vector<PeptideHit>& hits = pep_ids[i].getHits();
+    const vector<PeptideHit>& index_hits = index_pep_ids[i].getHits();
+    ABORT_IF(index_hits.size() != hits.size())
+    for (Size k = 0; k < hits.size(); ++k)
+    {
+      TEST_EQUAL(index_hits[k].getSequence(), hits[k].getSequence())
+      TEST_REAL_SIMILAR(index_hits[k].getScore(), hits[k].getScore())
+    }
+  }
 }
 END_SECTION
 
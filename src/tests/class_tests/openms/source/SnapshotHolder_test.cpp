@@ -0,0 +1,164 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/SnapshotHolder.h>
+///////////////////////////
+
+#include <map>
+
+using namespace OpenMS;
+using namespace std;
+
+typedef map<int, int> TestMap;
+
+START_TEST(SnapshotHolder, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SnapshotHolder<TestMap>* ptr = nullptr;
+SnapshotHolder<TestMap>* null_ptr = nullptr;
+START_SECTION(SnapshotHolder())
+{
+  ptr = new SnapshotHolder<TestMap>();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->get().empty(), true)
+}
+END_SECTION
+
+START_SECTION(~SnapshotHolder())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(const T& get() const)
+{
+  SnapshotHolder<TestMap> holder;
+  const TestMap& first = holder.get();
+  TEST_EQUAL(first.size(), 0)
+  // no new snapshot: the same object is returned
+  TEST_EQUAL(&holder.get() == &first, true)
+}
+END_SECTION
+
+START_SECTION(void publish(std::shared_ptr<const T> snapshot))
+{
+  SnapshotHolder<TestMap> holder;
+  auto tables = std::make_shared<TestMap>();
+  (*tables)[1] = 10;
+  holder.publish(tables);
+  TEST_EQUAL(holder.get().size(), 1)
+  TEST_EQUAL(holder.get().at(1), 10)
+
+  // copy-on-write update
+  auto updated = std::make_shared<TestMap>(holder.get());
+  (*updated)[2] = 20;
+  holder.publish(updated);
+  TEST_EQUAL(holder.get().size(), 2)
+  TEST_EQUAL(holder.get().at(2), 20)
+
+  // a second holder is independent of the first one
+  SnapshotHolder<TestMap> other;
+  TEST_EQUAL(other.get().size(), 0)
+  TEST_EQUAL(holder.get().size(), 2)
+
+  // concurrent readers always see a complete snapshot
+  Size errors = 0;
+#pragma omp parallel for reduction(+: errors)
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (i % 100 == 0)
+    {
+#pragma omp critical (SnapshotHolder_test)
+      {
+        auto next = std::make_shared<TestMap>(holder.get());
+        (*next)[next->size() + 1] = 10 * ((int)next->size() + 1);
+        holder.publish(next);
+      }
+    }
+    const TestMap& current = holder.get();
+    for (const auto& entry : current)
+    {
+      if (entry.second != 10 * entry.first) ++errors;
+    }
+  }
+  TEST_EQUAL(errors, 0)
+  TEST_EQUAL(holder.get().size(), 12)
+}
+END_SECTION
+
+START_SECTION([EXTRA] snapshots of destroyed holders are released by the reading thread)
+{
+  std::weak_ptr<const TestMap> released;
+  {
+    SnapshotHolder<TestMap> holder;
+    auto tables = std::make_shared<TestMap>();
+    (*tables)[1] = 10;
+    released = tables;
+    holder.publish(std::move(tables));
+    TEST_EQUAL(holder.get().at(1), 10)
+  }
+  // still referenced by the cache of this thread
+  TEST_EQUAL(released.expired(), false)
+
+  // the next new entry of this thread drops the entries of destroyed holders
+  SnapshotHolder<TestMap> other;
+  TEST_EQUAL(other.get().size(), 0)
+  TEST_EQUAL(released.expired(), true)
+
+  // a holder created at the address of a destroyed one does not see the old snapshot
+  for (int i = 0; i < 100; ++i)
+  {
+    SnapshotHolder<TestMap>* h = new SnapshotHolder<TestMap>();
+    auto tables = std::make_shared<TestMap>();
+    (*tables)[i] = i;
+    h->publish(std::move(tables));
+    TEST_EQUAL(h->get().size(), 1)
+    delete h;
+    SnapshotHolder<TestMap>* fresh = new SnapshotHolder<TestMap>();
+    TEST_EQUAL(fresh->get().size(), 0)
+    delete fresh;
+  }
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -146,6 +146,57 @@ START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType
 
 END_SECTION
 
+START_SECTION(([EXTRA] mergeSpectraPrecursors: grid and single linkage clustering agree))
+{
+  // MS2 spectra with precursors on a coarse RT/m/z lattice, so that some are within the tolerances
+  // (also transitively via chains) and others are not
+  PeakMap input;
+  for (Size i = 0; i < 300; ++i)
+  {
+    MSSpectrum spec;
+    spec.setMSLevel((i % 10 == 0) ? 1 : 2);
+    spec.setRT(i * 0.7);
+    Precursor prec;
+    prec.setMZ(400.0 + (i * 37 % 11) * 0.00004 + (i * 13 % 5));
+    spec.setPrecursors(vector<Precursor>(1, prec));
+    for (Size k = 0; k < 5; ++k)
+    {
+      spec.push_back(Peak1D(100.0 + k * 50.0 + (i % 3) * 0.1, 10.0f + k));
+    }
+    input.addSpectrum(spec);
+  }
+
+  Param p;
+  p.setValue("mz_binning_width", 0.3);
+  p.setValue("mz_binning_width_unit", "Da");
+  p.setValue("precursor_method:mz_tolerance", 10e-5);
+  p.setValue("precursor_method:rt_tolerance", 5.0);
+
+  PeakMap exp_grid = input, exp_linkage = input;
+  SpectraMerger merger;
+  p.setValue("precursor_method:clustering", "grid");
+  merger.setParameters(p);
+  merger.mergeSpectraPrecursors(exp_grid);
+  p.setValue("precursor_method:clustering", "single_linkage");
+  merger.setParameters(p);
+  merger.mergeSpectraPrecursors(exp_linkage);
+
+  TEST_EQUAL(exp_grid.size() < input.size(), true)
+  TEST_EQUAL(exp_grid.size(), exp_linkage.size())
+  ABORT_IF(exp_grid.size() != exp_linkage.size())
+  for (Size i = 0; i < exp_grid.size(); ++i)
+  {
+    TEST_EQUAL(exp_grid[i].getMSLevel(), exp_linkage[i].getMSLevel())
+    TEST_REAL_SIMILAR(exp_grid[i].getRT(), exp_linkage[i].getRT())
+    TEST_EQUAL(exp_grid[i].size(), exp_linkage[i].size())
+    if (exp_grid[i].getMSLevel() == 2)
+    {
+      TEST_REAL_SIMILAR(exp_grid[i].getPrecursors()[0].getMZ(), exp_linkage[i].getPrecursors()[0].getMZ())
+    }
+  }
+}
+END_SECTION
+
 START_SECTION((template < typename MapType > void averageGaussian(MapType &exp)))
 	PeakMap exp;
 	MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("SpectraMerger_input_3.mzML"), exp);    // profile mode
@@ -231,6 +231,14 @@ START_SECTION((static Int toInt(const String &this_s)))
   // incorrect type
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toInt(" abc "))
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toInt(" 123.45 "))
+  // sign and limits
+  TEST_EQUAL(StringUtils::toInt("+17"), 17)
+  TEST_EQUAL(StringUtils::toInt("-17"), -17)
+  TEST_EQUAL(StringUtils::toInt("2147483647"), 2147483647)
+  TEST_EQUAL(StringUtils::toInt("-2147483648"), -2147483647 - 1)
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toInt("2147483648"))
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toInt("-"))
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toInt(""))
 }
 END_SECTION
 
@@ -247,6 +255,12 @@ START_SECTION((static float toFloat(const String &this_s)))
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toFloat(" 1234.45 911.0"))     // '911.0' is not explained...
   // incorrect type
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toFloat(" abc "))
+  // exact results on the fast path
+  TEST_EQUAL(StringUtils::toFloat("0.1"), 0.1f)
+  TEST_EQUAL(StringUtils::toFloat("-3.5e2"), -350.0f)
+  // handled by the general parser
+  TEST_REAL_SIMILAR(StringUtils::toFloat("1.234567890123e-20"), 1.234567890123e-20)
+  TEST_EQUAL(std::isnan(StringUtils::toFloat("nan")), true)
 }
 END_SECTION
 
@@ -263,6 +277,25 @@ START_SECTION((static double toDouble(const String &this_s)))
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble(" 1234.45 911.0"))     // '911.0' is not explained...
   // incorrect type
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble(" abc "))
+  // exact results on the fast path
+  TEST_EQUAL(StringUtils::toDouble("0.1"), 0.1)
+  TEST_EQUAL(StringUtils::toDouble("1e22"), 1e22)
+  TEST_EQUAL(StringUtils::toDouble(".5"), 0.5)
+  TEST_EQUAL(StringUtils::toDouble("5."), 5.0)
+  TEST_EQUAL(StringUtils::toDouble("\t-445.1234567890123e-3\n"), -445.1234567890123e-3)
+  TEST_EQUAL(std::signbit(StringUtils::toDouble("-0")), true)
+  // handled by the general parser
+  TEST_REAL_SIMILAR(StringUtils::toDouble("1e23"), 1e23)
+  TEST_REAL_SIMILAR(StringUtils::toDouble("9007199254740993"), 9007199254740993.0)
+  TEST_REAL_SIMILAR(StringUtils::toDouble("123456789012345678901234567890"), 123456789012345678901234567890.0)
+  TEST_EQUAL(StringUtils::toDouble("4.9e-324") > 0, true)
+  TEST_EQUAL(std::isnan(StringUtils::toDouble("nan")), true)
+  TEST_EQUAL(std::isinf(StringUtils::toDouble("-inf")), true)
+  // invalid input
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble("1e"))
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble("."))
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble("-"))
+  TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble(""))
 }
 END_SECTION
 
@@ -327,6 +360,14 @@ START_SECTION((template <typename IteratorT> static bool extractDouble(IteratorT
     TEST_REAL_SIMILAR(d, 16e+06)
     TEST_EQUAL((int)std::distance(ss.begin(), it), 4); // was the iterator advanced?
   }
+  {
+    // an incomplete exponent is not consumed
+    std::string ss("16e+x");
+    auto it = ss.begin();
+    TEST_EQUAL(StringUtils::extractDouble(it, ss.end(), d), true);
+    TEST_EQUAL(d, 16.0)
+    TEST_EQUAL((int)std::distance(ss.begin(), it), 2); // was the iterator advanced?
+  }
   {
     std::string ss("!noNumber");
     auto it = ss.begin();
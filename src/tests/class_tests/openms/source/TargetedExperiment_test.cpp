@@ -330,6 +330,87 @@ START_SECTION((bool hasPeptide(const String & ref) const))
 }
 END_SECTION
 
+START_SECTION((const Protein & getProteinByRef(const String & ref) const))
+{
+  TargetedExperiment t;
+  for (Size i = 0; i < 100; ++i)
+  {
+    TargetedExperiment::Protein p;
+    p.id = "protein_" + String(i);
+    p.sequence = String(i);
+    t.addProtein(p);
+  }
+  TEST_EQUAL(t.getProteinByRef("protein_0").sequence, "0")
+  TEST_EQUAL(t.getProteinByRef("protein_57").sequence, "57")
+  TEST_EQUAL(t.hasProtein("protein_100"), false)
+
+  // the index is rebuilt after the proteins changed
+  TargetedExperiment::Protein p;
+  p.id = "protein_100";
+  p.sequence = "100";
+  t.addProtein(p);
+  TEST_EQUAL(t.hasProtein("protein_100"), true)
+  TEST_EQUAL(t.getProteinByRef("protein_100").sequence, "100")
+  TEST_EQUAL(t.getProteinByRef("protein_57").sequence, "57")
+
+  std::vector<TargetedExperiment::Protein> proteins(1, p);
+  proteins[0].id = "other";
+  t.setProteins(proteins);
+  TEST_EQUAL(t.hasProtein("protein_57"), false)
+  TEST_EQUAL(t.getProteinByRef("other").sequence, "100")
+}
+END_SECTION
+
+START_SECTION((const Peptide & getPeptideByRef(const String & ref) const))
+{
+  TargetedExperiment t;
+  for (Size i = 0; i < 100; ++i)
+  {
+    TargetedExperiment::Peptide p;
+    p.id = "peptide_" + String(i);
+    p.sequence = "PEPTIDE" + String(i);
+    t.addPeptide(p);
+  }
+  TEST_EQUAL(t.getPeptideByRef("peptide_0").sequence, "PEPTIDE0")
+  TEST_EQUAL(t.getPeptideByRef("peptide_99").sequence, "PEPTIDE99")
+  TEST_EQUAL(t.hasPeptide("peptide_100"), false)
+
+  TargetedExperiment::Peptide p;
+  p.id = "peptide_100";
+  p.sequence = "PEPTIDEK";
+  t.addPeptide(p);
+  TEST_EQUAL(t.getPeptideByRef("peptide_100").sequence, "PEPTIDEK")
+  TEST_EQUAL(t.getPeptideByRef("peptide_42").sequence, "PEPTIDE42")
+
+  // copies have their own index
+  TargetedExperiment copy(t);
+  TEST_EQUAL(copy.getPeptideByRef("peptide_42").sequence, "PEPTIDE42")
+  TEST_EQUAL(&copy.getPeptideByRef("peptide_42") == &copy.getPeptides()[42], true)
+}
+END_SECTION
+
+START_SECTION((const Compound & getCompoundByRef(const String & ref) const))
+{
+  TargetedExperiment t;
+  for (Size i = 0; i < 100; ++i)
+  {
+    TargetedExperiment::Compound c;
+    c.id = "compound_" + String(i);
+    c.molecular_formula = "C" + String(i + 1);
+    t.addCompound(c);
+  }
+  TEST_EQUAL(t.getCompoundByRef("compound_0").molecular_formula, "C1")
+  TEST_EQUAL(t.getCompoundByRef("compound_99").molecular_formula, "C100")
+  TEST_EQUAL(t.hasCompound("compound_100"), false)
+
+  TargetedExperiment::Compound c;
+  c.id = "compound_100";
+  t.addCompound(c);
+  TEST_EQUAL(t.hasCompound("compound_100"), true)
+  TEST_EQUAL(&t.getCompoundByRef("compound_100") == &t.getCompounds().back(), true)
+}
+END_SECTION
+
 START_SECTION((void setTransitions(const std::vector< ReactionMonitoringTransition > &transitions)))
 {
   TargetedExperiment t; 
@@ -0,0 +1,225 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinFile.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(TransitionBinFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+TransitionBinFile* ptr = nullptr;
+TransitionBinFile* nullPointer = nullptr;
+
+START_SECTION(TransitionBinFile())
+{
+  ptr = new TransitionBinFile();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+}
+END_SECTION
+
+START_SECTION(~TransitionBinFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+// a small library with two peptides (one with two proteins and a modification) and a metabolite
+OpenSwath::LightTargetedExperiment library;
+{
+  OpenSwath::LightProtein prot;
+  prot.id = "PROT_1";
+  prot.sequence = "PEPTIDEKPEPTIDER";
+  library.proteins.push_back(prot);
+  prot.id = "PROT_2";
+  prot.sequence = "";
+  library.proteins.push_back(prot);
+
+  OpenSwath::LightCompound pep;
+  pep.id = "PEPTIDEK/2";
+  pep.sequence = "PEPTIDEK";
+  pep.rt = 44.5;
+  pep.drift_time = 0.9;
+  pep.charge = 2;
+  pep.peptide_group_label = "group_1";
+  pep.gene_name = "GENE_1";
+  pep.protein_refs.push_back("PROT_1");
+  pep.protein_refs.push_back("PROT_2");
+  OpenSwath::LightModification mod;
+  mod.location = 3;
+  mod.unimod_id = 35;
+  pep.modifications.push_back(mod);
+  library.compounds.push_back(pep);
+
+  pep = OpenSwath::LightCompound();
+  pep.id = "PEPTIDER/3";
+  pep.sequence = "PEPTIDER";
+  pep.rt = -12.25;
+  pep.charge = 3;
+  pep.protein_refs.push_back("PROT_1");
+  library.compounds.push_back(pep);
+
+  OpenSwath::LightCompound met;
+  met.id = "glucose";
+  met.compound_name = "Glucose";
+  met.sum_formula = "C6H12O6";
+  met.rt = 100.0;
+  met.charge = 1;
+  library.compounds.push_back(met);
+
+  const char* names[] = {"tr_1", "tr_2", "tr_3", "tr_4", "tr_5"};
+  const char* refs[] = {"PEPTIDEK/2", "PEPTIDEK/2", "PEPTIDER/3", "glucose", "PEPTIDER/3"};
+  const double precursors[] = {450.5, 450.5, 320.1, 181.07, 320.1};
+  for (Size i = 0; i < 5; ++i)
+  {
+    OpenSwath::LightTransition tr;
+    tr.transition_name = names[i];
+    tr.peptide_ref = refs[i];
+    tr.precursor_mz = precursors[i];
+    tr.product_mz = 200.0 + i;
+    tr.library_intensity = 10.0 * i;
+    tr.fragment_charge = i % 3;
+    tr.decoy = (i == 4);
+    tr.detecting_transition = (i != 1);
+    tr.quantifying_transition = (i != 2);
+    tr.identifying_transition = (i == 1);
+    library.transitions.push_back(tr);
+  }
+}
+
+START_SECTION(void store(const String& filename, const OpenSwath::LightTargetedExperiment& transition_exp))
+{
+  // see load()
+  NOT_TESTABLE
+
+  OpenSwath::LightTargetedExperiment broken = library;
+  broken.transitions[2].peptide_ref = "not_in_library";
+  String broken_file;
+  NEW_TMP_FILE(broken_file)
+  TEST_EXCEPTION(Exception::IllegalArgument, TransitionBinFile().store(broken_file, broken))
+  TEST_EXCEPTION(Exception::UnableToCreateFile, TransitionBinFile().store("this/directory/does/not/exist.trBin", library))
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename, OpenSwath::LightTargetedExperiment& transition_exp))
+{
+  TransitionBinFile f;
+  String filename;
+  NEW_TMP_FILE(filename)
+  f.store(filename, library);
+
+  OpenSwath::LightTargetedExperiment loaded;
+  f.load(filename, loaded);
+
+  TEST_EQUAL(loaded.transitions.size(), 5)
+  TEST_EQUAL(loaded.compounds.size(), 3)
+  TEST_EQUAL(loaded.proteins.size(), 2)
+  for (Size i = 0; i < library.transitions.size(); ++i)
+  {
+    const OpenSwath::LightTransition& a = library.transitions[i];
+    const OpenSwath::LightTransition& b = loaded.transitions[i];
+    TEST_EQUAL(b.transition_name, a.transition_name)
+    TEST_EQUAL(b.peptide_ref, a.peptide_ref)
+    TEST_EQUAL(b.precursor_mz, a.precursor_mz)
+    TEST_EQUAL(b.product_mz, a.product_mz)
+    TEST_EQUAL(b.library_intensity, a.library_intensity)
+    TEST_EQUAL(b.fragment_charge, a.fragment_charge)
+    TEST_EQUAL(b.decoy, a.decoy)
+    TEST_EQUAL(b.detecting_transition, a.detecting_transition)
+    TEST_EQUAL(b.quantifying_transition, a.quantifying_transition)
+    TEST_EQUAL(b.identifying_transition, a.identifying_transition)
+  }
+  for (Size i = 0; i < library.compounds.size(); ++i)
+  {
+    const OpenSwath::LightCompound& a = library.compounds[i];
+    const OpenSwath::LightCompound& b = loaded.compounds[i];
+    TEST_EQUAL(b.id, a.id)
+    TEST_EQUAL(b.sequence, a.sequence)
+    TEST_EQUAL(b.rt, a.rt)
+    TEST_EQUAL(b.drift_time, a.drift_time)
+    TEST_EQUAL(b.charge, a.charge)
+    TEST_EQUAL(b.peptide_group_label, a.peptide_group_label)
+    TEST_EQUAL(b.gene_name, a.gene_name)
+    TEST_EQUAL(b.sum_formula, a.sum_formula)
+    TEST_EQUAL(b.compound_name, a.compound_name)
+    TEST_EQUAL(b.protein_refs.size(), a.protein_refs.size())
+    for (Size j = 0; j < a.protein_refs.size() && j < b.protein_refs.size(); ++j)
+    {
+      TEST_EQUAL(b.protein_refs[j], a.protein_refs[j])
+    }
+    TEST_EQUAL(b.modifications.size(), a.modifications.size())
+  }
+  TEST_EQUAL(loaded.compounds[0].modifications[0].location, 3)
+  TEST_EQUAL(loaded.compounds[0].modifications[0].unimod_id, 35)
+  TEST_EQUAL(loaded.proteins[0].id, "PROT_1")
+  TEST_EQUAL(loaded.proteins[0].sequence, "PEPTIDEKPEPTIDER")
+  TEST_EQUAL(loaded.proteins[1].id, "PROT_2")
+  TEST_EQUAL(loaded.proteins[1].sequence, "")
+
+  // empty library
+  String empty_file;
+  NEW_TMP_FILE(empty_file)
+  f.store(empty_file, OpenSwath::LightTargetedExperiment());
+  f.load(empty_file, loaded);
+  TEST_EQUAL(loaded.transitions.size(), 0)
+  TEST_EQUAL(loaded.compounds.size(), 0)
+  TEST_EQUAL(loaded.proteins.size(), 0)
+
+  TEST_EXCEPTION(Exception::FileNotFound, f.load("dummy/dummy.trBin", loaded))
+  TEST_EXCEPTION(Exception::ParseError, f.load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.TraML"), loaded))
+}
+END_SECTION
+
+START_SECTION(static bool isTransitionBinFile(const String& filename))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  TransitionBinFile().store(filename, library);
+  TEST_EQUAL(TransitionBinFile::isTransitionBinFile(filename), true)
+  TEST_EQUAL(TransitionBinFile::isTransitionBinFile(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.TraML")), false)
+  TEST_EQUAL(TransitionBinFile::isTransitionBinFile("dummy/dummy.trBin"), false)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
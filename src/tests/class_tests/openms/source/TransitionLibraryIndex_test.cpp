@@ -0,0 +1,302 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionLibraryIndex.h>
+///////////////////////////
+
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+namespace
+{
+  OpenSwath::LightTransition makeTransition(const std::string& name, const std::string& ref, double precursor_mz)
+  {
+    OpenSwath::LightTransition tr;
+    tr.transition_name = name;
+    tr.peptide_ref = ref;
+    tr.precursor_mz = precursor_mz;
+    tr.product_mz = 300.0;
+    tr.library_intensity = 100.0;
+    return tr;
+  }
+
+  OpenSwath::LightCompound makeCompound(const std::string& id, const std::vector<std::string>& protein_refs)
+  {
+    OpenSwath::LightCompound comp;
+    comp.id = id;
+    comp.protein_refs = protein_refs;
+    return comp;
+  }
+
+  OpenSwath::LightProtein makeProtein(const std::string& id)
+  {
+    OpenSwath::LightProtein prot;
+    prot.id = id;
+    return prot;
+  }
+
+  std::vector<std::string> transitionNames(const OpenSwath::LightTargetedExperiment& exp)
+  {
+    std::vector<std::string> names;
+    for (const auto& tr : exp.transitions) names.push_back(tr.transition_name);
+    return names;
+  }
+
+  std::vector<std::string> compoundIds(const OpenSwath::LightTargetedExperiment& exp)
+  {
+    std::vector<std::string> ids;
+    for (const auto& comp : exp.compounds) ids.push_back(comp.id);
+    return ids;
+  }
+
+  std::vector<std::string> proteinIds(const OpenSwath::LightTargetedExperiment& exp)
+  {
+    std::vector<std::string> ids;
+    for (const auto& prot : exp.proteins) ids.push_back(prot.id);
+    return ids;
+  }
+}
+
+START_TEST(TransitionLibraryIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+TransitionLibraryIndex* ptr = nullptr;
+TransitionLibraryIndex* nullPointer = nullptr;
+
+START_SECTION(TransitionLibraryIndex())
+{
+  ptr = new TransitionLibraryIndex();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNrTransitions(), 0)
+  TEST_EQUAL(ptr->getNrCompounds(), 0)
+  TEST_EQUAL(ptr->getNrProteins(), 0)
+  TEST_EQUAL(ptr->getCompoundIndex("PEP_1"), TransitionLibraryIndex::NOT_FOUND)
+}
+END_SECTION
+
+START_SECTION(~TransitionLibraryIndex())
+{
+  delete ptr;
+}
+END_SECTION
+
+// Library with a duplicate compound id (PEP_2), a duplicate protein id
+// (PROT_1), a transition of a missing compound, a compound referencing a
+// missing protein and a transition without precursor m/z. The transitions are
+// not sorted by precursor m/z.
+OpenSwath::LightTargetedExperiment library;
+library.proteins.push_back(makeProtein("PROT_1"));
+library.proteins.push_back(makeProtein("PROT_2"));
+library.proteins.push_back(makeProtein("PROT_1"));
+library.proteins.push_back(makeProtein("PROT_3"));
+library.compounds.push_back(makeCompound("PEP_1", {"PROT_1"}));
+library.compounds.push_back(makeCompound("PEP_2", {"PROT_2", "PROT_MISSING"}));
+library.compounds.push_back(makeCompound("PEP_3", {"PROT_3", "PROT_2"}));
+library.compounds.push_back(makeCompound("PEP_2", {"PROT_3"}));
+library.transitions.push_back(makeTransition("tr_1", "PEP_3", 650.0));
+library.transitions.push_back(makeTransition("tr_2", "PEP_1", 410.0));
+library.transitions.push_back(makeTransition("tr_3", "PEP_2", 520.0));
+library.transitions.push_back(makeTransition("tr_4", "PEP_1", 410.0));
+library.transitions.push_back(makeTransition("tr_5", "PEP_MISSING", 530.0));
+library.transitions.push_back(makeTransition("tr_6", "PEP_2", std::numeric_limits<double>::quiet_NaN()));
+library.transitions.push_back(makeTransition("tr_7", "PEP_3", 425.0));
+
+START_SECTION(TransitionLibraryIndex(const OpenSwath::LightTargetedExperiment& library))
+{
+  TransitionLibraryIndex index(library);
+  TEST_EQUAL(index.getNrTransitions(), 7)
+  TEST_EQUAL(index.getNrCompounds(), 4)
+  TEST_EQUAL(index.getNrProteins(), 4)
+}
+END_SECTION
+
+START_SECTION(void build(const OpenSwath::LightTargetedExperiment& library))
+{
+  TransitionLibraryIndex index;
+  OpenSwath::LightTargetedExperiment small;
+  small.compounds.push_back(makeCompound("PEP_X", {}));
+  small.transitions.push_back(makeTransition("tr_x", "PEP_X", 500.0));
+  index.build(small);
+  TEST_EQUAL(index.getNrTransitions(), 1)
+  TEST_EQUAL(index.getCompoundIndex("PEP_X"), 0)
+
+  // rebuilding replaces the previous index completely
+  index.build(library);
+  TEST_EQUAL(index.getNrTransitions(), 7)
+  TEST_EQUAL(index.getNrCompounds(), 4)
+  TEST_EQUAL(index.getNrProteins(), 4)
+  TEST_EQUAL(index.getCompoundIndex("PEP_X"), TransitionLibraryIndex::NOT_FOUND)
+  TEST_EQUAL(index.getCompoundIndex("PEP_3"), 2)
+}
+END_SECTION
+
+TransitionLibraryIndex index(library);
+
+START_SECTION(Size getNrTransitions() const)
+{
+  TEST_EQUAL(index.getNrTransitions(), 7)
+}
+END_SECTION
+
+START_SECTION(Size getNrCompounds() const)
+{
+  TEST_EQUAL(index.getNrCompounds(), 4)
+}
+END_SECTION
+
+START_SECTION(Size getNrProteins() const)
+{
+  TEST_EQUAL(index.getNrProteins(), 4)
+}
+END_SECTION
+
+START_SECTION(Size getCompoundIndex(const std::string& id) const)
+{
+  TEST_EQUAL(index.getCompoundIndex("PEP_1"), 0)
+  TEST_EQUAL(index.getCompoundIndex("PEP_2"), 1) // first of the duplicates
+  TEST_EQUAL(index.getCompoundIndex("PEP_3"), 2)
+  TEST_EQUAL(index.getCompoundIndex("PEP_MISSING"), TransitionLibraryIndex::NOT_FOUND)
+  TEST_EQUAL(index.getCompoundIndex(""), TransitionLibraryIndex::NOT_FOUND)
+}
+END_SECTION
+
+START_SECTION(Size getProteinIndex(const std::string& id) const)
+{
+  TEST_EQUAL(index.getProteinIndex("PROT_1"), 0) // first of the duplicates
+  TEST_EQUAL(index.getProteinIndex("PROT_2"), 1)
+  TEST_EQUAL(index.getProteinIndex("PROT_3"), 3)
+  TEST_EQUAL(index.getProteinIndex("PROT_MISSING"), TransitionLibraryIndex::NOT_FOUND)
+}
+END_SECTION
+
+START_SECTION(Size getTransitionCompound(Size transition_index) const)
+{
+  TEST_EQUAL(index.getTransitionCompound(0), 2)
+  TEST_EQUAL(index.getTransitionCompound(1), 0)
+  TEST_EQUAL(index.getTransitionCompound(2), 1)
+  TEST_EQUAL(index.getTransitionCompound(3), 0)
+  TEST_EQUAL(index.getTransitionCompound(4), TransitionLibraryIndex::NOT_FOUND)
+  TEST_EQUAL(index.getTransitionCompound(5), 1)
+  TEST_EQUAL(index.getTransitionCompound(6), 2)
+}
+END_SECTION
+
+START_SECTION(std::vector<Size> getCompoundProteins(Size compound_index) const)
+{
+  std::vector<Size> proteins = index.getCompoundProteins(0);
+  TEST_EQUAL(proteins.size(), 1)
+  TEST_EQUAL(proteins[0], 0)
+
+  // the missing protein is skipped
+  proteins = index.getCompoundProteins(1);
+  TEST_EQUAL(proteins.size(), 1)
+  TEST_EQUAL(proteins[0], 1)
+
+  // reference order is kept
+  proteins = index.getCompoundProteins(2);
+  TEST_EQUAL(proteins.size(), 2)
+  TEST_EQUAL(proteins[0], 3)
+  TEST_EQUAL(proteins[1], 1)
+}
+END_SECTION
+
+START_SECTION(void selectTransitions(const OpenSwath::LightTargetedExperiment& library, const std::vector<Size>& transition_indices, OpenSwath::LightTargetedExperiment& selected) const)
+{
+  OpenSwath::LightTargetedExperiment selected;
+  std::vector<Size> transition_indices = {2, 4, 6};
+  index.selectTransitions(library, transition_indices, selected);
+
+  std::vector<std::string> expected_transitions = {"tr_3", "tr_5", "tr_7"};
+  TEST_EQUAL(transitionNames(selected) == expected_transitions, true)
+  // both compounds with id PEP_2 are selected, in library order
+  std::vector<std::string> expected_compounds = {"PEP_2", "PEP_3", "PEP_2"};
+  TEST_EQUAL(compoundIds(selected) == expected_compounds, true)
+  std::vector<std::string> expected_proteins = {"PROT_2", "PROT_3"};
+  TEST_EQUAL(proteinIds(selected) == expected_proteins, true)
+
+  // nothing selected
+  OpenSwath::LightTargetedExperiment empty;
+  index.selectTransitions(library, std::vector<Size>(), empty);
+  TEST_EQUAL(empty.transitions.size(), 0)
+  TEST_EQUAL(empty.compounds.size(), 0)
+  TEST_EQUAL(empty.proteins.size(), 0)
+}
+END_SECTION
+
+START_SECTION(void selectSwathTransitions(const OpenSwath::LightTargetedExperiment& library, OpenSwath::LightTargetedExperiment& selected, double min_upper_edge_dist, double lower, double upper) const)
+{
+  // compare against the string based selection for a set of windows,
+  // including window edges that coincide with precursor m/z values
+  const double windows[][3] = {
+    {400.0, 450.0, 0.0},
+    {410.0, 425.0, 0.0},
+    {400.0, 450.0, 30.0},
+    {500.0, 550.0, 0.0},
+    {500.0, 700.0, 1.0},
+    {300.0, 400.0, 0.0},
+    {0.0, 1000.0, 0.0}
+  };
+  for (const auto& w : windows)
+  {
+    OpenSwath::LightTargetedExperiment expected, selected;
+    OpenSwathHelper::selectSwathTransitions(library, expected, w[2], w[0], w[1]);
+    index.selectSwathTransitions(library, selected, w[2], w[0], w[1]);
+
+    TEST_EQUAL(transitionNames(selected) == transitionNames(expected), true)
+    TEST_EQUAL(compoundIds(selected) == compoundIds(expected), true)
+    TEST_EQUAL(proteinIds(selected) == proteinIds(expected), true)
+  }
+
+  // the transition without precursor m/z is never selected
+  OpenSwath::LightTargetedExperiment all;
+  index.selectSwathTransitions(library, all, 0.0, 0.0, 1000.0);
+  TEST_EQUAL(all.transitions.size(), 6)
+  std::vector<std::string> expected_all = {"tr_1", "tr_2", "tr_3", "tr_4", "tr_5", "tr_7"};
+  TEST_EQUAL(transitionNames(all) == expected_all, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
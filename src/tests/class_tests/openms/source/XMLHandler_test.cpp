@@ -0,0 +1,199 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: agent $
+// $Authors: agent $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
+///////////////////////////
+
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/XMLString.hpp>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace OpenMS::Internal;
+using namespace std;
+
+START_TEST(XMLHandler, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+xercesc::XMLPlatformUtils::Initialize();
+
+StringManager sm;
+
+// conversion through the Xerces transcoder, i.e. without the ASCII fast path
+auto transcodeToNative = [](const XMLCh* str)
+{
+  char* ptr(xercesc::XMLString::transcode(str));
+  String result(ptr);
+  xercesc::XMLString::release(&ptr);
+  return result;
+};
+
+START_SECTION((XercesString convert(const char * str) const))
+{
+  // ASCII input is widened without the transcoder, the result has to be the same
+  const char* inputs[] = {"", "a", "featureMap", " 1.5e-3 ", "~!@#$%^&*()_+{}|:\"<>?`-=[]\\;',./", "\t\n\r"};
+  for (const char* input : inputs)
+  {
+    XMLCh* expected = xercesc::XMLString::transcode(input);
+    TEST_EQUAL(xercesc::XMLString::equals(sm.convert(input).c_str(), expected), true)
+    TEST_EQUAL(sm.convert(input).size(), xercesc::XMLString::stringLen(expected))
+    xercesc::XMLString::release(&expected);
+  }
+  TEST_EQUAL(sm.convert(String("attribute")).size(), 9)
+  TEST_EQUAL(sm.convert(std::string("attribute")).size(), 9)
+}
+END_SECTION
+
+START_SECTION((String convert(const XMLCh * str) const))
+{
+  // ASCII input is narrowed without the transcoder, the result has to be the same
+  const char* inputs[] = {"", "a", "featureMap", " 1.5e-3 ", "~!@#$%^&*()_+{}|:\"<>?`-=[]\\;',./", "\t\n\r"};
+  for (const char* input : inputs)
+  {
+    XMLCh* wide = xercesc::XMLString::transcode(input);
+    TEST_STRING_EQUAL(sm.convert(wide), input)
+    TEST_STRING_EQUAL(sm.convert(wide), transcodeToNative(wide))
+    xercesc::XMLString::release(&wide);
+  }
+
+  // non-ASCII input still goes through the transcoder
+  const XMLCh non_ascii[] = {'a', 0xE9, 'b', 0};
+  TEST_STRING_EQUAL(sm.convert(non_ascii), transcodeToNative(non_ascii))
+  const XMLCh only_non_ascii[] = {0x00FC, 0};
+  TEST_STRING_EQUAL(sm.convert(only_non_ascii), transcodeToNative(only_non_ascii))
+}
+END_SECTION
+
+START_SECTION((static bool parseDouble(const XMLCh * str, double & value)))
+{
+  double value = 0.0;
+
+  // plain numbers, sign and exponent
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("0.1").c_str(), value), true)
+  TEST_EQUAL(value, 0.1)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("1.5e3").c_str(), value), true)
+  TEST_EQUAL(value, 1500.0)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("1.5E+3").c_str(), value), true)
+  TEST_EQUAL(value, 1500.0)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("-2.5e-2").c_str(), value), true)
+  TEST_EQUAL(value, -0.025)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("+3").c_str(), value), true)
+  TEST_EQUAL(value, 3.0)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("-0").c_str(), value), true)
+  TEST_EQUAL(std::signbit(value), true)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("1e-400").c_str(), value), true)
+  TEST_EQUAL(value, 0.0)
+
+  // surrounding whitespace is allowed
+  TEST_EQUAL(StringManager::parseDouble(sm.convert(" \t7.25\n ").c_str(), value), true)
+  TEST_EQUAL(value, 7.25)
+
+  // inf and nan
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("nan").c_str(), value), true)
+  TEST_EQUAL(std::isnan(value), true)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("NaN").c_str(), value), true)
+  TEST_EQUAL(std::isnan(value), true)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("inf").c_str(), value), true)
+  TEST_EQUAL(std::isinf(value) && value > 0, true)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("-inf").c_str(), value), true)
+  TEST_EQUAL(std::isinf(value) && value < 0, true)
+
+  // mantissas longer than the fast path handles are left to the general parser
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("123456789012345678901234567890").c_str(), value), true)
+  TEST_REAL_SIMILAR(value, 123456789012345678901234567890.0)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("0.1234567890123456789012345").c_str(), value), true)
+  TEST_REAL_SIMILAR(value, 0.1234567890123456789012345)
+
+  // rejected: invalid, incomplete, out of range, trailing text, empty, too long, non-ASCII
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("abc").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("1e").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("-").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert(".").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("1e400").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("1.0 2.0").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert("").c_str(), value), false)
+  TEST_EQUAL(StringManager::parseDouble(sm.convert(String(65, '1')).c_str(), value), false)
+  const XMLCh non_ascii[] = {'1', 0xE9, 0};
+  TEST_EQUAL(StringManager::parseDouble(non_ascii, value), false)
+  TEST_EQUAL(StringManager::parseDouble(nullptr, value), false)
+
+  // agrees with the String based conversion used as fallback by the attribute helpers
+  const char* numbers[] = {"445.1234567890123", "-1.000000000000001e-5", "9007199254740993", "1e22", "1e23", "5."};
+  for (const char* number : numbers)
+  {
+    TEST_EQUAL(StringManager::parseDouble(sm.convert(number).c_str(), value), true)
+    TEST_EQUAL(value, String(number).toDouble())
+  }
+}
+END_SECTION
+
+START_SECTION((static DataValue stringUserParamValue_(const String& value)))
+{
+  Size count = DataValue::internedCount();
+
+  // short labels are interned and share their storage
+  DataValue a = XMLHandler::stringUserParamValue_("MS:1002252_score_type");
+  DataValue b = XMLHandler::stringUserParamValue_("MS:1002252_score_type");
+  TEST_EQUAL(a.valueType(), DataValue::STRING_VALUE)
+  TEST_STRING_EQUAL(a.toString(), "MS:1002252_score_type")
+  TEST_EQUAL(a.toChar() == b.toChar(), true)
+  TEST_EQUAL(DataValue::internedCount(), count + 1)
+
+  // long (typically unique) values are not added to the pool
+  String long_value(XMLHandler::MAX_INTERNED_USERPARAM_LENGTH + 1, 'A');
+  DataValue c = XMLHandler::stringUserParamValue_(long_value);
+  DataValue d = XMLHandler::stringUserParamValue_(long_value);
+  TEST_STRING_EQUAL(c.toString(), long_value)
+  TEST_EQUAL(c == d, true)
+  TEST_EQUAL(c.toChar() == d.toChar(), false)
+  TEST_EQUAL(DataValue::internedCount(), count + 1)
+
+  // the limit itself is still interned
+  DataValue e = XMLHandler::stringUserParamValue_(String(XMLHandler::MAX_INTERNED_USERPARAM_LENGTH, 'A'));
+  TEST_EQUAL(DataValue::internedCount(), count + 2)
+}
+END_SECTION
+
+xercesc::XMLPlatformUtils::Terminate();
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
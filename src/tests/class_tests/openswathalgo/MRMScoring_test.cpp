@@ -284,6 +284,43 @@ BOOST_AUTO_TEST_CASE(initializeXCorrMatrix)
 }
 END_SECTION
 
+BOOST_AUTO_TEST_CASE(getXCorrMatrix_concurrent)
+{
+  MockMRMFeature * imrmfeature = new MockMRMFeature();
+  MRMScoring mrmscore;
+
+  std::vector<std::string> native_ids;
+  fill_mock_objects(imrmfeature, native_ids);
+  mrmscore.initializeXCorrMatrix(imrmfeature, native_ids);
+
+  // the full matrix is computed on first access, concurrent first accesses have to see the same result
+  std::vector<std::size_t> sizes(8, 0);
+  std::vector<double> values(8, 0.0);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < 8; i++)
+  {
+    const MRMScoring::XCorrMatrixType& m = mrmscore.getXCorrMatrix();
+    sizes[i] = m[0][1].data.size();
+    values[i] = m[0][1].data[10].second;
+  }
+  for (std::size_t i = 0; i < sizes.size(); i++)
+  {
+    TEST_EQUAL(sizes[i], 23)
+    TEST_REAL_SIMILAR(values[i], 0.30204049)
+  }
+
+  // copies keep the peaks and compute the full matrix on their own
+  MRMScoring copy(mrmscore);
+  TEST_EQUAL(copy.getXCorrMatrix().size(), 2)
+  TEST_REAL_SIMILAR(copy.getXCorrMatrix()[0][1].data[10].second, 0.30204049)
+  TEST_REAL_SIMILAR(copy.calcXcorrCoelutionScore(), mrmscore.calcXcorrCoelutionScore())
+
+  delete imrmfeature;
+}
+END_SECTION
+
 BOOST_AUTO_TEST_CASE(initializeXCorrPrecursorContrastMatrix)
 {
   MockMRMFeature * imrmfeature = new MockMRMFeature();
@@ -800,6 +837,48 @@ BOOST_AUTO_TEST_CASE(test_calcMIPrecursorCombinedScore)
 }
 END_SECTION
 
+BOOST_AUTO_TEST_CASE(initializeMIMatrices)
+{
+  MockMRMFeature * imrmfeature = new MockMRMFeature();
+  MRMScoring mrmscore;
+  MRMScoring mrmscore_separate;
+
+  std::vector<std::string> precursor_ids;
+  std::vector<std::string> native_ids;
+  fill_mock_objects2(imrmfeature, precursor_ids, native_ids);
+
+  // all MI matrices at once
+  mrmscore.initializeMIMatrices(imrmfeature, native_ids, precursor_ids);
+
+  mrmscore_separate.initializeMIMatrix(imrmfeature, native_ids);
+  mrmscore_separate.initializeMIPrecursorMatrix(imrmfeature, precursor_ids);
+  mrmscore_separate.initializeMIPrecursorContrastMatrix(imrmfeature, precursor_ids, native_ids);
+  mrmscore_separate.initializeMIPrecursorCombinedMatrix(imrmfeature, precursor_ids, native_ids);
+
+  TEST_EQUAL(mrmscore.getMIMatrix().size(), 2)
+  TEST_EQUAL(mrmscore.getMIPrecursorContrastMatrix().size(), 3)
+  TEST_EQUAL(mrmscore.getMIPrecursorContrastMatrix()[0].size(), 2)
+  TEST_EQUAL(mrmscore.getMIPrecursorCombinedMatrix().size(), 5)
+  TEST_EQUAL(mrmscore.getMIPrecursorCombinedMatrix()[0].size(), 5)
+
+  TEST_REAL_SIMILAR(mrmscore.getMIMatrix()[0][0], 3.2776)
+  TEST_REAL_SIMILAR(mrmscore.getMIMatrix()[0][1], 3.2776)
+  TEST_REAL_SIMILAR(mrmscore.getMIMatrix()[1][1], 3.4594)
+  for (std::size_t i = 0; i < 5; i++)
+  {
+    for (std::size_t j = 0; j < 5; j++)
+    {
+      TEST_REAL_SIMILAR(mrmscore.getMIPrecursorCombinedMatrix()[i][j], mrmscore_separate.getMIPrecursorCombinedMatrix()[i][j])
+    }
+  }
+
+  TEST_REAL_SIMILAR(mrmscore.calcMIScore(), mrmscore_separate.calcMIScore())
+  TEST_REAL_SIMILAR(mrmscore.calcMIPrecursorScore(), mrmscore_separate.calcMIPrecursorScore())
+  TEST_REAL_SIMILAR(mrmscore.calcMIPrecursorContrastScore(), 2.003257)
+  TEST_REAL_SIMILAR(mrmscore.calcMIPrecursorCombinedScore(), 1.959490)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -350,6 +350,57 @@ BOOST_AUTO_TEST_CASE(test_MRMFeatureScoring_normalizedCrossCorrelation)
 }
 END_SECTION
 
+BOOST_AUTO_TEST_CASE(test_standardizedCrossCorrelationMaxPeak)
+//START_SECTION((XCorrEntry standardizedCrossCorrelationMaxPeak(const std::vector<double>& data1, const std::vector<double>& data2)))
+{
+  // example from above, the highest peak is at lag -1
+  {
+    static const double arr1[] = {0,1,3,5,2,0};
+    static const double arr2[] = {1,3,5,2,0,0};
+    std::vector<double> data1 (arr1, arr1 + sizeof(arr1) / sizeof(arr1[0]) );
+    std::vector<double> data2 (arr2, arr2 + sizeof(arr2) / sizeof(arr2[0]) );
+    Scoring::standardize_data(data1);
+    Scoring::standardize_data(data2);
+
+    OpenSwath::Scoring::XCorrEntry peak = Scoring::standardizedCrossCorrelationMaxPeak(data1, data2);
+    TEST_EQUAL (peak.first, -1)
+    TEST_REAL_SIMILAR (peak.second, 0.8215339)
+  }
+
+  // has to find the same peak as xcorrArrayGetMaxPeak on the full normalized cross-correlation,
+  // also for identical and mirrored traces (ties between lags)
+  unsigned int seed = 42;
+  const std::size_t sizes[] = {2, 3, 6, 11, 25, 40};
+  for (std::size_t size : sizes)
+  {
+    for (int rep = 0; rep < 10; rep++)
+    {
+      std::vector<double> data1(size), data2(size);
+      for (std::size_t i = 0; i < size; i++)
+      {
+        seed = seed * 1103515245u + 12345u;
+        data1[i] = (seed >> 16) % 1000;
+        seed = seed * 1103515245u + 12345u;
+        data2[i] = (seed >> 16) % 1000;
+      }
+      if (rep == 0) data2 = data1;
+      if (rep == 1) data2.assign(data1.rbegin(), data1.rend());
+
+      std::vector<double> std1(data1), std2(data2);
+      Scoring::standardize_data(std1);
+      Scoring::standardize_data(std2);
+      OpenSwath::Scoring::XCorrEntry peak = Scoring::standardizedCrossCorrelationMaxPeak(std1, std2);
+
+      OpenSwath::Scoring::XCorrArrayType full = Scoring::normalizedCrossCorrelation(data1, data2, static_cast<int>(size), 1);
+      OpenSwath::Scoring::XCorrArrayType::const_iterator expected = Scoring::xcorrArrayGetMaxPeak(full);
+
+      TEST_EQUAL (peak.first, expected->first)
+      TEST_REAL_SIMILAR (peak.second, expected->second)
+    }
+  }
+}
+END_SECTION
+
 BOOST_AUTO_TEST_CASE(test_MRMFeatureScoring_calcxcorr_legacy_mquest_)
 //START_SECTION((MRMFeatureScoring::XCorrArrayType MRMFeatureScoring::calcxcorr(std::vector<double>& data1, std::vector<double>& data2, bool normalize)))
 {
@@ -166,6 +166,8 @@ protected:
     vector<PeptideIdentification> pep_ids;
     vector<ProteinIdentification> prot_ids;
 
+    // the same peptides occur in many PSMs: parse each sequence only once
+    AASequence::setParseCacheEnabled(true);
     IdXMLFile().load(in, prot_ids, pep_ids);
 
     Size n_prot_ids = prot_ids.size();
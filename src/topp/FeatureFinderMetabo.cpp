@@ -36,12 +36,15 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/MassTrace.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/ElutionPeakDetection.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/FeatureFindingMetabo.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
+
 
 using namespace OpenMS;
 using namespace std;
@@ -126,6 +129,8 @@ protected:
     registerOutputFile_("out_chrom", "<file>", "", "Optional mzML file with chromatograms", false);
     setValidFormats_("out_chrom", ListUtils::create<String>("mzML"));
 
+    registerFlag_("low_memory", "Read the input block-wise from disc during mass trace detection instead of loading it completely. Requires an indexed mzML file and keeps the memory consumption bounded for long runs.", true);
+
     addEmptyLine_();
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
@@ -180,12 +185,31 @@ protected:
     //-------------------------------------------------------------
     // loading input
     //-------------------------------------------------------------
-    MzMLFile mz_data_file;
-    mz_data_file.setLogType(log_type_);
+    const bool low_memory = getFlag_("low_memory");
     PeakMap ms_peakmap;
-    std::vector<Int> ms_level(1, 1);
-    mz_data_file.getOptions().setMSLevels(ms_level);
-    mz_data_file.load(in, ms_peakmap);
+    OnDiscMSExperiment ondisc_map;
+    if (low_memory)
+    {
+      // only the meta data (spectra without peaks) is kept in memory
+      if (!ondisc_map.openFile(in))
+      {
+        OPENMS_LOG_ERROR << "The input file '" << in << "' is not an indexed mzML file, which is required for '-low_memory'." << std::endl;
+        return INCOMPATIBLE_INPUT_DATA;
+      }
+      ms_peakmap = *ondisc_map.getMetaData();
+      // restrict to MS1, as the in-memory path does when loading
+      std::vector<MSSpectrum>& spectra = ms_peakmap.getSpectra();
+      spectra.erase(std::remove_if(spectra.begin(), spectra.end(),
+          [](const MSSpectrum& spectrum) { return spectrum.getMSLevel() != 1; }), spectra.end());
+    }
+    else
+    {
+      MzMLFile mz_data_file;
+      mz_data_file.setLogType(log_type_);
+      std::vector<Int> ms_level(1, 1);
+      mz_data_file.getOptions().setMSLevels(ms_level);
+      mz_data_file.load(in, ms_peakmap);
+    }
 
     if (ms_peakmap.empty())
     {
@@ -206,8 +230,11 @@ protected:
       }
     }
 
-    // make sure the spectra are sorted by m/z
-    ms_peakmap.sortSpectra(true);
+    // make sure the spectra are sorted by m/z (the low memory path sorts each spectrum when reading it from disk)
+    if (!low_memory)
+    {
+      ms_peakmap.sortSpectra(true);
+    }
 
     vector<MassTrace> m_traces;
 
@@ -236,7 +263,14 @@ protected:
     mtd_param.remove("chrom_fwhm");
     mtdet.setParameters(mtd_param);
 
-    mtdet.run(ms_peakmap, m_traces);
+    if (low_memory)
+    {
+      mtdet.run(ondisc_map, m_traces);
+    }
+    else
+    {
+      mtdet.run(ms_peakmap, m_traces);
+    }
 
     //-------------------------------------------------------------
     // configure and run elution peak detection
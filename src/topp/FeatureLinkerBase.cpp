@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureBinFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
@@ -80,9 +81,9 @@ protected:
   void registerOptionsAndFlags_() override   // only for "unlabeled" algorithms!
   {
     registerInputFileList_("in", "<files>", ListUtils::create<String>(""), "input files separated by blanks", true);
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,featureBin,consensusXML,consensusBin"));
     registerOutputFile_("out", "<file>", "", "Output file", true);
-    setValidFormats_("out", ListUtils::create<String>("consensusXML"));
+    setValidFormats_("out", ListUtils::create<String>("consensusXML,consensusBin"));
     registerInputFile_("design", "<file>", "", "input file containing the experimental design", false);
     setValidFormats_("design", ListUtils::create<String>("tsv"));
     addEmptyLine_();
@@ -109,11 +110,12 @@ protected:
     //-------------------------------------------------------------
     // check for valid input
     //-------------------------------------------------------------
-    // check if all input files have the correct type
-    FileTypes::Type file_type = FileHandler::getType(ins[0]);
+    // check if all input files have the correct type (XML and binary files of the same kind can be mixed)
+    auto isFeatureFile = [](FileTypes::Type type) { return type == FileTypes::FEATUREXML || type == FileTypes::FEATUREBIN; };
+    const bool feature_input = isFeatureFile(FileHandler::getType(ins[0]));
     for (Size i = 0; i < ins.size(); ++i)
     {
-      if (FileHandler::getType(ins[i]) != file_type)
+      if (isFeatureFile(FileHandler::getType(ins[i])) != feature_input)
       {
         writeLog_("Error: All input files must be of the same type!");
         return ILLEGAL_PARAMETERS;
@@ -142,15 +144,15 @@ protected:
       design_file = getStringOption_("design");
     }
 
-    if (file_type == FileTypes::CONSENSUSXML && !design_file.empty())
+    if (!feature_input && !design_file.empty())
     {
       writeLog_("Error: Using fractionated design with consensusXML als input is not supported!");
       return ILLEGAL_PARAMETERS;
     }
   
-    if (file_type == FileTypes::FEATUREXML)
+    if (feature_input)
     {
-      OPENMS_LOG_INFO << "Linking " << ins.size() << " featureXMLs." << endl;
+      OPENMS_LOG_INFO << "Linking " << ins.size() << " feature maps." << endl;
   
       //-------------------------------------------------------------
       // Extract (optional) fraction identifiers and associate with featureXMLs
@@ -185,13 +187,13 @@ protected:
       }
 
       vector<FeatureMap > maps(ins.size());
-      FeatureXMLFile f;
-      FeatureFileOptions param = f.getOptions();
+      FileHandler f;
+      FeatureFileOptions param = f.getFeatOptions();
 
       // to save memory don't load convex hulls and subordinates
       param.setLoadSubordinates(false);
       param.setLoadConvexHull(false);
-      f.setOptions(param);
+      f.setFeatOptions(param);
 
       Size progress = 0;
       setLogType(ProgressLogger::CMD);
@@ -199,7 +201,7 @@ protected:
       for (Size i = 0; i < ins.size(); ++i)
       {
         FeatureMap tmp;
-        f.load(ins[i], tmp);
+        f.loadFeatures(ins[i], tmp);
 
         StringList ms_runs;
         tmp.getPrimaryMSRunPath(ms_runs);
@@ -286,10 +288,10 @@ protected:
       // Otherwise everyone has to remember e.g. to annotate the old map_index etc.
       bool keep_subelements = getFlag_("keep_subelements");
       vector<ConsensusMap> maps(ins.size());
-      ConsensusXMLFile f;
+      FileHandler f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        f.load(ins[i], maps[i]);
+        f.loadConsensusFeatures(ins[i], maps[i]);
         maps[i].updateRanges();
         // copy over information on the primary MS run
         StringList ms_runs;
@@ -347,7 +349,7 @@ protected:
     out_map.sortPeptideIdentificationsByMapIndex();
 
     // write output
-    ConsensusXMLFile().store(out, out_map);
+    FileHandler().storeConsensusFeatures(out, out_map);
 
     // some statistics
     map<Size, UInt> num_consfeat_of_size;
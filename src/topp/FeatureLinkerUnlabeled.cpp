@@ -129,11 +129,12 @@ protected:
     //-------------------------------------------------------------
     // check for valid input
     //-------------------------------------------------------------
-    // check if all input files have the correct type
-    FileTypes::Type file_type = FileHandler::getType(ins[0]);
+    // check if all input files have the correct type (XML and binary files of the same kind can be mixed)
+    auto isFeatureFile = [](FileTypes::Type type) { return type == FileTypes::FEATUREXML || type == FileTypes::FEATUREBIN; };
+    const bool feature_input = isFeatureFile(FileHandler::getType(ins[0]));
     for (Size i = 0; i < ins.size(); ++i)
     {
-      if (FileHandler::getType(ins[i]) != file_type)
+      if (isFeatureFile(FileHandler::getType(ins[i])) != feature_input)
       {
         writeLog_("Error: All input files must be of the same type!");
         return ILLEGAL_PARAMETERS;
@@ -154,14 +155,14 @@ protected:
     // load input
     ConsensusMap out_map;
     StringList ms_run_locations;
-    if (file_type == FileTypes::FEATUREXML)
+    if (feature_input)
     {
       // use map with highest number of features as reference:
       Size max_count(0);
       FeatureXMLFile f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        Size s = f.loadSize(ins[i]);
+        Size s = FileHandler::getType(ins[i]) == FileTypes::FEATUREBIN ? FeatureBinFile().loadSize(ins[i]) : f.loadSize(ins[i]);
         if (s > max_count)
         {
           max_count = s;
@@ -176,10 +177,10 @@ protected:
       std::vector<ProteinIdentification> ref_protids;
       {
         FeatureMap map_ref;
-        FeatureXMLFile f_fxml_tmp;
-        f_fxml_tmp.getOptions().setLoadConvexHull(false);
-        f_fxml_tmp.getOptions().setLoadSubordinates(false);
-        f_fxml_tmp.load(ins[reference_index], map_ref);
+        FileHandler f_fxml_tmp;
+        f_fxml_tmp.getFeatOptions().setLoadConvexHull(false);
+        f_fxml_tmp.getFeatOptions().setLoadSubordinates(false);
+        f_fxml_tmp.loadFeatures(ins[reference_index], map_ref);
         algorithm->setReference(reference_index, map_ref);
         ref_id = map_ref.getUniqueId();
         ref_size = map_ref.size();
@@ -192,11 +193,11 @@ protected:
       for (Size i = 0; i < ins.size(); ++i)
       {
 
-        FeatureXMLFile f_fxml_tmp;
+        FileHandler f_fxml_tmp;
         FeatureMap tmp_map;
-        f_fxml_tmp.getOptions().setLoadConvexHull(false);
-        f_fxml_tmp.getOptions().setLoadSubordinates(false);
-        f_fxml_tmp.load(ins[i], tmp_map);
+        f_fxml_tmp.getFeatOptions().setLoadConvexHull(false);
+        f_fxml_tmp.getFeatOptions().setLoadSubordinates(false);
+        f_fxml_tmp.loadFeatures(ins[i], tmp_map);
 
         // copy over information on the primary MS run
         StringList ms_runs;
@@ -290,10 +291,10 @@ protected:
     else
     {
       vector<ConsensusMap> maps(ins.size());
-      ConsensusXMLFile f;
+      FileHandler f;
       for (Size i = 0; i < ins.size(); ++i)
       {
-        f.load(ins[i], maps[i]);
+        f.loadConsensusFeatures(ins[i], maps[i]);
         StringList ms_runs;
         maps[i].getPrimaryMSRunPath(ms_runs);
         ms_run_locations.insert(ms_run_locations.end(), ms_runs.begin(), ms_runs.end());
@@ -328,7 +329,7 @@ protected:
 
     out_map.setPrimaryMSRunPath(ms_run_locations);
     // write output
-    ConsensusXMLFile().store(out, out_map);
+    FileHandler().storeConsensusFeatures(out, out_map);
 
     // some statistics
     map<Size, UInt> num_consfeat_of_size;
@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
@@ -191,7 +192,21 @@ protected:
   ExitCodes doLowMemAlgorithm(const PeakPickerHiRes& pp)
   {
     ///////////////////////////////////
-    // Create the consumer object, add data processing
+    // Indexed mzML: read, pick and write in a parallel pipeline
+    ///////////////////////////////////
+    OnDiscMSExperiment ondisc_exp;
+    ondisc_exp.setMemoryMapping(true);
+    // look for the index first: loading the meta data would parse the whole file if there is none
+    if (ondisc_exp.openFile(in, true) && ondisc_exp.openFile(in))
+    {
+      PlainMSDataWritingConsumer writer(out);
+      writer.addDataProcessing(getProcessingInfo_(DataProcessing::PEAK_PICKING));
+      pp.pickExperiment(ondisc_exp, writer, !getFlag_("force"));
+      return EXECUTION_OK;
+    }
+
+    ///////////////////////////////////
+    // Otherwise: create the consumer object, add data processing
     ///////////////////////////////////
     PPHiResMzMLConsumer pp_consumer(out, pp);
     pp_consumer.addDataProcessing(getProcessingInfo_(DataProcessing::PEAK_PICKING));
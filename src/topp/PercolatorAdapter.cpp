@@ -625,6 +625,8 @@ protected:
   
   ExitCodes readInputFiles_(const StringList& in_list, vector<PeptideIdentification>& all_peptide_ids, vector<ProteinIdentification>& all_protein_ids, bool isDecoy, bool& found_decoys, int& min_charge, int& max_charge)
   {
+    // the same peptides occur in many PSMs and across all input files: parse each sequence only once
+    AASequence::setParseCacheEnabled(true);
     for (StringList::const_iterator fit = in_list.begin(); fit != in_list.end(); ++fit)
     {
       String file_idx(distance(in_list.begin(), fit));
@@ -354,7 +354,7 @@ protected:
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "Input file");
-    setValidFormats_("in", ListUtils::create<String>("featureXML,consensusXML,idXML"));
+    setValidFormats_("in", ListUtils::create<String>("featureXML,featureBin,consensusXML,consensusBin,idXML"));
     registerInputFile_("protein_groups", "<file>", "", "Protein inference results for the identification runs that were used to annotate the input (e.g. from ProteinProphet via IDFileConverter or Fido via FidoAdapter).\nInformation about indistinguishable proteins will be used for protein quantification.", false);
     setValidFormats_("protein_groups", ListUtils::create<String>("idXML"));
 
@@ -761,10 +761,10 @@ protected:
 
     ExperimentalDesign ed;
 
-    if (in_type == FileTypes::FEATUREXML)
+    if (in_type == FileTypes::FEATUREXML || in_type == FileTypes::FEATUREBIN)
     {
       FeatureMap features;
-      FeatureXMLFile().load(in, features);
+      FileHandler().loadFeatures(in, features);
       columns_headers_[0].filename = in;
 
       ed = getExperimentalDesignFeatureMap_(design_file, features);
@@ -803,10 +803,10 @@ protected:
       quantifier.quantifyPeptides(peptides_); // quantify on peptide level
       quantifier.quantifyProteins(proteins_);
     }
-    else // consensusXML
+    else // consensusXML or consensusBin
     {
       ConsensusMap consensus;
-      ConsensusXMLFile().load(in, consensus);
+      FileHandler().loadConsensusFeatures(in, consensus);
       columns_headers_ = consensus.getColumnHeaders();
 
       ed = getExperimentalDesignConsensusMap_(design_file, consensus);
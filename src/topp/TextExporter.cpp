@@ -498,6 +498,44 @@ namespace OpenMS
     }
   }
 
+  // writes identifications while an idXML file is read (see IdXMLFile::transform)
+  class IdentificationTextWriter :
+    public Interfaces::IIdentificationConsumer
+  {
+  public:
+    IdentificationTextWriter(SVOutStream& out, const String& what, bool proteins_only, bool peptides_only, bool groups, bool first_dim_rt) :
+      out_(out), what_(what), proteins_only_(proteins_only), peptides_only_(peptides_only), groups_(groups), first_dim_rt_(first_dim_rt)
+    {
+    }
+
+    void consumeProteinIdentification(ProteinIdentification& prot_id) override
+    {
+      if (peptides_only_) return;
+      if (groups_)
+      {
+        writeProteinGroups(out_, prot_id.getIndistinguishableProteins());
+      }
+      writeProteinId(out_, prot_id, StringList());
+    }
+
+    void consumePeptideIdentifications(vector<PeptideIdentification>& pep_ids) override
+    {
+      if (proteins_only_) return;
+      for (const PeptideIdentification& pep_id : pep_ids)
+      {
+        writePeptideId(out_, pep_id, what_, true, true, first_dim_rt_);
+      }
+    }
+
+  private:
+    SVOutStream& out_;
+    String what_;
+    bool proteins_only_;
+    bool peptides_only_;
+    bool groups_;
+    bool first_dim_rt_;
+  };
+
   class TOPPTextExporter :
     public TOPPBase
   {
@@ -1217,6 +1255,52 @@ protected:
       }
       else if (in_type == FileTypes::IDXML)
       {
+        bool proteins_only = getFlag_("id:proteins_only");
+        bool peptides_only = getFlag_("id:peptides_only");
+        bool groups = getFlag_("id:protein_groups");
+        if (proteins_only && peptides_only)
+        {
+          throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "'id:proteins_only' and 'id:peptides_only' cannot be used together");
+        }
+        String what = peptides_only ? "" : "PEPTIDE";
+
+        auto writeHeaders = [&](SVOutStream& output, const StringList& protein_hit_meta_keys,
+                                const StringList& peptide_id_meta_keys, const StringList& peptide_hit_meta_keys)
+        {
+          if (!peptides_only)
+          {
+            writeRunHeader(output);
+            if (groups)
+            {
+              writeProteinGroupHeader(output);
+            }
+            writeProteinHeader(output);
+            writeMetaValuesHeader(output, protein_hit_meta_keys);
+            output << nl;
+          }
+          if (!proteins_only)
+          {
+            writePeptideHeader(output, what, true, true, first_dim_rt);
+            writeMetaValuesHeader(output, peptide_id_meta_keys);
+            writeMetaValuesHeader(output, peptide_hit_meta_keys);
+            output << nl;
+          }
+        };
+
+        // without meta value columns the header does not depend on the
+        // content, so the identifications are written while the file is read
+        // (each run in idXML is followed by its peptide identifications)
+        if (add_id_metavalues < 0 && add_hit_metavalues < 0 && add_protein_hit_metavalues < 0)
+        {
+          ofstream txt_out(out.c_str());
+          SVOutStream output(txt_out, sep, replacement, quoting_method);
+          writeHeaders(output, StringList(), StringList(), StringList());
+          IdentificationTextWriter writer(output, what, proteins_only, peptides_only, groups, first_dim_rt);
+          IdXMLFile().transform(in, &writer);
+          txt_out.close();
+          return EXECUTION_OK;
+        }
+
         vector<ProteinIdentification> prot_ids;
         vector<PeptideIdentification> pep_ids;
         String document_id;
@@ -1255,34 +1339,7 @@ protected:
 
         ofstream txt_out(out.c_str());
         SVOutStream output(txt_out, sep, replacement, quoting_method);
-
-        bool proteins_only = getFlag_("id:proteins_only");
-        bool peptides_only = getFlag_("id:peptides_only");
-        bool groups = getFlag_("id:protein_groups");
-        if (proteins_only && peptides_only)
-        {
-          throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "'id:proteins_only' and 'id:peptides_only' cannot be used together");
-        }
-
-        String what = peptides_only ? "" : "PEPTIDE";
-        if (!peptides_only)
-        {
-          writeRunHeader(output);
-          if (groups)
-          {
-            writeProteinGroupHeader(output);
-          }
-          writeProteinHeader(output);
-          writeMetaValuesHeader(output, protein_hit_meta_keys);
-          output << nl;
-        }
-        if (!proteins_only)
-        {
-          writePeptideHeader(output, what, true, true, first_dim_rt);
-          writeMetaValuesHeader(output, peptide_id_meta_keys);
-          writeMetaValuesHeader(output, peptide_hit_meta_keys);
-          output << nl;
-        }
+        writeHeaders(output, protein_hit_meta_keys, peptide_id_meta_keys, peptide_hit_meta_keys);
 
         for (vector<ProteinIdentification>::const_iterator it =
                prot_ids.begin(); it != prot_ids.end(); ++it)
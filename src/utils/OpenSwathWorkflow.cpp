@@ -49,6 +49,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathQC.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/MappedTransitionLibrary.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathTSVWriter.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 #include <OpenMS/SYSTEM/File.h>
@@ -58,6 +59,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessTransforming.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSCached.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SwathMap.h>
 
 // Helpers
@@ -138,7 +140,9 @@ using namespace OpenMS;
   Since the file size can become rather large, it is recommended to not load the
   whole file into memory but rather cache it somewhere on the disk using a
   fast-access data format. This can be specified using the -readOptions cache
-  parameter (this is recommended!).
+  parameter (this is recommended!). With -readOptions cacheMemoryMapped, the
+  cached files are additionally memory-mapped and chromatograms are extracted
+  directly from the mapped files without copying each spectrum to memory first.
 
   The assay library (transition list) is provided through the @p -tr parameter and can be in one of the following formats:
   
@@ -146,11 +150,17 @@ using namespace OpenMS;
       <li> @ref OpenMS::TraMLFile "TraML" </li>
       <li> @ref OpenMS::TransitionTSVFile "OpenSWATH TSV transition lists" </li>
       <li> @ref OpenMS::TransitionPQPFile "OpenSWATH PQP SQLite files" </li>
+      <li> @ref OpenMS::TransitionBinFile "OpenSWATH binary transition libraries (trBin)" </li>
       <li> SpectraST MRM transition lists </li>
       <li> Skyline transition lists </li>
       <li> Spectronaut transition lists </li>
     </ul>
 
+  Binary transition libraries (created with TargetedFileConverter) are
+  memory-mapped and only the transitions of the SWATH window that is currently
+  analyzed are held in memory. Several OpenSwathWorkflow processes using the
+  same library share it through the page cache.
+
   <h3>Parameters</h3>
   The current parameters are optimized for 2 hour gradients on SCIEX 5600 /
   6600 TripleTOF instruments with a peak width of around 30 seconds using iRT
@@ -433,10 +443,10 @@ protected:
     registerInputFileList_("in", "<files>", StringList(), "Input files separated by blank");
     setValidFormats_("in", ListUtils::create<String>("mzML,mzXML,sqMass"));
 
-    registerInputFile_("tr", "<file>", "", "transition file ('TraML','tsv','pqp')");
-    setValidFormats_("tr", ListUtils::create<String>("traML,tsv,pqp"));
+    registerInputFile_("tr", "<file>", "", "transition file ('TraML','tsv','pqp','trBin')");
+    setValidFormats_("tr", ListUtils::create<String>("traML,tsv,pqp,trBin"));
     registerStringOption_("tr_type", "<type>", "", "input file type -- default: determined from file extension or content\n", false);
-    setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,pqp"));
+    setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,pqp,trBin"));
 
     // one of the following two needs to be set
     registerInputFile_("tr_irt", "<file>", "", "transition file ('TraML')", false);
@@ -516,8 +526,8 @@ protected:
     registerFlag_("split_file_input", "The input files each contain one single SWATH (alternatively: all SWATH are in separate files)", true);
     registerFlag_("use_elution_model_score", "Turn on elution model score (EMG fit to peak)", true);
 
-    registerStringOption_("readOptions", "<name>", "normal", "Whether to run OpenSWATH directly on the input data, cache data to disk first or to perform a datareduction step first. If you choose cache, make sure to also set tempDirectory", false, true);
-    setValidStrings_("readOptions", ListUtils::create<String>("normal,cache,cacheWorkingInMemory,workingInMemory"));
+    registerStringOption_("readOptions", "<name>", "normal", "Whether to run OpenSWATH directly on the input data, cache data to disk first or to perform a datareduction step first. If you choose cache, make sure to also set tempDirectory. cacheMemoryMapped accesses the cached data through a memory mapping (recommended on 64 bit systems).", false, true);
+    setValidStrings_("readOptions", ListUtils::create<String>("normal,cache,cacheWorkingInMemory,workingInMemory,cacheMemoryMapped"));
 
     registerStringOption_("mz_correction_function", "<name>", "none", "Use the retention time normalization peptide MS2 masses to perform a mass correction (linear, weighted by intensity linear or quadratic) of all spectra.", false, true);
     setValidStrings_("mz_correction_function", ListUtils::create<String>("none,regression_delta_ppm,unweighted_regression,weighted_regression,quadratic_regression,weighted_quadratic_regression,weighted_quadratic_regression_delta_ppm,quadratic_regression_delta_ppm"));
@@ -711,7 +721,13 @@ protected:
     ///////////////////////////////////
 
     bool load_into_memory = false;
-    if (readoptions == "cacheWorkingInMemory")
+    bool memory_map = false;
+    if (readoptions == "cacheMemoryMapped")
+    {
+      readoptions = "cache";
+      memory_map = true;
+    }
+    else if (readoptions == "cacheWorkingInMemory")
     {
       readoptions = "cache";
       load_into_memory = true;
@@ -805,9 +821,23 @@ protected:
     ///////////////////////////////////
     // Load the transitions
     ///////////////////////////////////
-    OpenSwath::LightTargetedExperiment transition_exp = loadTransitionList(tr_type, tr_file, tsv_reader_param);
-    OPENMS_LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
-      transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
+    // Binary libraries are mapped and read window by window during extraction,
+    // unless they need to be modified (ion mobility calibration below) or are
+    // used for SONAR data
+    OpenSwath::LightTargetedExperiment transition_exp;
+    MappedTransitionLibrary mapped_library;
+    if (tr_type == FileTypes::TRANSITIONBIN && !sonar && nonlinear_irt_tr_file.empty())
+    {
+      mapped_library.open(tr_file);
+      OPENMS_LOG_INFO << "Mapped " << mapped_library.getNrProteins() << " proteins, " <<
+        mapped_library.getNrCompounds() << " compounds with " << mapped_library.getNrTransitions() << " transitions." << std::endl;
+    }
+    else
+    {
+      transition_exp = loadTransitionList(tr_type, tr_file, tsv_reader_param);
+      OPENMS_LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
+        transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
+    }
 
     if (tr_type == FileTypes::PQP)
     {
@@ -852,6 +882,16 @@ protected:
       }
     }
 
+    if (memory_map)
+    {
+      // cached maps will be read in place from the mapped files
+      for (auto& m : swath_maps)
+      {
+        boost::shared_ptr<SpectrumAccessOpenMSCached> cached = boost::dynamic_pointer_cast<SpectrumAccessOpenMSCached>(m.sptr);
+        if (cached != nullptr) cached->setMemoryMapping(true);
+      }
+    }
+
 
     ///////////////////////////////////
     // Get the transformation information (using iRT peptides)
@@ -929,7 +969,8 @@ protected:
     // Either use chrom.mzML or sqlite DB
     ///////////////////////////////////
     Interfaces::IMSDataConsumer* chromatogramConsumer;
-    prepareChromOutput(&chromatogramConsumer, exp_meta, transition_exp, out_chrom);
+    prepareChromOutput(&chromatogramConsumer, exp_meta,
+                       mapped_library.isOpen() ? mapped_library.getNrTransitions() : transition_exp.getTransitions().size(), out_chrom);
 
     ///////////////////////////////////
     // Set up peakgroup file output
@@ -952,8 +993,16 @@ protected:
     {
       OpenSwathWorkflow wf(use_ms1_traces, use_ms1_im, prm, outer_loop_threads);
       wf.setLogType(log_type_);
-      wf.performExtraction(swath_maps, trafo_rtnorm, cp, cp_ms1, feature_finder_param, transition_exp,
-          out_featureFile, !out.empty(), tsvwriter, oswwriter, chromatogramConsumer, batchSize, ms1_isotopes, load_into_memory);
+      if (mapped_library.isOpen())
+      {
+        wf.performExtraction(swath_maps, trafo_rtnorm, cp, cp_ms1, feature_finder_param, mapped_library,
+            out_featureFile, !out.empty(), tsvwriter, oswwriter, chromatogramConsumer, batchSize, ms1_isotopes, load_into_memory);
+      }
+      else
+      {
+        wf.performExtraction(swath_maps, trafo_rtnorm, cp, cp_ms1, feature_finder_param, transition_exp,
+            out_featureFile, !out.empty(), tsvwriter, oswwriter, chromatogramConsumer, batchSize, ms1_isotopes, load_into_memory);
+      }
     }
 
     if (!out.empty())
@@ -34,6 +34,8 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/TransitionBinFile.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/CONCEPT/Exception.h>
@@ -65,6 +67,10 @@ using namespace OpenMS;
           <li> Spectronaut transition lists </li>
         </ul>
 
+  In addition, libraries can be converted (output only) to the
+  @ref OpenMS::TransitionBinFile "OpenSWATH binary transition library" format
+  (trBin), which OpenSwathWorkflow memory-maps instead of loading it.
+
   <B>The command line parameters of this tool are:</B>
   @verbinclude UTILS_TargetedFileConverter.cli
   <B>INI file documentation of this tool:</B>
@@ -94,7 +100,7 @@ protected:
     setValidFormats_("in", formats);
     setValidStrings_("in_type", formats);
 
-    formats = { "tsv", "pqp", "TraML" };
+    formats = { "tsv", "pqp", "TraML", "trBin" };
     registerOutputFile_("out", "<file>", "", "Output file");
     setValidFormats_("out", formats);
     registerStringOption_("out_type", "<type>", "", "Output file type -- default: determined from file extension or content\nNote: not all conversion paths work or make sense.", false);
@@ -192,6 +198,14 @@ protected:
       TraMLFile traml;
       traml.store(out, targeted_exp);
     }
+    else if (out_type == FileTypes::TRANSITIONBIN)
+    {
+      OpenSwath::LightTargetedExperiment transition_exp;
+      OpenSwathDataAccessHelper::convertTargetedExp(targeted_exp, transition_exp);
+      TransitionBinFile bin_writer;
+      bin_writer.setLogType(log_type_);
+      bin_writer.store(out, transition_exp);
+    }
 
     return EXECUTION_OK;
   }